@@ -53,6 +53,15 @@ public class MetricsStep {
   @JsonProperty("miss_cache_millisecond")
   protected long missCacheMillisecond;
 
+  @JsonProperty("runtime_filters")
+  protected long runtimeFilters;
+
+  @JsonProperty("footer_cache_hits")
+  protected long footerCacheHits;
+
+  @JsonProperty("footer_cache_misses")
+  protected long footerCacheMisses;
+
   public String getName() {
     return name;
   }
@@ -148,4 +157,28 @@ public class MetricsStep {
   public void setMissCacheMillisecond(long missCacheMillisecond) {
     this.missCacheMillisecond = missCacheMillisecond;
   }
+
+  public long getRuntimeFilters() {
+    return runtimeFilters;
+  }
+
+  public void setRuntimeFilters(long runtimeFilters) {
+    this.runtimeFilters = runtimeFilters;
+  }
+
+  public long getFooterCacheHits() {
+    return footerCacheHits;
+  }
+
+  public void setFooterCacheHits(long footerCacheHits) {
+    this.footerCacheHits = footerCacheHits;
+  }
+
+  public long getFooterCacheMisses() {
+    return footerCacheMisses;
+  }
+
+  public void setFooterCacheMisses(long footerCacheMisses) {
+    this.footerCacheMisses = footerCacheMisses;
+  }
 }
@@ -38,14 +38,16 @@ public class CHStreamReader implements AutoCloseable {
             this.inputStream,
             inputStream.isCompressed(),
             CHBackendSettings.maxShuffleReadRows(),
-            CHBackendSettings.maxShuffleReadBytes());
+            CHBackendSettings.maxShuffleReadBytes(),
+            CHBackendSettings.shuffleReadDecompressThreads());
   }
 
   private static native long createNativeShuffleReader(
       ShuffleInputStream inputStream,
       boolean compressed,
       long maxShuffleReadRows,
-      long maxShuffleReadBytes);
+      long maxShuffleReadBytes,
+      int decompressThreads);
 
   private native long nativeNext(long nativeShuffleReader);
 
@@ -60,9 +62,10 @@ public class CHStreamReader implements AutoCloseable {
 
   @Override
   public void close() throws Exception {
-    // close input stream and release buffer
-    this.inputStream.close();
+    // close the native reader first, it reads the input stream and waits for its decompression
     nativeClose(nativeShuffleReader);
     nativeShuffleReader = 0L;
+    // close input stream and release buffer
+    this.inputStream.close();
   }
 }
@@ -35,6 +35,9 @@ public class StorageJoinBuilder {
 
   public static native long nativeCloneBuildHashTable(long hashTableData);
 
+  /** Native memory held by a built hash table, in bytes. */
+  public static native long nativeGetMemoryUsage(long hashTableData);
+
   private static native long nativeBuild(
       String buildHashTableId,
       byte[] in,
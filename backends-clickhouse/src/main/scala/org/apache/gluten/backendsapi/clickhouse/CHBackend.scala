@@ -109,6 +109,19 @@ object CHBackendSettings extends BackendSettingsApi with Logging {
   // unit: SECONDS, default 1 day
   val GLUTEN_CLICKHOUSE_BROADCAST_CACHE_EXPIRED_TIME_DEFAULT: Int = 86400
 
+  // Upper bound of the native memory held by the cached broadcast hash tables of an executor,
+  // default 2GB, 0 means unlimited. Above it, the least recently used idle tables are removed,
+  // and are built again from the broadcast value when they are used later.
+  val GLUTEN_CLICKHOUSE_BROADCAST_CACHE_MAX_SIZE: String =
+    CHConfig.prefixOf("broadcast.cache.max.size")
+  val GLUTEN_CLICKHOUSE_BROADCAST_CACHE_MAX_SIZE_DEFAULT: String = "2GB"
+
+  // A table is only removed for the size limit if it is not used for at least this time.
+  val GLUTEN_CLICKHOUSE_BROADCAST_CACHE_MIN_IDLE_TIME: String =
+    CHConfig.prefixOf("broadcast.cache.min.idle.time")
+  // unit: SECONDS
+  val GLUTEN_CLICKHOUSE_BROADCAST_CACHE_MIN_IDLE_TIME_DEFAULT: Int = 60
+
   private val GLUTEN_CLICKHOUSE_SHUFFLE_SUPPORTED_CODEC: Set[String] = Set("lz4", "zstd", "snappy")
 
   // The algorithm for hash partition of the shuffle
@@ -139,6 +152,11 @@ object CHBackendSettings extends BackendSettingsApi with Logging {
   private val GLUTEN_MAX_SHUFFLE_READ_BYTES: String =
     CHConfig.runtimeConfig("max_source_concatenate_bytes")
   private val GLUTEN_MAX_SHUFFLE_READ_BYTES_DEFAULT = GLUTEN_MAX_BLOCK_SIZE_DEFAULT * 256
+  // Threads decompressing shuffle data ahead of the consumer in each reader, 0 decompresses on
+  // the consumer thread
+  private val GLUTEN_SHUFFLE_READ_DECOMPRESS_THREADS: String =
+    CHConfig.prefixOf("shuffle.read.decompress.threads")
+  private val GLUTEN_SHUFFLE_READ_DECOMPRESS_THREADS_DEFAULT = 0
 
   val GLUTEN_AQE_PROPAGATEEMPTY: String = CHConfig.prefixOf("aqe.propagate.empty.relation")
 
@@ -372,6 +390,12 @@ object CHBackendSettings extends BackendSettingsApi with Logging {
       .getLong(GLUTEN_MAX_SHUFFLE_READ_BYTES, GLUTEN_MAX_SHUFFLE_READ_BYTES_DEFAULT)
   }
 
+  def shuffleReadDecompressThreads(): Int = {
+    SparkEnv.get.conf.getInt(
+      GLUTEN_SHUFFLE_READ_DECOMPRESS_THREADS,
+      GLUTEN_SHUFFLE_READ_DECOMPRESS_THREADS_DEFAULT)
+  }
+
   // Move the pre-prejection for a aggregation ahead of the expand node
   // for example, select a, b, sum(c+d) from t group by a, b with cube
   def enablePushdownPreProjectionAheadExpand(): Boolean = {
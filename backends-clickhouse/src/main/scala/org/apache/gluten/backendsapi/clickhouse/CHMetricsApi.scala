@@ -167,7 +167,13 @@ class CHMetricsApi extends MetricsApi with Logging with LogLevelUtil {
         "Time reading from filesystem cache"),
       "missCacheMillisecond" -> SQLMetrics.createTimingMetric(
         sparkContext,
-        "Time reading from filesystem cache source (from remote filesystem, etc)")
+        "Time reading from filesystem cache source (from remote filesystem, etc)"),
+      "footerCacheHits" -> SQLMetrics.createMetric(
+        sparkContext,
+        "Number of times the parquet footer was found in the footer cache"),
+      "footerCacheMisses" -> SQLMetrics.createMetric(
+        sparkContext,
+        "Number of times the parquet footer was parsed for the footer cache")
     )
 
   override def genFileSourceScanTransformerMetricsUpdater(
@@ -412,7 +418,11 @@ class CHMetricsApi extends MetricsApi with Logging with LogLevelUtil {
       "fillingRightJoinSideTime" -> SQLMetrics.createTimingMetric(
         sparkContext,
         "filling right join side time"),
-      "conditionTime" -> SQLMetrics.createTimingMetric(sparkContext, "join condition time")
+      "conditionTime" -> SQLMetrics.createTimingMetric(sparkContext, "join condition time"),
+      "numDynamicFiltersProduced" ->
+        SQLMetrics.createMetric(sparkContext, "number of dynamic filters produced"),
+      "numDynamicFilterDroppedRows" ->
+        SQLMetrics.createMetric(sparkContext, "number of rows dropped by dynamic filters")
     )
 
   override def genHashJoinTransformerMetricsUpdater(
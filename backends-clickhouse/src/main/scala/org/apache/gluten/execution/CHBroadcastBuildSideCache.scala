@@ -19,7 +19,7 @@ package org.apache.gluten.execution
 import org.apache.gluten.backendsapi.clickhouse.CHBackendSettings
 import org.apache.gluten.vectorized.StorageJoinBuilder
 
-import org.apache.spark.SparkEnv
+import org.apache.spark.{SparkEnv, TaskContext}
 import org.apache.spark.broadcast.Broadcast
 import org.apache.spark.internal.Logging
 import org.apache.spark.sql.execution.joins.{BuildSideRelation, ClickHouseBuildSideRelation}
@@ -27,8 +27,36 @@ import org.apache.spark.sql.execution.joins.{BuildSideRelation, ClickHouseBuildS
 import com.github.benmanes.caffeine.cache.{Cache, Caffeine, RemovalCause, RemovalListener}
 
 import java.util.concurrent.TimeUnit
+import java.util.concurrent.atomic.AtomicInteger
 
-case class BroadcastHashTable(pointer: Long, relation: ClickHouseBuildSideRelation)
+import scala.collection.JavaConverters._
+
+class BroadcastHashTable(val pointer: Long, val relation: ClickHouseBuildSideRelation) {
+
+  // Number of running tasks using the table
+  private val users = new AtomicInteger(0)
+
+  // Native bytes of the table. Set when it's cached, and updated when a task using it completes,
+  // since the first task builds the hash table lazily.
+  @volatile private var cachedMemoryUsage = 0L
+
+  // Set once the native table is released, guarded by the lock of CHBroadcastBuildSideCache
+  private[execution] var removed = false
+
+  def retain(): Unit = users.incrementAndGet()
+
+  def release(): Unit = users.decrementAndGet()
+
+  def inUse: Boolean = users.get() > 0
+
+  def memoryUsage: Long = cachedMemoryUsage
+
+  private[execution] def updateMemoryUsage(): Unit = {
+    // A cloned table shares the memory of the table it is cloned from
+    cachedMemoryUsage =
+      if (relation != null) StorageJoinBuilder.nativeGetMemoryUsage(pointer) else 0L
+  }
+}
 
 /**
  * `CHBroadcastBuildSideCache` is used for controlling to build bhj hash table once.
@@ -43,6 +71,16 @@ object CHBroadcastBuildSideCache extends Logging with RemovalListener[String, Br
     CHBackendSettings.GLUTEN_CLICKHOUSE_BROADCAST_CACHE_EXPIRED_TIME_DEFAULT
   )
 
+  private lazy val maxMemoryUsage = SparkEnv.get.conf.getSizeAsBytes(
+    CHBackendSettings.GLUTEN_CLICKHOUSE_BROADCAST_CACHE_MAX_SIZE,
+    CHBackendSettings.GLUTEN_CLICKHOUSE_BROADCAST_CACHE_MAX_SIZE_DEFAULT
+  )
+
+  private lazy val minIdleTime = SparkEnv.get.conf.getLong(
+    CHBackendSettings.GLUTEN_CLICKHOUSE_BROADCAST_CACHE_MIN_IDLE_TIME,
+    CHBackendSettings.GLUTEN_CLICKHOUSE_BROADCAST_CACHE_MIN_IDLE_TIME_DEFAULT
+  )
+
   // Use for controlling to build bhj hash table once.
   // key: hashtable id, value is hashtable backend pointer(long to string).
   private val buildSideRelationCache: Cache[String, BroadcastHashTable] =
@@ -54,19 +92,77 @@ object CHBroadcastBuildSideCache extends Logging with RemovalListener[String, Br
   def getOrBuildBroadcastHashTable(
       broadcast: Broadcast[BuildSideRelation],
       broadCastContext: BroadCastHashJoinContext): BroadcastHashTable = {
-
-    buildSideRelationCache
-      .get(
-        broadCastContext.buildHashTableId,
-        (broadcast_id: String) => {
-          val (pointer, relation) =
-            broadcast.value
-              .asInstanceOf[ClickHouseBuildSideRelation]
-              .buildHashTable(broadCastContext)
-          logDebug(s"Create bhj $broadcast_id = 0x${pointer.toHexString}")
-          BroadcastHashTable(pointer, relation)
+    val id = broadCastContext.buildHashTableId
+    var table: BroadcastHashTable = null
+    while (table == null) {
+      val cached = buildSideRelationCache
+        .get(
+          id,
+          (broadcast_id: String) => {
+            val (pointer, relation) =
+              broadcast.value
+                .asInstanceOf[ClickHouseBuildSideRelation]
+                .buildHashTable(broadCastContext)
+            val created = new BroadcastHashTable(pointer, relation)
+            created.updateMemoryUsage()
+            logDebug(
+              s"Create bhj $broadcast_id = 0x${pointer.toHexString}, " +
+                s"${created.memoryUsage} bytes")
+            created
+          }
+        )
+      // The native plan looks the table up in the cache later on, so the task pins it until it
+      // completes. Pinning holds the lock of evictIdleTables, retry if it was evicted meanwhile.
+      synchronized {
+        if (buildSideRelationCache.getIfPresent(id) eq cached) {
+          table = cached
+          Option(TaskContext.get()).foreach {
+            context =>
+              table.retain()
+              context.addTaskCompletionListener[Unit](_ => releaseTable(table))
+          }
         }
-      )
+      }
+    }
+    if (maxMemoryUsage > 0) {
+      evictIdleTables()
+    }
+    table
+  }
+
+  /** Unpin the table, its size is read again since the task may have built its hash table. */
+  private def releaseTable(table: BroadcastHashTable): Unit = synchronized {
+    table.release()
+    if (!table.removed) {
+      table.updateMemoryUsage()
+    }
+  }
+
+  /**
+   * Remove the least recently used tables until the cached tables fit into `maxMemoryUsage`. Only
+   * tables not used by a running task and not used for `minIdleTime` are removed.
+   */
+  private def evictIdleTables(): Unit = synchronized {
+    val sizes = buildSideRelationCache.asMap().asScala.map {
+      case (id, table) => id -> table.memoryUsage
+    }
+    var memoryUsage = sizes.values.sum
+    val expiration = buildSideRelationCache.policy().expireAfterAccess()
+    if (memoryUsage > maxMemoryUsage && expiration.isPresent) {
+      // Ordered from the least recently used one
+      expiration.get().oldest(Int.MaxValue).asScala.foreach {
+        case (id, table) =>
+          val idleTime = expiration.get().ageOf(id, TimeUnit.SECONDS).orElse(0L)
+          val size = sizes.getOrElse(id, 0L)
+          if (memoryUsage > maxMemoryUsage && !table.inUse && idleTime >= minIdleTime) {
+            logInfo(
+              s"Remove bhj $id of $size bytes, idle for $idleTime s, " +
+                s"cached bhj use $memoryUsage bytes")
+            buildSideRelationCache.invalidate(id)
+            memoryUsage -= size
+          }
+      }
+    }
   }
 
   /** This is callback from c++ backend. */
@@ -85,11 +181,13 @@ object CHBroadcastBuildSideCache extends Logging with RemovalListener[String, Br
 
   def cleanAll(): Unit = buildSideRelationCache.invalidateAll()
 
-  override def onRemoval(key: String, value: BroadcastHashTable, cause: RemovalCause): Unit = {
-    logDebug(s"Remove bhj $key = 0x${value.pointer.toHexString}")
-    if (value.relation != null) {
-      value.relation.reset()
+  override def onRemoval(key: String, value: BroadcastHashTable, cause: RemovalCause): Unit =
+    synchronized {
+      logDebug(s"Remove bhj $key = 0x${value.pointer.toHexString}")
+      value.removed = true
+      if (value.relation != null) {
+        value.relation.reset()
+      }
+      StorageJoinBuilder.nativeCleanBuildHashTable(key, value.pointer)
     }
-    StorageJoinBuilder.nativeCleanBuildHashTable(key, value.pointer)
-  }
 }
@@ -19,6 +19,8 @@ package org.apache.gluten.metrics
 import org.apache.spark.internal.Logging
 import org.apache.spark.sql.execution.metric.SQLMetric
 
+import scala.collection.JavaConverters._
+
 class HashJoinMetricsUpdater(val metrics: Map[String, SQLMetric])
   extends MetricsUpdater
   with Logging {
@@ -66,8 +68,21 @@ class HashJoinMetricsUpdater(val metrics: Map[String, SQLMetric])
           metrics("outputWaitTime") += (joinMetricsData.outputWaitTime / 1000L).toLong
           totalTime += joinMetricsData.time
 
+          // runtime filters on the probe side, their FilterTransform is not the join condition
+          val runtimeFilterSteps = joinMetricsData.steps.asScala
+            .filter(_.description == HashJoinMetricsUpdater.RUNTIME_FILTER_STEP)
+          // only the filters that were actually built and published
+          metrics("numDynamicFiltersProduced") += runtimeFilterSteps.map(_.getRuntimeFilters).sum
+          val runtimeFilterProcessors = runtimeFilterSteps.flatMap(_.processors.asScala)
+          runtimeFilterProcessors.foreach(
+            processor => {
+              metrics("numDynamicFilterDroppedRows") += processor.inputRows - processor.outputRows
+              metrics("extraTime") += (processor.time / 1000L).toLong
+            })
+
           MetricsUtil
             .getAllProcessorList(joinMetricsData)
+            .filterNot(processor => runtimeFilterProcessors.exists(_ eq processor))
             .foreach(
               processor => {
                 if (processor.name.equalsIgnoreCase("FillingRightJoinSide")) {
@@ -114,4 +129,6 @@ class HashJoinMetricsUpdater(val metrics: Map[String, SQLMetric])
 object HashJoinMetricsUpdater {
   val INCLUDING_PROCESSORS = Array("JoiningTransform", "FillingRightJoinSide", "FilterTransform")
   val CH_PLAN_NODE_NAME = Array("JoiningTransform")
+  // Description of the steps filtering the probe side by the build side keys
+  val RUNTIME_FILTER_STEP = "Runtime Filter"
 }
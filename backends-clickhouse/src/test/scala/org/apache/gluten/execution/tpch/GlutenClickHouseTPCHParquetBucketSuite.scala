@@ -47,6 +47,7 @@ class GlutenClickHouseTPCHParquetBucketSuite
       .set("spark.gluten.sql.columnar.backend.ch.shuffle.hash.algorithm", "sparkMurmurHash3_32")
       .setCHConfig("enable_pre_projection_for_join_conditions", "false")
       .setCHConfig("enable_grace_aggregate_spill_test", "true")
+      .setCHConfig("grace_aggregate_merging_parallelism", "2")
   }
 
   lazy val hasSortByCol: Boolean = true
@@ -48,6 +48,15 @@ public interface JniFilesystem {
   interface ReadFile {
     void pread(long offset, long length, long buf); // uint64_t offset, uint64_t length, void* buf
 
+    // Reads several ranges with a single call from C++, bufs[i] receives lengths[i] bytes at
+    // offsets[i]. The ranges are in the ascending order of offsets. Implementations backed by
+    // remote storage should override this to issue the reads together.
+    default void preadv(long[] offsets, long[] lengths, long[] bufs) {
+      for (int i = 0; i < offsets.length; i++) {
+        pread(offsets[i], lengths[i], bufs[i]);
+      }
+    }
+
     boolean shouldCoalesce();
 
     long size();
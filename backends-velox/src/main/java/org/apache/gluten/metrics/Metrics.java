@@ -52,6 +52,9 @@ public class Metrics implements IMetrics {
   public long[] localReadBytes;
   public long[] ramReadBytes;
   public long[] preloadSplits;
+  public long[] footerCacheHits;
+  public long[] footerCacheMisses;
+  public long[] splitPreloadDepth;
 
   public long[] physicalWrittenBytes;
   public long[] writeIOTime;
@@ -97,6 +100,9 @@ public class Metrics implements IMetrics {
       long[] localReadBytes,
       long[] ramReadBytes,
       long[] preloadSplits,
+      long[] footerCacheHits,
+      long[] footerCacheMisses,
+      long[] splitPreloadDepth,
       long[] physicalWrittenBytes,
       long[] writeIOTime,
       long[] numWrittenFiles,
@@ -135,6 +141,9 @@ public class Metrics implements IMetrics {
     this.localReadBytes = localReadBytes;
     this.ramReadBytes = ramReadBytes;
     this.preloadSplits = preloadSplits;
+    this.footerCacheHits = footerCacheHits;
+    this.footerCacheMisses = footerCacheMisses;
+    this.splitPreloadDepth = splitPreloadDepth;
     this.physicalWrittenBytes = physicalWrittenBytes;
     this.writeIOTime = writeIOTime;
     this.numWrittenFiles = numWrittenFiles;
@@ -180,6 +189,9 @@ public class Metrics implements IMetrics {
         localReadBytes[index],
         ramReadBytes[index],
         preloadSplits[index],
+        footerCacheHits[index],
+        footerCacheMisses[index],
+        splitPreloadDepth[index],
         physicalWrittenBytes[index],
         writeIOTime[index],
         numWrittenFiles[index]);
@@ -50,6 +50,9 @@ public class OperatorMetrics implements IOperatorMetrics {
   public long localReadBytes;
   public long ramReadBytes;
   public long preloadSplits;
+  public long footerCacheHits;
+  public long footerCacheMisses;
+  public long splitPreloadDepth;
 
   public long physicalWrittenBytes;
   public long writeIOTime;
@@ -90,6 +93,9 @@ public class OperatorMetrics implements IOperatorMetrics {
       long localReadBytes,
       long ramReadBytes,
       long preloadSplits,
+      long footerCacheHits,
+      long footerCacheMisses,
+      long splitPreloadDepth,
       long physicalWrittenBytes,
       long writeIOTime,
       long numWrittenFiles) {
@@ -126,6 +132,9 @@ public class OperatorMetrics implements IOperatorMetrics {
     this.localReadBytes = localReadBytes;
     this.ramReadBytes = ramReadBytes;
     this.preloadSplits = preloadSplits;
+    this.footerCacheHits = footerCacheHits;
+    this.footerCacheMisses = footerCacheMisses;
+    this.splitPreloadDepth = splitPreloadDepth;
     this.physicalWrittenBytes = physicalWrittenBytes;
     this.writeIOTime = writeIOTime;
     this.numWrittenFiles = numWrittenFiles;
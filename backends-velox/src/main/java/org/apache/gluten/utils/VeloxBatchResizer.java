@@ -39,4 +39,11 @@ public final class VeloxBatchResizer {
                 new ColumnarBatchInIterator(BackendsApiManager.getBackendName(), in));
     return new ColumnarBatchOutIterator(runtime, outHandle);
   }
+
+  /** Peak bytes of the input batches held while their slices were returned, read before close. */
+  public static long peakRetainedBytes(ColumnarBatchOutIterator out) {
+    final Runtime runtime =
+        Runtimes.contextInstance(BackendsApiManager.getBackendName(), "VeloxBatchResizer");
+    return VeloxBatchResizerJniWrapper.create(runtime).peakRetainedBytes(out.itrHandle());
+  }
 }
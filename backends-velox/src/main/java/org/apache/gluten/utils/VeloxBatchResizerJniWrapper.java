@@ -38,4 +38,6 @@ public class VeloxBatchResizerJniWrapper implements RuntimeAware {
 
   public native long create(
       int minOutputBatchSize, int maxOutputBatchSize, ColumnarBatchInIterator itr);
+
+  public native long peakRetainedBytes(long iterHandle);
 }
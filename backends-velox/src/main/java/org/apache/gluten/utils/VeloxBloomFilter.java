@@ -17,10 +17,12 @@
 package org.apache.gluten.utils;
 
 import org.apache.gluten.backendsapi.BackendsApiManager;
+import org.apache.gluten.columnarbatch.ColumnarBatches;
 import org.apache.gluten.runtime.Runtimes;
 
 import io.netty.util.internal.PlatformDependent;
 import org.apache.commons.io.IOUtils;
+import org.apache.spark.sql.vectorized.ColumnarBatch;
 import org.apache.spark.util.sketch.BloomFilter;
 import org.apache.spark.util.sketch.IncompatibleMergeException;
 
@@ -32,10 +34,15 @@ import java.io.OutputStream;
 import java.nio.ByteBuffer;
 
 public class VeloxBloomFilter extends BloomFilter {
+  // Items passed to putLong are inserted into the native filter in batches of this size.
+  private static final int PENDING_ITEMS_CAPACITY = 1024;
+
   private final VeloxBloomFilterJniWrapper jni =
       VeloxBloomFilterJniWrapper.create(
           Runtimes.contextInstance(BackendsApiManager.getBackendName(), "VeloxBloomFilter"));
   private final long handle;
+  private long[] pendingItems = null;
+  private int numPendingItems = 0;
 
   private VeloxBloomFilter(byte[] data) {
     handle = jni.init(data);
@@ -97,10 +104,32 @@ public class VeloxBloomFilter extends BloomFilter {
 
   @Override
   public boolean putLong(long item) {
-    jni.insertLong(handle, item);
+    if (pendingItems == null) {
+      pendingItems = new long[PENDING_ITEMS_CAPACITY];
+    }
+    pendingItems[numPendingItems++] = item;
+    if (numPendingItems == PENDING_ITEMS_CAPACITY) {
+      flushPendingItems();
+    }
     return true;
   }
 
+  /** Inserts the first numItems items with one JNI call. */
+  public void putLongs(long[] items, int numItems) {
+    jni.insertLongs(handle, items, numItems);
+  }
+
+  /**
+   * Inserts the non-null values of the BIGINT column at columnIndex of a native (offloaded)
+   * columnar batch with one JNI call.
+   */
+  public void putColumn(ColumnarBatch batch, int columnIndex) {
+    jni.insertColumn(
+        handle,
+        ColumnarBatches.getNativeHandle(BackendsApiManager.getBackendName(), batch),
+        columnIndex);
+  }
+
   @Override
   public boolean putBinary(byte[] item) {
     throw new UnsupportedOperationException("Not yet implemented");
@@ -118,6 +147,8 @@ public class VeloxBloomFilter extends BloomFilter {
           "Cannot merge Velox bloom-filter with non-Velox bloom-filter");
     }
     final VeloxBloomFilter from = (VeloxBloomFilter) other;
+    flushPendingItems();
+    from.flushPendingItems();
 
     if (!jni.isCompatibleWith(from.jni)) {
       throw new IncompatibleMergeException(
@@ -144,9 +175,28 @@ public class VeloxBloomFilter extends BloomFilter {
 
   @Override
   public boolean mightContainLong(long item) {
+    flushPendingItems();
     return jni.mightContainLong(handle, item);
   }
 
+  /** Probes the first numItems items with one JNI call. */
+  public boolean[] mightContainLongs(long[] items, int numItems) {
+    flushPendingItems();
+    return jni.mightContainLongs(handle, items, numItems);
+  }
+
+  /**
+   * Probes the BIGINT column at columnIndex of a native (offloaded) columnar batch with one JNI
+   * call. Null rows are reported as false.
+   */
+  public boolean[] mightContainColumn(ColumnarBatch batch, int columnIndex) {
+    flushPendingItems();
+    return jni.mightContainColumn(
+        handle,
+        ColumnarBatches.getNativeHandle(BackendsApiManager.getBackendName(), batch),
+        columnIndex);
+  }
+
   /**
    * GLUTEN-9849: We have to use this API for static may-contain evaluation over {@link
    * #mightContainLong} in Spark because if we are on Spark driver, there is no task context
@@ -183,7 +233,16 @@ public class VeloxBloomFilter extends BloomFilter {
 
   @Override
   public void writeTo(OutputStream out) throws IOException {
+    flushPendingItems();
     byte[] data = jni.serialize(handle);
     out.write(data);
   }
+
+  private void flushPendingItems() {
+    if (numPendingItems == 0) {
+      return;
+    }
+    jni.insertLongs(handle, pendingItems, numPendingItems);
+    numPendingItems = 0;
+  }
 }
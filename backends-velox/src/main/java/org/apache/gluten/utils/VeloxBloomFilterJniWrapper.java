@@ -43,6 +43,17 @@ public class VeloxBloomFilterJniWrapper implements RuntimeAware {
 
   public native boolean mightContainLong(long handle, long item);
 
+  /** Inserts the first numItems items in one call. */
+  public native void insertLongs(long handle, long[] items, int numItems);
+
+  /** Inserts the non-null values of a BIGINT column of a native columnar batch. */
+  public native void insertColumn(long handle, long batchHandle, int columnIndex);
+
+  public native boolean[] mightContainLongs(long handle, long[] items, int numItems);
+
+  /** Probes a BIGINT column of a native columnar batch. Null rows are reported as false. */
+  public native boolean[] mightContainColumn(long handle, long batchHandle, int columnIndex);
+
   public static native boolean mightContainLongOnSerializedBloom(long address, long item);
 
   public native void mergeFrom(long handle, long other);
@@ -96,6 +96,9 @@ class VeloxMetricsApi extends MetricsApi with Logging {
       "skippedSplits" -> SQLMetrics.createMetric(sparkContext, "number of skipped splits"),
       "processedSplits" -> SQLMetrics.createMetric(sparkContext, "number of processed splits"),
       "preloadSplits" -> SQLMetrics.createMetric(sparkContext, "number of preloaded splits"),
+      "footerCacheHits" -> SQLMetrics.createMetric(sparkContext, "number of footer cache hits"),
+      "footerCacheMisses" -> SQLMetrics.createMetric(sparkContext, "number of footer cache misses"),
+      "splitPreloadDepth" -> SQLMetrics.createAverageMetric(sparkContext, "split preload depth"),
       "skippedStrides" -> SQLMetrics.createMetric(sparkContext, "number of skipped row groups"),
       "processedStrides" -> SQLMetrics.createMetric(sparkContext, "number of processed row groups"),
       "remainingFilterTime" -> SQLMetrics.createNanoTimingMetric(
@@ -137,6 +140,9 @@ class VeloxMetricsApi extends MetricsApi with Logging {
       "skippedSplits" -> SQLMetrics.createMetric(sparkContext, "number of skipped splits"),
       "processedSplits" -> SQLMetrics.createMetric(sparkContext, "number of processed splits"),
       "preloadSplits" -> SQLMetrics.createMetric(sparkContext, "number of preloaded splits"),
+      "footerCacheHits" -> SQLMetrics.createMetric(sparkContext, "number of footer cache hits"),
+      "footerCacheMisses" -> SQLMetrics.createMetric(sparkContext, "number of footer cache misses"),
+      "splitPreloadDepth" -> SQLMetrics.createAverageMetric(sparkContext, "split preload depth"),
       "skippedStrides" -> SQLMetrics.createMetric(sparkContext, "number of skipped row groups"),
       "processedStrides" -> SQLMetrics.createMetric(sparkContext, "number of processed row groups"),
       "remainingFilterTime" -> SQLMetrics.createNanoTimingMetric(
@@ -178,6 +184,9 @@ class VeloxMetricsApi extends MetricsApi with Logging {
       "skippedSplits" -> SQLMetrics.createMetric(sparkContext, "number of skipped splits"),
       "processedSplits" -> SQLMetrics.createMetric(sparkContext, "number of processed splits"),
       "preloadSplits" -> SQLMetrics.createMetric(sparkContext, "number of preloaded splits"),
+      "footerCacheHits" -> SQLMetrics.createMetric(sparkContext, "number of footer cache hits"),
+      "footerCacheMisses" -> SQLMetrics.createMetric(sparkContext, "number of footer cache misses"),
+      "splitPreloadDepth" -> SQLMetrics.createAverageMetric(sparkContext, "split preload depth"),
       "skippedStrides" -> SQLMetrics.createMetric(sparkContext, "number of skipped row groups"),
       "processedStrides" -> SQLMetrics.createMetric(sparkContext, "number of processed row groups"),
       "remainingFilterTime" -> SQLMetrics.createNanoTimingMetric(
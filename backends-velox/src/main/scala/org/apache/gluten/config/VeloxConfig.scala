@@ -167,6 +167,18 @@ object VeloxConfig {
       .booleanConf
       .createWithDefault(false)
 
+  val COLUMNAR_VELOX_SSD_CACHE_PERSISTENT =
+    buildStaticConf("spark.gluten.sql.columnar.backend.velox.ssdCachePersistent")
+      .internal()
+      .doc(
+        "Keep the SSD cache files across executor restarts and restore the cache from its " +
+          "checkpoint on startup. Cached entries of files modified since are evicted before " +
+          "they are read. Enables checkpointing with ssdCacheSize / 16 as interval if " +
+          "ssdCheckpointIntervalBytes is 0. Files without a known modification time are not " +
+          "cached.")
+      .booleanConf
+      .createWithDefault(false)
+
   val COLUMNAR_VELOX_SSD_CHCEKPOINT_DISABLE_FILE_COW =
     buildStaticConf("spark.gluten.sql.columnar.backend.velox.ssdDisableFileCow")
       .internal()
@@ -206,6 +218,16 @@ object VeloxConfig {
       .intConf
       .createOptional
 
+  val COLUMNAR_VELOX_JNI_FILE_SYSTEM_READ_THREADS =
+    buildStaticConf("spark.gluten.sql.columnar.backend.velox.jniFileSystemReadThreads")
+      .internal()
+      .doc(
+        "The size of the thread pool that completes the asynchronous vectored reads of the " +
+          "JVM-backed file system. 0 means these reads are done on the calling thread.")
+      .intConf
+      .checkValue(_ >= 0, "must not be negative")
+      .createWithDefault(0)
+
   val COLUMNAR_VELOX_ASYNC_TIMEOUT =
     buildStaticConf("spark.gluten.sql.columnar.backend.velox.asyncTimeoutOnTaskStopping")
       .internal()
@@ -223,6 +245,26 @@ object VeloxConfig {
       .intConf
       .createWithDefault(2)
 
+  val COLUMNAR_VELOX_SPLIT_PRELOAD_MEMORY_BYTES =
+    buildConf("spark.gluten.sql.columnar.backend.velox.splitPreloadMemoryBytes")
+      .internal()
+      .doc(
+        "Memory budget of split preloading per task. If positive, the number of splits opened " +
+          "ahead of the one being read, with their footers and first row groups fetched on the " +
+          "IO threads, is derived from this budget and the average split size (capped by " +
+          "loadQuantum), up to splitPreloadMaxDepth. SplitPreloadPerDriver is ignored then. " +
+          "Helps tasks reading many small files.")
+      .bytesConf(ByteUnit.BYTE)
+      .createWithDefaultString("0")
+
+  val COLUMNAR_VELOX_SPLIT_PRELOAD_MAX_DEPTH =
+    buildConf("spark.gluten.sql.columnar.backend.velox.splitPreloadMaxDepth")
+      .internal()
+      .doc("Upper bound of the splits preloaded per task when splitPreloadMemoryBytes is set.")
+      .intConf
+      .checkValue(_ > 0, "must be a positive number")
+      .createWithDefault(16)
+
   val COLUMNAR_VELOX_GLOG_VERBOSE_LEVEL =
     buildConf("spark.gluten.sql.columnar.backend.velox.glogVerboseLevel")
       .internal()
@@ -476,6 +518,37 @@ object VeloxConfig {
       .booleanConf
       .createWithDefault(false)
 
+  val COLUMNAR_VELOX_FILE_HANDLE_CACHE_SIZE =
+    buildStaticConf("spark.gluten.sql.columnar.backend.velox.fileHandleCacheSize")
+      .internal()
+      .doc(
+        "Max number of opened files kept by the file handle cache of an executor, when " +
+          "fileHandleCacheEnabled is true. Set it above the number of files repeatedly read " +
+          "by the tasks, e.g. the files of dimension tables.")
+      .intConf
+      .checkValue(_ > 0, "must be a positive number")
+      .createWithDefault(20000)
+
+  val COLUMNAR_VELOX_FOOTER_CACHE_SIZE =
+    buildStaticConf("spark.gluten.sql.columnar.backend.velox.footerCacheSize")
+      .internal()
+      .doc(
+        "Capacity of the executor-wide cache of the last bytes of the scanned files, which " +
+          "hold the Parquet and ORC footers, so that tasks reading the same files don't fetch " +
+          "their footers from the storage again. Only files with a known modification time are " +
+          "cached. 0 disables the cache.")
+      .bytesConf(ByteUnit.BYTE)
+      .createWithDefaultString("0")
+
+  val COLUMNAR_VELOX_FOOTER_CACHE_TAIL_SIZE =
+    buildStaticConf("spark.gluten.sql.columnar.backend.velox.footerCacheTailSize")
+      .internal()
+      .doc(
+        "Reads within this many bytes from the end of a file go through the footer cache. It " +
+          "should be at least directorySizeGuess, and above the footer size of the files.")
+      .bytesConf(ByteUnit.BYTE)
+      .createWithDefaultString("1MB")
+
   val DIRECTORY_SIZE_GUESS =
     buildStaticConf("spark.gluten.sql.columnar.backend.velox.directorySizeGuess")
       .internal()
@@ -526,6 +599,28 @@ object VeloxConfig {
       .intConf
       .createWithDefault(0)
 
+  val COLUMNAR_BATCH_SERDE_FORMAT =
+    buildConf("spark.gluten.sql.columnar.backend.velox.columnarBatchSerde.format")
+      .internal()
+      .doc(
+        "Format used to serialize columnar batches, e.g. for broadcast. presto: Presto pages; " +
+          "columnar: Velox vectors as aligned, optionally compressed buffers, which keeps " +
+          "constant and dictionary encodings and deserializes without per-row decoding.")
+      .stringConf
+      .transform(_.toLowerCase(Locale.ROOT))
+      .checkValues(Set("presto", "columnar"))
+      .createWithDefault("presto")
+
+  val COLUMNAR_BATCH_SERDE_CODEC =
+    buildConf("spark.gluten.sql.columnar.backend.velox.columnarBatchSerde.codec")
+      .internal()
+      .doc(
+        "Compression codec of the columnar batch serde format 'columnar', e.g. lz4 or zstd. " +
+          "none: no compression.")
+      .stringConf
+      .transform(_.toLowerCase(Locale.ROOT))
+      .createWithDefault("lz4")
+
   val AWS_SDK_LOG_LEVEL =
     buildConf("spark.gluten.velox.awsSdkLogLevel")
       .internal()
@@ -51,7 +51,8 @@ case class VeloxResizeBatchesExec(
     "numInputBatches" -> SQLMetrics.createMetric(sparkContext, "number of input batches"),
     "numOutputRows" -> SQLMetrics.createMetric(sparkContext, "number of output rows"),
     "numOutputBatches" -> SQLMetrics.createMetric(sparkContext, "number of output batches"),
-    "selfTime" -> SQLMetrics.createTimingMetric(sparkContext, "time to append / split batches")
+    "selfTime" -> SQLMetrics.createTimingMetric(sparkContext, "time to append / split batches"),
+    "peakRetainedBytes" -> SQLMetrics.createSizeMetric(sparkContext, "peak retained input bytes")
   )
 
   override def batchType(): Convention.BatchType = BackendsApiManager.getSettings.primaryBatchType
@@ -66,6 +67,7 @@ case class VeloxResizeBatchesExec(
     val numOutputRows = longMetric("numOutputRows")
     val numOutputBatches = longMetric("numOutputBatches")
     val selfTime = longMetric("selfTime")
+    val peakRetainedBytes = longMetric("peakRetainedBytes")
 
     child.executeColumnar().mapPartitions {
       in =>
@@ -93,6 +95,7 @@ case class VeloxResizeBatchesExec(
           .collectReadMillis(outMillis => appendMillis.getAndAdd(outMillis))
           .recyclePayload(_.close())
           .recycleIterator {
+            peakRetainedBytes += VeloxBatchResizer.peakRetainedBytes(appender)
             appender.close()
             selfTime += appendMillis.get()
           }
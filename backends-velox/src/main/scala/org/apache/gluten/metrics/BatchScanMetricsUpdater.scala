@@ -54,6 +54,9 @@ class BatchScanMetricsUpdater(val metrics: Map[String, SQLMetric]) extends Metri
       metrics("localReadBytes") += operatorMetrics.localReadBytes
       metrics("ramReadBytes") += operatorMetrics.ramReadBytes
       metrics("preloadSplits") += operatorMetrics.preloadSplits
+      metrics("footerCacheHits") += operatorMetrics.footerCacheHits
+      metrics("footerCacheMisses") += operatorMetrics.footerCacheMisses
+      metrics("splitPreloadDepth") += operatorMetrics.splitPreloadDepth
     }
   }
 }
@@ -42,6 +42,9 @@ class FileSourceScanMetricsUpdater(@transient val metrics: Map[String, SQLMetric
   val skippedSplits: SQLMetric = metrics("skippedSplits")
   val processedSplits: SQLMetric = metrics("processedSplits")
   val preloadSplits: SQLMetric = metrics("preloadSplits")
+  val footerCacheHits: SQLMetric = metrics("footerCacheHits")
+  val footerCacheMisses: SQLMetric = metrics("footerCacheMisses")
+  val splitPreloadDepth: SQLMetric = metrics("splitPreloadDepth")
   val skippedStrides: SQLMetric = metrics("skippedStrides")
   val processedStrides: SQLMetric = metrics("processedStrides")
   val remainingFilterTime: SQLMetric = metrics("remainingFilterTime")
@@ -80,6 +83,9 @@ class FileSourceScanMetricsUpdater(@transient val metrics: Map[String, SQLMetric
       localReadBytes += operatorMetrics.localReadBytes
       ramReadBytes += operatorMetrics.ramReadBytes
       preloadSplits += operatorMetrics.preloadSplits
+      footerCacheHits += operatorMetrics.footerCacheHits
+      footerCacheMisses += operatorMetrics.footerCacheMisses
+      splitPreloadDepth += operatorMetrics.splitPreloadDepth
     }
   }
 }
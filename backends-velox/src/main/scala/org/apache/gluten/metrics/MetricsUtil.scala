@@ -133,6 +133,9 @@ object MetricsUtil extends Logging {
     var localReadBytes: Long = 0
     var ramReadBytes: Long = 0
     var preloadSplits: Long = 0
+    var footerCacheHits: Long = 0
+    var footerCacheMisses: Long = 0
+    var splitPreloadDepth: Long = 0
     var numWrittenFiles: Long = 0
 
     val metricsIterator = operatorMetrics.iterator()
@@ -163,6 +166,9 @@ object MetricsUtil extends Logging {
       localReadBytes += metrics.localReadBytes
       ramReadBytes += metrics.ramReadBytes
       preloadSplits += metrics.preloadSplits
+      footerCacheHits += metrics.footerCacheHits
+      footerCacheMisses += metrics.footerCacheMisses
+      splitPreloadDepth += metrics.splitPreloadDepth
       numWrittenFiles += metrics.numWrittenFiles
     }
 
@@ -200,6 +206,9 @@ object MetricsUtil extends Logging {
       localReadBytes,
       ramReadBytes,
       preloadSplits,
+      footerCacheHits,
+      footerCacheMisses,
+      splitPreloadDepth,
       physicalWrittenBytes,
       writeIOTime,
       numWrittenFiles
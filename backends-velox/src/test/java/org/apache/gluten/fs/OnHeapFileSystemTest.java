@@ -55,4 +55,39 @@ public class OnHeapFileSystemTest {
 
     Assert.assertEquals(text, decoded);
   }
+
+  @Test
+  public void testPreadv() {
+    final String path = "/bar";
+    final byte[] bytes = "HELLO WORLD".getBytes(StandardCharsets.UTF_8);
+    JniFilesystem.WriteFile writeFile = fs.openFileForWrite(path);
+    try {
+      ByteBuffer buf = PlatformDependent.allocateDirectNoCleaner(bytes.length);
+      buf.put(bytes);
+      writeFile.append(bytes.length, PlatformDependent.directBufferAddress(buf));
+    } finally {
+      writeFile.close();
+    }
+
+    JniFilesystem.ReadFile readFile = fs.openFileForRead(path);
+    ByteBuffer first = PlatformDependent.allocateDirectNoCleaner(2);
+    ByteBuffer second = PlatformDependent.allocateDirectNoCleaner(5);
+    try {
+      readFile.preadv(
+          new long[] {0, 6},
+          new long[] {2, 5},
+          new long[] {
+            PlatformDependent.directBufferAddress(first),
+            PlatformDependent.directBufferAddress(second)
+          });
+    } finally {
+      readFile.close();
+    }
+    byte[] out = new byte[2];
+    first.get(out);
+    Assert.assertEquals("HE", new String(out, StandardCharsets.UTF_8));
+    out = new byte[5];
+    second.get(out);
+    Assert.assertEquals("WORLD", new String(out, StandardCharsets.UTF_8));
+  }
 }
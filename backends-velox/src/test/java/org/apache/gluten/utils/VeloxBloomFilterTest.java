@@ -16,8 +16,13 @@
  */
 package org.apache.gluten.utils;
 
+import org.apache.gluten.columnarbatch.ColumnarBatches;
+import org.apache.gluten.memory.arrow.alloc.ArrowBufferAllocators;
 import org.apache.gluten.test.VeloxBackendTestBase;
+import org.apache.gluten.vectorized.ArrowWritableColumnVector;
 
+import org.apache.spark.sql.types.StructType;
+import org.apache.spark.sql.vectorized.ColumnarBatch;
 import org.apache.spark.task.TaskResources$;
 import org.apache.spark.util.sketch.BloomFilter;
 import org.apache.spark.util.sketch.IncompatibleMergeException;
@@ -187,6 +192,85 @@ public class VeloxBloomFilterTest extends VeloxBackendTestBase {
         });
   }
 
+  @Test
+  public void testBulk() {
+    TaskResources$.MODULE$.runUnsafe(
+        () -> {
+          final int numItems = 3000;
+          final long[] items = new long[numItems + 1];
+          for (int i = 0; i < numItems; i++) {
+            items[i] = i * 7L - 5000L;
+          }
+          final VeloxBloomFilter bulk = VeloxBloomFilter.empty(10000);
+          bulk.putLongs(items, numItems);
+          final VeloxBloomFilter single = VeloxBloomFilter.empty(10000);
+          for (int i = 0; i < numItems; i++) {
+            single.putLong(items[i]);
+          }
+          Assert.assertArrayEquals(single.serialize(), bulk.serialize());
+
+          final boolean[] outcomes = bulk.mightContainLongs(items, numItems);
+          Assert.assertEquals(numItems, outcomes.length);
+          for (int i = 0; i < numItems; i++) {
+            Assert.assertTrue(outcomes[i]);
+          }
+
+          final long[] probes = new long[numItems];
+          for (int i = 0; i < numItems; i++) {
+            probes[i] = 100000L + i;
+          }
+          final boolean[] probeOutcomes = bulk.mightContainLongs(probes, numItems);
+          for (int i = 0; i < numItems; i++) {
+            Assert.assertEquals(bulk.mightContainLong(probes[i]), probeOutcomes[i]);
+          }
+          return null;
+        });
+  }
+
+  @Test
+  public void testColumn() {
+    TaskResources$.MODULE$.runUnsafe(
+        () -> {
+          final int numRows = 3000;
+          final ArrowWritableColumnVector[] columns =
+              ArrowWritableColumnVector.allocateColumns(numRows, StructType.fromDDL("a bigint"));
+          final long[] nonNullItems = new long[numRows];
+          int numNonNullItems = 0;
+          for (int i = 0; i < numRows; i++) {
+            if (i % 3 == 0) {
+              columns[0].putNull(i);
+            } else {
+              columns[0].putLong(i, i * 7L - 5000L);
+              nonNullItems[numNonNullItems++] = i * 7L - 5000L;
+            }
+          }
+          columns[0].setValueCount(numRows);
+          final ColumnarBatch batch = new ColumnarBatch(columns);
+          batch.setNumRows(numRows);
+          final ColumnarBatch offloaded =
+              ColumnarBatches.offload(ArrowBufferAllocators.contextInstance(), batch);
+
+          // Null rows are skipped on insert.
+          final VeloxBloomFilter column = VeloxBloomFilter.empty(10000);
+          column.putColumn(offloaded, 0);
+          final VeloxBloomFilter bulk = VeloxBloomFilter.empty(10000);
+          bulk.putLongs(nonNullItems, numNonNullItems);
+          Assert.assertArrayEquals(bulk.serialize(), column.serialize());
+
+          // And reported as false on probe, even though 0 was inserted.
+          column.putLong(0L);
+          final boolean[] outcomes = column.mightContainColumn(offloaded, 0);
+          Assert.assertEquals(numRows, outcomes.length);
+          for (int i = 0; i < numRows; i++) {
+            Assert.assertEquals(i % 3 != 0, outcomes[i]);
+          }
+
+          Assert.assertThrows(RuntimeException.class, () -> column.putColumn(offloaded, 1));
+          offloaded.close();
+          return null;
+        });
+  }
+
   private static void checkFalsePositives(BloomFilter filter, int start) {
     final int attemptStart = start;
     final int attemptCount = 5000000;
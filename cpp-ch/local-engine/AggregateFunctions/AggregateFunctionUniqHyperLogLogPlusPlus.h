@@ -27,6 +27,10 @@
 #include <Common/FieldVisitors.h>
 #include <Common/HashTable/Hash.h>
 #include <Common/HyperLogLogWithSmallSetOptimization.h>
+#include <Common/PODArray.h>
+#include <IO/ReadHelpers.h>
+#include <IO/VarInt.h>
+#include <IO/WriteHelpers.h>
 #include <Parsers/NullsAction.h>
 namespace DB
 {
@@ -50,6 +54,11 @@ extern const int INCORRECT_DATA;
  * The accuracy is controlled by the relative standard deviation (relative_sd) parameter.
  *
  * The algorithm also includes bias correction and linear counting for improved accuracy.
+ *
+ * A state starts sparse: only the non-zero registers are kept, as a sorted list of (index, value). It switches to the
+ * dense register words once the list would take more memory than them. With many groups of low cardinality most
+ * states never become dense. Both representations give exactly the same registers, so results stay identical to
+ * Spark's HyperLogLogPlusPlus.
  */
 struct HyperLogLogPlusPlusData
 {
@@ -74,14 +83,28 @@ struct HyperLogLogPlusPlusData
                 "HLL++ requires at most 25 bits for addressing instead of {} to avoid allocating too much memory",
                 p);
 
-        registers = PaddedPODArray<UInt64>(num_words, 0); // Initialize registers with zeros
     }
 
+    bool isSparse() const { return registers.empty(); }
+
+    /// A sparse state is written with 0 words, followed by the delta encoded sorted entries.
     void serialize(WriteBuffer & buf) const
     {
         writeBinaryLittleEndian(relative_sd, buf);
 
         writeBinaryLittleEndian(registers.size(), buf);
+        if (isSparse())
+        {
+            writeVarUInt(sparse.size(), buf);
+            UInt32 prev = 0;
+            for (const auto entry : sparse)
+            {
+                writeVarUInt(entry - prev, buf);
+                prev = entry;
+            }
+            return;
+        }
+
         for (const auto & word : registers)
             writeBinaryLittleEndian(word, buf);
     }
@@ -96,10 +119,37 @@ struct HyperLogLogPlusPlusData
 
         size_t registers_size = 0;
         readBinaryLittleEndian(registers_size, buf);
-        if (registers_size != registers.size())
+        if (registers_size == 0)
+        {
+            size_t sparse_size = 0;
+            readVarUInt(sparse_size, buf);
+            if (sparse_size > maxSparseSize())
+                throw Exception(
+                    ErrorCodes::INCORRECT_DATA, "The number of sparse registers {} is more than the limit {}", sparse_size, maxSparseSize());
+
+            PaddedPODArray<UInt64>().swap(registers);
+            sparse.resize(sparse_size);
+            UInt32 entry = 0;
+            for (size_t i = 0; i < sparse_size; ++i)
+            {
+                UInt64 delta = 0;
+                readVarUInt(delta, buf);
+                /// The entries must be sorted by distinct register indexes, otherwise updateDense writes out of bounds
+                const UInt64 idx = (entry + delta) >> REGISTER_SIZE;
+                if (delta > std::numeric_limits<UInt32>::max() - entry || idx >= m || (i > 0 && idx <= (entry >> REGISTER_SIZE)))
+                    throw Exception(ErrorCodes::INCORRECT_DATA, "Invalid sparse register entry at {}, delta {} after {}", i, delta, entry);
+                entry += static_cast<UInt32>(delta);
+                sparse[i] = entry;
+            }
+            return;
+        }
+
+        if (registers_size != num_words)
             throw Exception(
-                ErrorCodes::INCORRECT_DATA, "The number of registers {} isn't the expected one {}", registers_size, registers.size());
+                ErrorCodes::INCORRECT_DATA, "The number of registers {} isn't the expected one {}", registers_size, num_words);
 
+        SparseEntries().swap(sparse);
+        registers.resize(num_words);
         for (size_t i = 0; i < registers_size; ++i)
             readBinaryLittleEndian(registers[i], buf);
     }
@@ -111,33 +161,66 @@ struct HyperLogLogPlusPlusData
         UInt64 w = (x << p) | w_padding;
         UInt64 pw = __builtin_clzll(w) + 1;
 
-        UInt64 word_offset = idx / REGISTERS_PER_WORD;
-        UInt64 word = registers[word_offset];
+        if (isSparse())
+            updateSparse(idx, pw);
+        else
+            updateDense(idx, pw);
+    }
 
-        UInt64 shift = (idx - word_offset * REGISTERS_PER_WORD) * REGISTER_SIZE;
-        UInt64 mask = REGISTER_WORD_MASK << shift;
-        UInt64 midx = (word & mask) >> shift;
-        if (pw > midx)
+    void addBatch(const UInt64 * values, size_t size)
+    {
+        /// The batch would most likely fill the sparse list anyway
+        if (isSparse() && size >= maxSparseSize())
+            toDense();
+
+        if (isSparse())
         {
-            registers[word_offset] = (word & ~mask) | (pw << shift);
+            for (size_t i = 0; i < size; ++i)
+                add(values[i]);
+            return;
+        }
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            const UInt64 x = values[i];
+            updateDense(x >> idx_shift, __builtin_clzll((x << p) | w_padding) + 1);
         }
     }
 
     void merge(const HyperLogLogPlusPlusData & other)
     {
-        size_t i = 0; // global register index
-        for (size_t word_i = 0; word_i < num_words; ++word_i)
+        if (other.isSparse())
         {
-            UInt64 word1 = registers[word_i];
-            UInt64 word2 = other.registers[word_i];
-            UInt64 mask = REGISTER_WORD_MASK;
-            UInt64 merged_word = 0;
-            for (size_t register_i = 0; i < m && register_i < REGISTERS_PER_WORD; ++register_i, ++i)
+            if (isSparse())
             {
-                merged_word |= std::max((word1 & mask), (word2 & mask));
-                mask <<= REGISTER_SIZE;
+                mergeSparse(other.sparse);
             }
-            registers[word_i] = merged_word;
+            else
+            {
+                for (const auto entry : other.sparse)
+                    updateDense(entry >> REGISTER_SIZE, entry & REGISTER_WORD_MASK);
+            }
+            return;
+        }
+
+        if (isSparse())
+            toDense();
+
+        /// Register-wise max of 10 packed registers per word without unpacking them. The loop has no branches, so it
+        /// is vectorized (AVX2 handles 4 words at once).
+        UInt64 * __restrict words = registers.data();
+        const UInt64 * __restrict other_words = other.registers.data();
+        for (size_t word_i = 0; word_i < num_words; ++word_i)
+        {
+            const UInt64 a = words[word_i];
+            const UInt64 b = other_words[word_i];
+            /// High bit of each register: whether the low 5 bits of a are >= the low 5 bits of b
+            const UInt64 low_ge = (a | REGISTER_HIGH_BITS) - (b & ~REGISTER_HIGH_BITS);
+            /// High bit of each register: whether a >= b
+            const UInt64 ge = ((a & ~b) | (~(a ^ b) & low_ge)) & REGISTER_HIGH_BITS;
+            /// All bits of the registers where a >= b
+            const UInt64 mask = (ge << 1) - (ge >> (REGISTER_SIZE - 1));
+            words[word_i] = (a & mask) | (b & ~mask);
         }
     }
 
@@ -146,17 +229,34 @@ struct HyperLogLogPlusPlusData
         Float64 z_inverse = 0.0;
         UInt64 v = 0;
 
-        size_t i = 0; // global register index
-        for (size_t word_i = 0; word_i < num_words; ++word_i)
+        /// Registers are summed in index order in both representations, the result must not depend on it
+        auto add_register = [&](UInt64 midx)
         {
-            UInt64 word = registers[word_i];
-            for (size_t register_i = 0; i < m && register_i < REGISTERS_PER_WORD; ++register_i, ++i)
-            {
-                UInt64 midx = (word >> (register_i * REGISTER_SIZE)) & REGISTER_WORD_MASK;
-                z_inverse += 1.0 / (1ULL << midx);
+            z_inverse += 1.0 / (1ULL << midx);
 
-                if (midx == 0)
-                    ++v;
+            if (midx == 0)
+                ++v;
+        };
+
+        if (isSparse())
+        {
+            size_t next = 0;
+            for (UInt64 i = 0; i < m; ++i)
+            {
+                UInt64 midx = 0;
+                if (next < sparse.size() && (sparse[next] >> REGISTER_SIZE) == i)
+                    midx = sparse[next++] & REGISTER_WORD_MASK;
+                add_register(midx);
+            }
+        }
+        else
+        {
+            size_t i = 0; // global register index
+            for (size_t word_i = 0; word_i < num_words; ++word_i)
+            {
+                UInt64 word = registers[word_i];
+                for (size_t register_i = 0; i < m && register_i < REGISTERS_PER_WORD; ++register_i, ++i)
+                    add_register((word >> (register_i * REGISTER_SIZE)) & REGISTER_WORD_MASK);
             }
         }
 
@@ -181,6 +281,77 @@ struct HyperLogLogPlusPlusData
     }
 
 private:
+    /// Sorted by register index, (index << REGISTER_SIZE) | value. p <= 25, so it fits in 31 bits.
+    using SparseEntries = PODArray<UInt32, 64>;
+
+    /// Switch to dense registers when the sparse entries would take more memory
+    size_t maxSparseSize() const { return num_words * sizeof(UInt64) / sizeof(UInt32); }
+
+    void updateDense(UInt64 idx, UInt64 pw)
+    {
+        UInt64 word_offset = idx / REGISTERS_PER_WORD;
+        UInt64 word = registers[word_offset];
+
+        UInt64 shift = (idx - word_offset * REGISTERS_PER_WORD) * REGISTER_SIZE;
+        UInt64 mask = REGISTER_WORD_MASK << shift;
+        UInt64 midx = (word & mask) >> shift;
+        if (pw > midx)
+        {
+            registers[word_offset] = (word & ~mask) | (pw << shift);
+        }
+    }
+
+    void updateSparse(UInt64 idx, UInt64 pw)
+    {
+        const auto entry = static_cast<UInt32>((idx << REGISTER_SIZE) | pw);
+        auto * it = std::lower_bound(sparse.begin(), sparse.end(), static_cast<UInt32>(idx << REGISTER_SIZE));
+        if (it != sparse.end() && (*it >> REGISTER_SIZE) == idx)
+        {
+            /// Same index, the larger entry has the larger value
+            *it = std::max(*it, entry);
+            return;
+        }
+
+        const size_t pos = it - sparse.begin();
+        sparse.push_back(entry);
+        std::rotate(sparse.begin() + pos, sparse.end() - 1, sparse.end());
+        if (sparse.size() > maxSparseSize())
+            toDense();
+    }
+
+    void mergeSparse(const SparseEntries & other)
+    {
+        SparseEntries merged;
+        merged.reserve(sparse.size() + other.size());
+        size_t i = 0;
+        size_t j = 0;
+        while (i < sparse.size() && j < other.size())
+        {
+            const UInt32 lhs_idx = sparse[i] >> REGISTER_SIZE;
+            const UInt32 rhs_idx = other[j] >> REGISTER_SIZE;
+            if (lhs_idx < rhs_idx)
+                merged.push_back(sparse[i++]);
+            else if (rhs_idx < lhs_idx)
+                merged.push_back(other[j++]);
+            else
+                merged.push_back(std::max(sparse[i++], other[j++]));
+        }
+        merged.insert(sparse.begin() + i, sparse.end());
+        merged.insert(other.begin() + j, other.end());
+        sparse.swap(merged);
+
+        if (sparse.size() > maxSparseSize())
+            toDense();
+    }
+
+    void toDense()
+    {
+        registers.resize_fill(num_words, 0);
+        for (const auto entry : sparse)
+            updateDense(entry >> REGISTER_SIZE, entry & REGISTER_WORD_MASK);
+        SparseEntries().swap(sparse);
+    }
+
     Float64 computeAlphaMM() const
     {
         // Compute alpha * m * m based on the value of m
@@ -274,6 +445,15 @@ private:
 
     static constexpr UInt64 REGISTERS_PER_WORD = WORD_SIZE / REGISTER_SIZE;
 
+    /// The highest bit of every register in a word
+    static constexpr UInt64 REGISTER_HIGH_BITS = []
+    {
+        UInt64 bits = 0;
+        for (UInt64 i = 0; i < REGISTERS_PER_WORD; ++i)
+            bits |= 1ULL << (i * REGISTER_SIZE + REGISTER_SIZE - 1);
+        return bits;
+    }();
+
     /// Number of points used for interpolating the bias value.
     static constexpr UInt64 K = 6;
 
@@ -3001,7 +3181,9 @@ private:
           1238126.379, 1244673.795, 1251260.649, 1257697.86,  1264320.983, 1270736.319, 1277274.694, 1283804.95,  1290211.514,
           1296858.568, 1303455.691}}};
 
-    PaddedPODArray<UInt64> registers; // Declaration of registers
+    /// Dense registers, empty while the state is sparse
+    PaddedPODArray<UInt64> registers;
+    SparseEntries sparse;
 };
 
 class AggregateFunctionUniqHyperLogLogPlusPlus final
@@ -3056,6 +3238,24 @@ public:
         data(place).add(value);
     }
 
+    void addBatchSinglePlace(
+        size_t row_begin,
+        size_t row_end,
+        AggregateDataPtr __restrict place,
+        const IColumn ** columns,
+        Arena * arena,
+        ssize_t if_argument_pos) const override
+    {
+        if (if_argument_pos >= 0)
+        {
+            IAggregateFunctionDataHelper::addBatchSinglePlace(row_begin, row_end, place, columns, arena, if_argument_pos);
+            return;
+        }
+
+        const auto & values = static_cast<const ColumnUInt64 &>(*columns[0]).getData();
+        data(place).addBatch(values.data() + row_begin, row_end - row_begin);
+    }
+
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs, Arena *) const override { data(place).merge(data(rhs)); }
 
     void serialize(ConstAggregateDataPtr place, WriteBuffer & buf, std::optional<size_t>) const override { data(place).serialize(buf); }
@@ -59,6 +59,7 @@
 #include <Storages/Cache/CacheManager.h>
 #include <Storages/MergeTree/StorageMergeTreeFactory.h>
 #include <Storages/Output/WriteBufferBuilder.h>
+#include <Storages/Parquet/ParquetFooterCache.h>
 #include <Storages/SubstraitSource/ReadBufferBuilder.h>
 #include <arrow/util/compression.h>
 #include <boost/algorithm/string/case_conv.hpp>
@@ -956,6 +957,10 @@ void BackendInitializerUtil::initBackend(const SparkConfigs::ConfigMap & spark_c
     // Init the table metadata cache map
     StorageMergeTreeFactory::init_cache_map();
 
+    // Init the parsed parquet footer cache
+    ParquetFooterCache::instance().initialize(
+        ParquetFooterCacheConfig::loadFromContext(QueryContext::globalContext()).parquet_footer_cache_max_size);
+
     JobScheduler::initialize(QueryContext::globalContext());
     CacheManager::initialize(QueryContext::globalMutableContext());
 
@@ -1000,6 +1005,7 @@ void BackendFinalizerUtil::finalizeGlobally()
     // Make sure client caches release before ClientCacheRegistry
     ReadBufferBuilderFactory::instance().clean();
     StorageMergeTreeFactory::clear_cache_map();
+    ParquetFooterCache::instance().clear();
     QueryContext::resetGlobal();
     std::lock_guard lock(paths_mutex);
     std::ranges::for_each(
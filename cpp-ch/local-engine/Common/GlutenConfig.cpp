@@ -74,6 +74,7 @@ GraceMergingAggregateConfig GraceMergingAggregateConfig::loadFromContext(const D
     config.max_allowed_memory_usage_ratio_for_aggregate_merging
         = context->getConfigRef().getDouble(MAX_ALLOWED_MEMORY_USAGE_RATIO_FOR_AGGREGATE_MERGING, 0.9);
     config.enable_spill_test = context->getConfigRef().getBool(ENABLE_SPILL_TEST, false);
+    config.grace_aggregate_merging_parallelism = context->getConfigRef().getUInt64(GRACE_AGGREGATE_MERGING_PARALLELISM, 0);
     return config;
 }
 
@@ -96,6 +97,10 @@ JoinConfig JoinConfig::loadFromContext(const DB::ContextPtr & context)
     config.prefer_multi_join_on_clauses = context->getConfigRef().getBool(PREFER_MULTI_JOIN_ON_CLAUSES, true);
     config.multi_join_on_clauses_build_side_rows_limit
         = context->getConfigRef().getUInt64(MULTI_JOIN_ON_CLAUSES_BUILD_SIDE_ROWS_LIMIT, 10000000);
+    config.runtime_filter_enabled = context->getConfigRef().getBool(RUNTIME_FILTER_ENABLED, false);
+    config.runtime_filter_bloom_filter_max_bytes = context->getConfigRef().getUInt64(RUNTIME_FILTER_BLOOM_FILTER_MAX_BYTES, 1048576);
+    config.broadcast_parallel_build_min_rows = context->getConfigRef().getUInt64(BROADCAST_PARALLEL_BUILD_MIN_ROWS, 0);
+    config.broadcast_build_threads = context->getConfigRef().getUInt64(BROADCAST_BUILD_THREADS, 8);
     return config;
 }
 
@@ -130,6 +135,13 @@ MergeTreeConfig MergeTreeConfig::loadFromContext(const DB::ContextPtr & context)
     config.table_metadata_cache_max_count = context->getConfigRef().getUInt64(TABLE_METADATA_CACHE_MAX_COUNT, 500);
     return config;
 }
+ParquetFooterCacheConfig ParquetFooterCacheConfig::loadFromContext(const DB::ContextPtr & context)
+{
+    ParquetFooterCacheConfig config;
+    config.parquet_footer_cache_max_size
+        = context->getConfigRef().getUInt64(PARQUET_FOOTER_CACHE_MAX_SIZE, config.parquet_footer_cache_max_size);
+    return config;
+}
 GlutenJobSchedulerConfig GlutenJobSchedulerConfig::loadFromContext(const DB::ContextPtr & context)
 {
     GlutenJobSchedulerConfig config;
@@ -149,6 +161,7 @@ WindowConfig WindowConfig::loadFromContext(const DB::ContextPtr & context)
     config.aggregate_topk_sample_rows = context->getConfigRef().getUInt64(WINDOW_AGGREGATE_TOPK_SAMPLE_ROWS, 5000);
     config.aggregate_topk_high_cardinality_threshold
         = context->getConfigRef().getDouble(WINDOW_AGGREGATE_TOPK_HIGH_CARDINALITY_THRESHOLD, 0.6);
+    config.hash_topk_max_limit = context->getConfigRef().getUInt64(WINDOW_HASH_TOPK_MAX_LIMIT, 0);
     return config;
 }
 
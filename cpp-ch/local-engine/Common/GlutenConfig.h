@@ -62,6 +62,7 @@ struct GraceMergingAggregateConfig
     inline static const String MAX_ALLOWED_MEMORY_USAGE_RATIO_FOR_AGGREGATE_MERGING
         = "max_allowed_memory_usage_ratio_for_aggregate_merging";
     inline static const String ENABLE_SPILL_TEST = "enable_grace_aggregate_spill_test";
+    inline static const String GRACE_AGGREGATE_MERGING_PARALLELISM = "grace_aggregate_merging_parallelism";
 
     size_t max_grace_aggregate_merging_buckets = 32;
     bool throw_on_overflow_grace_aggregate_merging_buckets = false;
@@ -69,6 +70,8 @@ struct GraceMergingAggregateConfig
     size_t max_pending_flush_blocks_per_grace_aggregate_merging_bucket = 1_MiB;
     double max_allowed_memory_usage_ratio_for_aggregate_merging = 0.9;
     bool enable_spill_test = false;
+    /// Number of processors merging the spilled buckets concurrently, 0 means they are merged one by one.
+    size_t grace_aggregate_merging_parallelism = 0;
 
     static GraceMergingAggregateConfig loadFromContext(const DB::ContextPtr & context);
 };
@@ -98,8 +101,25 @@ struct JoinConfig
     /// table is larger then this limit, this transform will not work.
     inline static const String MULTI_JOIN_ON_CLAUSES_BUILD_SIDE_ROWS_LIMIT = "multi_join_on_clauses_build_side_row_limit";
 
+    /// For inner and left semi hash joins, filter the probe side by the min/max and a bloom filter of the build side
+    /// values of the join keys. The filters of broadcast joins are pushed down into the scan. Those of shuffled hash
+    /// joins are only known once the build side is read, they filter the rows after the scan and are not pushed to the
+    /// parquet reader or ColumnIndexFilter.
+    inline static const String RUNTIME_FILTER_ENABLED = "join.runtime_filter.enabled";
+    /// The bloom filter takes 10 bits per build side value, above this size only the min/max filter is used.
+    inline static const String RUNTIME_FILTER_BLOOM_FILTER_MAX_BYTES = "join.runtime_filter.bloom_filter_max_bytes";
+
+    /// Broadcast tables with at least this number of rows are built into partitions on several threads. The joined rows
+    /// of a probe block are then output grouped by partition instead of in the order of the probe rows. 0 disables it.
+    inline static const String BROADCAST_PARALLEL_BUILD_MIN_ROWS = "join.broadcast_parallel_build_min_rows";
+    inline static const String BROADCAST_BUILD_THREADS = "join.broadcast_build_threads";
+
     bool prefer_multi_join_on_clauses = true;
     size_t multi_join_on_clauses_build_side_rows_limit = 10000000;
+    bool runtime_filter_enabled = false;
+    size_t runtime_filter_bloom_filter_max_bytes = 1048576;
+    size_t broadcast_parallel_build_min_rows = 0;
+    size_t broadcast_build_threads = 8;
 
     static JoinConfig loadFromContext(const DB::ContextPtr & context);
 };
@@ -141,6 +161,16 @@ struct MergeTreeConfig
     static MergeTreeConfig loadFromContext(const DB::ContextPtr & context);
 };
 
+struct ParquetFooterCacheConfig
+{
+    inline static const String PARQUET_FOOTER_CACHE_MAX_SIZE = "parquet.footer_cache.max_size";
+
+    /// 0 disables the executor-wide cache of parsed parquet footers and page indexes.
+    size_t parquet_footer_cache_max_size = 128_MiB;
+
+    static ParquetFooterCacheConfig loadFromContext(const DB::ContextPtr & context);
+};
+
 struct GlutenJobSchedulerConfig
 {
     inline static const String JOB_SCHEDULER_MAX_THREADS = "job_scheduler_max_threads";
@@ -166,6 +196,9 @@ public:
     inline static const String WINDOW_AGGREGATE_TOPK_HIGH_CARDINALITY_THRESHOLD = "window.aggregate_topk_high_cardinality_threshold";
     size_t aggregate_topk_sample_rows = 5000;
     double aggregate_topk_high_cardinality_threshold = 0.6;
+    /// High cardinality group limits up to this limit keep per-partition heaps instead of sorting the input, 0 disables it
+    inline static const String WINDOW_HASH_TOPK_MAX_LIMIT = "window.hash_topk_max_limit";
+    size_t hash_topk_max_limit = 0;
     static WindowConfig loadFromContext(const DB::ContextPtr & context);
 };
 
@@ -18,8 +18,10 @@
 #include <cerrno>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 #include <Columns/ColumnNullable.h>
 #include <Columns/ColumnTuple.h>
 #include <DataTypes/DataTypeNullable.h>
@@ -28,6 +30,10 @@
 #include <DataTypes/IDataType.h>
 #include <Functions/FunctionSQLJSON.h>
 #include <Functions/IFunction.h>
+#include <Functions/JSONPath/ASTs/ASTJSONPath.h>
+#include <Functions/JSONPath/ASTs/ASTJSONPathMemberAccess.h>
+#include <Functions/JSONPath/ASTs/ASTJSONPathQuery.h>
+#include <Functions/JSONPath/ASTs/ASTJSONPathRoot.h>
 #include <Functions/JSONPath/Generator/GeneratorJSONPath.h>
 #include <Functions/JSONPath/Parsers/ParserJSONPath.h>
 #include <Interpreters/Context.h>
@@ -489,47 +495,52 @@ public:
         {
             return false;
         }
+        if (elements.size() == 1) [[likely]]
+            return insertElementToColumn(dest, elements[0], path_has_asterisk);
+
         DB::ColumnNullable & nullable_col_str = assert_cast<DB::ColumnNullable &>(dest);
         DB::ColumnString * col_str = assert_cast<DB::ColumnString *>(&nullable_col_str.getNestedColumn());
         JSONStringSerializer serializer(*col_str);
-        if (elements.size() == 1) [[likely]]
-        {
-            if (elements[0].isNull())
-                return false;
-            nullable_col_str.getNullMapData().push_back(0);
-
-            if (elements[0].isString())
+        const char * array_begin = "[";
+        const char * array_end = "]";
+        const char * comma = ",";
+        bool flag = false;
+        serializer.addRawData(array_begin, 1);
+        nullable_col_str.getNullMapData().push_back(0);
+        for (auto & element : elements)
+        {
+            if (flag)
             {
-                auto str = elements[0].getString();
-                if (path_has_asterisk)
-                {
-                    str = "\"" + std::string(str) + "\"";
-                }
-                serializer.addRawString(str);
+                serializer.addRawData(comma, 1);
             }
+            serializer.addElement(element);
+            flag = true;
+        }
+        serializer.addRawData(array_end, 1);
+        serializer.commit();
+        return true;
+    }
+
+    /// Insert the only element matched by a json path.
+    bool insertElementToColumn(DB::IColumn & dest, const Element & element, bool path_has_asterisk)
+    {
+        if (element.isNull())
+            return false;
+
+        DB::ColumnNullable & nullable_col_str = assert_cast<DB::ColumnNullable &>(dest);
+        DB::ColumnString * col_str = assert_cast<DB::ColumnString *>(&nullable_col_str.getNestedColumn());
+        JSONStringSerializer serializer(*col_str);
+        nullable_col_str.getNullMapData().push_back(0);
+        if (element.isString())
+        {
+            if (path_has_asterisk)
+                serializer.addRawString("\"" + std::string(element.getString()) + "\"");
             else
-            { 
-                serializer.addElement(elements[0]);
-            }
+                serializer.addRawString(element.getString());
         }
         else
         {
-            const char * array_begin = "[";
-            const char * array_end = "]";
-            const char * comma = ",";
-            bool flag = false;
-            serializer.addRawData(array_begin, 1);
-            nullable_col_str.getNullMapData().push_back(0);
-            for (auto & element : elements)
-            {
-                if (flag)
-                {
-                    serializer.addRawData(comma, 1);
-                }
-                serializer.addElement(element);
-                flag = true;
-            }
-            serializer.addRawData(array_end, 1);
+            serializer.addElement(element);
         }
         serializer.commit();
         return true;
@@ -582,6 +593,86 @@ private:
     static void normalizeOnOtherTokens(DB::IParser::Pos & iter, String & res);
 };
 
+/// Required json paths which are plain member chains, like `$.a.b`, organized as a trie. They are resolved by
+/// direct object lookups on the parsed document instead of GeneratorJSONPath, and a prefix shared by several
+/// paths, e.g. `$.a` in `$.a.b|$.a.c`, is only looked up once per row.
+class JSONMemberPathTrie
+{
+public:
+    /// Returns the member names if the json path only consists of member accesses.
+    static std::optional<std::vector<String>> tryGetMemberChain(const DB::ASTPtr & json_path_ast)
+    {
+        const auto * json_path = json_path_ast ? json_path_ast->as<DB::ASTJSONPath>() : nullptr;
+        if (!json_path || !json_path->jsonpath_query)
+            return std::nullopt;
+
+        std::vector<String> members;
+        for (const auto & child : json_path->jsonpath_query->children)
+        {
+            if (child->as<DB::ASTJSONPathRoot>())
+                continue;
+            const auto * member_access = child->as<DB::ASTJSONPathMemberAccess>();
+            if (!member_access)
+                return std::nullopt;
+            members.push_back(member_access->member_name);
+        }
+        return members;
+    }
+
+    void add(const std::vector<String> & members, size_t output)
+    {
+        Node * node = &root;
+        for (const auto & member : members)
+        {
+            auto it = std::find_if(
+                node->children.begin(), node->children.end(), [&](const auto & child) { return child->member == member; });
+            if (it == node->children.end())
+            {
+                node->children.emplace_back(std::make_unique<Node>());
+                node->children.back()->member = member;
+                it = std::prev(node->children.end());
+            }
+            node = it->get();
+        }
+        node->outputs.push_back(output);
+    }
+
+    bool empty() const { return root.outputs.empty() && root.children.empty(); }
+
+    /// Calls on_match(output, element) for every path found in the document.
+    template <typename Element, typename OnMatch>
+    void visit(const Element & document, OnMatch && on_match) const
+    {
+        visitImpl(root, document, on_match);
+    }
+
+private:
+    struct Node
+    {
+        String member;
+        std::vector<size_t> outputs;
+        std::vector<std::unique_ptr<Node>> children;
+    };
+    Node root;
+
+    template <typename Element, typename OnMatch>
+    static void visitImpl(const Node & node, const Element & element, OnMatch & on_match)
+    {
+        for (auto output : node.outputs)
+            on_match(output, element);
+        if (node.children.empty() || !element.isObject())
+            return;
+
+        auto object = element.getObject();
+        for (const auto & child : node.children)
+        {
+            Element child_element;
+            if (object.find(child->member, child_element))
+                visitImpl(*child, child_element, on_match);
+        }
+    }
+};
+
 /// Flatten a json string into a tuple.
 /// Not use JSONExtract here, since the json path is a complicated expression.
 class FlattenJSONStringOnRequiredFunction : public DB::IFunction
@@ -648,8 +739,9 @@ private:
     mutable size_t total_parsed_rows = 0;
     mutable size_t total_normalized_rows = 0;
 
+    /// normalized_buf is reused across rows, the parser copies the text it parses.
     template <typename JSONParser>
-    bool safeParseJson(std::string_view str, JSONParser & parser, JSONParser::Element & doc) const
+    bool safeParseJson(std::string_view str, JSONParser & parser, JSONParser::Element & doc, std::vector<char> & normalized_buf) const
     {
         total_parsed_rows++;
         if (total_parsed_rows > 10000 && total_normalized_rows * 100 / total_parsed_rows > 90)
@@ -665,16 +757,12 @@ private:
         if (!is_doc_ok && str.size() > 0)
         {
             total_normalized_rows++;
-            std::vector<char> buf;
-            buf.resize(str.size(), 0);
-            char * buf_pos = buf.data();
+            if (normalized_buf.size() < str.size())
+                normalized_buf.resize(str.size());
+            char * buf_pos = normalized_buf.data();
             const char * pos = JSONTextNormalizer::normalize(str.data(), str.data() + str.size(), buf_pos);
             if (pos)
-            {
-                std::string n_str(buf.data(), buf_pos - buf.data());
-                // LOG_DEBUG(getLogger("GetJsonObject"), "xxx normalize {} to {}", str, n_str);
-                is_doc_ok = parser.parse(n_str, doc);
-            }
+                is_doc_ok = parser.parse(std::string_view(normalized_buf.data(), buf_pos - normalized_buf.data()), doc);
         }
         return is_doc_ok;
     }
@@ -760,36 +848,58 @@ private:
         using Element = typename JSONParser::Element;
         Element document;
         bool document_ok = false;
+        std::vector<char> normalized_buf;
         if (col_json_const)
         {
             std::string_view json{reinterpret_cast<const char *>(chars.data()), offsets[0] - 1};
-            document_ok = safeParseJson(json, parser, document);
+            document_ok = safeParseJson(json, parser, document, normalized_buf);
         }
 
+        /// Plain member chains go to the trie, the others are evaluated by GeneratorJSONPath.
         size_t tuple_size = tuple_columns.size();
-        std::vector<std::shared_ptr<DB::GeneratorJSONPath<JSONParser>>> generator_json_paths;
-        std::transform(
-            json_path_asts.begin(),
-            json_path_asts.end(),
-            std::back_inserter(generator_json_paths),
-            [](const auto & ast) { return std::make_shared<DB::GeneratorJSONPath<JSONParser>>(ast); });
+        JSONMemberPathTrie member_paths;
+        std::vector<size_t> generic_paths;
+        std::vector<std::shared_ptr<DB::GeneratorJSONPath<JSONParser>>> generator_json_paths(tuple_size);
+        for (size_t j = 0; j < tuple_size; ++j)
+        {
+            if (auto members = JSONMemberPathTrie::tryGetMemberChain(json_path_asts[j]))
+            {
+                member_paths.add(*members, j);
+            }
+            else
+            {
+                generic_paths.push_back(j);
+                generator_json_paths[j] = std::make_shared<DB::GeneratorJSONPath<JSONParser>>(json_path_asts[j]);
+            }
+        }
 
+        std::vector<UInt8> inserted(tuple_size);
         for (const auto i : collections::range(0, arguments[0].column->size()))
         {
             if (!col_json_const)
             {
                 std::string_view json{reinterpret_cast<const char *>(&chars[offsets[i - 1]]), offsets[i] - offsets[i - 1] - 1};
-                document_ok = safeParseJson(json, parser, document);
+                document_ok = safeParseJson(json, parser, document, normalized_buf);
             }
             if (document_ok)
             {
-                for (size_t j = 0; j < tuple_size; ++j)
+                std::fill(inserted.begin(), inserted.end(), 0);
+                if (!member_paths.empty())
+                {
+                    member_paths.visit(
+                        document,
+                        [&](size_t j, const Element & element)
+                        { inserted[j] = impl.insertElementToColumn(*tuple_columns[j], element, path_has_asterisk[j]); });
+                }
+                for (auto j : generic_paths)
                 {
                     generator_json_paths[j]->reinitialize();
-                    if (!impl.insertResultToColumn(*tuple_columns[j], document, *generator_json_paths[j], path_has_asterisk[j]))
-                    {
+                    inserted[j] = impl.insertResultToColumn(*tuple_columns[j], document, *generator_json_paths[j], path_has_asterisk[j]);
+                }
+                for (size_t j = 0; j < tuple_size; ++j)
+                {
+                    if (!inserted[j])
                         tuple_columns[j]->insertDefault();
-                    }
                 }
             }
             else
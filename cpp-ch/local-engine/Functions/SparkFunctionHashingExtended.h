@@ -641,6 +641,42 @@ struct SparkMurmurHash3_32
         SparkMurmurHash3_32_Impl(data, size, static_cast<UInt32>(seed), bytes);
         return h;
     }
+
+    /// Same as apply on the 4 or 8 bytes of value, i.e. Murmur3_x86_32.hashInt/hashLong in Spark
+    static ALWAYS_INLINE UInt32 applyInt32(UInt32 value, UInt32 seed) { return fmix(mixH1(seed, mixK1(value)), 4); }
+
+    static ALWAYS_INLINE UInt32 applyInt64(UInt64 value, UInt32 seed)
+    {
+        UInt32 h1 = mixH1(seed, mixK1(static_cast<UInt32>(value)));
+        h1 = mixH1(h1, mixK1(static_cast<UInt32>(value >> 32)));
+        return fmix(h1, 8);
+    }
+
+private:
+    static ALWAYS_INLINE UInt32 mixK1(UInt32 k1)
+    {
+        k1 *= 0xcc9e2d51;
+        k1 = rotl32(k1, 15);
+        return k1 * 0x1b873593;
+    }
+
+    static ALWAYS_INLINE UInt32 mixH1(UInt32 h1, UInt32 k1)
+    {
+        h1 ^= k1;
+        h1 = rotl32(h1, 13);
+        return h1 * 5 + 0xe6546b64;
+    }
+
+    static ALWAYS_INLINE UInt32 fmix(UInt32 h1, UInt32 len)
+    {
+        h1 ^= len;
+        h1 ^= h1 >> 16;
+        h1 *= 0x85ebca6b;
+        h1 ^= h1 >> 13;
+        h1 *= 0xc2b2ae35;
+        h1 ^= h1 >> 16;
+        return h1;
+    }
 };
 
 using SparkFunctionXxHash64 = SparkFunctionAnyHash<SparkImplXxHash64>;
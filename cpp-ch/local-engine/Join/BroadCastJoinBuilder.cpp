@@ -27,7 +27,10 @@
 #include <jni/jni_common.h>
 #include <Poco/StringTokenizer.h>
 #include <Common/CHUtil.h>
+#include <Common/GlutenConfig.h>
 #include <Common/JNIUtils.h>
+#include <Common/MemoryTrackerSwitcher.h>
+#include <Common/QueryContext.h>
 #include <Common/logger_useful.h>
 
 namespace DB
@@ -86,9 +89,10 @@ void cleanBuildHashTable(const std::string & hash_table_id, jlong instance)
 {
     auto clean_join = [&]
     {
+        MemoryTrackerSwitcher switcher(&StorageJoinFromReadBuffer::memoryTracker());
         SharedPointerWrapper<StorageJoinFromReadBuffer>::dispose(instance);
     };
-    /// Record memory usage in Total Memory Tracker
+    /// Record memory usage in the broadcast tracker
     ThreadFromGlobalPoolNoTracingContextPropagation thread(clean_join);
     thread.join();
     LOG_DEBUG(&Poco::Logger::get("BroadCastJoinBuilder"), "Broadcast hash table {} is cleaned", hash_table_id);
@@ -142,6 +146,7 @@ std::shared_ptr<StorageJoinFromReadBuffer> buildJoin(
     Blocks data;
     auto collect_data = [&]
     {
+        MemoryTrackerSwitcher switcher(&StorageJoinFromReadBuffer::memoryTracker());
         bool only_one_column = header.getNamesAndTypesList().empty();
         if (only_one_column)
             header = BlockUtil::buildRowCountBlock(0).getColumnsWithTypeAndName();
@@ -173,12 +178,18 @@ std::shared_ptr<StorageJoinFromReadBuffer> buildJoin(
             block = block_stream.read();
         }
     };
-    /// Record memory usage in Total Memory Tracker
+    /// Record memory usage in the broadcast tracker
     ThreadFromGlobalPoolNoTracingContextPropagation thread(collect_data);
     thread.join();
 
     ColumnsDescription columns_description(header.getNamesAndTypesList());
 
+    auto join_config = JoinConfig::loadFromContext(QueryContext::globalContext());
+    size_t build_threads = 1;
+    if (join_config.broadcast_parallel_build_min_rows && row_count >= 0
+        && static_cast<size_t>(row_count) >= join_config.broadcast_parallel_build_min_rows)
+        build_threads = std::max<size_t>(join_config.broadcast_build_threads, 1);
+
     return make_shared<StorageJoinFromReadBuffer>(
         data,
         row_count,
@@ -192,7 +203,9 @@ std::shared_ptr<StorageJoinFromReadBuffer> buildJoin(
         key,
         true,
         is_null_aware_anti_join,
-        has_null_key_values);
+        has_null_key_values,
+        build_threads,
+        join_config.runtime_filter_enabled ? std::make_optional(join_config.runtime_filter_bloom_filter_max_bytes) : std::nullopt);
 }
 
 void init(JNIEnv * env)
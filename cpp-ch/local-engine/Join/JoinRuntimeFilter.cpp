@@ -0,0 +1,229 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "JoinRuntimeFilter.h"
+
+#include <AggregateFunctions/AggregateFunctionFactory.h>
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypeLowCardinality.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Functions/FunctionFactory.h>
+#include <IO/WriteBufferFromString.h>
+#include <base/scope_guard.h>
+#include <Common/Arena.h>
+#include <Common/SipHash.h>
+#include <Common/assert_cast.h>
+
+namespace local_engine
+{
+using namespace DB;
+
+bool JoinKeyRuntimeFilterBuilder::isSupportedType(const DataTypePtr & type)
+{
+    const WhichDataType which(type);
+    return which.isNativeInt() || which.isNativeUInt() || which.isDateOrDate32() || which.isString() || which.isDecimal();
+}
+
+JoinKeyRuntimeFilterBuilder::JoinKeyRuntimeFilterBuilder(
+    const DataTypePtr & key_type, size_t bloom_filter_max_bytes_, const ContextPtr & context)
+    : type(removeNullable(removeLowCardinality(key_type))), bloom_filter_max_bytes(bloom_filter_max_bytes_)
+{
+    if (bloom_filter_max_bytes)
+        hash_function = FunctionFactory::instance().get("xxHash64", context)->build({ColumnWithTypeAndName(type, "key")});
+}
+
+void JoinKeyRuntimeFilterBuilder::add(const ColumnPtr & column)
+{
+    const auto full_column = column->convertToFullIfNeeded();
+    if (full_column->empty())
+        return;
+
+    /// Nulls never match, both getExtremes and the hashing below skip them.
+    Field block_min;
+    Field block_max;
+    full_column->getExtremes(block_min, block_max);
+    if (block_min.isNull())
+        return;
+    if (!has_value)
+    {
+        min = std::move(block_min);
+        max = std::move(block_max);
+        has_value = true;
+    }
+    else
+    {
+        if (block_min < min)
+            min = std::move(block_min);
+        if (max < block_max)
+            max = std::move(block_max);
+    }
+
+    if (hash_function)
+        addNotNull(full_column);
+}
+
+void JoinKeyRuntimeFilterBuilder::addNotNull(const ColumnPtr & column)
+{
+    const NullMap * null_map = nullptr;
+    ColumnPtr nested = column;
+    if (const auto * nullable_column = checkAndGetColumn<ColumnNullable>(column.get()))
+    {
+        nested = nullable_column->getNestedColumnPtr();
+        null_map = &nullable_column->getNullMapData();
+    }
+
+    const auto hashed
+        = hash_function->execute({ColumnWithTypeAndName(nested, type, "key")}, hash_function->getResultType(), nested->size(), false);
+    const auto & data = assert_cast<const ColumnUInt64 &>(*hashed).getData();
+    if (!null_map)
+        hashes.insert(data.begin(), data.end());
+    else
+    {
+        for (size_t i = 0; i < data.size(); ++i)
+            if (!(*null_map)[i])
+                hashes.push_back(data[i]);
+    }
+
+    checkBloomFilterSize();
+}
+
+void JoinKeyRuntimeFilterBuilder::checkBloomFilterSize()
+{
+    /// Given up rather than losing precision, the range still applies.
+    if (hashes.size() * BLOOM_FILTER_BITS_PER_VALUE / 8 > bloom_filter_max_bytes)
+    {
+        hash_function.reset();
+        PaddedPODArray<UInt64>().swap(hashes);
+    }
+}
+
+void JoinKeyRuntimeFilterBuilder::merge(JoinKeyRuntimeFilterBuilder && other)
+{
+    if (!other.has_value)
+        return;
+    if (!has_value)
+    {
+        min = std::move(other.min);
+        max = std::move(other.max);
+        has_value = true;
+    }
+    else
+    {
+        if (other.min < min)
+            min = std::move(other.min);
+        if (max < other.max)
+            max = std::move(other.max);
+    }
+
+    if (!other.hash_function)
+    {
+        hash_function.reset();
+        PaddedPODArray<UInt64>().swap(hashes);
+    }
+    else if (hash_function)
+    {
+        hashes.insert(other.hashes.begin(), other.hashes.end());
+        checkBloomFilterSize();
+    }
+}
+
+String JoinKeyRuntimeFilterBuilder::buildBloomFilter() const
+{
+    const size_t bytes = std::max(MIN_BLOOM_FILTER_BYTES, (hashes.size() * BLOOM_FILTER_BITS_PER_VALUE + 7) / 8);
+    /// The same function bloomFilterContains deserializes the state with.
+    AggregateFunctionProperties properties;
+    const auto agg_function = AggregateFunctionFactory::instance().get(
+        "groupBloomFilter",
+        NullsAction::EMPTY,
+        {makeNullable(std::make_shared<DataTypeInt64>())},
+        {Field(static_cast<UInt64>(bytes)), Field(static_cast<UInt64>(BLOOM_FILTER_HASH_FUNCTIONS)), Field(static_cast<UInt64>(0))},
+        properties);
+
+    auto values = ColumnInt64::create();
+    values->getData().insert(hashes.begin(), hashes.end());
+    const auto column = ColumnNullable::create(std::move(values), ColumnUInt8::create(hashes.size(), 0));
+    const IColumn * columns[] = {column.get()};
+
+    Arena arena;
+    auto * place = arena.alignedAlloc(agg_function->sizeOfData(), agg_function->alignOfData());
+    agg_function->create(place);
+    SCOPE_EXIT({ agg_function->destroy(place); });
+    agg_function->addBatchSinglePlace(0, hashes.size(), place, columns, &arena);
+    WriteBufferFromOwnString out;
+    agg_function->serialize(place, out);
+    return out.str();
+}
+
+std::optional<JoinKeyRuntimeFilter> JoinKeyRuntimeFilterBuilder::finish()
+{
+    if (!has_value)
+        return std::nullopt;
+
+    JoinKeyRuntimeFilter filter;
+    filter.type = type;
+    filter.min = std::move(min);
+    filter.max = std::move(max);
+    if (hash_function)
+        filter.bloom_filter = buildBloomFilter();
+    return filter;
+}
+
+std::optional<JoinKeyRuntimeFilter> JoinKeyRuntimeFilterBuilder::build(
+    const Blocks & blocks, const String & key_name, size_t bloom_filter_max_bytes, const ContextPtr & context)
+{
+    if (blocks.empty() || !blocks.front().has(key_name))
+        return std::nullopt;
+
+    const auto & key_type = blocks.front().getByName(key_name).type;
+    if (!isSupportedType(removeNullable(removeLowCardinality(key_type))))
+        return std::nullopt;
+
+    JoinKeyRuntimeFilterBuilder builder(key_type, bloom_filter_max_bytes, context);
+    for (const auto & block : blocks)
+        builder.add(block.getByName(key_name).column);
+    return builder.finish();
+}
+
+const ActionsDAG::Node *
+JoinKeyRuntimeFilter::buildCondition(ActionsDAG & actions_dag, const ActionsDAG::Node & key, const ContextPtr & context) const
+{
+    auto & factory = FunctionFactory::instance();
+    auto add_function = [&](const String & name, const ActionsDAG::NodeRawConstPtrs & args) -> const ActionsDAG::Node *
+    { return &actions_dag.addFunction(factory.get(name, context), args, {}); };
+    auto add_literal = [&](const Field & literal) -> const ActionsDAG::Node *
+    { return &actions_dag.addColumn(ColumnWithTypeAndName(type->createColumnConst(1, literal), type, toString(literal))); };
+
+    ActionsDAG::NodeRawConstPtrs conditions;
+    conditions.emplace_back(add_function("greaterOrEquals", {&key, add_literal(min)}));
+    conditions.emplace_back(add_function("lessOrEquals", {&key, add_literal(max)}));
+
+    /// The hash of a LowCardinality key would be LowCardinality too, which bloomFilterContains doesn't take.
+    if (!bloom_filter.empty() && !key.result_type->lowCardinality())
+    {
+        auto string_type = std::make_shared<DataTypeString>();
+        /// Named by its hash rather than its content, which may be up to the size cap.
+        const auto * state = &actions_dag.addColumn(ColumnWithTypeAndName(
+            string_type->createColumnConst(1, bloom_filter), string_type, fmt::format("bloom_filter_{}", sipHash64(bloom_filter))));
+        const auto * hash = add_function("xxHash64", {&key});
+        conditions.emplace_back(add_function("bloomFilterContains", {state, hash}));
+    }
+    return add_function("and", conditions);
+}
+
+}
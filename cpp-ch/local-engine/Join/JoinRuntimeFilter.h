@@ -0,0 +1,100 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <memory>
+#include <optional>
+#include <Core/Block.h>
+#include <Core/Field.h>
+#include <Interpreters/ActionsDAG.h>
+#include <Common/PODArray.h>
+
+namespace DB
+{
+class IFunctionBase;
+using FunctionBasePtr = std::shared_ptr<const IFunctionBase>;
+}
+
+namespace local_engine
+{
+
+/// Summary of the values of one join key on the build side: min/max, and a bloom filter of the xxHash64 of the values.
+/// A probe row whose key falls outside of them can't find a match, so for inner and semi joins the probe side can
+/// drop it early.
+struct JoinKeyRuntimeFilter
+{
+    DB::DataTypePtr type; /// without Nullable and LowCardinality
+    DB::Field min;
+    DB::Field max;
+    /// Serialized groupBloomFilter state, as read by bloomFilterContains. Empty if the bloom filter would be larger
+    /// than the size cap.
+    String bloom_filter;
+
+    /// Build `key between min and max`, and `bloomFilterContains(bloom_filter, xxHash64(key))` if there is a bloom
+    /// filter and key is not LowCardinality, on the column key of actions_dag. Above the probe side of a broadcast join
+    /// the query plan optimizer pushes the range down into the source step (row group/page index and parquet filter
+    /// push down).
+    const DB::ActionsDAG::Node *
+    buildCondition(DB::ActionsDAG & actions_dag, const DB::ActionsDAG::Node & key, const DB::ContextPtr & context) const;
+};
+using JoinKeyRuntimeFilterPtr = std::shared_ptr<const JoinKeyRuntimeFilter>;
+
+/// Collects the JoinKeyRuntimeFilter of one key column block by block, from the typed columns: min/max by
+/// IColumn::getExtremes, and the values hashed by xxHash64 a column at a time. The hashes are kept until finish()
+/// sizes the bloom filter by their number, and dropped once the bloom filter would exceed bloom_filter_max_bytes.
+class JoinKeyRuntimeFilterBuilder
+{
+public:
+    /// About 1% false positives
+    static constexpr size_t BLOOM_FILTER_BITS_PER_VALUE = 10;
+    static constexpr size_t BLOOM_FILTER_HASH_FUNCTIONS = 7;
+    static constexpr size_t MIN_BLOOM_FILTER_BYTES = 64;
+
+    /// Floats are not supported, NaN and -0.0 don't compare like the hash table matches them.
+    static bool isSupportedType(const DB::DataTypePtr & type);
+
+    /// A bloom_filter_max_bytes of 0 disables the bloom filter.
+    JoinKeyRuntimeFilterBuilder(const DB::DataTypePtr & key_type, size_t bloom_filter_max_bytes_, const DB::ContextPtr & context);
+
+    /// column is of the key type, possibly Nullable, LowCardinality or Const.
+    void add(const DB::ColumnPtr & column);
+
+    /// Adds the values added to other, which is of the same key type.
+    void merge(JoinKeyRuntimeFilterBuilder && other);
+
+    /// Returns nullopt if no non-null value was added.
+    std::optional<JoinKeyRuntimeFilter> finish();
+
+    /// Returns nullopt if the key type is not supported or there is no non-null key value.
+    static std::optional<JoinKeyRuntimeFilter>
+    build(const DB::Blocks & blocks, const String & key_name, size_t bloom_filter_max_bytes, const DB::ContextPtr & context);
+
+private:
+    DB::DataTypePtr type;
+    size_t bloom_filter_max_bytes;
+    /// xxHash64 on type, nullptr once the bloom filter is given up
+    DB::FunctionBasePtr hash_function;
+    DB::PaddedPODArray<UInt64> hashes;
+    bool has_value = false;
+    DB::Field min;
+    DB::Field max;
+
+    void addNotNull(const DB::ColumnPtr & column);
+    void checkBloomFilterSize();
+    String buildBloomFilter() const;
+};
+
+}
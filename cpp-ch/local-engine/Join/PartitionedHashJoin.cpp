@@ -0,0 +1,177 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "PartitionedHashJoin.h"
+
+#include <algorithm>
+#include <Interpreters/HashJoin/HashJoin.h>
+#include <Interpreters/TableJoin.h>
+#include <Common/Exception.h>
+#include <Common/WeakHash.h>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int LOGICAL_ERROR;
+extern const int NOT_IMPLEMENTED;
+}
+}
+
+namespace local_engine
+{
+using namespace DB;
+
+namespace
+{
+/// Concatenates the results of the partitions a probe block was scattered to.
+class PartitionedJoinResult : public IJoinResult
+{
+public:
+    explicit PartitionedJoinResult(std::vector<JoinResultPtr> results_) : results(std::move(results_)) { }
+
+    JoinResultBlock next() override
+    {
+        while (true)
+        {
+            auto res = results[current]->next();
+            if (res.is_last)
+                ++current;
+            res.is_last = current == results.size();
+            if (res.is_last || res.block.rows())
+                return res;
+        }
+    }
+
+private:
+    std::vector<JoinResultPtr> results;
+    size_t current = 0;
+};
+}
+
+PartitionedHashJoin::PartitionedHashJoin(
+    std::shared_ptr<TableJoin> table_join_, std::vector<std::shared_ptr<HashJoin>> partitions_, Names probe_key_names_)
+    : table_join(std::move(table_join_)), partitions(std::move(partitions_)), probe_key_names(std::move(probe_key_names_))
+{
+    if (partitions.empty() || table_join->getClauses().size() != 1)
+        throw Exception(ErrorCodes::LOGICAL_ERROR, "PartitionedHashJoin needs at least one partition and exactly one join clause");
+}
+
+std::optional<Names> PartitionedHashJoin::probeKeyNames(const TableJoin & table_join, const Names & build_key_names)
+{
+    if (table_join.getClauses().size() != 1)
+        return std::nullopt;
+    const auto & clause = table_join.getOnlyClause();
+    if (clause.key_names_right.size() != build_key_names.size() || clause.key_names_left.size() != build_key_names.size())
+        return std::nullopt;
+
+    Names probe_keys;
+    for (size_t i = 0; i < build_key_names.size(); ++i)
+    {
+        auto it = std::find(clause.key_names_right.begin(), clause.key_names_right.end(), build_key_names[i]);
+        const size_t position = it == clause.key_names_right.end() ? i : it - clause.key_names_right.begin();
+        probe_keys.emplace_back(clause.key_names_left[position]);
+    }
+    return probe_keys;
+}
+
+std::vector<Block> PartitionedHashJoin::scatterBlock(const Block & block, const Names & key_names, size_t partitions)
+{
+    std::vector<size_t> key_positions;
+    key_positions.reserve(key_names.size());
+    for (const auto & key : key_names)
+        key_positions.emplace_back(block.getPositionByName(key));
+    return scatterBlock(block, key_positions, partitions);
+}
+
+std::vector<Block> PartitionedHashJoin::scatterBlock(const Block & block, const std::vector<size_t> & key_positions, size_t partitions)
+{
+    const size_t rows = block.rows();
+    WeakHash32 hash(rows);
+    for (const auto position : key_positions)
+        hash.update(block.getByPosition(position).column->convertToFullIfNeeded()->getWeakHash32());
+
+    IColumn::Selector selector(rows);
+    const auto & hash_data = hash.getData();
+    for (size_t i = 0; i < rows; ++i)
+        selector[i] = hash_data[i] % partitions;
+
+    std::vector<MutableColumns> columns(partitions, MutableColumns(block.columns()));
+    for (size_t i = 0; i < block.columns(); ++i)
+    {
+        auto scattered = block.getByPosition(i).column->scatter(partitions, selector);
+        for (size_t p = 0; p < partitions; ++p)
+            columns[p][i] = std::move(scattered[p]);
+    }
+
+    std::vector<Block> res;
+    res.reserve(partitions);
+    for (auto & partition_columns : columns)
+        res.emplace_back(block.cloneWithColumns(std::move(partition_columns)));
+    return res;
+}
+
+bool PartitionedHashJoin::addBlockToJoin(const Block &, bool)
+{
+    throw Exception(ErrorCodes::NOT_IMPLEMENTED, "PartitionedHashJoin is built by StorageJoinFromReadBuffer");
+}
+
+void PartitionedHashJoin::checkTypesOfKeys(const Block & block) const
+{
+    partitions.front()->checkTypesOfKeys(block);
+}
+
+JoinResultPtr PartitionedHashJoin::joinBlock(Block block)
+{
+    if (partitions.size() == 1 || !block.rows())
+        return partitions.front()->joinBlock(std::move(block));
+
+    auto scattered = scatterBlock(block, probe_key_names, partitions.size());
+    std::vector<JoinResultPtr> results;
+    for (size_t p = 0; p < partitions.size(); ++p)
+        if (scattered[p].rows())
+            results.emplace_back(partitions[p]->joinBlock(std::move(scattered[p])));
+    return std::make_unique<PartitionedJoinResult>(std::move(results));
+}
+
+size_t PartitionedHashJoin::getTotalRowCount() const
+{
+    size_t rows = 0;
+    for (const auto & partition : partitions)
+        rows += partition->getTotalRowCount();
+    return rows;
+}
+
+size_t PartitionedHashJoin::getTotalByteCount() const
+{
+    size_t bytes = 0;
+    for (const auto & partition : partitions)
+        bytes += partition->getTotalByteCount();
+    return bytes;
+}
+
+bool PartitionedHashJoin::alwaysReturnsEmptySet() const
+{
+    return std::ranges::all_of(partitions, [](const auto & partition) { return partition->alwaysReturnsEmptySet(); });
+}
+
+IBlocksStreamPtr PartitionedHashJoin::getNonJoinedBlocks(const Block &, const Block &, UInt64) const
+{
+    /// Only INNER/LEFT joins are partitioned, they have no non-joined rows from the right side.
+    return nullptr;
+}
+
+}
@@ -0,0 +1,80 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <memory>
+#include <optional>
+#include <vector>
+#include <Core/Block.h>
+#include <Interpreters/IJoin.h>
+
+namespace DB
+{
+class HashJoin;
+class TableJoin;
+}
+
+namespace local_engine
+{
+
+/// A broadcast hash table split into partitions by the hash of the join keys. The partitions are built by
+/// StorageJoinFromReadBuffer on several threads, and a probe block is scattered by the same hash so that each
+/// row is joined with the only partition which could contain its matches.
+///
+/// It's only used for single clause INNER/LEFT joins, where every probe row is output by the partition it is
+/// sent to. RIGHT/FULL joins would need the non-joined rows of all partitions and are not supported.
+///
+/// The output is grouped by partition: the joined rows of a probe block are not in the order of the probe rows,
+/// unlike the output of a single HashJoin.
+class PartitionedHashJoin : public DB::IJoin
+{
+public:
+    /// partitions are clones sharing the data of the built partitions, see HashJoin::reuseJoinedData.
+    /// probe_key_names_ are the probe side keys in the order of the keys which the partitions are hashed on, see
+    /// probeKeyNames.
+    PartitionedHashJoin(
+        std::shared_ptr<DB::TableJoin> table_join_, std::vector<std::shared_ptr<DB::HashJoin>> partitions_, DB::Names probe_key_names_);
+
+    /// The probe side keys of the only clause of table_join, in the order of build_key_names. A build key is looked
+    /// up in the right keys of the clause by name, or else by its position, since the broadcast table keys are the
+    /// right keys of the join in the same order. nullopt if table_join can't be partitioned on build_key_names.
+    static std::optional<DB::Names> probeKeyNames(const DB::TableJoin & table_join, const DB::Names & build_key_names);
+
+    /// Split block into partitions rows by the hash of the key columns. Rows with equal keys end up in the same
+    /// partition, also when one side is Nullable and the other is not.
+    static std::vector<DB::Block> scatterBlock(const DB::Block & block, const std::vector<size_t> & key_positions, size_t partitions);
+    static std::vector<DB::Block> scatterBlock(const DB::Block & block, const DB::Names & key_names, size_t partitions);
+
+    std::string getName() const override { return "PartitionedHashJoin"; }
+    const DB::TableJoin & getTableJoin() const override { return *table_join; }
+    bool addBlockToJoin(const DB::Block & block, bool check_limits) override;
+    void checkTypesOfKeys(const DB::Block & block) const override;
+    DB::JoinResultPtr joinBlock(DB::Block block) override;
+    size_t getTotalRowCount() const override;
+    size_t getTotalByteCount() const override;
+    bool alwaysReturnsEmptySet() const override;
+    bool isFilled() const override { return true; }
+    DB::IBlocksStreamPtr
+    getNonJoinedBlocks(const DB::Block & left_sample_block, const DB::Block & result_sample_block, UInt64 max_block_size) const override;
+
+private:
+    std::shared_ptr<DB::TableJoin> table_join;
+    std::vector<std::shared_ptr<DB::HashJoin>> partitions;
+    /// Probe side keys, in the order of the build side keys
+    DB::Names probe_key_names;
+};
+
+}
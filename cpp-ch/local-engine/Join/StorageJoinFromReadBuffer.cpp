@@ -16,12 +16,18 @@
  */
 #include "StorageJoinFromReadBuffer.h"
 
+#include <atomic>
+#include <mutex>
 #include <Interpreters/Context.h>
 #include <Interpreters/HashJoin/HashJoin.h>
 #include <Interpreters/TableJoin.h>
+#include <Join/PartitionedHashJoin.h>
 #include <Common/BlockTypeUtils.h>
 #include <Common/CHUtil.h>
 #include <Common/Exception.h>
+#include <Common/MemoryTracker.h>
+#include <Common/MemoryTrackerSwitcher.h>
+#include <Common/QueryContext.h>
 #include <Common/ThreadPool.h>
 #include <Common/logger_useful.h>
 
@@ -75,8 +81,16 @@ StorageJoinFromReadBuffer::StorageJoinFromReadBuffer(
     const String & comment,
     const bool overwrite_,
     bool is_null_aware_anti_join_,
-    bool has_null_key_values_)
-    : key_names(key_names_), use_nulls(use_nulls_), row_count(row_count_), overwrite(overwrite_), is_null_aware_anti_join(is_null_aware_anti_join_), has_null_key_value(has_null_key_values_)
+    bool has_null_key_values_,
+    size_t build_threads_,
+    std::optional<size_t> runtime_filter_bloom_filter_max_bytes)
+    : key_names(key_names_)
+    , use_nulls(use_nulls_)
+    , row_count(row_count_)
+    , overwrite(overwrite_)
+    , is_null_aware_anti_join(is_null_aware_anti_join_)
+    , build_threads(build_threads_)
+    , has_null_key_value(has_null_key_values_)
 {
     is_empty_hash_table = row_count < 1;
     storage_metadata.setColumns(columns);
@@ -95,6 +109,20 @@ StorageJoinFromReadBuffer::StorageJoinFromReadBuffer(
     }
 
     right_sample_block = toShared(rightSampleBlock(use_nulls, storage_metadata, table_join->kind()));
+    for (const auto & key : key_names)
+        key_positions.emplace_back(storage_metadata.getSampleBlock().getPositionByName(key));
+
+    /// Collected once per broadcast table, the probe sides of all tasks on this executor share them.
+    if (runtime_filter_bloom_filter_max_bytes)
+    {
+        for (const auto & key : key_names)
+        {
+            const auto & context = QueryContext::globalContext();
+            if (auto filter = JoinKeyRuntimeFilterBuilder::build(data, key, *runtime_filter_bloom_filter_max_bytes, context))
+                runtime_filters.emplace(key, std::make_shared<const JoinKeyRuntimeFilter>(std::move(*filter)));
+        }
+    }
+
     /// If there is mixed join conditions, need to build the hash join lazily, which rely on the real table join.
     if (!has_mixed_join_condition)
         buildJoin(data, right_sample_block, table_join);
@@ -102,19 +130,112 @@ StorageJoinFromReadBuffer::StorageJoinFromReadBuffer(
         collectAllInputs(data);
 }
 
+MemoryTracker & StorageJoinFromReadBuffer::memoryTracker()
+{
+    static MemoryTracker tracker(&total_memory_tracker, VariableContext::Global);
+    static std::once_flag described;
+    std::call_once(described, [] { tracker.setDescription("(for broadcast hash tables)"); });
+    return tracker;
+}
+
+/// Run task(0), ..., task(tasks - 1) on at most `threads` threads. The threads don't belong to any query, so the
+/// memory of the hash tables is recorded in the broadcast tracker.
+template <typename Task>
+static void runInParallel(size_t tasks, size_t threads, Task && task)
+{
+    std::atomic<size_t> next_task = 0;
+    std::vector<std::exception_ptr> exceptions(threads);
+    auto worker = [&](size_t thread_index)
+    {
+        MemoryTrackerSwitcher switcher(&StorageJoinFromReadBuffer::memoryTracker());
+        try
+        {
+            for (size_t i = next_task++; i < tasks; i = next_task++)
+                task(i);
+        }
+        catch (...)
+        {
+            exceptions[thread_index] = std::current_exception();
+        }
+    };
+
+    std::vector<ThreadFromGlobalPoolNoTracingContextPropagation> workers;
+    workers.reserve(threads);
+    try
+    {
+        for (size_t i = 0; i < threads; ++i)
+            workers.emplace_back(worker, i);
+    }
+    catch (...)
+    {
+        for (auto & thread : workers)
+            thread.join();
+        throw;
+    }
+    for (auto & thread : workers)
+        thread.join();
+    for (const auto & exception : exceptions)
+        if (exception)
+            std::rethrow_exception(exception);
+}
+
+bool StorageJoinFromReadBuffer::canBuildPartitioned(const DB::TableJoin & analyzed_join) const
+{
+    /// The rows of a RIGHT/FULL join which are not joined would have to be collected from all partitions. If the join
+    /// keys can't be matched to the keys of the table, see PartitionedHashJoin::probeKeyNames, a single HashJoin is built.
+    return build_threads > 1 && !key_names.empty() && isInnerOrLeft(analyzed_join.kind()) && analyzed_join.getClauses().size() == 1
+        && analyzed_join.getOnlyClause().key_names_right.size() == key_names.size();
+}
+
 void StorageJoinFromReadBuffer::buildJoin(const Blocks & data, const SharedHeader & header, std::shared_ptr<DB::TableJoin> analyzed_join)
 {
+    if (canBuildPartitioned(*analyzed_join))
+    {
+        buildPartitionedJoin(data, header, analyzed_join);
+        return;
+    }
+
     auto build_join = [&]
     {
+        MemoryTrackerSwitcher switcher(&memoryTracker());
         join = std::make_shared<HashJoin>(analyzed_join, header, overwrite, row_count, "", false);
         for (const Block& block : data)
             join->addBlockToJoin(block, true);
     };
-    /// Record memory usage in Total Memory Tracker
+    /// Record memory usage in the broadcast tracker
     ThreadFromGlobalPoolNoTracingContextPropagation thread(build_join);
     thread.join();
 }
 
+/// Radix partition the blocks by the hash of the join keys, then build one HashJoin per partition, both steps on
+/// build_threads threads. Probe blocks are partitioned by the same hash in PartitionedHashJoin.
+void StorageJoinFromReadBuffer::buildPartitionedJoin(
+    const Blocks & data, const SharedHeader & header, std::shared_ptr<DB::TableJoin> analyzed_join)
+{
+    const size_t partitions = build_threads;
+    std::vector<std::vector<Block>> scattered(data.size());
+    runInParallel(
+        data.size(), partitions, [&](size_t i) { scattered[i] = PartitionedHashJoin::scatterBlock(data[i], key_positions, partitions); });
+
+    std::vector<std::shared_ptr<HashJoin>> joins(partitions);
+    runInParallel(
+        partitions,
+        partitions,
+        [&](size_t partition)
+        {
+            auto partition_join = std::make_shared<HashJoin>(analyzed_join, header, overwrite, row_count / partitions, "", false);
+            for (auto & blocks : scattered)
+            {
+                if (blocks[partition].rows())
+                    partition_join->addBlockToJoin(blocks[partition], true);
+                blocks[partition].clear();
+            }
+            joins[partition] = std::move(partition_join);
+        });
+    partitioned_joins = std::move(joins);
+    LOG_DEBUG(getLogger("StorageJoinFromReadBuffer"), "Built broadcast table {} in {} partitions", storage_metadata.comment, partitions);
+}
+
 void StorageJoinFromReadBuffer::collectAllInputs(Blocks & data)
 {
     for (Block block : data)
@@ -123,38 +244,73 @@ void StorageJoinFromReadBuffer::collectAllInputs(Blocks & data)
 
 void StorageJoinFromReadBuffer::buildJoinLazily(const DB::SharedHeader & header, std::shared_ptr<DB::TableJoin> analyzed_join)
 {
-    auto build_join = [&]
     {
+        std::shared_lock lock(join_mutex);
+        if (join || !partitioned_joins.empty())
+            return;
+    }
+    std::unique_lock lock(join_mutex);
+    if (join || !partitioned_joins.empty())
+        return;
+
+    auto convert_block = [&](const Block & block)
+    {
+        DB::ColumnsWithTypeAndName columns;
+        for (size_t i = 0; i < block.columns(); ++i)
         {
-            std::shared_lock lock(join_mutex);
-            if (join)
-                return;
+            const auto & column = block.getByPosition(i);
+            columns.emplace_back(BlockUtil::convertColumnAsNecessary(column, header->getByPosition(i)));
         }
-        std::unique_lock lock(join_mutex);
-        if (join)
-            return;
+        return DB::Block(columns);
+    };
+
+    if (canBuildPartitioned(*analyzed_join))
+    {
+        Blocks data;
+        data.reserve(input_blocks.size());
+        for (const auto & block : input_blocks)
+            data.emplace_back(convert_block(block));
+        input_blocks.clear();
+        buildPartitionedJoin(data, header, analyzed_join);
+        return;
+    }
+
+    auto build_join = [&]
+    {
+        MemoryTrackerSwitcher switcher(&memoryTracker());
         join = std::make_shared<HashJoin>(analyzed_join, header, overwrite, row_count, "", false);
         while (!input_blocks.empty())
         {
-            auto & block = *input_blocks.begin();
-            DB::ColumnsWithTypeAndName columns;
-            for (size_t i = 0; i < block.columns(); ++i)
-            {
-                const auto & column = block.getByPosition(i);
-                columns.emplace_back(BlockUtil::convertColumnAsNecessary(column, header->getByPosition(i)));
-            }
-            DB::Block final_block(columns);
-            join->addBlockToJoin(final_block, true);
+            join->addBlockToJoin(convert_block(*input_blocks.begin()), true);
             input_blocks.pop_front();
         }
     };
 
-    /// Record memory usage in Total Memory Tracker
+    /// Record memory usage in the broadcast tracker
     ThreadFromGlobalPoolNoTracingContextPropagation thread(build_join);
     thread.join();
 }
 
 
+size_t StorageJoinFromReadBuffer::getMemoryUsage()
+{
+    std::shared_lock lock(join_mutex);
+    size_t bytes = 0;
+    if (join)
+        bytes += join->getTotalByteCount();
+    for (const auto & partition : partitioned_joins)
+        bytes += partition->getTotalByteCount();
+    for (const auto & block : input_blocks)
+        bytes += block.allocatedBytes();
+    return bytes;
+}
+
+JoinKeyRuntimeFilterPtr StorageJoinFromReadBuffer::getRuntimeFilter(const String & key_name) const
+{
+    auto it = runtime_filters.find(key_name);
+    return it == runtime_filters.end() ? nullptr : it->second;
+}
+
 /// The column names of 'right_header' could be different from the ones in `input_blocks`, and we must
 /// use 'right_header' to build the HashJoin. Otherwise, it will cause exceptions with name mismatches.
 ///
@@ -169,6 +325,25 @@ DB::JoinPtr StorageJoinFromReadBuffer::getJoinLocked(std::shared_ptr<DB::TableJo
             "Table {} needs the same join_use_nulls setting as present in LEFT or FULL JOIN",
             storage_metadata.comment);
     buildJoinLazily(right_sample_block, analyzed_join);
+    if (!partitioned_joins.empty())
+    {
+        auto probe_key_names = PartitionedHashJoin::probeKeyNames(*analyzed_join, key_names);
+        if (!probe_key_names)
+            throw Exception(
+                ErrorCodes::LOGICAL_ERROR,
+                "Join keys {} of broadcast table {} don't match the join clause",
+                fmt::join(key_names, ", "),
+                storage_metadata.comment);
+        std::vector<HashJoinPtr> partitions;
+        partitions.reserve(partitioned_joins.size());
+        for (const auto & partition : partitioned_joins)
+        {
+            HashJoinPtr partition_clone = std::make_shared<HashJoin>(analyzed_join, right_sample_block);
+            partition_clone->reuseJoinedData(*partition);
+            partitions.emplace_back(std::move(partition_clone));
+        }
+        return std::make_shared<PartitionedHashJoin>(analyzed_join, std::move(partitions), std::move(*probe_key_names));
+    }
     HashJoinPtr join_clone = std::make_shared<HashJoin>(analyzed_join, right_sample_block);
     /// reuseJoinedData will set the flag `HashJoin::from_storage_join` which is required by `FilledStep`
     join_clone->reuseJoinedData(static_cast<const HashJoin &>(*join));
@@ -16,10 +16,14 @@
  */
 #pragma once
 #include <shared_mutex>
+#include <unordered_map>
 #include <Core/Joins.h>
 #include <Interpreters/JoinUtils.h>
+#include <Join/JoinRuntimeFilter.h>
 #include <Storages/StorageInMemoryMetadata.h>
 
+class MemoryTracker;
+
 namespace DB
 {
 class TableJoin;
@@ -48,7 +52,9 @@ public:
         const String & comment,
         bool overwrite_,
         bool is_null_aware_anti_join_,
-        bool has_null_key_values_);
+        bool has_null_key_values_,
+        size_t build_threads_ = 1,
+        std::optional<size_t> runtime_filter_bloom_filter_max_bytes = std::nullopt);
 
     bool has_null_key_value = false;
     bool is_empty_hash_table = false;
@@ -59,9 +65,23 @@ public:
     DB::JoinPtr getJoinLocked(std::shared_ptr<DB::TableJoin> analyzed_join, DB::ContextPtr context);
     const DB::Block & getRightSampleBlock() const { return *right_sample_block; }
 
+    /// Bytes held by the hash table, or by the blocks waiting for a lazy build. Read when asked, since a lazily built
+    /// hash table replaces the blocks on the first getJoinLocked.
+    size_t getMemoryUsage();
+
+    /// The memory of all broadcast tables on the executor is charged to this tracker, which is a child of the Total
+    /// Memory Tracker. It's switched to in the threads building, reading and releasing them.
+    static MemoryTracker & memoryTracker();
+
+    /// Summary of the build side values of a key column, nullptr if not available. Only collected if the constructor
+    /// is given runtime_filter_bloom_filter_max_bytes.
+    JoinKeyRuntimeFilterPtr getRuntimeFilter(const String & key_name) const;
+
 private:
     DB::StorageInMemoryMetadata storage_metadata;
     DB::Names key_names;
+    /// Positions of key_names in the blocks of the table, which keep them when they are renamed to right_sample_block
+    std::vector<size_t> key_positions;
     bool use_nulls;
     size_t row_count;
     bool overwrite;
@@ -69,11 +89,18 @@ private:
     std::shared_mutex join_mutex;
     std::list<DB::Block> input_blocks;
     std::shared_ptr<DB::HashJoin> join = nullptr;
+    /// If more than one thread is allowed, INNER/LEFT joins are built into this number of partitions in parallel,
+    /// and probed through PartitionedHashJoin instead of `join`.
+    size_t build_threads;
+    std::vector<std::shared_ptr<DB::HashJoin>> partitioned_joins;
     bool is_null_aware_anti_join;
+    std::unordered_map<String, JoinKeyRuntimeFilterPtr> runtime_filters;
 
     void readAllBlocksFromInput(DB::ReadBuffer & in);
     void buildJoin(const DB::Blocks & data, const DB::SharedHeader & header, std::shared_ptr<DB::TableJoin> analyzed_join);
     void collectAllInputs(DB::Blocks & data);
     void buildJoinLazily(const DB::SharedHeader & header, std::shared_ptr<DB::TableJoin> analyzed_join);
+    bool canBuildPartitioned(const DB::TableJoin & analyzed_join) const;
+    void buildPartitionedJoin(const DB::Blocks & data, const DB::SharedHeader & header, std::shared_ptr<DB::TableJoin> analyzed_join);
 };
 }
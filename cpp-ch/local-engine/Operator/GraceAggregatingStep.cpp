@@ -23,6 +23,7 @@
 #include <QueryPipeline/QueryPipelineBuilder.h>
 #include <Common/BlockTypeUtils.h>
 #include <Common/CHUtil.h>
+#include <Common/GlutenConfig.h>
 
 namespace DB::ErrorCodes
 {
@@ -65,16 +66,23 @@ void GraceAggregatingStep::transformPipeline(DB::QueryPipelineBuilder & pipeline
     }
     auto num_streams = pipeline.getNumStreams();
     auto transform_params = std::make_shared<DB::AggregatingTransformParams>(pipeline.getSharedHeader(), params, false);
+    auto merging_parallelism = GraceMergingAggregateConfig::loadFromContext(context).grace_aggregate_merging_parallelism;
     pipeline.resize(1);
     auto build_transform = [&](DB::OutputPortRawPtrs outputs)
     {
         DB::Processors new_processors;
         for (auto & output : outputs)
         {
-            auto op
-                = std::make_shared<GraceAggregatingTransform>(pipeline.getSharedHeader(), transform_params, context, no_pre_aggregated, false);
+            auto op = std::make_shared<GraceAggregatingTransform>(
+                pipeline.getSharedHeader(), transform_params, context, no_pre_aggregated, false, merging_parallelism);
             new_processors.push_back(op);
             DB::connect(*output, op->getInputs().front());
+            for (auto it = std::next(op->getOutputs().begin()); it != op->getOutputs().end(); ++it)
+            {
+                auto merging_op = std::make_shared<GraceBucketMergingTransform>(transform_params, no_pre_aggregated, false);
+                new_processors.push_back(merging_op);
+                DB::connect(*it, merging_op->getInputs().front());
+            }
         }
         return new_processors;
     };
@@ -22,6 +22,7 @@
 #include <Common/CHUtil.h>
 #include <Common/CurrentThread.h>
 #include <Common/GlutenConfig.h>
+#include <Common/MemoryTracker.h>
 #include <Common/QueryContext.h>
 #include <Common/formatReadable.h>
 
@@ -32,13 +33,24 @@ extern const int LOGICAL_ERROR;
 
 namespace local_engine
 {
+static DB::OutputPorts buildOutputPorts(const DB::AggregatingTransformParamsPtr & params, size_t merging_parallelism)
+{
+    DB::OutputPorts output_ports;
+    output_ports.emplace_back(toShared(params->getHeader()));
+    /// The spilled buckets are passed in chunk infos, without any column.
+    for (size_t i = 0; i < merging_parallelism; ++i)
+        output_ports.emplace_back(toShared(DB::Block{}));
+    return output_ports;
+}
+
 GraceAggregatingTransform::GraceAggregatingTransform(
     const DB::SharedHeader & header_,
     DB::AggregatingTransformParamsPtr params_,
     DB::ContextPtr context_,
     bool no_pre_aggregated_,
-    bool final_output_)
-    : IProcessor({header_}, {params_->getHeader()})
+    bool final_output_,
+    size_t merging_parallelism_)
+    : IProcessor({header_}, buildOutputPorts(params_, merging_parallelism_))
     , header(header_)
     , params(params_)
     , context(context_)
@@ -47,6 +59,7 @@ GraceAggregatingTransform::GraceAggregatingTransform(
     , no_pre_aggregated(no_pre_aggregated_)
     , final_output(final_output_)
     , tmp_data_disk(context_->getTempDataOnDisk())
+    , merging_parallelism(merging_parallelism_)
 {
     output_header = params->getHeader();
     auto config = GraceMergingAggregateConfig::loadFromContext(context);
@@ -90,8 +103,11 @@ GraceAggregatingTransform::Status GraceAggregatingTransform::prepare()
     if (output.isFinished() || isCancelled())
     {
         input.close();
+        for (auto & bucket_output : outputs)
+            bucket_output.finish();
         return Status::Finished;
     }
+    bool merging_outputs_finished = pushMergingBuckets();
     if (has_output)
     {
         if (output.canPush())
@@ -137,8 +153,14 @@ GraceAggregatingTransform::Status GraceAggregatingTransform::prepare()
         return Status::Ready;
     }
 
+    if (merging_parallelism && !merging_buckets_prepared)
+        return Status::Ready;
+
     if (current_bucket_index >= getBucketsNum() && (!block_converter || !block_converter->hasNext()))
     {
+        /// Wait for the merging transforms to take the remaining spilled buckets
+        if (!merging_outputs_finished)
+            return Status::PortFull;
         output.finish();
         return Status::Finished;
     }
@@ -157,6 +179,11 @@ void GraceAggregatingTransform::work()
     else
     {
         assert(input_finished);
+        if (merging_parallelism && !merging_buckets_prepared)
+        {
+            prepareMergingBuckets();
+            return;
+        }
         if (!block_converter || !block_converter->hasNext())
         {
             block_converter = nullptr;
@@ -292,6 +319,8 @@ void GraceAggregatingTransform::addBlockIntoFileBucket(size_t bucket_index, cons
     }
     auto & file_stream = buckets[bucket_index];
     file_stream.pending_bytes += block.allocatedBytes();
+    file_stream.total_bytes += block.allocatedBytes();
+    file_stream.min_scattered_buckets = std::min(file_stream.min_scattered_buckets, block.info.bucket_num);
     if (is_original_block && no_pre_aggregated)
         file_stream.original_blocks.push_back(block);
     else
@@ -365,25 +394,18 @@ size_t GraceAggregatingTransform::flushBucket(size_t bucket_index)
     return flush_bytes;
 }
 
-std::unique_ptr<AggregateDataBlockConverter> GraceAggregatingTransform::prepareBucketOutputBlocks(size_t bucket_index)
+void GraceAggregatingTransform::readBucketBlocks(
+    BufferFileStream & file_stream,
+    const std::function<void(const DB::Block & block, bool is_original_block)> & callback,
+    size_t & read_bytes,
+    size_t & read_rows)
 {
-    auto & buffer_file_stream = buckets[bucket_index];
-    if (!current_data_variants && !buffer_file_stream.intermediate_file_stream && buffer_file_stream.intermediate_blocks.empty()
-        && !buffer_file_stream.original_file_stream && buffer_file_stream.original_blocks.empty())
+    auto read_file_stream = [&](std::optional<DB::TemporaryBlockStreamHolder> & tmp_stream, bool is_original_block)
     {
-        return nullptr;
-    }
-
-    size_t read_bytes = 0;
-    size_t read_rows = 0;
-    Stopwatch watch;
-
-    checkAndSetupCurrentDataVariants();
-
-    if (buffer_file_stream.intermediate_file_stream)
-    {
-        buffer_file_stream.intermediate_file_stream->finishWriting();
-        auto reader = buffer_file_stream.intermediate_file_stream->getReadStream();
+        if (!tmp_stream)
+            return;
+        tmp_stream.value()->finishWriting();
+        auto reader = tmp_stream.value()->getReadStream();
         while (true)
         {
             auto block = reader->read();
@@ -391,47 +413,51 @@ std::unique_ptr<AggregateDataBlockConverter> GraceAggregatingTransform::prepareB
                 break;
             read_bytes += block.bytes();
             read_rows += block.rows();
-            mergeOneBlock(block, false);
-            block = {};
+            callback(block, is_original_block);
         }
-        buffer_file_stream.intermediate_file_stream.reset();
-        total_read_disk_time += watch.elapsedMilliseconds();
-    }
-    if (!buffer_file_stream.intermediate_blocks.empty())
+        tmp_stream.reset();
+    };
+    auto read_blocks = [&](std::list<DB::Block> & blocks, bool is_original_block)
     {
-        for (auto & block : buffer_file_stream.intermediate_blocks)
+        while (!blocks.empty())
         {
-            mergeOneBlock(block, false);
-            block = {};
+            auto block = std::move(blocks.front());
+            blocks.pop_front();
+            callback(block, is_original_block);
         }
-    }
+    };
 
-    if (buffer_file_stream.original_file_stream)
-    {
-        buffer_file_stream.original_file_stream->finishWriting();
-        auto reader = buffer_file_stream.original_file_stream->getReadStream();
-        while (true)
-        {
-            auto block = reader->read();
-            if (!block.rows())
-                break;
-            read_bytes += block.bytes();
-            read_rows += block.rows();
-            mergeOneBlock(block, true);
-            block = {};
-        }
-        buffer_file_stream.original_file_stream.reset();
-        total_read_disk_time += watch.elapsedMilliseconds();
-    }
-    if (!buffer_file_stream.original_blocks.empty())
+    read_file_stream(file_stream.intermediate_file_stream, false);
+    read_blocks(file_stream.intermediate_blocks, false);
+    read_file_stream(file_stream.original_file_stream, true);
+    read_blocks(file_stream.original_blocks, true);
+    file_stream.pending_bytes = 0;
+}
+
+std::unique_ptr<AggregateDataBlockConverter> GraceAggregatingTransform::prepareBucketOutputBlocks(size_t bucket_index)
+{
+    auto & buffer_file_stream = buckets[bucket_index];
+    if (!current_data_variants && !buffer_file_stream.intermediate_file_stream && buffer_file_stream.intermediate_blocks.empty()
+        && !buffer_file_stream.original_file_stream && buffer_file_stream.original_blocks.empty())
     {
-        for (auto & block : buffer_file_stream.original_blocks)
-        {
-            mergeOneBlock(block, true);
-            block = {};
-        }
+        return nullptr;
     }
 
+    size_t read_bytes = 0;
+    size_t read_rows = 0;
+    Stopwatch watch;
+
+    checkAndSetupCurrentDataVariants();
+
+    bool from_disk = buffer_file_stream.intermediate_file_stream || buffer_file_stream.original_file_stream;
+    readBucketBlocks(
+        buffer_file_stream,
+        [&](const DB::Block & block, bool is_original_block) { mergeOneBlock(block, is_original_block); },
+        read_bytes,
+        read_rows);
+    if (from_disk)
+        total_read_disk_time += watch.elapsedMilliseconds();
+
     auto last_data_variants_size = current_data_variants->size();
     auto converter = currentDataVariantToBlockConverter(final_output);
     LOG_INFO(
@@ -631,4 +657,282 @@ bool GraceAggregatingTransform::spillOnSize(size_t bytes)
     return true;
 }
 
+
+void GraceAggregatingTransform::prepareMergingBuckets()
+{
+    merging_buckets_prepared = true;
+    const auto buckets_num = getBucketsNum();
+    if (buckets_num == 1)
+        return;
+
+    Stopwatch watch;
+    /// Blocks scattered before the buckets were extended only contain keys of buckets with greater indexes, so
+    /// redistributing them in the index order leaves every bucket with blocks scattered by buckets_num.
+    for (size_t i = 1; i < buckets_num; ++i)
+    {
+        auto & file_stream = buckets[i];
+        if (file_stream.min_scattered_buckets >= static_cast<Int32>(buckets_num))
+            continue;
+        auto stale_stream = std::move(file_stream);
+        file_stream = BufferFileStream();
+        size_t read_bytes = 0;
+        size_t read_rows = 0;
+        readBucketBlocks(
+            stale_stream,
+            [&](const DB::Block & block, bool is_original_block)
+            {
+                if (block.info.bucket_num == static_cast<Int32>(buckets_num))
+                {
+                    addBlockIntoFileBucket(i, block, is_original_block);
+                    return;
+                }
+                auto scattered_blocks = scatterBlock(block);
+                for (size_t j = 0; j < i; ++j)
+                {
+                    if (scattered_blocks[j].rows())
+                        throw DB::Exception(
+                            DB::ErrorCodes::LOGICAL_ERROR, "Scattered blocks of bucket {} should not belong to bucket {}", i, j);
+                }
+                for (size_t j = i; j < buckets_num; ++j)
+                    addBlockIntoFileBucket(j, scattered_blocks[j], is_original_block);
+            },
+            read_bytes,
+            read_rows);
+    }
+
+    size_t memory_limit = 0;
+    size_t free_bytes = 0;
+    if (auto thread_group = DB::CurrentThread::getGroup())
+    {
+        auto memory_soft_limit = thread_group->memory_tracker.getSoftLimit();
+        if (memory_soft_limit)
+        {
+            memory_limit = static_cast<size_t>(memory_soft_limit * max_allowed_memory_usage_ratio);
+            auto current_mem_used = currentThreadGroupMemoryUsage();
+            free_bytes = memory_limit > current_mem_used ? memory_limit - current_mem_used : 1;
+        }
+    }
+    for (size_t i = 1; i < buckets_num; ++i)
+    {
+        /// Such a bucket may need to be split again while it's merged, which is only done by this transform.
+        if (free_bytes && buckets[i].total_bytes > free_bytes)
+        {
+            LOG_INFO(
+                logger,
+                "Bucket {} with {} is larger than the free memory {}, merge the spilled buckets one by one",
+                i,
+                ReadableSize(buckets[i].total_bytes),
+                ReadableSize(free_bytes));
+            return;
+        }
+    }
+
+    auto budget = std::make_shared<GraceMergingBudget>(memory_limit);
+    for (size_t i = 1; i < buckets_num; ++i)
+    {
+        auto & file_stream = buckets[i];
+        if (!file_stream.total_bytes)
+            continue;
+        auto bucket = std::make_shared<GraceMergingBucket>();
+        bucket->bucket_index = i;
+        bucket->bytes = file_stream.total_bytes;
+        bucket->file_stream = std::make_shared<BufferFileStream>(std::move(file_stream));
+        bucket->budget = budget;
+        merging_buckets.emplace_back(std::move(bucket));
+    }
+    /// Only the in-memory bucket is left to this transform
+    for (size_t i = 1; i < buckets_num; ++i)
+        buckets.erase(i);
+    LOG_INFO(
+        logger,
+        "Hand over {} spilled buckets to {} merging transforms, memory limit: {}, time: {} ms",
+        merging_buckets.size(),
+        merging_parallelism,
+        ReadableSize(memory_limit),
+        watch.elapsedMilliseconds());
+}
+
+bool GraceAggregatingTransform::pushMergingBuckets()
+{
+    if (!merging_parallelism)
+        return true;
+    if (!merging_buckets_prepared)
+        return false;
+
+    bool all_finished = true;
+    for (auto it = std::next(outputs.begin()); it != outputs.end(); ++it)
+    {
+        auto & bucket_output = *it;
+        if (bucket_output.isFinished())
+            continue;
+        if (merging_buckets.empty())
+        {
+            bucket_output.finish();
+            continue;
+        }
+        all_finished = false;
+        if (!bucket_output.canPush())
+            continue;
+        auto & bucket = merging_buckets.front();
+        auto reservation = bucket->budget->tryAcquire(bucket->bytes, currentThreadGroupMemoryUsage());
+        if (!reservation)
+            continue;
+        bucket->reservation = *reservation;
+        DB::Chunk chunk;
+        chunk.getChunkInfos().add(std::move(bucket));
+        merging_buckets.pop_front();
+        bucket_output.push(std::move(chunk));
+    }
+    return all_finished;
+}
+
+size_t GraceMergingBudget::estimate(size_t spilled_bytes) const
+{
+    std::lock_guard lock(mutex);
+    if (!merged_spilled_bytes || !merged_used_bytes)
+        return spilled_bytes;
+    return static_cast<size_t>(static_cast<double>(spilled_bytes) * merged_used_bytes / merged_spilled_bytes);
+}
+
+std::optional<GraceMergingBudget::Reservation> GraceMergingBudget::tryAcquire(size_t spilled_bytes, size_t memory_usage)
+{
+    auto bytes = estimate(spilled_bytes);
+    std::lock_guard lock(mutex);
+    /// The bytes already used by the hash tables are part of memory_usage.
+    if (memory_limit && acquired_buckets && memory_usage + (reserved_bytes - used_bytes) + bytes > memory_limit)
+        return {};
+    ++acquired_buckets;
+    reserved_bytes += bytes;
+    return Reservation{.spilled_bytes = spilled_bytes, .reserved_bytes = bytes, .used_bytes = 0};
+}
+
+void GraceMergingBudget::update(Reservation & reservation, size_t used)
+{
+    std::lock_guard lock(mutex);
+    used_bytes = used_bytes - reservation.used_bytes + used;
+    reservation.used_bytes = used;
+    if (used > reservation.reserved_bytes)
+    {
+        reserved_bytes += used - reservation.reserved_bytes;
+        reservation.reserved_bytes = used;
+    }
+}
+
+void GraceMergingBudget::release(const Reservation & reservation)
+{
+    std::lock_guard lock(mutex);
+    --acquired_buckets;
+    reserved_bytes -= reservation.reserved_bytes;
+    used_bytes -= reservation.used_bytes;
+    merged_spilled_bytes += reservation.spilled_bytes;
+    merged_used_bytes += reservation.used_bytes;
+}
+
+GraceBucketMergingTransform::GraceBucketMergingTransform(
+    DB::AggregatingTransformParamsPtr params_, bool no_pre_aggregated_, bool final_output_)
+    : IProcessor({toShared(DB::Block{})}, {params_->getHeader()})
+    , params(params_)
+    , no_pre_aggregated(no_pre_aggregated_)
+    , final_output(final_output_)
+    , key_columns(params_->params.keys_size)
+    , aggregate_columns(params_->params.aggregates_size)
+{
+}
+
+GraceBucketMergingTransform::Status GraceBucketMergingTransform::prepare()
+{
+    auto & output = outputs.front();
+    auto & input = inputs.front();
+    if (output.isFinished() || isCancelled())
+    {
+        input.close();
+        return Status::Finished;
+    }
+    if (has_output)
+    {
+        if (!output.canPush())
+            return Status::PortFull;
+        output.push(std::move(output_chunk));
+        has_output = false;
+    }
+
+    if (current_bucket)
+        return Status::Ready;
+
+    if (input.isFinished())
+    {
+        output.finish();
+        return Status::Finished;
+    }
+    /// Only ask for the next bucket once the current one is output, the budget is released by then.
+    input.setNeeded();
+    if (!input.hasData())
+        return Status::NeedData;
+    auto chunk = input.pull(true);
+    current_bucket = chunk.getChunkInfos().get<GraceMergingBucket>();
+    if (!current_bucket)
+        throw DB::Exception(DB::ErrorCodes::LOGICAL_ERROR, "Chunk without GraceMergingBucket");
+    reservation = current_bucket->reservation;
+    return Status::Ready;
+}
+
+void GraceBucketMergingTransform::work()
+{
+    if (!block_converter)
+    {
+        Stopwatch watch;
+        auto data_variants = std::make_shared<DB::AggregatedDataVariants>();
+        bool no_more_keys = false;
+        size_t read_bytes = 0;
+        size_t read_rows = 0;
+        /// The whole bucket is merged in this call, so the growth of the thread's memory is what its hash table takes.
+        auto * memory_tracker = DB::CurrentThread::getMemoryTracker();
+        const Int64 memory_before = memory_tracker ? memory_tracker->get() : 0;
+        GraceAggregatingTransform::readBucketBlocks(
+            *current_bucket->file_stream,
+            [&](const DB::Block & block, bool is_original_block)
+            {
+                if (is_original_block && no_pre_aggregated)
+                    params->aggregator.executeOnBlock(block, *data_variants, key_columns, aggregate_columns, no_more_keys);
+                else
+                    params->aggregator.mergeOnBlock(block, *data_variants, no_more_keys, is_cancelled);
+                size_t used_bytes = data_variants->aggregates_pool ? data_variants->aggregates_pool->allocatedBytes() : 0;
+                if (memory_tracker)
+                    used_bytes = std::max(used_bytes, static_cast<size_t>(std::max<Int64>(memory_tracker->get() - memory_before, 0)));
+                current_bucket->budget->update(reservation, used_bytes);
+            },
+            read_bytes,
+            read_rows);
+        LOG_INFO(
+            logger,
+            "Merged bucket {}, aggregated result keys: {}, read bytes from disk: {}, read rows: {}, hash table bytes: {}, reserved "
+            "bytes: {}, time: {} ms",
+            current_bucket->bucket_index,
+            data_variants->size(),
+            ReadableSize(read_bytes),
+            read_rows,
+            ReadableSize(reservation.used_bytes),
+            ReadableSize(reservation.reserved_bytes),
+            watch.elapsedMilliseconds());
+        block_converter = std::make_unique<AggregateDataBlockConverter>(params->aggregator, data_variants, final_output);
+    }
+
+    while (block_converter->hasNext())
+    {
+        auto block = block_converter->next();
+        if (!block.rows())
+            continue;
+        output_chunk = DB::Chunk(block.getColumns(), block.rows());
+        has_output = true;
+        break;
+    }
+
+    if (!block_converter->hasNext())
+    {
+        block_converter = nullptr;
+        current_bucket->budget->release(reservation);
+        current_bucket = nullptr;
+    }
+}
+
 }
@@ -15,6 +15,11 @@
  * limitations under the License.
  */
 #pragma once
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
 #include <Core/Block.h>
 #include <Interpreters/Aggregator.h>
 #include <Interpreters/Context.h>
@@ -29,11 +34,18 @@
 
 namespace local_engine
 {
+class GraceMergingBudget;
+struct GraceMergingBucket;
+
 /**
  * GraceAggregatingTransform is use to aggregate original data or merging intermediate aggregating result. It support spilling data into disk
  * when the memory usage is over limit.
  * If the input data is original data, no_pre_aggregated is true. If it's intermediate aggregating result, no_pre_aggregated is false.
  * IF the output data is final aggregating result, final is true, otherwise it false.
+ *
+ * With merging_parallelism > 0, there are merging_parallelism more outputs, each one connected to a GraceBucketMergingTransform.
+ * Once the input is finished, the spilled buckets are handed over to them through these outputs and merged concurrently,
+ * while this transform only outputs the in-memory bucket.
  */
 class GraceAggregatingTransform : public DB::IProcessor
 {
@@ -44,13 +56,38 @@ public:
         DB::AggregatingTransformParamsPtr params_,
         DB::ContextPtr context_,
         bool no_pre_aggregated_,
-        bool final_output_);
+        bool final_output_,
+        size_t merging_parallelism_ = 0);
     ~GraceAggregatingTransform() override;
 
     Status prepare() override;
     void work() override;
     String getName() const override { return "GraceAggregatingTransform"; }
 
+    struct BufferFileStream
+    {
+        /// store the intermediate result blocks.
+        std::list<DB::Block> intermediate_blocks;
+        /// Only be used when there is no pre-aggregated step, store the original input blocks.
+        std::list<DB::Block> original_blocks;
+        /// store the intermediate result blocks.
+        std::optional<DB::TemporaryBlockStreamHolder> intermediate_file_stream;
+        /// Only be used when there is no pre-aggregated step
+        std::optional<DB::TemporaryBlockStreamHolder> original_file_stream;
+        size_t pending_bytes = 0;
+        /// Bytes of all blocks added into this bucket, in memory or on disk.
+        size_t total_bytes = 0;
+        /// The smallest number of buckets that the blocks of this bucket were scattered by.
+        Int32 min_scattered_buckets = std::numeric_limits<Int32>::max();
+    };
+
+    /// Read all blocks of a bucket, the blocks in memory are released after they are read.
+    static void readBucketBlocks(
+        BufferFileStream & file_stream,
+        const std::function<void(const DB::Block & block, bool is_original_block)> & callback,
+        size_t & read_bytes,
+        size_t & read_rows);
+
 private:
     bool no_pre_aggregated;
     bool final_output;
@@ -77,18 +114,6 @@ private:
     // configured by max_pending_flush_blocks_per_grace_merging_bucket
     size_t max_pending_flush_blocks_per_bucket = 0;
 
-    struct BufferFileStream
-    {
-        /// store the intermediate result blocks.
-        std::list<DB::Block> intermediate_blocks;
-        /// Only be used when there is no pre-aggregated step, store the original input blocks.
-        std::list<DB::Block> original_blocks;
-        /// store the intermediate result blocks.
-        std::optional<DB::TemporaryBlockStreamHolder> intermediate_file_stream;
-        /// Only be used when there is no pre-aggregated step
-        std::optional<DB::TemporaryBlockStreamHolder> original_file_stream;
-        size_t pending_bytes = 0;
-    };
     std::unordered_map<size_t, BufferFileStream> buckets;
 
     size_t getBucketsNum() const { return buckets.size(); }
@@ -108,6 +133,16 @@ private:
     /// Merge one block into current_data_variants.
     void mergeOneBlock(const DB::Block & block, bool is_original_block);
 
+    /// Parallel merging of the spilled buckets.
+    size_t merging_parallelism = 0;
+    bool merging_buckets_prepared = false;
+    std::deque<std::shared_ptr<GraceMergingBucket>> merging_buckets;
+    /// Re-scatter the blocks which were scattered by fewer buckets, so that every spilled bucket can be merged on its own,
+    /// then move the spilled buckets into merging_buckets. Nothing is moved if one of them is larger than the free memory.
+    void prepareMergingBuckets();
+    /// Push merging_buckets into the outputs which need data, returns true when all these outputs are finished.
+    bool pushMergingBuckets();
+
     // spill control
     bool isMemoryOverflow();
     DB::ProcessorMemoryStats getMemoryStats() override;
@@ -139,4 +174,79 @@ private:
 
     Poco::Logger * logger = &Poco::Logger::get("GraceMergingAggregatedTransform");
 };
+
+/// Memory of the hash tables merging the spilled buckets at the same time, shared by the GraceBucketMergingTransforms of one
+/// GraceAggregatingTransform. The memory of a bucket is estimated from the spilled bytes, scaled by the hash table bytes per
+/// spilled byte of the buckets merged so far, and replaced by the bytes its hash table really takes while it's merged.
+class GraceMergingBudget
+{
+public:
+    struct Reservation
+    {
+        size_t spilled_bytes = 0;
+        /// At least the bytes the hash table takes so far.
+        size_t reserved_bytes = 0;
+        size_t used_bytes = 0;
+    };
+
+    /// memory_limit_ is the soft limit of the query memory while merging, 0 means no limit.
+    explicit GraceMergingBudget(size_t memory_limit_) : memory_limit(memory_limit_) { }
+
+    /// Estimated hash table bytes of a bucket with spilled_bytes.
+    size_t estimate(size_t spilled_bytes) const;
+    /// Refused if the query memory, the reserved bytes not used yet and the estimation exceed the limit. A bucket is always
+    /// accepted if no other bucket is being merged.
+    std::optional<Reservation> tryAcquire(size_t spilled_bytes, size_t memory_usage);
+    /// Record the bytes the hash table of a bucket takes while it's merged, the reservation grows with them.
+    void update(Reservation & reservation, size_t used_bytes);
+    void release(const Reservation & reservation);
+
+private:
+    mutable std::mutex mutex;
+    size_t memory_limit;
+    size_t acquired_buckets = 0;
+    size_t reserved_bytes = 0;
+    size_t used_bytes = 0;
+    size_t merged_spilled_bytes = 0;
+    size_t merged_used_bytes = 0;
+};
+
+/// A spilled bucket handed over to a GraceBucketMergingTransform, all its blocks are scattered by the final number of buckets.
+struct GraceMergingBucket : public DB::ChunkInfoCloneable<GraceMergingBucket>
+{
+    size_t bucket_index = 0;
+    size_t bytes = 0;
+    std::shared_ptr<GraceAggregatingTransform::BufferFileStream> file_stream;
+    std::shared_ptr<GraceMergingBudget> budget;
+    GraceMergingBudget::Reservation reservation;
+};
+
+/// Merge the spilled buckets received from a GraceAggregatingTransform one by one. The memory the hash table takes is checked
+/// after each merged block and reported to the budget.
+class GraceBucketMergingTransform : public DB::IProcessor
+{
+public:
+    using Status = DB::IProcessor::Status;
+    GraceBucketMergingTransform(DB::AggregatingTransformParamsPtr params_, bool no_pre_aggregated_, bool final_output_);
+    ~GraceBucketMergingTransform() override = default;
+
+    Status prepare() override;
+    void work() override;
+    String getName() const override { return "GraceBucketMergingTransform"; }
+
+private:
+    DB::AggregatingTransformParamsPtr params;
+    bool no_pre_aggregated;
+    bool final_output;
+    DB::ColumnRawPtrs key_columns;
+    DB::Aggregator::AggregateColumns aggregate_columns;
+
+    std::shared_ptr<const GraceMergingBucket> current_bucket;
+    GraceMergingBudget::Reservation reservation;
+    std::unique_ptr<AggregateDataBlockConverter> block_converter;
+    bool has_output = false;
+    DB::Chunk output_chunk;
+
+    Poco::Logger * logger = &Poco::Logger::get("GraceBucketMergingTransform");
+};
 }
@@ -21,6 +21,7 @@
 #include <QueryPipeline/QueryPipelineBuilder.h>
 #include <Common/BlockTypeUtils.h>
 #include <Common/CHUtil.h>
+#include <Common/GlutenConfig.h>
 
 namespace DB
 {
@@ -67,15 +68,23 @@ void GraceMergingAggregatedStep::transformPipeline(DB::QueryPipelineBuilder & pi
     }
     auto num_streams = pipeline.getNumStreams();
     auto transform_params = std::make_shared<DB::AggregatingTransformParams>(pipeline.getSharedHeader(), params, true);
+    auto merging_parallelism = GraceMergingAggregateConfig::loadFromContext(context).grace_aggregate_merging_parallelism;
     pipeline.resize(1);
     auto build_transform = [&](DB::OutputPortRawPtrs outputs)
     {
         DB::Processors new_processors;
         for (auto & output : outputs)
         {
-            auto op = std::make_shared<GraceAggregatingTransform>(pipeline.getSharedHeader(), transform_params, context, no_pre_aggregated, true);
+            auto op = std::make_shared<GraceAggregatingTransform>(
+                pipeline.getSharedHeader(), transform_params, context, no_pre_aggregated, true, merging_parallelism);
             new_processors.push_back(op);
             DB::connect(*output, op->getInputs().front());
+            for (auto it = std::next(op->getOutputs().begin()); it != op->getOutputs().end(); ++it)
+            {
+                auto merging_op = std::make_shared<GraceBucketMergingTransform>(transform_params, no_pre_aggregated, true);
+                new_processors.push_back(merging_op);
+                DB::connect(*it, merging_op->getInputs().front());
+            }
         }
         return new_processors;
     };
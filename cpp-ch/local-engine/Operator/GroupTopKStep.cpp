@@ -0,0 +1,469 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "GroupTopKStep.h"
+
+#include <algorithm>
+#include <Columns/ColumnsNumber.h>
+#include <Columns/IColumn.h>
+#include <Core/Defines.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Interpreters/Context.h>
+#include <Processors/Port.h>
+#include <QueryPipeline/QueryPipelineBuilder.h>
+#include <Common/BlockTypeUtils.h>
+#include <Common/CurrentThread.h>
+#include <Common/GlutenConfig.h>
+#include <Common/WeakHash.h>
+#include <Common/logger_useful.h>
+
+namespace local_engine
+{
+static DB::ITransformingStep::Traits getTraits()
+{
+    return DB::ITransformingStep::Traits{
+        {
+            .preserves_number_of_streams = false,
+            .preserves_sorting = false,
+        },
+        {
+            .preserves_number_of_rows = false,
+        }};
+}
+
+GroupTopKStep::GroupTopKStep(
+    const DB::ContextPtr & context_,
+    const DB::SharedHeader & input_header_,
+    const std::vector<size_t> & partition_columns_,
+    const DB::SortDescription & sort_description_,
+    size_t limit_)
+    : DB::ITransformingStep(input_header_, toShared(buildOutputHeader(*input_header_)), getTraits())
+    , context(context_)
+    , partition_columns(partition_columns_)
+    , sort_description(sort_description_)
+    , limit(limit_)
+{
+}
+
+DB::Block GroupTopKStep::buildOutputHeader(const DB::Block & input_header)
+{
+    auto output_header = input_header.cloneEmpty();
+    output_header.insert(DB::ColumnWithTypeAndName(std::make_shared<DB::DataTypeUInt64>(), "row_number"));
+    return output_header;
+}
+
+void GroupTopKStep::updateOutputHeader()
+{
+    output_header = toShared(buildOutputHeader(*input_headers.front()));
+}
+
+void GroupTopKStep::describePipeline(DB::IQueryPlanStep::FormatSettings & settings) const
+{
+    if (!processors.empty())
+        DB::IQueryPlanStep::describePipeline(processors, settings);
+}
+
+void GroupTopKStep::transformPipeline(DB::QueryPipelineBuilder & pipeline, const DB::BuildQueryPipelineSettings & /*settings*/)
+{
+    const auto spill_mem_ratio = MemoryConfig::loadFromContext(context).spill_mem_ratio;
+    if (pipeline.getNumStreams() > 1)
+    {
+        pipeline.addSimpleTransform(
+            [&](const DB::SharedHeader & header)
+            {
+                return std::make_shared<GroupTopKTransform>(
+                    header, partition_columns, sort_description, limit, false, spill_mem_ratio, nullptr);
+            });
+        pipeline.resize(1);
+    }
+    pipeline.addSimpleTransform(
+        [&](const DB::SharedHeader & header)
+        {
+            return std::make_shared<GroupTopKTransform>(
+                header, partition_columns, sort_description, limit, true, spill_mem_ratio, context->getTempDataOnDisk());
+        });
+}
+
+GroupTopKTransform::GroupTopKTransform(
+    const DB::SharedHeader & input_header_,
+    const std::vector<size_t> & partition_columns_,
+    const DB::SortDescription & sort_description_,
+    size_t limit_,
+    bool final_,
+    double spill_mem_ratio_,
+    DB::TemporaryDataOnDiskScopePtr tmp_data_disk_,
+    size_t max_rows_before_spill_)
+    : DB::IProcessor({input_header_}, {final_ ? toShared(GroupTopKStep::buildOutputHeader(*input_header_)) : input_header_})
+    , input_header(input_header_)
+    , partition_columns(partition_columns_)
+    , limit(std::max<size_t>(limit_, 1))
+    , final(final_)
+    , spill_mem_ratio(spill_mem_ratio_)
+    , tmp_data_disk(std::move(tmp_data_disk_))
+    , max_rows_before_spill(max_rows_before_spill_)
+{
+    for (const auto & sort_column : sort_description_)
+    {
+        sort_columns.push_back(input_header->getPositionByName(sort_column.column_name));
+        sort_directions.push_back(sort_column.direction);
+        nulls_directions.push_back(sort_column.nulls_direction);
+    }
+}
+
+GroupTopKTransform::Status GroupTopKTransform::prepare()
+{
+    auto & output = outputs.front();
+    auto & input = inputs.front();
+    if (output.isFinished())
+    {
+        input.close();
+        return Status::Finished;
+    }
+
+    if (has_output)
+    {
+        if (!output.canPush())
+            return Status::PortFull;
+        output.push(std::move(output_chunk));
+        has_output = false;
+    }
+
+    /// Emit the flushed candidates before taking more input
+    if (has_input || hasPendingOutput())
+        return Status::Ready;
+
+    if (!input_finished)
+    {
+        if (!input.isFinished())
+        {
+            input.setNeeded();
+            if (!input.hasData())
+                return Status::NeedData;
+            input_chunk = input.pull(true);
+            has_input = true;
+            return Status::Ready;
+        }
+        input_finished = true;
+    }
+
+    if (!output_prepared || hasMoreBuckets())
+        return Status::Ready;
+
+    output.finish();
+    return Status::Finished;
+}
+
+void GroupTopKTransform::work()
+{
+    if (has_input)
+    {
+        addRows(input_chunk.getColumns(), input_chunk.getNumRows());
+        input_chunk.clear();
+        has_input = false;
+        if (isMemoryShort())
+        {
+            if (final)
+                spill();
+            else
+                prepareOutput();
+        }
+    }
+    else if (input_finished && !output_prepared)
+    {
+        output_prepared = true;
+        if (spilled_buckets.empty())
+            prepareOutput();
+        else
+            spill();
+    }
+
+    while (!hasPendingOutput() && output_prepared && hasMoreBuckets())
+    {
+        loadBucket(next_bucket++);
+        prepareOutput();
+    }
+
+    if (hasPendingOutput())
+    {
+        output_chunk = generateOutputChunk();
+        has_output = true;
+    }
+}
+
+void GroupTopKTransform::addRows(const DB::Columns & input_columns, size_t num_rows)
+{
+    if (!num_rows)
+        return;
+
+    DB::Columns columns;
+    columns.reserve(input_columns.size());
+    for (const auto & column : input_columns)
+        columns.push_back(column->convertToFullColumnIfConst());
+    if (rows.empty())
+        rows = input_header->cloneEmptyColumns();
+
+    DB::WeakHash32 hash(num_rows);
+    for (const auto column : partition_columns)
+        hash.update(columns[column]->getWeakHash32());
+    const auto & hashes = hash.getData();
+
+    auto less = [this](UInt64 lhs, UInt64 rhs) { return compareStored(lhs, rhs) < 0; };
+    for (size_t i = 0; i < num_rows; ++i)
+    {
+        const UInt32 group = findOrCreateGroup(columns, i, hashes[i]);
+        UInt64 * heap = heap_rows.data() + group * limit;
+        auto & size = group_sizes[group];
+        if (size < limit)
+        {
+            heap[size++] = appendRow(columns, i);
+            std::push_heap(heap, heap + size, less);
+        }
+        else if (compareWithStored(columns, i, heap[0]) < 0)
+        {
+            std::pop_heap(heap, heap + size, less);
+            heap[size - 1] = appendRow(columns, i);
+            std::push_heap(heap, heap + size, less);
+            ++garbage_rows;
+        }
+    }
+
+    if (garbage_rows > DEFAULT_BLOCK_SIZE && garbage_rows * 2 > stored_rows)
+        compact();
+}
+
+UInt32 GroupTopKTransform::findOrCreateGroup(const DB::Columns & columns, size_t row, UInt32 hash)
+{
+    HashMap<UInt32, UInt32>::LookupResult it;
+    bool inserted = false;
+    groups_by_hash.emplace(hash, it, inserted);
+    if (!inserted)
+    {
+        /// Any candidate of a group has its partition key, every group has at least one candidate
+        for (UInt32 group = it->getMapped(); group != NO_GROUP; group = next_groups[group])
+        {
+            const size_t stored_row = heap_rows[group * limit];
+            bool equals = true;
+            for (const auto column : partition_columns)
+            {
+                if (columns[column]->compareAt(row, stored_row, *rows[column], 1) != 0)
+                {
+                    equals = false;
+                    break;
+                }
+            }
+            if (equals)
+                return group;
+        }
+    }
+
+    const auto group = static_cast<UInt32>(group_sizes.size());
+    group_sizes.push_back(0);
+    group_hashes.push_back(hash);
+    next_groups.push_back(inserted ? NO_GROUP : it->getMapped());
+    it->getMapped() = group;
+    heap_rows.resize(heap_rows.size() + limit);
+    return group;
+}
+
+size_t GroupTopKTransform::appendRow(const DB::Columns & columns, size_t row)
+{
+    for (size_t i = 0; i < columns.size(); ++i)
+        rows[i]->insertFrom(*columns[i], row);
+    return stored_rows++;
+}
+
+int GroupTopKTransform::compareWithStored(const DB::Columns & columns, size_t row, size_t stored_row) const
+{
+    for (size_t i = 0; i < sort_columns.size(); ++i)
+    {
+        const auto column = sort_columns[i];
+        if (int res = columns[column]->compareAt(row, stored_row, *rows[column], nulls_directions[i]))
+            return res * sort_directions[i];
+    }
+    return 0;
+}
+
+int GroupTopKTransform::compareStored(size_t lhs, size_t rhs) const
+{
+    for (size_t i = 0; i < sort_columns.size(); ++i)
+    {
+        const auto & column = *rows[sort_columns[i]];
+        if (int res = column.compareAt(lhs, rhs, column, nulls_directions[i]))
+            return res * sort_directions[i];
+    }
+    return 0;
+}
+
+void GroupTopKTransform::compact()
+{
+    auto indexes = DB::ColumnUInt64::create();
+    auto & data = indexes->getData();
+    data.reserve(stored_rows - garbage_rows);
+    for (size_t group = 0; group < group_sizes.size(); ++group)
+    {
+        UInt64 * heap = heap_rows.data() + group * limit;
+        for (size_t i = 0; i < group_sizes[group]; ++i)
+        {
+            data.push_back(heap[i]);
+            heap[i] = data.size() - 1;
+        }
+    }
+
+    for (auto & column : rows)
+        column = DB::IColumn::mutate(column->index(*indexes, 0));
+    stored_rows = data.size();
+    garbage_rows = 0;
+}
+
+bool GroupTopKTransform::isMemoryShort() const
+{
+    if (max_rows_before_spill)
+        return stored_rows > max_rows_before_spill;
+
+    const auto thread_group = DB::CurrentThread::getGroup();
+    if (!thread_group)
+        return false;
+    const auto soft_limit = thread_group->memory_tracker.getSoftLimit();
+    return soft_limit && static_cast<double>(thread_group->memory_tracker.get()) > soft_limit * spill_mem_ratio;
+}
+
+void GroupTopKTransform::spill()
+{
+    if (spilled_buckets.empty())
+    {
+        LOG_INFO(getLogger("GroupTopKTransform"), "Memory is short with {} groups, spill them into disk", group_sizes.size());
+        spilled_buckets.resize(SPILL_BUCKETS);
+    }
+    if (group_sizes.empty())
+        return;
+
+    /// The buckets only depend on the partition key, so each group is in exactly one bucket
+    auto indexes = DB::ColumnUInt64::create();
+    auto & data = indexes->getData();
+    DB::IColumn::Selector selector;
+    data.reserve(stored_rows - garbage_rows);
+    selector.reserve(stored_rows - garbage_rows);
+    for (size_t group = 0; group < group_sizes.size(); ++group)
+    {
+        const UInt64 * heap = heap_rows.data() + group * limit;
+        for (size_t i = 0; i < group_sizes[group]; ++i)
+        {
+            data.push_back(heap[i]);
+            selector.push_back(group_hashes[group] % SPILL_BUCKETS);
+        }
+    }
+
+    std::vector<DB::MutableColumns> bucket_columns(SPILL_BUCKETS);
+    for (const auto & column : rows)
+    {
+        auto scattered = column->index(*indexes, 0)->scatter(SPILL_BUCKETS, selector);
+        for (size_t bucket = 0; bucket < SPILL_BUCKETS; ++bucket)
+            bucket_columns[bucket].push_back(std::move(scattered[bucket]));
+    }
+    reset();
+
+    for (size_t bucket = 0; bucket < SPILL_BUCKETS; ++bucket)
+    {
+        auto block = input_header->cloneWithColumns(std::move(bucket_columns[bucket]));
+        if (!block.rows())
+            continue;
+        auto & stream = spilled_buckets[bucket];
+        if (!stream)
+            stream = DB::TemporaryBlockStreamHolder(input_header, tmp_data_disk.get());
+        stream.value()->write(block);
+    }
+}
+
+void GroupTopKTransform::loadBucket(size_t bucket)
+{
+    auto & stream = spilled_buckets[bucket];
+    if (!stream)
+        return;
+
+    stream.value()->finishWriting();
+    auto reader = stream.value()->getReadStream();
+    while (true)
+    {
+        auto block = reader->read();
+        if (!block.rows())
+            break;
+        addRows(block.getColumns(), block.rows());
+    }
+    stream.reset();
+}
+
+void GroupTopKTransform::prepareOutput()
+{
+    output_order.clear();
+    output_row_numbers.clear();
+    output_pos = 0;
+
+    auto less = [this](UInt64 lhs, UInt64 rhs) { return compareStored(lhs, rhs) < 0; };
+    for (size_t group = 0; group < group_sizes.size(); ++group)
+    {
+        UInt64 * heap = heap_rows.data() + group * limit;
+        const size_t size = group_sizes[group];
+        std::sort_heap(heap, heap + size, less);
+        for (size_t i = 0; i < size; ++i)
+        {
+            output_order.push_back(heap[i]);
+            output_row_numbers.push_back(i + 1);
+        }
+    }
+
+    if (!hasPendingOutput())
+        reset();
+}
+
+DB::Chunk GroupTopKTransform::generateOutputChunk()
+{
+    const size_t num_rows = std::min<size_t>(DEFAULT_BLOCK_SIZE, output_order.size() - output_pos);
+    auto indexes = DB::ColumnUInt64::create();
+    indexes->getData().assign(output_order.begin() + output_pos, output_order.begin() + output_pos + num_rows);
+
+    DB::Columns columns;
+    for (const auto & column : rows)
+        columns.push_back(column->index(*indexes, 0));
+    if (final)
+    {
+        auto row_numbers = DB::ColumnUInt64::create();
+        row_numbers->getData().assign(
+            output_row_numbers.begin() + output_pos, output_row_numbers.begin() + output_pos + num_rows);
+        columns.push_back(std::move(row_numbers));
+    }
+    output_pos += num_rows;
+
+    if (!hasPendingOutput())
+        reset();
+    return DB::Chunk(std::move(columns), num_rows);
+}
+
+void GroupTopKTransform::reset()
+{
+    rows.clear();
+    stored_rows = 0;
+    garbage_rows = 0;
+    DB::PaddedPODArray<UInt64>().swap(heap_rows);
+    DB::PaddedPODArray<UInt32>().swap(group_sizes);
+    DB::PaddedPODArray<UInt32>().swap(group_hashes);
+    DB::PaddedPODArray<UInt32>().swap(next_groups);
+    groups_by_hash.clearAndShrink();
+    DB::PaddedPODArray<UInt64>().swap(output_order);
+    DB::PaddedPODArray<UInt64>().swap(output_row_numbers);
+    output_pos = 0;
+}
+
+}
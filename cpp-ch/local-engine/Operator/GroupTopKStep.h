@@ -0,0 +1,155 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <limits>
+#include <optional>
+#include <vector>
+#include <Core/Block.h>
+#include <Core/SortDescription.h>
+#include <Interpreters/Context_fwd.h>
+#include <Interpreters/TemporaryDataOnDisk.h>
+#include <Processors/Chunk.h>
+#include <Processors/IProcessor.h>
+#include <Processors/QueryPlan/ITransformingStep.h>
+#include <Common/HashTable/HashMap.h>
+#include <Common/PODArray.h>
+
+namespace local_engine
+{
+
+/// row_number() <= limit per partition without sorting the input, meant for a small limit over many partitions,
+/// e.g. the latest row per key.
+///
+/// The output is the input columns plus a UInt64 row_number column, rows of a partition are in sort order.
+/// With several input streams, each stream first keeps its own top rows per partition, which is a valid pre-filter,
+/// then a single transform merges them.
+class GroupTopKStep : public DB::ITransformingStep
+{
+public:
+    GroupTopKStep(
+        const DB::ContextPtr & context_,
+        const DB::SharedHeader & input_header_,
+        const std::vector<size_t> & partition_columns_,
+        const DB::SortDescription & sort_description_,
+        size_t limit_);
+    ~GroupTopKStep() override = default;
+
+    String getName() const override { return "GroupTopKStep"; }
+
+    void transformPipeline(DB::QueryPipelineBuilder & pipeline, const DB::BuildQueryPipelineSettings & settings) override;
+    void describePipeline(DB::IQueryPlanStep::FormatSettings & settings) const override;
+
+    static DB::Block buildOutputHeader(const DB::Block & input_header);
+
+private:
+    DB::ContextPtr context;
+    std::vector<size_t> partition_columns;
+    DB::SortDescription sort_description;
+    size_t limit;
+
+    void updateOutputHeader() override;
+};
+
+/// Keeps at most `limit` candidate rows per partition. The candidates of all partitions are stored in one set of
+/// columns, each partition only holds a max-heap of `limit` row numbers, whose top is the candidate that goes last.
+/// A row that goes before the top replaces it, the replaced row stays in the columns until they are compacted.
+///
+/// If final, row_number is appended to the output, and the candidates are spilled into disk buckets by the hash of
+/// the partition key when memory is short, and every bucket is processed again at the end. Otherwise the output
+/// only is a pre-filter, and the candidates are simply emitted when memory is short.
+class GroupTopKTransform : public DB::IProcessor
+{
+public:
+    using Status = DB::IProcessor::Status;
+
+    GroupTopKTransform(
+        const DB::SharedHeader & input_header_,
+        const std::vector<size_t> & partition_columns_,
+        const DB::SortDescription & sort_description_,
+        size_t limit_,
+        bool final_,
+        double spill_mem_ratio_,
+        DB::TemporaryDataOnDiskScopePtr tmp_data_disk_,
+        size_t max_rows_before_spill_ = 0);
+    ~GroupTopKTransform() override = default;
+
+    String getName() const override { return "GroupTopKTransform"; }
+
+    Status prepare() override;
+    void work() override;
+
+private:
+    static constexpr UInt32 NO_GROUP = std::numeric_limits<UInt32>::max();
+    static constexpr size_t SPILL_BUCKETS = 32;
+
+    DB::SharedHeader input_header;
+    std::vector<size_t> partition_columns;
+    std::vector<size_t> sort_columns;
+    std::vector<int> sort_directions;
+    std::vector<int> nulls_directions;
+    size_t limit;
+    bool final;
+    double spill_mem_ratio;
+    DB::TemporaryDataOnDiskScopePtr tmp_data_disk;
+    /// Spill once there are more candidate rows than this, only used by tests
+    size_t max_rows_before_spill;
+
+    /// Candidate rows of all groups, and the replaced rows until compact()
+    DB::MutableColumns rows;
+    size_t stored_rows = 0;
+    size_t garbage_rows = 0;
+    /// Row numbers of group g are heap_rows[g * limit, g * limit + group_sizes[g])
+    DB::PaddedPODArray<UInt64> heap_rows;
+    DB::PaddedPODArray<UInt32> group_sizes;
+    DB::PaddedPODArray<UInt32> group_hashes;
+    /// WeakHash32 of the partition key -> the last group with this hash, older ones are chained by next_groups
+    HashMap<UInt32, UInt32> groups_by_hash;
+    DB::PaddedPODArray<UInt32> next_groups;
+
+    std::vector<std::optional<DB::TemporaryBlockStreamHolder>> spilled_buckets;
+    size_t next_bucket = 0;
+
+    DB::PaddedPODArray<UInt64> output_order;
+    DB::PaddedPODArray<UInt64> output_row_numbers;
+    size_t output_pos = 0;
+
+    bool has_input = false;
+    bool input_finished = false;
+    bool output_prepared = false;
+    bool has_output = false;
+    DB::Chunk input_chunk;
+    DB::Chunk output_chunk;
+
+    void addRows(const DB::Columns & columns, size_t num_rows);
+    UInt32 findOrCreateGroup(const DB::Columns & columns, size_t row, UInt32 hash);
+    size_t appendRow(const DB::Columns & columns, size_t row);
+    int compareWithStored(const DB::Columns & columns, size_t row, size_t stored_row) const;
+    int compareStored(size_t lhs, size_t rhs) const;
+    void compact();
+
+    bool isMemoryShort() const;
+    void spill();
+    bool hasMoreBuckets() const { return next_bucket < spilled_buckets.size(); }
+    void loadBucket(size_t bucket);
+
+    void prepareOutput();
+    bool hasPendingOutput() const { return output_pos < output_order.size(); }
+    DB::Chunk generateOutputChunk();
+    void reset();
+};
+
+}
@@ -0,0 +1,205 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "JoinRuntimeFilterStep.h"
+
+#include <Columns/FilterDescription.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <Functions/FunctionFactory.h>
+#include <Interpreters/ExpressionActions.h>
+#include <QueryPipeline/QueryPipelineBuilder.h>
+#include <Common/BlockTypeUtils.h>
+#include <Common/QueryContext.h>
+
+namespace local_engine
+{
+using namespace DB;
+
+JoinRuntimeFilterCollector::JoinRuntimeFilterCollector(const DataTypes & key_types_, size_t bloom_filter_max_bytes_)
+    : key_types(key_types_), bloom_filter_max_bytes(bloom_filter_max_bytes_)
+{
+}
+
+std::vector<JoinKeyRuntimeFilterBuilder> JoinRuntimeFilterCollector::createBuilders()
+{
+    std::vector<JoinKeyRuntimeFilterBuilder> builders;
+    for (const auto & type : key_types)
+        builders.emplace_back(type, bloom_filter_max_bytes, QueryContext::globalContext());
+
+    std::lock_guard lock(mutex);
+    ++running_builders;
+    return builders;
+}
+
+void JoinRuntimeFilterCollector::finishBuilders(std::vector<JoinKeyRuntimeFilterBuilder> && builders, bool complete)
+{
+    std::lock_guard lock(mutex);
+    abandoned |= !complete;
+    if (merged_builders.empty())
+        merged_builders = std::move(builders);
+    else
+    {
+        for (size_t i = 0; i < merged_builders.size(); ++i)
+            merged_builders[i].merge(std::move(builders[i]));
+    }
+
+    if (--running_builders > 0 || abandoned)
+        return;
+    auto result = std::make_shared<Filters>();
+    for (auto & builder : merged_builders)
+        result->emplace_back(builder.finish());
+    merged_builders.clear();
+    filters = std::move(result);
+}
+
+std::shared_ptr<const JoinRuntimeFilterCollector::Filters> JoinRuntimeFilterCollector::getFilters() const
+{
+    std::lock_guard lock(mutex);
+    return filters;
+}
+
+static ITransformingStep::Traits getTraits(bool build_side)
+{
+    return ITransformingStep::Traits{
+        {
+            .preserves_number_of_streams = true,
+            .preserves_sorting = true,
+        },
+        {
+            .preserves_number_of_rows = build_side,
+        }};
+}
+
+JoinRuntimeFilterStep::JoinRuntimeFilterStep(
+    const SharedHeader & input_header, JoinRuntimeFilterCollectorPtr collector_, const Names & key_names_, bool build_side_)
+    : ITransformingStep(input_header, input_header, getTraits(build_side_))
+    , collector(std::move(collector_))
+    , key_names(key_names_)
+    , build_side(build_side_)
+{
+}
+
+void JoinRuntimeFilterStep::transformPipeline(QueryPipelineBuilder & pipeline, const BuildQueryPipelineSettings & /*settings*/)
+{
+    pipeline.addSimpleTransform(
+        [&](const SharedHeader & header) -> ProcessorPtr
+        {
+            if (build_side)
+                return std::make_shared<JoinRuntimeFilterBuildTransform>(header, collector, key_names);
+            return std::make_shared<JoinRuntimeFilterProbeTransform>(header, collector, key_names);
+        });
+}
+
+void JoinRuntimeFilterStep::describeActions(IQueryPlanStep::FormatSettings & settings) const
+{
+    if (!processors.empty())
+        IQueryPlanStep::describePipeline(processors, settings);
+}
+
+void JoinRuntimeFilterStep::updateOutputHeader()
+{
+    output_header = input_headers.front();
+}
+
+JoinRuntimeFilterBuildTransform::JoinRuntimeFilterBuildTransform(
+    const SharedHeader & header, JoinRuntimeFilterCollectorPtr collector_, const Names & key_names)
+    : ISimpleTransform(header, header, false), collector(std::move(collector_)), builders(collector->createBuilders())
+{
+    for (const auto & key_name : key_names)
+        key_positions.emplace_back(header->getPositionByName(key_name));
+}
+
+IProcessor::Status JoinRuntimeFilterBuildTransform::prepare()
+{
+    /// Closed from downstream, e.g. on cancellation, the rest of the input is not read.
+    const bool output_closed = output.isFinished();
+    const auto status = ISimpleTransform::prepare();
+    if (status == Status::Finished && !finished)
+    {
+        finished = true;
+        collector->finishBuilders(std::move(builders), !output_closed);
+    }
+    return status;
+}
+
+void JoinRuntimeFilterBuildTransform::transform(Chunk & chunk)
+{
+    const auto & columns = chunk.getColumns();
+    for (size_t i = 0; i < key_positions.size(); ++i)
+        builders[i].add(columns[key_positions[i]]);
+}
+
+JoinRuntimeFilterProbeTransform::JoinRuntimeFilterProbeTransform(
+    const SharedHeader & header, JoinRuntimeFilterCollectorPtr collector_, const Names & key_names_)
+    : ISimpleTransform(header, header, true), collector(std::move(collector_)), key_names(key_names_)
+{
+}
+
+void JoinRuntimeFilterProbeTransform::buildActions(const JoinRuntimeFilterCollector::Filters & filters)
+{
+    const auto & header = getInputPort().getHeader();
+    ActionsDAG actions_dag{header.getColumnsWithTypeAndName()};
+    ActionsDAG::NodeRawConstPtrs conditions;
+    for (size_t i = 0; i < key_names.size(); ++i)
+    {
+        if (!filters[i])
+        {
+            drop_all = true;
+            return;
+        }
+        const auto * key_node = actions_dag.tryFindInOutputs(key_names[i]);
+        conditions.emplace_back(filters[i]->buildCondition(actions_dag, *key_node, QueryContext::globalContext()));
+    }
+    const auto * cond_node = conditions.size() == 1
+        ? conditions.front()
+        : &actions_dag.addFunction(FunctionFactory::instance().get("and", QueryContext::globalContext()), conditions, {});
+    actions_dag.addOrReplaceInOutputs(*cond_node);
+    filter_column_name = cond_node->result_name;
+    actions = std::make_shared<ExpressionActions>(std::move(actions_dag));
+}
+
+void JoinRuntimeFilterProbeTransform::transform(Chunk & chunk)
+{
+    if (!actions && !drop_all)
+    {
+        const auto filters = collector->getFilters();
+        /// The build side is not read yet
+        if (!filters)
+            return;
+        buildActions(*filters);
+    }
+    if (drop_all)
+    {
+        chunk.clear();
+        return;
+    }
+
+    auto block = getInputPort().getHeader().cloneWithColumns(chunk.getColumns());
+    size_t num_rows = chunk.getNumRows();
+    actions->execute(block, num_rows);
+    const auto filter_column = block.getByName(filter_column_name).column->convertToFullColumnIfConst();
+    FilterDescription filter(*filter_column);
+    const size_t result_rows = filter.countBytesInFilter();
+    if (result_rows == chunk.getNumRows())
+        return;
+
+    auto columns = chunk.detachColumns();
+    for (auto & column : columns)
+        column = filter.filter(*column, result_rows);
+    chunk.setColumns(std::move(columns), result_rows);
+}
+
+}
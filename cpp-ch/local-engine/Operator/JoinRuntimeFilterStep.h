@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <mutex>
+#include <Join/JoinRuntimeFilter.h>
+#include <Processors/ISimpleTransform.h>
+#include <Processors/QueryPlan/ITransformingStep.h>
+
+namespace DB
+{
+class ExpressionActions;
+using ExpressionActionsPtr = std::shared_ptr<ExpressionActions>;
+}
+
+namespace local_engine
+{
+
+/// Runtime filters of the join keys of a shuffled hash join. The build side transforms collect the values of the keys,
+/// and once all of them have finished, i.e. the whole build side is read, the probe side transforms drop the rows that
+/// can't match. JoiningTransform doesn't read the probe side before the hash table is filled, so only the few blocks
+/// read ahead pass unfiltered. Unlike the filters of broadcast joins, they can't be pushed down into the scan, which is
+/// planned before the build side is read.
+class JoinRuntimeFilterCollector
+{
+public:
+    using Filters = std::vector<std::optional<JoinKeyRuntimeFilter>>;
+
+    JoinRuntimeFilterCollector(const DB::DataTypes & key_types_, size_t bloom_filter_max_bytes_);
+
+    /// Called by each build side transform when it is created.
+    std::vector<JoinKeyRuntimeFilterBuilder> createBuilders();
+
+    /// Called by each build side transform when it is finished. If it didn't see all of its input, e.g. on
+    /// cancellation, no filter is published.
+    void finishBuilders(std::vector<JoinKeyRuntimeFilterBuilder> && builders, bool complete);
+
+    /// The filter of each key once the whole build side was collected, nullptr before. A key without filter has no
+    /// non-null value on the build side.
+    std::shared_ptr<const Filters> getFilters() const;
+
+private:
+    const DB::DataTypes key_types;
+    const size_t bloom_filter_max_bytes;
+
+    mutable std::mutex mutex;
+    size_t running_builders = 0;
+    bool abandoned = false;
+    std::vector<JoinKeyRuntimeFilterBuilder> merged_builders;
+    std::shared_ptr<const Filters> filters;
+};
+using JoinRuntimeFilterCollectorPtr = std::shared_ptr<JoinRuntimeFilterCollector>;
+
+/// Collects the keys on the build side (build_side) or filters the probe side by them.
+class JoinRuntimeFilterStep : public DB::ITransformingStep
+{
+public:
+    JoinRuntimeFilterStep(
+        const DB::SharedHeader & input_header, JoinRuntimeFilterCollectorPtr collector_, const DB::Names & key_names_, bool build_side_);
+
+    String getName() const override { return "JoinRuntimeFilterStep"; }
+    void transformPipeline(DB::QueryPipelineBuilder & pipeline, const DB::BuildQueryPipelineSettings & settings) override;
+    void describeActions(DB::IQueryPlanStep::FormatSettings & settings) const override;
+
+    /// 1 for the probe side step once the build side published its filters, reported in the rel metrics.
+    size_t publishedFilters() const { return !build_side && collector->getFilters() ? 1 : 0; }
+
+private:
+    JoinRuntimeFilterCollectorPtr collector;
+    DB::Names key_names;
+    bool build_side;
+
+    void updateOutputHeader() override;
+};
+
+class JoinRuntimeFilterBuildTransform : public DB::ISimpleTransform
+{
+public:
+    JoinRuntimeFilterBuildTransform(const DB::SharedHeader & header, JoinRuntimeFilterCollectorPtr collector_, const DB::Names & key_names);
+
+    String getName() const override { return "JoinRuntimeFilterBuildTransform"; }
+    Status prepare() override;
+    void transform(DB::Chunk & chunk) override;
+
+private:
+    JoinRuntimeFilterCollectorPtr collector;
+    std::vector<size_t> key_positions;
+    std::vector<JoinKeyRuntimeFilterBuilder> builders;
+    bool finished = false;
+};
+
+class JoinRuntimeFilterProbeTransform : public DB::ISimpleTransform
+{
+public:
+    JoinRuntimeFilterProbeTransform(
+        const DB::SharedHeader & header, JoinRuntimeFilterCollectorPtr collector_, const DB::Names & key_names_);
+
+    String getName() const override { return "JoinRuntimeFilterProbeTransform"; }
+    void transform(DB::Chunk & chunk) override;
+
+private:
+    JoinRuntimeFilterCollectorPtr collector;
+    DB::Names key_names;
+    /// Built from the filters once they are published. Not shared with the other streams, since bloomFilterContains
+    /// deserializes its state lazily.
+    DB::ExpressionActionsPtr actions;
+    String filter_column_name;
+    /// Some key has no non-null value on the build side, no row matches.
+    bool drop_all = false;
+
+    void buildActions(const JoinRuntimeFilterCollector::Filters & filters);
+};
+
+}
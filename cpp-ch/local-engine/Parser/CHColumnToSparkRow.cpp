@@ -17,8 +17,11 @@
 #include "CHColumnToSparkRow.h"
 #include <Columns/ColumnArray.h>
 #include <Columns/ColumnConst.h>
+#include <Columns/ColumnDecimal.h>
+#include <Columns/ColumnMap.h>
 #include <Columns/ColumnNullable.h>
 #include <Columns/ColumnString.h>
+#include <Columns/ColumnTuple.h>
 #include <Columns/IColumn.h>
 #include <DataTypes/DataTypeArray.h>
 #include <DataTypes/DataTypeLowCardinality.h>
@@ -29,6 +32,7 @@
 #include <DataTypes/ObjectUtils.h>
 #include <jni/jni_common.h>
 #include <Common/Exception.h>
+#include <Common/assert_cast.h>
 
 namespace DB
 {
@@ -54,6 +58,14 @@ static int64_t calculatedFixeSizePerRow(int64_t num_cols)
     return calculateBitSetWidthInBytes(num_cols) + num_cols * 8;
 }
 
+/// Return nested column and null map of column, null map is nullptr if column is not nullable
+static std::pair<const IColumn *, const NullMap *> unwrapNullable(const IColumn & column)
+{
+    if (const auto * nullable_column = checkAndGetColumn<ColumnNullable>(&column))
+        return {&nullable_column->getNestedColumn(), &nullable_column->getNullMapData()};
+    return {&column, nullptr};
+}
+
 int64_t roundNumberOfBytesToNearestWord(int64_t num_bytes)
 {
     auto remainder = num_bytes & 0x07; // This is equivalent to `numBytes % 8`
@@ -191,12 +203,10 @@ static void writeVariableLengthNonNullableValue(
     }
     else
     {
-        Field field;
         for (size_t i = 0; i < num_rows; i++)
         {
             size_t row_idx = masks == nullptr ? i : masks->at(i);
-            field = (*col.column)[row_idx];
-            int64_t offset_and_size = writer.write(i, field, 0);
+            int64_t offset_and_size = writer.write(i, *col.column, row_idx, 0);
             memcpy(buffer_address + offsets[i] + field_offset, &offset_and_size, 8);
         }
     }
@@ -246,7 +256,6 @@ static void writeVariableLengthNullableValue(
     }
     else
     {
-        Field field;
         for (size_t i = 0; i < num_rows; i++)
         {
             size_t row_idx = masks == nullptr ? i : masks->at(i);
@@ -254,8 +263,7 @@ static void writeVariableLengthNullableValue(
                 bitSet(buffer_address + offsets[i], col_index);
             else
             {
-                field = nested_column[row_idx];
-                int64_t offset_and_size = writer.write(i, field, 0);
+                int64_t offset_and_size = writer.write(i, nested_column, row_idx, 0);
                 memcpy(buffer_address + offsets[i] + field_offset, &offset_and_size, 8);
             }
         }
@@ -346,12 +354,12 @@ SparkRowInfo::SparkRowInfo(
             }
             else
             {
+                auto column = col.column->convertToFullIfNeeded();
                 BackingDataLengthCalculator calculator(type_without_nullable);
                 for (size_t i = 0; i < num_rows; ++i)
                 {
                     size_t row_idx = masks == nullptr ? i : masks->at(i);
-                    const auto field = (*col.column)[row_idx];
-                    lengths[i] += calculator.calculate(field);
+                    lengths[i] += calculator.calculate(*column, row_idx);
                 }
             }
         }
@@ -570,6 +578,76 @@ int64_t BackingDataLengthCalculator::calculate(const Field & field) const
         ErrorCodes::UNKNOWN_TYPE, "Doesn't support type {} for BackingBufferLengthCalculator", type_without_nullable->getName());
 }
 
+int64_t BackingDataLengthCalculator::calculate(const IColumn & column, size_t row) const
+{
+    const auto [data_column, null_map] = unwrapNullable(column);
+    if (null_map && (*null_map)[row])
+        return 0;
+
+    if (isFixedLengthDataType(type_without_nullable))
+        return 0;
+
+    if (which.isStringOrFixedString())
+        return roundNumberOfBytesToNearestWord(data_column->getDataAt(row).size);
+
+    if (which.isDecimal128())
+        return 16;
+
+    if (which.isArray())
+    {
+        if (const auto * array_column = checkAndGetColumn<ColumnArray>(data_column))
+        {
+            const auto & array_offsets = array_column->getOffsets();
+            const auto * array_type = typeid_cast<const DataTypeArray *>(type_without_nullable.get());
+            return calculateArray(array_type->getNestedType(), array_column->getData(), array_offsets[row - 1], array_offsets[row]);
+        }
+    }
+    else if (which.isMap())
+    {
+        if (const auto * map_column = checkAndGetColumn<ColumnMap>(data_column))
+        {
+            /// Length of UnsafeArrayData of key(8B) | UnsafeArrayData of key | UnsafeArrayData of value
+            const auto & map_offsets = map_column->getNestedColumn().getOffsets();
+            const auto & key_values = map_column->getNestedData();
+            const auto * map_type = typeid_cast<const DataTypeMap *>(type_without_nullable.get());
+            return 8 + calculateArray(map_type->getKeyType(), key_values.getColumn(0), map_offsets[row - 1], map_offsets[row])
+                + calculateArray(map_type->getValueType(), key_values.getColumn(1), map_offsets[row - 1], map_offsets[row]);
+        }
+    }
+    else if (which.isTuple())
+    {
+        if (const auto * tuple_column = checkAndGetColumn<ColumnTuple>(data_column))
+        {
+            const auto * type_tuple = typeid_cast<const DataTypeTuple *>(type_without_nullable.get());
+            const auto & type_fields = type_tuple->getElements();
+            const auto num_fields = type_fields.size();
+            int64_t res = calculateBitSetWidthInBytes(num_fields) + 8 * num_fields;
+            for (size_t i = 0; i < num_fields; ++i)
+            {
+                if (!isFixedLengthDataType(removeNullable(type_fields[i])))
+                    res += BackingDataLengthCalculator(type_fields[i]).calculate(tuple_column->getColumn(i), row);
+            }
+            return res;
+        }
+    }
+
+    /// Unexpected column layout, e.g. a sparse or const nested column
+    return calculate(column[row]);
+}
+
+int64_t BackingDataLengthCalculator::calculateArray(const DataTypePtr & nested_type, const IColumn & elements, size_t begin, size_t end)
+{
+    const auto num_elems = end - begin;
+    int64_t res = 8 + calculateBitSetWidthInBytes(num_elems) + roundNumberOfBytesToNearestWord(getArrayElementSize(nested_type) * num_elems);
+    if (isFixedLengthDataType(removeNullable(nested_type)))
+        return res;
+
+    BackingDataLengthCalculator calculator(nested_type);
+    for (size_t i = begin; i < end; ++i)
+        res += calculator.calculate(elements, i);
+    return res;
+}
+
 int64_t BackingDataLengthCalculator::getArrayElementSize(const DataTypePtr & nested_type)
 {
     const WhichDataType nested_which(removeNullable(nested_type));
@@ -790,6 +868,190 @@ int64_t VariableLengthDataWriter::writeStruct(size_t row_idx, const DB::Tuple &
     return BackingDataLengthCalculator::getOffsetAndSize(start - parent_offset, cursor - start);
 }
 
+int64_t VariableLengthDataWriter::writeArray(
+    size_t row_idx, const DataTypePtr & nested_type, const IColumn & elements, size_t begin, size_t end, int64_t parent_offset)
+{
+    /// 内存布局：numElements(8B) | null_bitmap(与numElements成正比) | values(每个值长度与类型有关) | backing data
+    const auto & offset = offsets[row_idx];
+    auto & cursor = buffer_cursor[row_idx];
+    const size_t num_elems = end - begin;
+
+    /// Write numElements(8B)
+    const auto start = cursor;
+    memcpy(buffer_address + offset + cursor, &num_elems, 8);
+    cursor += 8;
+    if (num_elems == 0)
+        return BackingDataLengthCalculator::getOffsetAndSize(start - parent_offset, 8);
+
+    /// Skip null_bitmap and values(already reset to zero)
+    const auto len_null_bitmap = calculateBitSetWidthInBytes(num_elems);
+    const auto elem_size = BackingDataLengthCalculator::getArrayElementSize(nested_type);
+    cursor += len_null_bitmap + roundNumberOfBytesToNearestWord(elem_size * num_elems);
+
+    char * null_bitmap = buffer_address + offset + start + 8;
+    char * values = null_bitmap + len_null_bitmap;
+    const auto [data_column, null_map] = unwrapNullable(elements);
+    if (BackingDataLengthCalculator::isFixedLengthDataType(removeNullable(nested_type)))
+    {
+        FixedLengthDataWriter writer(nested_type);
+        if (!writer.getWhichDataType().isDecimal32() && data_column->isFixedAndContiguous()
+            && data_column->sizeOfValueIfFixed() == static_cast<size_t>(elem_size))
+        {
+            /// Values of null elements are default(zero) in nested column, copy them in one go
+            memcpy(values, data_column->getRawData().data() + begin * elem_size, num_elems * elem_size);
+            if (null_map)
+            {
+                for (size_t i = 0; i < num_elems; ++i)
+                    if ((*null_map)[begin + i])
+                        bitSet(null_bitmap, i);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < num_elems; ++i)
+            {
+                if (null_map && (*null_map)[begin + i])
+                    bitSet(null_bitmap, i);
+                else
+                    writer.write(*data_column, begin + i, values + i * elem_size);
+            }
+        }
+    }
+    else
+    {
+        VariableLengthDataWriter writer(nested_type, buffer_address, offsets, buffer_cursor);
+        for (size_t i = 0; i < num_elems; ++i)
+        {
+            if (null_map && (*null_map)[begin + i])
+                bitSet(null_bitmap, i);
+            else
+            {
+                const auto offset_and_size = writer.write(row_idx, *data_column, begin + i, start);
+                memcpy(values + i * elem_size, &offset_and_size, 8);
+            }
+        }
+    }
+    return BackingDataLengthCalculator::getOffsetAndSize(start - parent_offset, cursor - start);
+}
+
+int64_t VariableLengthDataWriter::writeMap(size_t row_idx, const ColumnMap & map_column, size_t column_row, int64_t parent_offset)
+{
+    /// 内存布局：Length of UnsafeArrayData of key(8B) |  UnsafeArrayData of key | UnsafeArrayData of value
+    const auto & offset = offsets[row_idx];
+    auto & cursor = buffer_cursor[row_idx];
+
+    /// Skip length of UnsafeArrayData of key(8B)
+    const auto start = cursor;
+    cursor += 8;
+
+    const auto & map_offsets = map_column.getNestedColumn().getOffsets();
+    const auto & key_values = map_column.getNestedData();
+    const auto begin = map_offsets[column_row - 1];
+    const auto end = map_offsets[column_row];
+    const auto * map_type = typeid_cast<const DB::DataTypeMap *>(type_without_nullable.get());
+
+    /// Append UnsafeArrayData of key and fill its length
+    const auto key_array_size = BackingDataLengthCalculator::extractSize(
+        writeArray(row_idx, map_type->getKeyType(), key_values.getColumn(0), begin, end, start + 8));
+    memcpy(buffer_address + offset + start, &key_array_size, 8);
+
+    /// Append UnsafeArrayData of value
+    writeArray(row_idx, map_type->getValueType(), key_values.getColumn(1), begin, end, start + 8 + key_array_size);
+    return BackingDataLengthCalculator::getOffsetAndSize(start - parent_offset, cursor - start);
+}
+
+int64_t VariableLengthDataWriter::writeStruct(size_t row_idx, const ColumnTuple & tuple_column, size_t column_row, int64_t parent_offset)
+{
+    /// 内存布局：null_bitmap(字节数与字段数成正比) | values(num_fields * 8B) | backing data
+    const auto & offset = offsets[row_idx];
+    auto & cursor = buffer_cursor[row_idx];
+    const auto start = cursor;
+
+    const auto * tuple_type = typeid_cast<const DataTypeTuple *>(type_without_nullable.get());
+    const auto & field_types = tuple_type->getElements();
+    const auto num_fields = field_types.size();
+    if (num_fields == 0)
+        return BackingDataLengthCalculator::getOffsetAndSize(start - parent_offset, 0);
+    const auto len_null_bitmap = calculateBitSetWidthInBytes(num_fields);
+    cursor += len_null_bitmap + num_fields * 8;
+
+    for (size_t i = 0; i < num_fields; ++i)
+    {
+        const auto & field_column = tuple_column.getColumn(i);
+        const auto & field_type = field_types[i];
+        if (field_column.isNullAt(column_row))
+        {
+            bitSet(buffer_address + offset + start, i);
+            continue;
+        }
+
+        if (BackingDataLengthCalculator::isFixedLengthDataType(removeNullable(field_type)))
+        {
+            FixedLengthDataWriter writer(field_type);
+            writer.write(field_column, column_row, buffer_address + offset + start + len_null_bitmap + i * 8);
+        }
+        else
+        {
+            VariableLengthDataWriter writer(field_type, buffer_address, offsets, buffer_cursor);
+            const auto offset_and_size = writer.write(row_idx, field_column, column_row, start);
+            memcpy(buffer_address + offset + start + len_null_bitmap + 8 * i, &offset_and_size, 8);
+        }
+    }
+    return BackingDataLengthCalculator::getOffsetAndSize(start - parent_offset, cursor - start);
+}
+
+int64_t VariableLengthDataWriter::write(size_t row_idx, const IColumn & column, size_t column_row, int64_t parent_offset)
+{
+    assert(row_idx < offsets.size());
+
+    const auto [data_column, null_map] = unwrapNullable(column);
+    if (null_map && (*null_map)[column_row])
+        return 0;
+
+    if (which.isStringOrFixedString())
+    {
+        const auto str = data_column->getDataAt(column_row);
+        return writeUnalignedBytes(row_idx, str.data, str.size, parent_offset);
+    }
+
+    if (which.isDecimal128())
+    {
+        const auto str = data_column->getDataAt(column_row);
+        String buf(str.data, str.size);
+        BackingDataLengthCalculator::swapDecimalEndianBytes(buf);
+        return writeUnalignedBytes(row_idx, buf.data(), buf.size(), parent_offset);
+    }
+
+    if (which.isArray())
+    {
+        if (const auto * array_column = checkAndGetColumn<ColumnArray>(data_column))
+        {
+            const auto & array_offsets = array_column->getOffsets();
+            const auto * array_type = typeid_cast<const DataTypeArray *>(type_without_nullable.get());
+            return writeArray(
+                row_idx,
+                array_type->getNestedType(),
+                array_column->getData(),
+                array_offsets[column_row - 1],
+                array_offsets[column_row],
+                parent_offset);
+        }
+    }
+    else if (which.isMap())
+    {
+        if (const auto * map_column = checkAndGetColumn<ColumnMap>(data_column))
+            return writeMap(row_idx, *map_column, column_row, parent_offset);
+    }
+    else if (which.isTuple())
+    {
+        if (const auto * tuple_column = checkAndGetColumn<ColumnTuple>(data_column))
+            return writeStruct(row_idx, *tuple_column, column_row, parent_offset);
+    }
+
+    /// Unexpected column layout, e.g. a sparse or const nested column
+    return write(row_idx, column[column_row], parent_offset);
+}
+
 int64_t VariableLengthDataWriter::write(size_t row_idx, const DB::Field & field, int64_t parent_offset)
 {
     assert(row_idx < offsets.size());
@@ -936,6 +1198,19 @@ void FixedLengthDataWriter::write(const DB::Field & field, char * buffer)
         throw Exception(ErrorCodes::UNKNOWN_TYPE, "FixedLengthDataWriter doesn't support type {}", type_without_nullable->getName());
 }
 
+void FixedLengthDataWriter::write(const IColumn & column, size_t row, char * buffer)
+{
+    const IColumn * data_column = unwrapNullable(column).first;
+    if (which.isDecimal32())
+    {
+        /// Decimal32 is stored as 8 bytes in Spark Row
+        const Int64 decimal = assert_cast<const ColumnDecimal<Decimal32> &>(*data_column).getData()[row].value;
+        memcpy(buffer, &decimal, 8);
+    }
+    else
+        unsafeWrite(data_column->getDataAt(row), buffer);
+}
+
 void FixedLengthDataWriter::unsafeWrite(const StringRef & str, char * buffer)
 {
     memcpy(buffer, str.data, str.size);
@@ -25,6 +25,12 @@
 
 struct StringRef;
 
+namespace DB
+{
+class ColumnMap;
+class ColumnTuple;
+}
+
 namespace local_engine
 {
 int64_t calculateBitSetWidthInBytes(int64_t num_fields);
@@ -107,6 +113,10 @@ public:
     /// Return length is guranteed to round up to 8
     virtual int64_t calculate(const DB::Field & field) const;
 
+    /// Same as calculate(Field), but walks offsets and nested columns of Array/Map/Tuple directly
+    /// instead of materializing the value at row as a Field
+    int64_t calculate(const DB::IColumn & column, size_t row) const;
+
     static int64_t getArrayElementSize(const DB::DataTypePtr & nested_type);
 
     /// Is CH DataType can be converted to fixed-length data type in Spark?
@@ -131,6 +141,9 @@ public:
     static int64_t extractSize(int64_t offset_and_size);
 
 private:
+    /// Length of an UnsafeArrayData made of elements[begin, end)
+    static int64_t calculateArray(const DB::DataTypePtr & nested_type, const DB::IColumn & elements, size_t begin, size_t end);
+
     // const DB::DataTypePtr type;
     const DB::DataTypePtr type_without_nullable;
     const DB::WhichDataType which;
@@ -155,6 +168,9 @@ public:
     /// parent_offset: the starting offset of current structure in which we are updating it's backing data region
     virtual int64_t write(size_t row_idx, const DB::Field & field, int64_t parent_offset);
 
+    /// Same as write(Field), but reads the value at column_row of column directly without building a Field
+    int64_t write(size_t row_idx, const DB::IColumn & column, size_t column_row, int64_t parent_offset);
+
     /// Only support String/FixedString/Decimal128
     int64_t writeUnalignedBytes(size_t row_idx, const char * src, size_t size, int64_t parent_offset);
 
@@ -163,6 +179,11 @@ private:
     int64_t writeMap(size_t row_idx, const DB::Map & map, int64_t parent_offset);
     int64_t writeStruct(size_t row_idx, const DB::Tuple & tuple, int64_t parent_offset);
 
+    int64_t writeArray(
+        size_t row_idx, const DB::DataTypePtr & nested_type, const DB::IColumn & elements, size_t begin, size_t end, int64_t parent_offset);
+    int64_t writeMap(size_t row_idx, const DB::ColumnMap & map_column, size_t column_row, int64_t parent_offset);
+    int64_t writeStruct(size_t row_idx, const DB::ColumnTuple & tuple_column, size_t column_row, int64_t parent_offset);
+
     // const DB::DataTypePtr type;
     const DB::DataTypePtr type_without_nullable;
     const DB::WhichDataType which;
@@ -185,6 +206,9 @@ public:
     /// It's caller's duty to make sure that struct fields or array elements are written in order
     virtual void write(const DB::Field & field, char * buffer);
 
+    /// Write the non-null value at row of column, which may be wrapped with Nullable
+    void write(const DB::IColumn & column, size_t row, char * buffer);
+
     /// Copy memory chunk of Fixed length typed CH Column directory to buffer for performance.
     /// It is unsafe unless you know what you are doing.
     virtual void unsafeWrite(const StringRef & str, char * buffer);
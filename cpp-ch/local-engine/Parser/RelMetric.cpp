@@ -16,9 +16,12 @@
  */
 #include "RelMetric.h"
 
+#include <Operator/JoinRuntimeFilterStep.h>
 #include <Processors/IProcessor.h>
 #include <Processors/QueryPlan/AggregatingStep.h>
+#include <Processors/QueryPlan/FilterStep.h>
 #include <Processors/QueryPlan/ReadFromMergeTree.h>
+#include <Storages/SubstraitSource/SubstraitFileSource.h>
 #include <Storages/SubstraitSource/SubstraitFileSourceStep.h>
 #include <Common/QueryContext.h>
 
@@ -47,6 +50,24 @@ extern const Event CachedReadBufferReadFromCacheMisses;
 namespace local_engine
 {
 
+static void writeFooterCacheHits(Writer<StringBuffer> & writer, const DB::IQueryPlanStep & step)
+{
+    size_t hits = 0;
+    size_t misses = 0;
+    for (const auto & processor : step.getProcessors())
+    {
+        if (const auto * source = dynamic_cast<const SubstraitFileSource *>(processor.get()))
+        {
+            hits += source->footerCacheHits();
+            misses += source->footerCacheMisses();
+        }
+    }
+    writer.Key("footer_cache_hits");
+    writer.Uint64(hits);
+    writer.Key("footer_cache_misses");
+    writer.Uint64(misses);
+}
+
 static void writeCacheHits(Writer<StringBuffer> & writer)
 {
     const auto thread_group = QueryContext::currentThreadGroup();
@@ -181,6 +202,18 @@ void RelMetric::serialize(Writer<StringBuffer> & writer, bool) const
             else if (dynamic_cast<SubstraitFileSourceStep *>(step))
             {
                 writeCacheHits(writer);
+                writeFooterCacheHits(writer, *step);
+            }
+            else if (auto * runtime_filter = dynamic_cast<JoinRuntimeFilterStep *>(step))
+            {
+                writer.Key("runtime_filters");
+                writer.Uint64(runtime_filter->publishedFilters());
+            }
+            else if (dynamic_cast<DB::FilterStep *>(step) && step->getStepDescription() == "Runtime Filter")
+            {
+                /// The filters of a broadcast join are built with its hash table, the step is only planned with them.
+                writer.Key("runtime_filters");
+                writer.Uint64(1);
             }
 
             writer.EndObject();
@@ -32,6 +32,7 @@
 #include <Interpreters/WindowDescription.h>
 #include <Operator/BranchStep.h>
 #include <Operator/GraceMergingAggregatedStep.h>
+#include <Operator/GroupTopKStep.h>
 #include <Operator/WindowGroupLimitStep.h>
 #include <Parser/AdvancedParametersParseUtil.h>
 #include <Parser/RelParsers/SortParsingUtils.h>
@@ -231,9 +232,15 @@ DB::QueryPlanPtr AggregateGroupLimitRelParser::parse(
     postProjectionForExplodingArrays(*aggregation_plan);
     LOG_DEBUG(getLogger("AggregateGroupLimitRelParser"), "Aggregate topk plan:\n{}", PlanUtil::explainPlan(*aggregation_plan));
 
+    // For a small limit, keeping a heap per partition is much cheaper than sorting the whole input
     auto window_plan = BranchStepHelper::createSubPlan(branch_in_header, 1);
-    addSortStep(*window_plan);
-    addWindowLimitStep(*window_plan);
+    if (win_config.hash_topk_max_limit && limit <= win_config.hash_topk_max_limit)
+        addHashTopKStep(*window_plan, partition_fields);
+    else
+    {
+        addSortStep(*window_plan);
+        addWindowLimitStep(*window_plan);
+    }
     auto convert_actions_dag = DB::ActionsDAG::makeConvertingActions(
         window_plan->getCurrentHeader()->getColumnsWithTypeAndName(),
         aggregation_plan->getCurrentHeader()->getColumnsWithTypeAndName(),
@@ -425,6 +432,15 @@ void AggregateGroupLimitRelParser::addSortStep(DB::QueryPlan & plan)
     plan.addStep(std::move(sorting_step));
 }
 
+void AggregateGroupLimitRelParser::addHashTopKStep(DB::QueryPlan & plan, const std::vector<size_t> & partition_fields)
+{
+    const auto & header = plan.getCurrentHeader();
+    auto sort_descr = parseSortFields(*header, win_rel_def->sorts());
+    auto topk_step = std::make_unique<GroupTopKStep>(getContext(), header, partition_fields, sort_descr, limit);
+    topk_step->setStepDescription("Hash TopK");
+    plan.addStep(std::move(topk_step));
+}
+
 static DB::WindowFrame buildWindowFrame(const std::string & ch_function_name)
 {
     DB::WindowFrame frame;
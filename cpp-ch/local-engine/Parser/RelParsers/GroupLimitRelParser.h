@@ -81,5 +81,6 @@ private:
 
     void addSortStep(DB::QueryPlan & plan);
     void addWindowLimitStep(DB::QueryPlan & plan);
+    void addHashTopKStep(DB::QueryPlan & plan, const std::vector<size_t> & partition_fields);
 };
 }
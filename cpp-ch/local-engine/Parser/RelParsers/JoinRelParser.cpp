@@ -18,6 +18,8 @@
 #include <optional>
 #include <Core/Block.h>
 #include <Core/Settings.h>
+#include <DataTypes/DataTypeLowCardinality.h>
+#include <DataTypes/DataTypeNullable.h>
 #include <Functions/FunctionFactory.h>
 #include <Interpreters/CollectJoinOnKeysVisitor.h>
 #include <Interpreters/ExpressionActions.h>
@@ -28,6 +30,7 @@
 #include <Join/BroadCastJoinBuilder.h>
 #include <Join/StorageJoinFromReadBuffer.h>
 #include <Operator/EarlyStopStep.h>
+#include <Operator/JoinRuntimeFilterStep.h>
 #include <Parser/AdvancedParametersParseUtil.h>
 #include <Parser/ExpressionParser.h>
 #include <Parser/SubstraitParserUtils.h>
@@ -35,6 +38,7 @@
 #include <Processors/QueryPlan/ExpressionStep.h>
 #include <Processors/QueryPlan/FilterStep.h>
 #include <Processors/QueryPlan/JoinStep.h>
+#include <fmt/ranges.h>
 #include <google/protobuf/wrappers.pb.h>
 #include <Common/CHUtil.h>
 #include <Common/GlutenConfig.h>
@@ -291,6 +295,8 @@ DB::QueryPlanPtr JoinRelParser::parseJoin(const substrait::JoinRel & join, DB::Q
             }
             // other case: is_empty_hash_table, don't need to handle
         }
+        if (join_config.runtime_filter_enabled)
+            addRuntimeFilter(join, join_opt_info, *table_join, *left, *storage_join);
         applyJoinFilter(*table_join, join, *left, *right, true);
         auto broadcast_hash_join = storage_join->getJoinLocked(table_join, context);
 
@@ -354,7 +360,7 @@ DB::QueryPlanPtr JoinRelParser::parseJoin(const substrait::JoinRel & join, DB::Q
         }
         else
         {
-            query_plan = buildSingleOnClauseHashJoin(join, table_join, std::move(left), std::move(right));
+            query_plan = buildSingleOnClauseHashJoin(join, join_opt_info, table_join, std::move(left), std::move(right));
         }
     }
 
@@ -634,6 +640,105 @@ void JoinRelParser::addPostFilter(DB::QueryPlan & query_plan, const substrait::J
     query_plan.addStep(std::move(filter_step));
 }
 
+/// The broadcast table is complete before the probe side is planned, so for inner and left semi joins, a probe row
+/// whose key is outside of the build side key values can be dropped before the join. The filter step is pushed down
+/// into the file source by the query plan optimizer, where it can also skip row groups and pages.
+/// The (left, right) key pairs a runtime filter can be built on: the keys compared by `=` in the single join on clause
+/// of an inner or left semi join.
+static std::vector<std::pair<String, String>>
+getRuntimeFilterKeys(const substrait::JoinRel & join, const JoinOptimizationInfo & join_opt_info, const DB::TableJoin & table_join)
+{
+    std::vector<std::pair<String, String>> keys;
+    if (join_opt_info.is_existence_join || table_join.getClauses().size() != 1)
+        return keys;
+    if (join.type() != substrait::JoinRel_JoinType_JOIN_TYPE_INNER && join.type() != substrait::JoinRel_JoinType_JOIN_TYPE_LEFT_SEMI)
+        return keys;
+
+    const auto & clause = table_join.getOnlyClause();
+    for (size_t i = 0; i < clause.key_names_left.size(); ++i)
+    {
+        /// null <=> null matches, a null probe key must be kept
+        if (!clause.isNullsafeCompareKey(i))
+            keys.emplace_back(clause.key_names_left[i], clause.key_names_right[i]);
+    }
+    return keys;
+}
+
+void JoinRelParser::addRuntimeFilter(
+    const substrait::JoinRel & join,
+    const JoinOptimizationInfo & join_opt_info,
+    const DB::TableJoin & table_join,
+    DB::QueryPlan & left,
+    const StorageJoinFromReadBuffer & storage_join)
+{
+    const auto & left_header = *left.getCurrentHeader();
+    ActionsDAG actions_dag{left_header.getColumnsWithTypeAndName()};
+    ActionsDAG::NodeRawConstPtrs conditions;
+    for (const auto & [left_key, right_key] : getRuntimeFilterKeys(join, join_opt_info, table_join))
+    {
+        auto filter = storage_join.getRuntimeFilter(right_key);
+        if (!filter)
+            continue;
+        const auto * key = left_header.findByName(left_key);
+        if (!key || !removeNullable(removeLowCardinality(key->type))->equals(*filter->type))
+            continue;
+        const auto * key_node = actions_dag.tryFindInOutputs(key->name);
+        if (!key_node)
+            continue;
+        conditions.emplace_back(filter->buildCondition(actions_dag, *key_node, context));
+    }
+    if (conditions.empty())
+        return;
+
+    const auto * cond_node = conditions.size() == 1 ? conditions.front() : buildFunctionNode(actions_dag, "and", conditions);
+    actions_dag.addOrReplaceInOutputs(*cond_node);
+    LOG_DEBUG(getLogger("JoinRelParser"), "Add runtime filter on broadcast join probe side: {}", cond_node->result_name);
+    auto filter_step = std::make_unique<FilterStep>(left.getCurrentHeader(), std::move(actions_dag), cond_node->result_name, true);
+    filter_step->setStepDescription("Runtime Filter");
+    steps.emplace_back(filter_step.get());
+    left.addStep(std::move(filter_step));
+}
+
+void JoinRelParser::addShuffledRuntimeFilter(
+    const substrait::JoinRel & join,
+    const JoinOptimizationInfo & join_opt_info,
+    const DB::TableJoin & table_join,
+    DB::QueryPlan & left,
+    DB::QueryPlan & right,
+    size_t bloom_filter_max_bytes)
+{
+    Names left_keys;
+    Names right_keys;
+    DataTypes key_types;
+    for (const auto & [left_key, right_key] : getRuntimeFilterKeys(join, join_opt_info, table_join))
+    {
+        const auto * left_column = left.getCurrentHeader()->findByName(left_key);
+        const auto * right_column = right.getCurrentHeader()->findByName(right_key);
+        if (!left_column || !right_column)
+            continue;
+        auto type = removeNullable(removeLowCardinality(right_column->type));
+        if (!JoinKeyRuntimeFilterBuilder::isSupportedType(type) || !removeNullable(removeLowCardinality(left_column->type))->equals(*type))
+            continue;
+        left_keys.emplace_back(left_key);
+        right_keys.emplace_back(right_key);
+        key_types.emplace_back(right_column->type);
+    }
+    if (key_types.empty())
+        return;
+
+    auto collector = std::make_shared<JoinRuntimeFilterCollector>(key_types, bloom_filter_max_bytes);
+    auto build_step = std::make_unique<JoinRuntimeFilterStep>(right.getCurrentHeader(), collector, right_keys, true);
+    build_step->setStepDescription("Runtime Filter Build");
+    steps.emplace_back(build_step.get());
+    right.addStep(std::move(build_step));
+
+    LOG_DEBUG(getLogger("JoinRelParser"), "Add runtime filter on shuffled hash join probe side on keys: {}", fmt::join(left_keys, ", "));
+    auto probe_step = std::make_unique<JoinRuntimeFilterStep>(left.getCurrentHeader(), collector, left_keys, false);
+    probe_step->setStepDescription("Runtime Filter");
+    steps.emplace_back(probe_step.get());
+    left.addStep(std::move(probe_step));
+}
+
 /// Only support following pattern: a1 = b1 or a2 = b2 or (a3 = b3 and a4 = b4)
 bool JoinRelParser::couldRewriteToMultiJoinOnClauses(
     const DB::TableJoin::JoinOnClause & prefix_clause,
@@ -764,9 +869,17 @@ DB::QueryPlanPtr JoinRelParser::buildMultiOnClauseHashJoin(
 }
 
 DB::QueryPlanPtr JoinRelParser::buildSingleOnClauseHashJoin(
-    const substrait::JoinRel & join_rel, std::shared_ptr<DB::TableJoin> table_join, DB::QueryPlanPtr left_plan, DB::QueryPlanPtr right_plan)
+    const substrait::JoinRel & join_rel,
+    const JoinOptimizationInfo & join_opt_info,
+    std::shared_ptr<DB::TableJoin> table_join,
+    DB::QueryPlanPtr left_plan,
+    DB::QueryPlanPtr right_plan)
 {
     applyJoinFilter(*table_join, join_rel, *left_plan, *right_plan, true);
+    auto join_config = JoinConfig::loadFromContext(getContext());
+    if (join_config.runtime_filter_enabled)
+        addShuffledRuntimeFilter(
+            join_rel, join_opt_info, *table_join, *left_plan, *right_plan, join_config.runtime_filter_bloom_filter_max_bytes);
     /// Following is some configurations for grace hash join.
     /// - spark.gluten.sql.columnar.backend.ch.runtime_settings.join_algorithm=grace_hash. This will
     ///   enable grace hash join.
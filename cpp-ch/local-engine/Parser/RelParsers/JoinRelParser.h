@@ -32,6 +32,7 @@ namespace local_engine
 {
 
 class StorageJoinFromReadBuffer;
+struct JoinOptimizationInfo;
 
 class JoinRelParser : public RelParser
 {
@@ -69,6 +70,20 @@ private:
 
     void addPostFilter(DB::QueryPlan & plan, const substrait::JoinRel & join);
 
+    void addRuntimeFilter(
+        const substrait::JoinRel & join,
+        const JoinOptimizationInfo & join_opt_info,
+        const DB::TableJoin & table_join,
+        DB::QueryPlan & left,
+        const StorageJoinFromReadBuffer & storage_join);
+    void addShuffledRuntimeFilter(
+        const substrait::JoinRel & join,
+        const JoinOptimizationInfo & join_opt_info,
+        const DB::TableJoin & table_join,
+        DB::QueryPlan & left,
+        DB::QueryPlan & right,
+        size_t bloom_filter_max_bytes);
+
     void existenceJoinPostProject(DB::QueryPlan & plan, const DB::Names & left_input_cols);
 
     static std::unordered_set<DB::JoinTableSide>
@@ -88,6 +103,7 @@ private:
         const std::vector<DB::TableJoin::JoinOnClause> & join_on_clauses);
     DB::QueryPlanPtr buildSingleOnClauseHashJoin(
         const substrait::JoinRel & join_rel,
+        const JoinOptimizationInfo & join_opt_info,
         std::shared_ptr<DB::TableJoin> table_join,
         DB::QueryPlanPtr left_plan,
         DB::QueryPlanPtr right_plan);
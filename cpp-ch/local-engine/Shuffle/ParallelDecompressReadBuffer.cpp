@@ -0,0 +1,168 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ParallelDecompressReadBuffer.h"
+#include <city.h>
+#include <Compression/CompressionFactory.h>
+#include <Compression/CompressionInfo.h>
+#include <Compression/ICompressionCodec.h>
+#include <Core/Defines.h>
+#include <IO/ReadHelpers.h>
+#include <Common/CurrentMetrics.h>
+#include <Common/Exception.h>
+
+namespace CurrentMetrics
+{
+extern const Metric LocalThread;
+extern const Metric LocalThreadActive;
+extern const Metric LocalThreadScheduled;
+}
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int CORRUPTED_DATA;
+extern const int TOO_LARGE_SIZE_COMPRESSED;
+}
+}
+
+using namespace DB;
+
+namespace local_engine
+{
+
+ParallelDecompressReadBuffer::ParallelDecompressReadBuffer(ReadBuffer & in_, size_t threads, size_t max_prefetched_frames_)
+    : ReadBuffer(nullptr, 0)
+    , in(in_)
+    , max_prefetched_frames(std::max<size_t>(max_prefetched_frames_, 1))
+    , thread_group(CurrentThread::getGroup())
+    , pool(CurrentMetrics::LocalThread, CurrentMetrics::LocalThreadActive, CurrentMetrics::LocalThreadScheduled, std::max<size_t>(threads, 1))
+{
+}
+
+ParallelDecompressReadBuffer::~ParallelDecompressReadBuffer()
+{
+    /// The scheduled jobs notify this object
+    pool.wait();
+}
+
+bool ParallelDecompressReadBuffer::nextImpl()
+{
+    while (true)
+    {
+        /// The consumer is done with the current frame, make room for the next ones
+        current.reset();
+        readAhead();
+
+        std::unique_lock lock(mutex);
+        if (frames.empty())
+            return false;
+        cv.wait(lock, [&] { return frames.front()->ready; });
+        current = std::move(frames.front());
+        frames.pop_front();
+        lock.unlock();
+
+        if (current->exception)
+            std::rethrow_exception(current->exception);
+        if (current->decompressed_size)
+            break;
+    }
+
+    working_buffer = Buffer(current->decompressed.data(), current->decompressed.data() + current->decompressed_size);
+    return true;
+}
+
+void ParallelDecompressReadBuffer::readAhead()
+{
+    while (!in_finished)
+    {
+        {
+            std::lock_guard lock(mutex);
+            if (frames.size() >= max_prefetched_frames)
+                return;
+        }
+
+        auto frame = std::make_shared<Frame>();
+        if (!readFrame(*frame))
+        {
+            in_finished = true;
+            return;
+        }
+
+        {
+            std::lock_guard lock(mutex);
+            frames.push_back(frame);
+        }
+        pool.scheduleOrThrowOnError(
+            [this, frame]
+            {
+                std::optional<ThreadGroupSwitcher> switcher;
+                if (thread_group)
+                    switcher.emplace(thread_group, "ShuffleDecomp");
+                try
+                {
+                    decompress(*frame);
+                }
+                catch (...)
+                {
+                    frame->exception = std::current_exception();
+                }
+                {
+                    std::lock_guard lock(mutex);
+                    frame->ready = true;
+                }
+                cv.notify_all();
+            });
+    }
+}
+
+bool ParallelDecompressReadBuffer::readFrame(Frame & frame)
+{
+    if (in.eof())
+        return false;
+
+    /// checksum | method | compressed size (with header) | decompressed size | data
+    constexpr size_t checksum_size = sizeof(CityHash_v1_0_2::uint128);
+    const size_t header_size = ICompressionCodec::getHeaderSize();
+    char header[checksum_size + COMPRESSED_BLOCK_HEADER_SIZE];
+    in.readStrict(header, checksum_size + header_size);
+
+    const char * codec_header = header + checksum_size;
+    const size_t compressed_size = ICompressionCodec::readCompressedBlockSize(codec_header);
+    if (compressed_size > DBMS_MAX_COMPRESSED_SIZE)
+        throw Exception(ErrorCodes::TOO_LARGE_SIZE_COMPRESSED, "Too large size_compressed: {}. Most likely corrupted data.", compressed_size);
+    if (compressed_size < header_size)
+        throw Exception(ErrorCodes::CORRUPTED_DATA, "Too small size_compressed: {}. Most likely corrupted data.", compressed_size);
+
+    frame.compressed.resize(compressed_size);
+    memcpy(frame.compressed.data(), codec_header, header_size);
+    in.readStrict(frame.compressed.data() + header_size, compressed_size - header_size);
+    return true;
+}
+
+void ParallelDecompressReadBuffer::decompress(Frame & frame)
+{
+    const char * source = frame.compressed.data();
+    const auto codec = CompressionCodecFactory::instance().get(ICompressionCodec::readMethod(source));
+    frame.decompressed_size = ICompressionCodec::readDecompressedBlockSize(source);
+    frame.decompressed.resize(frame.decompressed_size + codec->getAdditionalSizeAtTheEndOfBuffer());
+    codec->decompress(source, static_cast<UInt32>(frame.compressed.size()), frame.decompressed.data());
+    /// The compressed bytes are not needed any more, free them before the consumer gets to the frame
+    frame.compressed = Memory<>();
+}
+
+}
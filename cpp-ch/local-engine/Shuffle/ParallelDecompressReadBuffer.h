@@ -0,0 +1,82 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <IO/BufferWithOwnMemory.h>
+#include <IO/ReadBuffer.h>
+#include <Common/CurrentThread.h>
+#include <Common/ThreadPool.h>
+
+namespace local_engine
+{
+
+/// Reads the same stream as CompressedReadBuffer, but decompresses ahead of the consumer.
+///
+/// The compressed frames are read from `in` on the consumer thread, since for shuffle these are JNI upcalls into the
+/// Java input stream and the task thread is already attached to the JVM. Each frame is handed to a pool of `threads`
+/// threads for decompression, attached to the thread group of the creating thread, so their memory is tracked by the
+/// query. At most `max_prefetched_frames` frames are read ahead. The consumer gets the decompressed frames in stream
+/// order, and working_buffer points directly into the decompressed memory of a frame, so NativeReader coalesces small
+/// blocks without another copy.
+///
+/// Checksums are not verified, same as configureCompressedReadBuffer.
+class ParallelDecompressReadBuffer final : public DB::ReadBuffer
+{
+public:
+    ParallelDecompressReadBuffer(DB::ReadBuffer & in_, size_t threads, size_t max_prefetched_frames_);
+    ~ParallelDecompressReadBuffer() override;
+
+private:
+    struct Frame
+    {
+        DB::Memory<> compressed;
+        DB::Memory<> decompressed;
+        size_t decompressed_size = 0;
+        bool ready = false;
+        std::exception_ptr exception;
+    };
+    using FramePtr = std::shared_ptr<Frame>;
+
+    bool nextImpl() override;
+
+    /// Read frames from `in` until max_prefetched_frames are in flight, and schedule their decompression
+    void readAhead();
+    /// Returns false at the end of `in`
+    bool readFrame(Frame & frame);
+    static void decompress(Frame & frame);
+
+    DB::ReadBuffer & in;
+    const size_t max_prefetched_frames;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    /// Frames in stream order, the front one is consumed next
+    std::deque<FramePtr> frames;
+    bool in_finished = false;
+
+    /// The frame working_buffer points into
+    FramePtr current;
+
+    DB::ThreadGroupPtr thread_group;
+    DB::ThreadPool pool;
+};
+
+}
@@ -15,15 +15,20 @@
  * limitations under the License.
  */
 #include "SelectorBuilder.h"
+#include <bit>
 #include <limits>
 #include <memory>
 #include <Columns/ColumnConst.h>
+#include <Columns/ColumnDecimal.h>
 #include <Columns/ColumnMap.h>
 #include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsNumber.h>
 #include <DataTypes/DataTypeArray.h>
 #include <DataTypes/DataTypeNullable.h>
 #include <DataTypes/DataTypesDecimal.h>
 #include <Functions/FunctionFactory.h>
+#include <Functions/SparkFunctionHashingExtended.h>
 #include <Parser/ExpressionParser.h>
 #include <Parser/ParserContext.h>
 #include <Parser/SerializedPlanParser.h>
@@ -33,6 +38,7 @@
 #include <Common/CHUtil.h>
 #include <Common/Exception.h>
 #include <Common/QueryContext.h>
+#include <Common/assert_cast.h>
 
 namespace DB
 {
@@ -45,6 +51,18 @@ namespace local_engine
 {
 using namespace DB;
 PartitionInfo PartitionInfo::fromSelector(DB::IColumn::Selector selector, size_t partition_num, bool use_external_sort_shuffle)
+{
+    if (use_external_sort_shuffle)
+        return PartitionInfo{.src_partition_num = std::move(selector), .partition_num = partition_num};
+
+    std::vector<size_t> partition_rows(partition_num + 1, 0);
+    for (size_t i = 0; i < selector.size(); ++i)
+        partition_rows[selector[i]]++;
+    return fromSelector(std::move(selector), std::move(partition_rows), partition_num, false);
+}
+
+PartitionInfo PartitionInfo::fromSelector(
+    DB::IColumn::Selector selector, std::vector<size_t> partition_rows, size_t partition_num, bool use_external_sort_shuffle)
 {
     if (use_external_sort_shuffle)
     {
@@ -53,10 +71,9 @@ PartitionInfo PartitionInfo::fromSelector(DB::IColumn::Selector selector, size_t
     else
     {
         auto rows = selector.size();
-        std::vector<size_t> partition_row_idx_start_points(partition_num + 1, 0);
+        std::vector<size_t> partition_row_idx_start_points = std::move(partition_rows);
+        partition_row_idx_start_points.resize(partition_num + 1, 0);
         IColumn::Selector partition_selector(rows, 0);
-        for (size_t i = 0; i < rows; ++i)
-            partition_row_idx_start_points[selector[i]]++;
 
         for (size_t i = 1; i <= partition_num; ++i)
             partition_row_idx_start_points[i] += partition_row_idx_start_points[i - 1];
@@ -91,6 +108,134 @@ HashSelectorBuilder::HashSelectorBuilder(
 {
 }
 
+namespace
+{
+/// Hash a number column into hashes like SparkFunctionAnyHash<SparkMurmurHash3_32>, a null keeps the hash
+template <typename T>
+void murmurHashNumbers(const IColumn & column, const NullMap * null_map, PaddedPODArray<UInt32> & hashes)
+{
+    const auto & data = assert_cast<const ColumnVectorOrDecimal<T> &>(column).getData();
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        UInt32 hash;
+        if constexpr (is_decimal<T>)
+            hash = SparkMurmurHash3_32::applyInt64(static_cast<UInt64>(static_cast<Int64>(data[i].value)), hashes[i]);
+        else if constexpr (std::is_same_v<T, Float32>)
+            hash = SparkMurmurHash3_32::applyInt32(data[i] == 0 || isNaN(data[i]) ? 0 : std::bit_cast<UInt32>(data[i]), hashes[i]);
+        else if constexpr (std::is_same_v<T, Float64>)
+            hash = SparkMurmurHash3_32::applyInt64(data[i] == 0 || isNaN(data[i]) ? 0 : std::bit_cast<UInt64>(data[i]), hashes[i]);
+        else if constexpr (sizeof(T) <= 4)
+        {
+            /// Smaller integers are promoted to 4 bytes, with sign extension for signed ones
+            using Promoted = std::conditional_t<is_signed_v<T>, Int32, UInt32>;
+            hash = SparkMurmurHash3_32::applyInt32(static_cast<UInt32>(static_cast<Promoted>(data[i])), hashes[i]);
+        }
+        else
+            hash = SparkMurmurHash3_32::applyInt64(static_cast<UInt64>(data[i]), hashes[i]);
+        hashes[i] = null_map && (*null_map)[i] ? hashes[i] : hash;
+    }
+}
+
+void murmurHashStrings(const IColumn & column, const NullMap * null_map, PaddedPODArray<UInt32> & hashes)
+{
+    const auto & string_column = assert_cast<const ColumnString &>(column);
+    const auto & chars = string_column.getChars();
+    const auto & offsets = string_column.getOffsets();
+    for (size_t i = 0; i < offsets.size(); ++i)
+    {
+        if (null_map && (*null_map)[i])
+            continue;
+        const auto begin = offsets[i - 1];
+        hashes[i] = SparkMurmurHash3_32::apply(reinterpret_cast<const char *>(&chars[begin]), offsets[i] - begin - 1, hashes[i]);
+    }
+}
+
+/// Types are mapped to columns the same way as SparkFunctionAnyHash::executeAny
+template <typename F>
+bool dispatchFusedMurmurHash(const DataTypePtr & type, F && f)
+{
+    if (type->lowCardinality())
+        return false;
+    const WhichDataType which(removeNullable(type));
+    if (which.isUInt8())
+        f.template operator()<UInt8>();
+    else if (which.isUInt16() || which.isDate())
+        f.template operator()<UInt16>();
+    else if (which.isUInt32() || which.isDateTime())
+        f.template operator()<UInt32>();
+    else if (which.isUInt64())
+        f.template operator()<UInt64>();
+    else if (which.isInt8())
+        f.template operator()<Int8>();
+    else if (which.isInt16())
+        f.template operator()<Int16>();
+    else if (which.isInt32() || which.isDate32())
+        f.template operator()<Int32>();
+    else if (which.isInt64())
+        f.template operator()<Int64>();
+    else if (which.isFloat32())
+        f.template operator()<Float32>();
+    else if (which.isFloat64())
+        f.template operator()<Float64>();
+    else if (which.isDateTime64())
+        f.template operator()<DateTime64>();
+    else if (which.isDecimal32())
+        f.template operator()<Decimal32>();
+    else if (which.isDecimal64())
+        f.template operator()<Decimal64>();
+    else if (which.isString())
+        f.template operator()<String>();
+    else
+        return false;
+    return true;
+}
+}
+
+bool HashSelectorBuilder::canUseFusedMurmurHash(const DB::ColumnsWithTypeAndName & args)
+{
+    return !args.empty()
+        && std::ranges::all_of(args, [](const auto & arg) { return dispatchFusedMurmurHash(arg.type, []<typename T>() { }); });
+}
+
+PartitionInfo HashSelectorBuilder::buildByFusedMurmurHash(const DB::ColumnsWithTypeAndName & args, size_t rows) const
+{
+    /// Initial seed is always 42
+    PaddedPODArray<UInt32> hashes(rows, 42);
+    for (const auto & arg : args)
+    {
+        const auto column = arg.column->convertToFullColumnIfConst();
+        const IColumn * data = column.get();
+        const NullMap * null_map = nullptr;
+        if (const auto * nullable = checkAndGetColumn<ColumnNullable>(data))
+        {
+            data = &nullable->getNestedColumn();
+            null_map = &nullable->getNullMapData();
+        }
+        dispatchFusedMurmurHash(
+            arg.type,
+            [&]<typename T>()
+            {
+                if constexpr (std::is_same_v<T, String>)
+                    murmurHashStrings(*data, null_map, hashes);
+                else
+                    murmurHashNumbers<T>(*data, null_map, hashes);
+            });
+    }
+
+    /// pmod of the hash as an int32, the same as vanilla spark
+    const auto parts_num_int32 = static_cast<Int32>(parts_num);
+    DB::IColumn::Selector partition_ids(rows);
+    std::vector<size_t> partition_rows(parts_num + 1, 0);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        Int32 res = static_cast<Int32>(hashes[i]) % parts_num_int32;
+        res = res < 0 ? res + parts_num_int32 : res;
+        partition_ids[i] = static_cast<UInt64>(res);
+        ++partition_rows[res];
+    }
+    return PartitionInfo::fromSelector(std::move(partition_ids), std::move(partition_rows), parts_num, use_sort_shuffle);
+}
+
 PartitionInfo HashSelectorBuilder::build(DB::Block & block)
 {
     ColumnsWithTypeAndName args;
@@ -99,6 +244,9 @@ PartitionInfo HashSelectorBuilder::build(DB::Block & block)
     auto flatten_block = BlockUtil::flattenBlock(DB::Block(args), BlockUtil::FLAT_STRUCT_FORCE | BlockUtil::FLAT_NESTED_TABLE, true);
     args = flatten_block.getColumnsWithTypeAndName();
 
+    if (hash_function_name == "sparkMurmurHash3_32" && canUseFusedMurmurHash(args))
+        return buildByFusedMurmurHash(args, block.rows());
+
     if (!hash_function) [[unlikely]]
     {
         auto & factory = DB::FunctionFactory::instance();
@@ -171,6 +319,7 @@ RangeSelectorBuilder::RangeSelectorBuilder(const std::string & option, const siz
     auto ordering_infos = info->get("ordering").extract<Poco::JSON::Array::Ptr>();
     initSortInformation(ordering_infos);
     initRangeBlock(info->get("range_bounds").extract<Poco::JSON::Array::Ptr>());
+    initNormalizedBounds();
     partition_num = partition_num_;
 }
 
@@ -344,6 +493,183 @@ void RangeSelectorBuilder::initActionsDAG(const DB::Block & block)
     has_init_actions_dag = true;
 }
 
+namespace
+{
+template <typename T>
+UInt64 toOrderedUInt64(T value)
+{
+    if constexpr (is_decimal<T>)
+        return toOrderedUInt64(value.value);
+    else if constexpr (std::is_signed_v<T>)
+        return static_cast<UInt64>(static_cast<Int64>(value)) ^ (1ULL << 63);
+    else
+        return static_cast<UInt64>(value);
+}
+
+template <typename ColumnType>
+void normalizeValues(const IColumn & column, int direction, PaddedPODArray<UInt64> & keys)
+{
+    const auto & data = assert_cast<const ColumnType &>(column).getData();
+    keys.resize(data.size());
+    /// Descending order is the ascending order of the complement
+    const UInt64 mask = direction < 0 ? ~0ULL : 0;
+    for (size_t i = 0; i < data.size(); ++i)
+        keys[i] = toOrderedUInt64(data[i]) ^ mask;
+}
+
+/// Map the values of column (not Nullable) to UInt64 values with the same order as compareAt * direction.
+/// Returns false if the column type is not supported. Floats are not, NaN compares like a null in compareAt.
+bool normalizeColumn(const IColumn & column, int direction, PaddedPODArray<UInt64> & keys)
+{
+    switch (column.getDataType())
+    {
+        case TypeIndex::UInt8: normalizeValues<ColumnUInt8>(column, direction, keys); return true;
+        case TypeIndex::UInt16: normalizeValues<ColumnUInt16>(column, direction, keys); return true;
+        case TypeIndex::UInt32: normalizeValues<ColumnUInt32>(column, direction, keys); return true;
+        case TypeIndex::UInt64: normalizeValues<ColumnUInt64>(column, direction, keys); return true;
+        case TypeIndex::Int8: normalizeValues<ColumnInt8>(column, direction, keys); return true;
+        case TypeIndex::Int16: normalizeValues<ColumnInt16>(column, direction, keys); return true;
+        case TypeIndex::Int32: normalizeValues<ColumnInt32>(column, direction, keys); return true;
+        case TypeIndex::Int64: normalizeValues<ColumnInt64>(column, direction, keys); return true;
+        case TypeIndex::Decimal32: normalizeValues<ColumnDecimal<Decimal32>>(column, direction, keys); return true;
+        case TypeIndex::Decimal64: normalizeValues<ColumnDecimal<Decimal64>>(column, direction, keys); return true;
+        case TypeIndex::DateTime64: normalizeValues<ColumnDecimal<DateTime64>>(column, direction, keys); return true;
+        default: return false;
+    }
+}
+
+/// Index of the first element of keys[0, n) which is not less than key, without branches in the loop
+ALWAYS_INLINE size_t lowerBound(const UInt64 * keys, size_t n, UInt64 key)
+{
+    if (!n)
+        return 0;
+    const UInt64 * base = keys;
+    while (n > 1)
+    {
+        const size_t half = n / 2;
+        base = base[half] < key ? base + half : base;
+        n -= half;
+    }
+    return (base - keys) + (*base < key);
+}
+
+ALWAYS_INLINE size_t upperBound(const UInt64 * keys, size_t n, UInt64 key)
+{
+    if (!n)
+        return 0;
+    const UInt64 * base = keys;
+    while (n > 1)
+    {
+        const size_t half = n / 2;
+        base = base[half] <= key ? base + half : base;
+        n -= half;
+    }
+    return (base - keys) + (*base <= key);
+}
+}
+
+void RangeSelectorBuilder::initNormalizedBounds()
+{
+    const auto & bound_column = *range_bounds_block.getByPosition(0).column;
+    const IColumn * nested = &bound_column;
+    const NullMap * null_map = nullptr;
+    if (const auto * nullable = checkAndGetColumn<ColumnNullable>(&bound_column))
+    {
+        nested = &nullable->getNestedColumn();
+        null_map = &nullable->getNullMapData();
+    }
+
+    PaddedPODArray<UInt64> keys;
+    if (!normalizeColumn(*nested, sort_descriptions[0].direction, keys))
+        return;
+
+    /// A null compares to a value as nulls_direction, so the null bounds are all at the beginning or all at the end
+    const bool nulls_first = sort_descriptions[0].nulls_direction * sort_descriptions[0].direction < 0;
+    size_t null_begin = bound_column.size();
+    size_t null_end = 0;
+    for (size_t i = 0; null_map && i < null_map->size(); ++i)
+    {
+        if ((*null_map)[i])
+        {
+            null_begin = std::min(null_begin, i);
+            null_end = i + 1;
+        }
+    }
+    if (null_begin > null_end)
+        null_begin = null_end = nulls_first ? 0 : bound_column.size();
+
+    const size_t non_null_begin = nulls_first ? null_end : 0;
+    const size_t non_null_end = nulls_first ? bound_column.size() : null_begin;
+    if ((nulls_first && null_begin != 0) || (!nulls_first && null_end != bound_column.size()))
+        return;
+    for (size_t i = non_null_begin; i < non_null_end; ++i)
+    {
+        if (null_map && (*null_map)[i])
+            return;
+        if (i > non_null_begin && keys[i] < keys[i - 1])
+            return;
+    }
+
+    normalized_bounds.keys.assign(keys.begin() + non_null_begin, keys.begin() + non_null_end);
+    normalized_bounds.non_null_begin = non_null_begin;
+    normalized_bounds.null_begin = null_begin;
+    normalized_bounds.null_end = null_end;
+    normalized_bounds.enabled = true;
+}
+
+bool RangeSelectorBuilder::computePartitionIdByNormalizedKey(const Columns & input_columns, size_t rows, IColumn::Selector & selector)
+{
+    const auto first_key = input_columns[sorting_key_columns[0]]->convertToFullColumnIfConst();
+    const IColumn * nested = first_key.get();
+    const NullMap * null_map = nullptr;
+    if (const auto * nullable = checkAndGetColumn<ColumnNullable>(nested))
+    {
+        nested = &nullable->getNestedColumn();
+        null_map = &nullable->getNullMapData();
+    }
+    if (!nested->structureEquals(*removeNullable(range_bounds_block.getByPosition(0).column)))
+        return false;
+
+    PaddedPODArray<UInt64> keys;
+    if (!normalizeColumn(*nested, sort_descriptions[0].direction, keys))
+        return false;
+
+    const auto & bounds_columns = range_bounds_block.getColumns();
+    const bool single_key = sorting_key_columns.size() == 1;
+    const UInt64 * bound_keys = normalized_bounds.keys.data();
+    const size_t bound_count = normalized_bounds.keys.size();
+
+    /// The bounds in [begin, end) tie with the row on the first key, the rest of the keys decide
+    auto search_ties = [&](size_t row, size_t begin, size_t end) -> size_t
+    {
+        if (begin == end || single_key)
+            return begin;
+        auto ret = binarySearchBound(bounds_columns, begin, end - 1, input_columns, sorting_key_columns, row);
+        return ret >= 0 ? static_cast<size_t>(ret) : end;
+    };
+
+    selector.resize(rows);
+    for (size_t r = 0; r < rows; ++r)
+    {
+        /// Without null bounds, null_begin is 0 or max_part depending on the side the nulls sort to
+        if (null_map && (*null_map)[r])
+        {
+            selector[r] = search_ties(r, normalized_bounds.null_begin, normalized_bounds.null_end);
+            continue;
+        }
+
+        const size_t lower = lowerBound(bound_keys, bound_count, keys[r]);
+        if (single_key || lower == bound_count || bound_keys[lower] != keys[r])
+        {
+            selector[r] = normalized_bounds.non_null_begin + lower;
+            continue;
+        }
+        const size_t upper = lower + upperBound(bound_keys + lower, bound_count - lower, keys[r]);
+        selector[r] = search_ties(r, normalized_bounds.non_null_begin + lower, normalized_bounds.non_null_begin + upper);
+    }
+    return true;
+}
+
 void RangeSelectorBuilder::computePartitionIdByBinarySearch(DB::Block & block, DB::IColumn::Selector & selector)
 {
     Chunks chunks;
@@ -358,6 +684,8 @@ void RangeSelectorBuilder::computePartitionIdByBinarySearch(DB::Block & block, D
     for (size_t i = 0; i < bounds_columns.size(); i++)
         if (bounds_columns[i]->isNullable() && !input_columns[sorting_key_columns[i]]->isNullable())
             input_columns[sorting_key_columns[i]] = makeNullable(input_columns[sorting_key_columns[i]]);
+    if (normalized_bounds.enabled && computePartitionIdByNormalizedKey(input_columns, total_rows, selector))
+        return;
     for (size_t r = 0; r < total_rows; ++r)
     {
         size_t selected_partition = 0;
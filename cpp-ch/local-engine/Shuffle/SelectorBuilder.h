@@ -39,6 +39,9 @@ struct PartitionInfo
     size_t partition_num;
 
     static PartitionInfo fromSelector(DB::IColumn::Selector selector, size_t partition_num, bool use_external_sort_shuffle);
+    /// Same as above, with the rows of each partition already counted in partition_rows[0, partition_num)
+    static PartitionInfo fromSelector(
+        DB::IColumn::Selector selector, std::vector<size_t> partition_rows, size_t partition_num, bool use_external_sort_shuffle);
 };
 
 class SelectorBuilder
@@ -72,6 +75,11 @@ public:
     PartitionInfo build(DB::Block & block) override;
 
 private:
+    /// sparkMurmurHash3_32 of the common key types, computed without the function into a hash buffer, and turned
+    /// into partition ids and partition row counts in one pass.
+    static bool canUseFusedMurmurHash(const DB::ColumnsWithTypeAndName & args);
+    PartitionInfo buildByFusedMurmurHash(const DB::ColumnsWithTypeAndName & args, size_t rows) const;
+
     UInt32 parts_num;
     std::vector<size_t> exprs_index;
     std::string hash_function_name;
@@ -110,6 +118,24 @@ private:
     template <typename T>
     void safeInsertFloatValue(const Poco::Dynamic::Var & field_value, DB::MutableColumnPtr & col);
 
+    /// The first sort key of the range bounds mapped to UInt64 values in the sort order, so that a fixed width
+    /// first key is located with a branchless search over a flat array instead of compareAt calls. Only the rows
+    /// which tie with some bounds on the first key fall back to compareRow.
+    struct NormalizedBounds
+    {
+        bool enabled = false;
+        /// Normalized first key of the non-null bounds, ascending
+        DB::PaddedPODArray<UInt64> keys;
+        /// Position of the first non-null bound in range_bounds_block
+        size_t non_null_begin = 0;
+        /// Range of the bounds whose first key is null
+        size_t null_begin = 0;
+        size_t null_end = 0;
+    };
+    NormalizedBounds normalized_bounds;
+
+    void initNormalizedBounds();
+    bool computePartitionIdByNormalizedKey(const DB::Columns & input_columns, size_t rows, DB::IColumn::Selector & selector);
     void computePartitionIdByBinarySearch(DB::Block & block, DB::IColumn::Selector & selector);
     int compareRow(
         const DB::Columns & columns,
@@ -18,6 +18,7 @@
 #include <Compression/CompressedReadBuffer.h>
 #include <Core/Block.h>
 #include <IO/ReadBuffer.h>
+#include <Shuffle/ParallelDecompressReadBuffer.h>
 #include <jni/jni_common.h>
 #include <Common/DebugUtils.h>
 #include <Common/JNIUtils.h>
@@ -32,10 +33,21 @@ void configureCompressedReadBuffer(DB::CompressedReadBuffer & compressedReadBuff
 {
     compressedReadBuffer.disableChecksumming();
 }
-ShuffleReader::ShuffleReader(std::unique_ptr<ReadBuffer> in_, bool compressed, Int64 max_shuffle_read_rows_, Int64 max_shuffle_read_bytes_)
+ShuffleReader::ShuffleReader(
+    std::unique_ptr<ReadBuffer> in_,
+    bool compressed,
+    Int64 max_shuffle_read_rows_,
+    Int64 max_shuffle_read_bytes_,
+    size_t decompress_threads)
     : in(std::move(in_)), max_shuffle_read_rows(max_shuffle_read_rows_), max_shuffle_read_bytes(max_shuffle_read_bytes_)
 {
-    if (compressed)
+    if (compressed && decompress_threads)
+    {
+        /// Keep every decompressing thread busy while the consumer works on the previous frames
+        compressed_in = std::make_unique<ParallelDecompressReadBuffer>(*in, decompress_threads, decompress_threads * 2);
+        input_stream = std::make_unique<NativeReader>(*compressed_in, max_shuffle_read_rows_, max_shuffle_read_bytes_);
+    }
+    else if (compressed)
     {
         compressed_in = std::make_unique<CompressedReadBuffer>(*in);
         configureCompressedReadBuffer(static_cast<DB::CompressedReadBuffer &>(*compressed_in));
@@ -57,9 +69,10 @@ Block * ShuffleReader::read()
 
 ShuffleReader::~ShuffleReader()
 {
-    in.reset();
-    compressed_in.reset();
+    /// compressed_in reads from in, and may still be decompressing frames on its thread pool
     input_stream.reset();
+    compressed_in.reset();
+    in.reset();
 }
 
 jclass ShuffleReader::shuffle_input_stream_class = nullptr;
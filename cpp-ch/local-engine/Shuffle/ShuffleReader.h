@@ -35,8 +35,14 @@ class ReadBufferFromJavaShuffleInputStream;
 class ShuffleReader : BlockIterator
 {
 public:
+    /// If decompress_threads > 0 and the stream is compressed, frames are decompressed ahead of read() on a thread pool,
+    /// see ParallelDecompressReadBuffer.
     explicit ShuffleReader(
-        std::unique_ptr<DB::ReadBuffer> in_, bool compressed, Int64 max_shuffle_read_rows_, Int64 max_shuffle_read_bytes_);
+        std::unique_ptr<DB::ReadBuffer> in_,
+        bool compressed,
+        Int64 max_shuffle_read_rows_,
+        Int64 max_shuffle_read_bytes_,
+        size_t decompress_threads = 0);
     DB::Block * read();
     ~ShuffleReader();
     static jclass shuffle_input_stream_class;
@@ -24,9 +24,12 @@
 #include <DataTypes/DataTypeNullable.h>
 #include <DataTypes/DataTypeString.h>
 #include <Functions/FunctionHelpers.h>
+#include <IO/ReadBuffer.h>
 #include <IO/WriteBufferFromVector.h>
 #include <IO/WriteHelpers.h>
 #include <Common/Arena.h>
+#include <Common/PODArray.h>
+#include <base/unaligned.h>
 
 using namespace DB;
 
@@ -35,7 +38,7 @@ namespace local_engine
 
 bool isFixedSizeStateAggregateFunction(const String& name)
 {
-    static const std::set<String> function_set = {"min", "max", "sum", "count", "avg"};
+    static const std::set<String> function_set = {"min", "max", "sum", "count", "avg", "sparkAvg"};
     return function_set.contains(name);
 }
 
@@ -145,5 +148,49 @@ DB::Block convertAggregateStateInBlock(DB::Block& block)
     return columns;
 }
 
+namespace
+{
+constexpr size_t COLUMNAR_WORD_SIZE = sizeof(UInt64);
+}
+
+void writeFixedSizeAggregateStatesColumnar(const char * states, size_t rows, size_t state_size, DB::WriteBuffer & out)
+{
+    PaddedPODArray<UInt64> words(rows);
+    for (size_t offset = 0; offset + COLUMNAR_WORD_SIZE <= state_size; offset += COLUMNAR_WORD_SIZE)
+    {
+        const char * src = states + offset;
+        for (size_t i = 0; i < rows; ++i, src += state_size)
+            words[i] = unalignedLoad<UInt64>(src);
+        out.write(reinterpret_cast<const char *>(words.data()), rows * COLUMNAR_WORD_SIZE);
+    }
+
+    PaddedPODArray<char> bytes(rows);
+    for (size_t offset = state_size / COLUMNAR_WORD_SIZE * COLUMNAR_WORD_SIZE; offset < state_size; ++offset)
+    {
+        const char * src = states + offset;
+        for (size_t i = 0; i < rows; ++i, src += state_size)
+            bytes[i] = *src;
+        out.write(bytes.data(), rows);
+    }
 }
 
+void readFixedSizeAggregateStatesColumnar(DB::ReadBuffer & in, char * const * places, size_t rows, size_t state_size)
+{
+    PaddedPODArray<UInt64> words(rows);
+    for (size_t offset = 0; offset + COLUMNAR_WORD_SIZE <= state_size; offset += COLUMNAR_WORD_SIZE)
+    {
+        in.readStrict(reinterpret_cast<char *>(words.data()), rows * COLUMNAR_WORD_SIZE);
+        for (size_t i = 0; i < rows; ++i)
+            unalignedStore<UInt64>(places[i] + offset, words[i]);
+    }
+
+    PaddedPODArray<char> bytes(rows);
+    for (size_t offset = state_size / COLUMNAR_WORD_SIZE * COLUMNAR_WORD_SIZE; offset < state_size; ++offset)
+    {
+        in.readStrict(bytes.data(), rows);
+        for (size_t i = 0; i < rows; ++i)
+            places[i][offset] = bytes[i];
+    }
+}
+
+}
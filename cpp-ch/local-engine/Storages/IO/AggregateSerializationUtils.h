@@ -19,6 +19,12 @@
 #include <Core/Block.h>
 #include <DataTypes/IDataType.h>
 
+namespace DB
+{
+class ReadBuffer;
+class WriteBuffer;
+}
+
 namespace local_engine {
 
 bool isFixedSizeAggregateFunction(const DB::AggregateFunctionPtr & function);
@@ -31,5 +37,14 @@ DB::ColumnWithTypeAndName convertAggregateStateToString(const DB::ColumnWithType
 
 DB::ColumnWithTypeAndName convertFixedStringToAggregateState(const DB::ColumnWithTypeAndName & col, const DB::DataTypePtr & type);
 
+/// Fixed size states are written field by field instead of state by state: the first 8 bytes of every state, then
+/// the next 8 bytes of every state, ..., then the remaining bytes one by one. For avg that is an array of sums
+/// followed by an array of counts, so similar values are next to each other and padding turns into runs of zeros,
+/// which the shuffle codec compresses much better. `states` holds `rows` states of `state_size` bytes each.
+void writeFixedSizeAggregateStatesColumnar(const char * states, size_t rows, size_t state_size, DB::WriteBuffer & out);
+
+/// Read states written by writeFixedSizeAggregateStatesColumnar into created states `places`.
+void readFixedSizeAggregateStatesColumnar(DB::ReadBuffer & in, char * const * places, size_t rows, size_t state_size);
+
 }
 
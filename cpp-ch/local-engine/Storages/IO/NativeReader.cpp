@@ -103,6 +103,23 @@ readFixedSizeAggregateData(DB::ReadBuffer & in, DB::ColumnPtr & column, size_t r
     }
 }
 
+static void
+readColumnarFixedSizeAggregateData(DB::ReadBuffer & in, DB::ColumnPtr & column, size_t rows, NativeReader::ColumnParseUtil & column_parse_util)
+{
+    ColumnAggregateFunction & real_column = typeid_cast<ColumnAggregateFunction &>(*column->assumeMutable());
+    auto & arena = real_column.createOrGetArena();
+    ColumnAggregateFunction::Container & vec = real_column.getData();
+    size_t initial_size = vec.size();
+    vec.reserve_exact(initial_size + rows);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        AggregateDataPtr place = arena.alignedAlloc(column_parse_util.aggregate_state_size, column_parse_util.aggregate_state_align);
+        column_parse_util.aggregate_function->create(place);
+        vec.push_back(place);
+    }
+    readFixedSizeAggregateStatesColumnar(in, vec.data() + initial_size, rows, column_parse_util.aggregate_state_size);
+}
+
 static void
 readVarSizeAggregateData(DB::ReadBuffer & in, DB::ColumnPtr & column, size_t rows, NativeReader::ColumnParseUtil & column_parse_util)
 {
@@ -186,8 +203,15 @@ DB::Block NativeReader::prepareByFirstBlock()
         String type_name;
         readBinary(type_name, istr);
         bool agg_opt_column = false;
+        bool agg_columnar_column = false;
         String real_type_name = type_name;
-        if (type_name.ends_with(NativeWriter::AGG_STATE_SUFFIX))
+        if (type_name.ends_with(NativeWriter::AGG_STATE_COLUMNAR_SUFFIX))
+        {
+            agg_opt_column = true;
+            agg_columnar_column = true;
+            real_type_name = type_name.substr(0, type_name.length() - NativeWriter::AGG_STATE_COLUMNAR_SUFFIX.length());
+        }
+        else if (type_name.ends_with(NativeWriter::AGG_STATE_SUFFIX))
         {
             agg_opt_column = true;
             real_type_name = type_name.substr(0, type_name.length() - NativeWriter::AGG_STATE_SUFFIX.length());
@@ -216,7 +240,12 @@ DB::Block NativeReader::prepareByFirstBlock()
                 column_parse_util.aggregate_state_align = aggregate_function->alignOfData();
 
                 bool fixed = isFixedSizeAggregateFunction(aggregate_function);
-                if (fixed)
+                if (agg_columnar_column)
+                {
+                    readColumnarFixedSizeAggregateData(istr, read_column, rows, column_parse_util);
+                    column_parse_util.parse = readColumnarFixedSizeAggregateData;
+                }
+                else if (fixed)
                 {
                     readFixedSizeAggregateData(istr, read_column, rows, column_parse_util);
                     column_parse_util.parse = readFixedSizeAggregateData;
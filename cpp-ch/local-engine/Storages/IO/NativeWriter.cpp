@@ -18,12 +18,14 @@
 #include <IO/WriteBuffer.h>
 #include <IO/WriteHelpers.h>
 #include <DataTypes/Serializations/ISerialization.h>
+#include <Columns/ColumnFixedString.h>
 #include <Columns/ColumnSparse.h>
 #include <Columns/ColumnString.h>
 #include <Storages/IO/AggregateSerializationUtils.h>
 #include <Functions/FunctionHelpers.h>
 #include <DataTypes/DataTypeAggregateFunction.h>
 #include <DataTypes/DataTypeLowCardinality.h>
+#include <Common/assert_cast.h>
 
 
 using namespace DB;
@@ -32,6 +34,7 @@ namespace local_engine
 {
 
 const String NativeWriter::AGG_STATE_SUFFIX= "#optagg";
+const String NativeWriter::AGG_STATE_COLUMNAR_SUFFIX = "#optaggcol";
 
 void NativeWriter::flush()
 {
@@ -79,7 +82,13 @@ size_t NativeWriter::write(const DB::Block & block)
         String type_name = original_type->getName();
         bool is_agg_opt = WhichDataType(original_type).isAggregateFunction()
             && header.safeGetByPosition(i).column->getDataType() != block.safeGetByPosition(i).column->getDataType();
-        if (is_agg_opt)
+        const auto * agg_type = checkAndGetDataType<DataTypeAggregateFunction>(original_type.get());
+        bool is_agg_columnar = is_agg_opt && agg_type && isFixedSizeAggregateFunction(agg_type->getFunction());
+        if (is_agg_columnar)
+        {
+            writeStringBinary(type_name + AGG_STATE_COLUMNAR_SUFFIX, ostr);
+        }
+        else if (is_agg_opt)
         {
             writeStringBinary(type_name + AGG_STATE_SUFFIX, ostr);
         }
@@ -94,8 +103,13 @@ size_t NativeWriter::write(const DB::Block & block)
         /// Data
         if (rows)    /// Zero items of data is always represented as zero number of bytes.
         {
-            const auto * agg_type = checkAndGetDataType<DataTypeAggregateFunction>(original_type.get());
-            if (is_agg_opt && agg_type && !isFixedSizeAggregateFunction(agg_type->getFunction()))
+            if (is_agg_columnar)
+            {
+                const auto & fixed_str_col = assert_cast<const ColumnFixedString &>(*column.column);
+                writeFixedSizeAggregateStatesColumnar(
+                    reinterpret_cast<const char *>(fixed_str_col.getChars().data()), rows, fixed_str_col.getN(), ostr);
+            }
+            else if (is_agg_opt && agg_type)
             {
                 const auto * str_col = static_cast<const ColumnString *>(column.column.get());
                 const PaddedPODArray<UInt8> & column_chars = str_col->getChars();
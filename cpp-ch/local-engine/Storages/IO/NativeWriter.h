@@ -33,6 +33,8 @@ class NativeWriter
 {
 public:
     static const String AGG_STATE_SUFFIX;
+    /// Fixed size aggregate states written by writeFixedSizeAggregateStatesColumnar
+    static const String AGG_STATE_COLUMNAR_SUFFIX;
     NativeWriter(
         DB::WriteBuffer & ostr_, const DB::Block & header_): ostr(ostr_), header(header_)
     {}
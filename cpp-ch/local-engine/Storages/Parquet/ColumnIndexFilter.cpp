@@ -802,6 +802,10 @@ ColumnIndexFilter::ColumnIndexFilter(const DB::ActionsDAG & filter_dag, DB::Cont
         std::move(context),
         [&](const DB::RPNBuilderTreeNode & node, RPNElement & out) { return extractAtomFromTree(node, out); });
     rpn_ = std::move(builder).extractRPN();
+
+    for (const auto & element : rpn_)
+        if (element.function == RPNElement::FUNCTION_EQUALS || element.function == RPNElement::FUNCTION_IN)
+            equality_columns_.insert(element.columnName);
 }
 
 bool tryPrepareSetIndex(const DB::RPNBuilderFunctionTreeNode & func, ColumnIndexFilter::RPNElement & out)
@@ -989,5 +993,66 @@ RowRanges ColumnIndexFilter::calculateRowRanges(const ColumnIndexStore & index_s
 
     return rpn_stack[0];
 }
+
+bool ColumnIndexFilter::mayMatch(const ColumnValueIndexStore & value_index_store) const
+{
+    std::vector<bool> rpn_stack;
+
+    auto CALL_OPERATOR = [&rpn_stack, &value_index_store](const RPNElement & element, auto && callback)
+    {
+        const auto it = value_index_store.find(element.columnName);
+        rpn_stack.push_back(it == value_index_store.end() || callback(*it->second, element));
+    };
+
+    for (const auto & element : rpn_)
+    {
+        switch (element.function)
+        {
+            case RPNElement::FUNCTION_EQUALS:
+                CALL_OPERATOR(element, [](const ColumnValueIndex & index, const RPNElement & e) { return index.mayContain(e.value); });
+                break;
+            case RPNElement::FUNCTION_IN:
+                CALL_OPERATOR(element, [](const ColumnValueIndex & index, const RPNElement & e) { return index.mayContainAny(e.column); });
+                break;
+            case RPNElement::FUNCTION_NOT_EQUALS:
+            case RPNElement::FUNCTION_LESS:
+            case RPNElement::FUNCTION_GREATER:
+            case RPNElement::FUNCTION_LESS_OR_EQUALS:
+            case RPNElement::FUNCTION_GREATER_OR_EQUALS:
+            case RPNElement::FUNCTION_NOT_IN:
+            case RPNElement::FUNCTION_UNKNOWN:
+            case RPNElement::ALWAYS_TRUE:
+                rpn_stack.push_back(true);
+                break;
+            case RPNElement::ALWAYS_FALSE:
+                rpn_stack.push_back(false);
+                break;
+            case RPNElement::FUNCTION_NOT:
+                /// `not (maybe)` is still maybe, and `not (never)` is always.
+                assert(!rpn_stack.empty());
+                rpn_stack.back() = true;
+                break;
+            case RPNElement::FUNCTION_AND: {
+                assert(rpn_stack.size() >= 2);
+                const bool arg1 = rpn_stack.back();
+                rpn_stack.pop_back();
+                rpn_stack.back() = arg1 && rpn_stack.back();
+                break;
+            }
+            case RPNElement::FUNCTION_OR: {
+                assert(rpn_stack.size() >= 2);
+                const bool arg1 = rpn_stack.back();
+                rpn_stack.pop_back();
+                rpn_stack.back() = arg1 || rpn_stack.back();
+                break;
+            }
+        }
+    }
+
+    if (rpn_stack.size() != 1)
+        throw DB::Exception(DB::ErrorCodes::LOGICAL_ERROR, "Unexpected stack size in ColumnIndexFilter::mayMatch");
+
+    return rpn_stack[0];
+}
 }
-#endif //USE_PARQUET
\ No newline at end of file
+#endif //USE_PARQUET
@@ -22,6 +22,7 @@
 #include <Columns/IColumn.h>
 #include <Core/Field.h>
 #include <Interpreters/ActionsDAG.h>
+#include <Storages/Parquet/ColumnValueIndex.h>
 #include <Storages/Parquet/RowRanges.h>
 #include <parquet/page_index.h>
 
@@ -201,9 +202,17 @@ public:
 private:
     static bool extractAtomFromTree(const DB::RPNBuilderTreeNode & node, RPNElement & out);
     RPN rpn_;
+    std::unordered_set<std::string> equality_columns_;
 
 public:
     RowRanges calculateRowRanges(const ColumnIndexStore & index_store, size_t rowgroup_count) const;
+
+    /// \brief Returns false if no row of the row group can match, only EQUALS and IN atoms are checked against
+    /// the bloom filters or dictionaries in `value_index_store`, other atoms are considered as matching.
+    bool mayMatch(const ColumnValueIndexStore & value_index_store) const;
+
+    /// Columns compared with literals by EQUALS or IN, i.e. the columns for which bloom filters and dictionaries help.
+    const std::unordered_set<std::string> & equalityColumns() const { return equality_columns_; }
 };
 }
 #endif
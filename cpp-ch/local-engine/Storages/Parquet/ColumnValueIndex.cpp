@@ -0,0 +1,334 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ColumnValueIndex.h"
+
+#if USE_PARQUET
+#include <Storages/Parquet/ArrowUtils.h>
+#include <Storages/Parquet/ParquetConverter.h>
+#include <arrow/io/memory.h>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <parquet/column_reader.h>
+#include <parquet/encoding.h>
+#include <parquet/properties.h>
+#include <parquet/schema.h>
+#include <Common/logger_useful.h>
+
+namespace local_engine
+{
+
+namespace
+{
+template <typename DType>
+class TypedBloomFilterIndex final : public ColumnValueIndex
+{
+    using T = typename DType::c_type;
+
+    const parquet::ColumnDescriptor * descr_;
+    std::unique_ptr<parquet::BloomFilter> bloom_filter_;
+
+    uint64_t hash(const T & value) const
+    {
+        if constexpr (std::is_same_v<DType, parquet::FLBAType>)
+            return bloom_filter_->Hash(&value, static_cast<uint32_t>(descr_->type_length()));
+        else if constexpr (std::is_same_v<DType, parquet::ByteArrayType>)
+            return bloom_filter_->Hash(&value);
+        else
+            return bloom_filter_->Hash(value);
+    }
+
+public:
+    TypedBloomFilterIndex(const parquet::ColumnDescriptor * descr, std::unique_ptr<parquet::BloomFilter> bloom_filter)
+        : descr_(descr), bloom_filter_(std::move(bloom_filter))
+    {
+    }
+
+    bool mayContain(const DB::Field & value) const override
+    {
+        /// Null values are not inserted into bloom filters.
+        if (value.isNull())
+            return true;
+        ToParquet<DType> to_parquet;
+        return bloom_filter_->FindHash(hash(to_parquet.as(value, *descr_)));
+    }
+
+    bool mayContainAny(const DB::ColumnPtr & column) const override
+    {
+        if (column->isNullable())
+            return true;
+        const auto converter = ParquetConverter<DType>::Make(column, *descr_);
+        const T * values = converter->getBatch(0, column->size());
+        for (size_t i = 0; i < column->size(); ++i)
+            if (bloom_filter_->FindHash(hash(values[i])))
+                return true;
+        return false;
+    }
+};
+
+template <typename DType>
+class TypedDictionaryIndex final : public ColumnValueIndex
+{
+    using T = typename DType::c_type;
+
+    const parquet::ColumnDescriptor * descr_;
+    /// Decoded byte arrays point into the page buffer.
+    std::shared_ptr<parquet::Page> page_;
+    std::shared_ptr<parquet::TypedComparator<DType>> comparator_;
+    std::vector<T> values_;
+
+    bool less(const T & a, const T & b) const { return comparator_->Compare(a, b); }
+    bool contains(const T & value) const
+    {
+        return std::binary_search(values_.begin(), values_.end(), value, [this](const T & a, const T & b) { return less(a, b); });
+    }
+
+public:
+    TypedDictionaryIndex(const parquet::ColumnDescriptor * descr, const std::shared_ptr<parquet::Page> & page)
+        : descr_(descr), page_(page), comparator_(parquet::MakeComparator<DType>(descr))
+    {
+        const auto & dictionary_page = static_cast<const parquet::DictionaryPage &>(*page_);
+        const int32_t num_values = dictionary_page.num_values();
+        auto decoder = parquet::MakeTypedDecoder<DType>(parquet::Encoding::PLAIN, descr_);
+        decoder->SetData(num_values, dictionary_page.data(), static_cast<int>(dictionary_page.size()));
+        values_.resize(num_values);
+        const int decoded = decoder->Decode(values_.data(), num_values);
+        values_.resize(decoded);
+        std::sort(values_.begin(), values_.end(), [this](const T & a, const T & b) { return less(a, b); });
+    }
+
+    bool mayContain(const DB::Field & value) const override
+    {
+        /// Nulls are not stored in dictionaries.
+        if (value.isNull())
+            return true;
+        ToParquet<DType> to_parquet;
+        return contains(to_parquet.as(value, *descr_));
+    }
+
+    bool mayContainAny(const DB::ColumnPtr & column) const override
+    {
+        if (column->isNullable())
+            return true;
+        const auto converter = ParquetConverter<DType>::Make(column, *descr_);
+        const T * values = converter->getBatch(0, column->size());
+        for (size_t i = 0; i < column->size(); ++i)
+            if (contains(values[i]))
+                return true;
+        return false;
+    }
+};
+}
+
+ColumnValueIndexPtr
+ColumnValueIndex::createBloomFilter(const parquet::ColumnDescriptor * descr, std::unique_ptr<parquet::BloomFilter> bloom_filter)
+{
+    switch (descr->physical_type())
+    {
+        case parquet::Type::INT32:
+            return std::make_unique<TypedBloomFilterIndex<parquet::Int32Type>>(descr, std::move(bloom_filter));
+        case parquet::Type::INT64:
+            return std::make_unique<TypedBloomFilterIndex<parquet::Int64Type>>(descr, std::move(bloom_filter));
+        case parquet::Type::FLOAT:
+            return std::make_unique<TypedBloomFilterIndex<parquet::FloatType>>(descr, std::move(bloom_filter));
+        case parquet::Type::DOUBLE:
+            return std::make_unique<TypedBloomFilterIndex<parquet::DoubleType>>(descr, std::move(bloom_filter));
+        case parquet::Type::BYTE_ARRAY:
+            return std::make_unique<TypedBloomFilterIndex<parquet::ByteArrayType>>(descr, std::move(bloom_filter));
+        case parquet::Type::FIXED_LEN_BYTE_ARRAY:
+            return std::make_unique<TypedBloomFilterIndex<parquet::FLBAType>>(descr, std::move(bloom_filter));
+        default:
+            return nullptr;
+    }
+}
+
+ColumnValueIndexPtr ColumnValueIndex::createDictionary(const parquet::ColumnDescriptor * descr, const std::shared_ptr<parquet::Page> & page)
+{
+    /// Floating point dictionaries are skipped, NaN breaks the ordering used by binary search.
+    switch (descr->physical_type())
+    {
+        case parquet::Type::INT32:
+            return std::make_unique<TypedDictionaryIndex<parquet::Int32Type>>(descr, page);
+        case parquet::Type::INT64:
+            return std::make_unique<TypedDictionaryIndex<parquet::Int64Type>>(descr, page);
+        case parquet::Type::BYTE_ARRAY:
+            return std::make_unique<TypedDictionaryIndex<parquet::ByteArrayType>>(descr, page);
+        case parquet::Type::FIXED_LEN_BYTE_ARRAY:
+            return std::make_unique<TypedDictionaryIndex<parquet::FLBAType>>(descr, page);
+        default:
+            return nullptr;
+    }
+}
+
+ColumnValueIndexReader::ColumnValueIndexReader(
+    const std::shared_ptr<arrow::io::RandomAccessFile> & source,
+    const std::shared_ptr<parquet::FileMetaData> & file_metadata,
+    bool case_insensitive)
+    : source_(source)
+    , file_metadata_(file_metadata)
+    , case_insensitive_(case_insensitive)
+    , cache_(source, arrow::io::IOContext{}, arrow::io::CacheOptions::LazyDefaults())
+{
+    THROW_ARROW_NOT_OK_OR_ASSIGN(const int64_t source_size, source_->GetSize());
+    source_size_ = source_size;
+}
+
+bool ColumnValueIndexReader::isFullyDictionaryEncoded(const parquet::ColumnChunkMetaData & column_metadata)
+{
+    if (!column_metadata.has_dictionary_page())
+        return false;
+
+    auto is_dictionary_encoding = [](parquet::Encoding::type encoding)
+    { return encoding == parquet::Encoding::PLAIN_DICTIONARY || encoding == parquet::Encoding::RLE_DICTIONARY; };
+
+    const auto & encoding_stats = column_metadata.encoding_stats();
+    if (!encoding_stats.empty())
+        return std::ranges::all_of(
+            encoding_stats,
+            [&](const parquet::PageEncodingStats & stats)
+            { return stats.page_type == parquet::PageType::DICTIONARY_PAGE || is_dictionary_encoding(stats.encoding); });
+
+    /// Without encoding stats, fall back to the encodings of the column chunk like parquet-mr does. PLAIN is
+    /// ambiguous here, since v2 writers also use it for the dictionary page, hence it is considered as fallback.
+    const auto & encodings = column_metadata.encodings();
+    return std::ranges::any_of(encodings, is_dictionary_encoding)
+        && std::ranges::all_of(
+               encodings,
+               [&](parquet::Encoding::type encoding)
+               { return is_dictionary_encoding(encoding) || encoding == parquet::Encoding::RLE || encoding == parquet::Encoding::BIT_PACKED; });
+}
+
+std::optional<arrow::io::ReadRange> ColumnValueIndexReader::bloomFilterRange(const parquet::ColumnChunkMetaData & column_metadata) const
+{
+    const auto offset = column_metadata.bloom_filter_offset();
+    if (!offset || *offset <= 0 || *offset >= source_size_)
+        return std::nullopt;
+    const auto length = column_metadata.bloom_filter_length();
+    if (!length || *length <= 0 || *offset + *length > source_size_)
+        return std::nullopt;
+    return arrow::io::ReadRange{*offset, *length};
+}
+
+std::optional<arrow::io::ReadRange> ColumnValueIndexReader::dictionaryRange(const parquet::ColumnChunkMetaData & column_metadata)
+{
+    if (!isFullyDictionaryEncoded(column_metadata))
+        return std::nullopt;
+    const int64_t offset = column_metadata.dictionary_page_offset();
+    const int64_t data_offset = column_metadata.data_page_offset();
+    if (offset <= 0 || offset >= data_offset)
+        return std::nullopt;
+    return arrow::io::ReadRange{offset, data_offset - offset};
+}
+
+void ColumnValueIndexReader::prefetch(const std::vector<Int32> & row_groups, const std::vector<Int32> & column_indices)
+{
+    std::vector<arrow::io::ReadRange> ranges;
+    for (const auto row_group : row_groups)
+    {
+        const auto rg_meta = file_metadata_->RowGroup(row_group);
+        for (const auto column_index : column_indices)
+        {
+            const auto column_metadata = rg_meta->ColumnChunk(column_index);
+            if (auto bloom_filter_range = bloomFilterRange(*column_metadata))
+                ranges.emplace_back(*bloom_filter_range);
+            else if (!column_metadata->bloom_filter_offset())
+                if (auto dictionary_range = dictionaryRange(*column_metadata))
+                    ranges.emplace_back(*dictionary_range);
+        }
+    }
+    if (!ranges.empty())
+        THROW_ARROW_NOT_OK(cache_.Cache(std::move(ranges)));
+}
+
+ColumnValueIndexPtr
+ColumnValueIndexReader::readBloomFilter(const parquet::ColumnDescriptor * descr, const parquet::ColumnChunkMetaData & column_metadata)
+{
+    const parquet::ReaderProperties properties;
+    std::shared_ptr<arrow::io::InputStream> stream;
+    std::optional<int64_t> length;
+    if (const auto range = bloomFilterRange(column_metadata))
+    {
+        THROW_ARROW_NOT_OK_OR_ASSIGN(auto buffer, cache_.Read(*range));
+        stream = std::make_shared<arrow::io::BufferReader>(buffer);
+        length = range->length;
+    }
+    else
+    {
+        /// Writers before parquet-format 2.10 don't record the length, the header has to be parsed first.
+        const int64_t offset = *column_metadata.bloom_filter_offset();
+        THROW_ARROW_NOT_OK_OR_ASSIGN(stream, arrow::io::RandomAccessFile::GetStream(source_, offset, source_size_ - offset));
+    }
+    auto bloom_filter
+        = std::make_unique<parquet::BlockSplitBloomFilter>(parquet::BlockSplitBloomFilter::Deserialize(properties, stream.get(), length));
+    return ColumnValueIndex::createBloomFilter(descr, std::move(bloom_filter));
+}
+
+ColumnValueIndexPtr
+ColumnValueIndexReader::readDictionary(const parquet::ColumnDescriptor * descr, const parquet::ColumnChunkMetaData & column_metadata)
+{
+    const auto range = dictionaryRange(column_metadata);
+    if (!range)
+        return nullptr;
+
+    THROW_ARROW_NOT_OK_OR_ASSIGN(auto buffer, cache_.Read(*range));
+    // Prior to Arrow 3.0.0, is_compressed was always set to false in column headers,
+    // even if compression was used. See ARROW-17100.
+    const bool always_compressed
+        = file_metadata_->writer_version().VersionLt(parquet::ApplicationVersion::PARQUET_CPP_10353_FIXED_VERSION());
+    const parquet::ReaderProperties properties;
+    auto page_reader = parquet::PageReader::Open(
+        std::make_shared<arrow::io::BufferReader>(buffer),
+        column_metadata.num_values(),
+        column_metadata.compression(),
+        properties,
+        always_compressed);
+    auto page = page_reader->NextPage();
+    if (!page || page->type() != parquet::PageType::DICTIONARY_PAGE)
+        return nullptr;
+    return ColumnValueIndex::createDictionary(descr, page);
+}
+
+ColumnValueIndexStore ColumnValueIndexReader::read(Int32 row_group, const std::vector<Int32> & column_indices)
+{
+    ColumnValueIndexStore result;
+    const auto rg_meta = file_metadata_->RowGroup(row_group);
+    for (const auto column_index : column_indices)
+    {
+        const auto * descr = rg_meta->schema()->Column(column_index);
+        const auto column_metadata = rg_meta->ColumnChunk(column_index);
+
+        ColumnValueIndexPtr value_index;
+        try
+        {
+            value_index = column_metadata->bloom_filter_offset() ? readBloomFilter(descr, *column_metadata)
+                                                                  : readDictionary(descr, *column_metadata);
+        }
+        catch (const std::exception & e)
+        {
+            /// It is only an optimization, a corrupted bloom filter or dictionary must not fail the query.
+            LOG_WARNING(getLogger("ColumnValueIndexReader"), "Failed to read bloom filter or dictionary of {}: {}", descr->name(), e.what());
+        }
+
+        if (value_index)
+        {
+            const std::string column_name = case_insensitive_ ? boost::to_lower_copy(descr->name()) : descr->name();
+            result[column_name] = std::move(value_index);
+        }
+    }
+    return result;
+}
+
+}
+#endif
@@ -0,0 +1,92 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include <config.h>
+
+#if USE_PARQUET
+#include <memory>
+#include <unordered_map>
+#include <Columns/IColumn.h>
+#include <Core/Field.h>
+#include <arrow/io/caching.h>
+#include <parquet/bloom_filter.h>
+#include <parquet/column_page.h>
+#include <parquet/metadata.h>
+
+namespace local_engine
+{
+class ColumnValueIndex;
+using ColumnValueIndexPtr = std::unique_ptr<ColumnValueIndex>;
+using ColumnValueIndexStore = std::unordered_map<std::string, ColumnValueIndexPtr>;
+
+/**
+ * Answers whether a column chunk may contain a value, using structures that are much cheaper to read than data
+ * pages: the split-block bloom filter, or the dictionary page of a fully dictionary-encoded column chunk.
+ *
+ * Unlike ColumnIndex, it only helps equality and IN predicates, which min/max statistics rarely prune on
+ * high-cardinality keys.
+ */
+class ColumnValueIndex
+{
+public:
+    virtual ~ColumnValueIndex() = default;
+
+    /// column == literal
+    virtual bool mayContain(const DB::Field & value) const = 0;
+
+    /// column in (literals)
+    virtual bool mayContainAny(const DB::ColumnPtr & column) const = 0;
+
+    static ColumnValueIndexPtr
+    createBloomFilter(const parquet::ColumnDescriptor * descr, std::unique_ptr<parquet::BloomFilter> bloom_filter);
+
+    /// Returns nullptr if the dictionary page can't be used for this physical type.
+    static ColumnValueIndexPtr createDictionary(const parquet::ColumnDescriptor * descr, const std::shared_ptr<parquet::Page> & page);
+};
+
+/// Reads bloom filters and dictionary pages of column chunks. All ranges of the requested row groups are planned
+/// upfront and fetched through coalesced range reads, before any data page is decoded.
+class ColumnValueIndexReader
+{
+public:
+    ColumnValueIndexReader(
+        const std::shared_ptr<arrow::io::RandomAccessFile> & source,
+        const std::shared_ptr<parquet::FileMetaData> & file_metadata,
+        bool case_insensitive);
+
+    void prefetch(const std::vector<Int32> & row_groups, const std::vector<Int32> & column_indices);
+
+    ColumnValueIndexStore read(Int32 row_group, const std::vector<Int32> & column_indices);
+
+    static bool isFullyDictionaryEncoded(const parquet::ColumnChunkMetaData & column_metadata);
+
+private:
+    std::optional<arrow::io::ReadRange> bloomFilterRange(const parquet::ColumnChunkMetaData & column_metadata) const;
+    static std::optional<arrow::io::ReadRange> dictionaryRange(const parquet::ColumnChunkMetaData & column_metadata);
+
+    ColumnValueIndexPtr readBloomFilter(const parquet::ColumnDescriptor * descr, const parquet::ColumnChunkMetaData & column_metadata);
+    ColumnValueIndexPtr readDictionary(const parquet::ColumnDescriptor * descr, const parquet::ColumnChunkMetaData & column_metadata);
+
+    std::shared_ptr<arrow::io::RandomAccessFile> source_;
+    int64_t source_size_;
+    std::shared_ptr<parquet::FileMetaData> file_metadata_;
+    const bool case_insensitive_;
+    arrow::io::internal::ReadRangeCache cache_;
+};
+
+}
+#endif
@@ -0,0 +1,212 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ParquetFooterCache.h"
+
+#include <Common/MemoryTracker.h>
+#include <Common/MemoryTrackerSwitcher.h>
+#include <Common/logger_useful.h>
+
+namespace local_engine
+{
+
+ParquetFooterCache & ParquetFooterCache::instance()
+{
+    static ParquetFooterCache cache;
+    return cache;
+}
+
+MemoryTracker & ParquetFooterCache::memoryTracker()
+{
+    static MemoryTracker tracker(&total_memory_tracker, VariableContext::Global);
+    static std::once_flag described;
+    std::call_once(described, [] { tracker.setDescription("(for parquet footer cache)"); });
+    return tracker;
+}
+
+void ParquetFooterCache::initialize(size_t max_size_in_bytes_)
+{
+    MemoryTrackerSwitcher switcher(&memoryTracker());
+    std::lock_guard lock(mutex);
+    max_size_in_bytes = max_size_in_bytes_;
+    queue.clear();
+    entries.clear();
+    current_size_in_bytes = 0;
+    hit_count = 0;
+    miss_count = 0;
+    LOG_INFO(getLogger("ParquetFooterCache"), "Initialize parquet footer cache with max size {} bytes", max_size_in_bytes_);
+}
+
+void ParquetFooterCache::clear()
+{
+    MemoryTrackerSwitcher switcher(&memoryTracker());
+    std::lock_guard lock(mutex);
+    queue.clear();
+    entries.clear();
+    current_size_in_bytes = 0;
+}
+
+ParquetFooterCache::LRUQueue::iterator ParquetFooterCache::findLocked(const ParquetFileIdentity & file)
+{
+    auto it = entries.find(file.path);
+    if (it == entries.end())
+        return queue.end();
+
+    auto entry = it->second;
+    if (entry->identity != file)
+    {
+        /// The file was overwritten, the cached footer is stale.
+        removeLocked(entry);
+        return queue.end();
+    }
+    queue.splice(queue.end(), queue, entry);
+    return entry;
+}
+
+void ParquetFooterCache::removeLocked(LRUQueue::iterator it)
+{
+    /// Freed here unless a reader still holds the footer
+    MemoryTrackerSwitcher switcher(&memoryTracker());
+    current_size_in_bytes -= it->weight;
+    entries.erase(it->identity.path);
+    queue.erase(it);
+}
+
+void ParquetFooterCache::evictLocked()
+{
+    /// Always keep the most recently used entry, even if it alone exceeds the limit.
+    while (current_size_in_bytes > max_size_in_bytes && queue.size() > 1)
+        removeLocked(queue.begin());
+}
+
+std::shared_ptr<parquet::FileMetaData> ParquetFooterCache::getFileMetaData(const ParquetFileIdentity & file)
+{
+    if (!enabled())
+        return nullptr;
+
+    std::lock_guard lock(mutex);
+    auto it = findLocked(file);
+    if (it == queue.end())
+    {
+        ++miss_count;
+        return nullptr;
+    }
+    ++hit_count;
+    return it->metadata;
+}
+
+void ParquetFooterCache::setFileMetaData(const ParquetFileIdentity & file, const std::shared_ptr<parquet::FileMetaData> & metadata)
+{
+    if (!enabled() || !metadata)
+        return;
+
+    std::lock_guard lock(mutex);
+    if (findLocked(file) != queue.end())
+        return;
+
+    Entry & entry = queue.emplace_back(Entry{.identity = file, .metadata = metadata});
+    entry.weight = weightOf(*metadata);
+    entries.emplace(file.path, std::prev(queue.end()));
+    current_size_in_bytes += entry.weight;
+    evictLocked();
+}
+
+std::optional<ParquetColumnPageIndex> ParquetFooterCache::getPageIndex(const ParquetFileIdentity & file, Int32 row_group, Int32 column)
+{
+    if (!enabled())
+        return std::nullopt;
+
+    std::lock_guard lock(mutex);
+    auto it = findLocked(file);
+    if (it == queue.end())
+        return std::nullopt;
+
+    auto page_index = it->page_indexes.find({row_group, column});
+    if (page_index == it->page_indexes.end())
+        return std::nullopt;
+    return page_index->second;
+}
+
+void ParquetFooterCache::setPageIndex(
+    const ParquetFileIdentity & file, Int32 row_group, Int32 column, const ParquetColumnPageIndex & page_index)
+{
+    if (!enabled())
+        return;
+
+    std::lock_guard lock(mutex);
+    /// Page indexes are only attached to a cached footer, they are useless without it.
+    auto it = findLocked(file);
+    if (it == queue.end())
+        return;
+
+    if (!it->page_indexes.emplace(std::make_pair(row_group, column), page_index).second)
+        return;
+
+    const size_t weight = weightOf(page_index);
+    it->weight += weight;
+    current_size_in_bytes += weight;
+    evictLocked();
+}
+
+size_t ParquetFooterCache::sizeInBytes() const
+{
+    std::lock_guard lock(mutex);
+    return current_size_in_bytes;
+}
+
+size_t ParquetFooterCache::count() const
+{
+    std::lock_guard lock(mutex);
+    return queue.size();
+}
+
+size_t ParquetFooterCache::hits() const
+{
+    std::lock_guard lock(mutex);
+    return hit_count;
+}
+
+size_t ParquetFooterCache::misses() const
+{
+    std::lock_guard lock(mutex);
+    return miss_count;
+}
+
+size_t ParquetFooterCache::weightOf(const parquet::FileMetaData & metadata)
+{
+    /// The thrift encoded size underestimates the parsed footer, which also keeps the schema descriptor and
+    /// the decoded row group/column chunk structures, so we charge it twice.
+    return sizeof(Entry) + 2 * static_cast<size_t>(metadata.size());
+}
+
+size_t ParquetFooterCache::weightOf(const ParquetColumnPageIndex & page_index)
+{
+    size_t weight = sizeof(ParquetColumnPageIndex);
+    if (page_index.offset_index)
+        weight += page_index.offset_index->page_locations().size() * sizeof(parquet::PageLocation);
+    if (page_index.column_index)
+    {
+        const auto & column_index = *page_index.column_index;
+        for (const auto & value : column_index.encoded_min_values())
+            weight += value.size();
+        for (const auto & value : column_index.encoded_max_values())
+            weight += value.size();
+        weight += column_index.null_pages().size() / 8 + column_index.null_counts().size() * sizeof(int64_t);
+    }
+    return weight;
+}
+
+}
@@ -0,0 +1,121 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <base/types.h>
+#include <parquet/metadata.h>
+#include <parquet/page_index.h>
+
+class MemoryTracker;
+
+namespace local_engine
+{
+
+/// Identity of a parquet file. A cached footer is only valid if both the modification time and the length
+/// still match, the same rule FileCacheConcurrentMap applies to the local file cache.
+struct ParquetFileIdentity
+{
+    String path;
+    size_t last_modified_time = 0;
+    size_t file_size = 0;
+
+    bool operator==(const ParquetFileIdentity & other) const = default;
+};
+
+/// Parsed page index of one column chunk, the raw material of ColumnIndex::create.
+struct ParquetColumnPageIndex
+{
+    std::shared_ptr<parquet::ColumnIndex> column_index;
+    std::shared_ptr<parquet::OffsetIndex> offset_index;
+};
+
+/// Executor-wide, size-bounded LRU cache of parsed parquet footers and page indexes.
+///
+/// Every split of a file, and every query reading the same file, used to open the file and parse
+/// `parquet::FileMetaData` again (plus the column/offset indexes when page index reader is used).
+/// Entries are keyed by path and validated by ParquetFileIdentity, a stale entry is dropped on lookup.
+///
+/// FileCacheConcurrentMap is not reused: it is an unbounded map of file versions without values, and updating a version
+/// there removes the file from a DB::FileCache. The LRU below adds values and byte-bounded eviction, and only borrows
+/// its versioning rule.
+///
+/// The parsed footers and page indexes are charged to memoryTracker(). The hits and misses of each scan are reported in
+/// its rel metrics, see ParquetMetaBuilder::footerCacheHits.
+class ParquetFooterCache
+{
+public:
+    static ParquetFooterCache & instance();
+
+    /// Initialized in native init phase, max_size_in_bytes = 0 disables the cache.
+    void initialize(size_t max_size_in_bytes);
+    void clear();
+    bool enabled() const { return max_size_in_bytes > 0; }
+
+    std::shared_ptr<parquet::FileMetaData> getFileMetaData(const ParquetFileIdentity & file);
+    void setFileMetaData(const ParquetFileIdentity & file, const std::shared_ptr<parquet::FileMetaData> & metadata);
+
+    std::optional<ParquetColumnPageIndex> getPageIndex(const ParquetFileIdentity & file, Int32 row_group, Int32 column);
+    void setPageIndex(const ParquetFileIdentity & file, Int32 row_group, Int32 column, const ParquetColumnPageIndex & page_index);
+
+    /// The memory of the cached footers and page indexes on the executor is charged to this tracker, which is a child
+    /// of the Total Memory Tracker. It's switched to in the threads parsing entries to cache and evicting them.
+    static MemoryTracker & memoryTracker();
+
+    /// Statistics since the last initialize()
+    size_t sizeInBytes() const;
+    size_t count() const;
+    size_t hits() const;
+    size_t misses() const;
+
+private:
+    struct Entry
+    {
+        ParquetFileIdentity identity;
+        std::shared_ptr<parquet::FileMetaData> metadata;
+        std::map<std::pair<Int32, Int32>, ParquetColumnPageIndex> page_indexes;
+        size_t weight = 0;
+    };
+    using LRUQueue = std::list<Entry>;
+
+    ParquetFooterCache() = default;
+
+    /// Find a valid entry and move it to the tail of the LRU queue, caller must hold the mutex.
+    LRUQueue::iterator findLocked(const ParquetFileIdentity & file);
+    void removeLocked(LRUQueue::iterator it);
+    void evictLocked();
+
+    static size_t weightOf(const parquet::FileMetaData & metadata);
+    static size_t weightOf(const ParquetColumnPageIndex & page_index);
+
+    mutable std::mutex mutex;
+    LRUQueue queue;
+    std::unordered_map<String, LRUQueue::iterator> entries;
+
+    std::atomic<size_t> max_size_in_bytes{0};
+    size_t current_size_in_bytes = 0;
+    size_t hit_count = 0;
+    size_t miss_count = 0;
+};
+
+}
@@ -26,6 +26,7 @@
 #include <parquet/arrow/reader.h>
 #include <parquet/arrow/schema.h>
 #include <parquet/metadata.h>
+#include <Common/MemoryTrackerSwitcher.h>
 
 namespace DB
 {
@@ -40,15 +41,47 @@ using namespace DB;
 namespace local_engine
 {
 
-std::unique_ptr<parquet::ParquetFileReader> ParquetMetaBuilder::openInputParquetFile(ReadBuffer & read_buffer)
+std::shared_ptr<arrow::io::RandomAccessFile> ParquetMetaBuilder::openArrowFile(ReadBuffer & read_buffer)
 {
     const FormatSettings format_settings{
         .seekable_read = true,
     };
     std::atomic<int> is_stopped{0};
-    auto arrow_file = asArrowFile(read_buffer, format_settings, is_stopped, "Parquet", PARQUET_MAGIC_BYTES);
+    return asArrowFile(read_buffer, format_settings, is_stopped, "Parquet", PARQUET_MAGIC_BYTES);
+}
 
-    return parquet::ParquetFileReader::Open(arrow_file, parquet::default_reader_properties(), nullptr);
+std::unique_ptr<parquet::ParquetFileReader>
+ParquetMetaBuilder::openInputParquetFile(ReadBuffer & read_buffer, const std::shared_ptr<parquet::FileMetaData> & metadata)
+{
+    return parquet::ParquetFileReader::Open(openArrowFile(read_buffer), parquet::default_reader_properties(), metadata);
+}
+
+std::unique_ptr<parquet::ParquetFileReader> ParquetMetaBuilder::openFile(const std::shared_ptr<arrow::io::RandomAccessFile> & arrow_file)
+{
+    if (!fileIdentity)
+    {
+        auto reader = parquet::ParquetFileReader::Open(arrow_file, parquet::default_reader_properties());
+        fileMetaData = reader->metadata();
+        return reader;
+    }
+
+    auto & footer_cache = ParquetFooterCache::instance();
+    auto cached_metadata = footer_cache.getFileMetaData(*fileIdentity);
+    if (cached_metadata)
+    {
+        ++footerCacheHits;
+        auto reader = parquet::ParquetFileReader::Open(arrow_file, parquet::default_reader_properties(), cached_metadata);
+        fileMetaData = reader->metadata();
+        return reader;
+    }
+
+    ++footerCacheMisses;
+    /// The parsed footer outlives this scan, so charge it to the cache rather than to the query.
+    MemoryTrackerSwitcher switcher(&ParquetFooterCache::memoryTracker());
+    auto reader = parquet::ParquetFileReader::Open(arrow_file, parquet::default_reader_properties());
+    fileMetaData = reader->metadata();
+    footer_cache.setFileMetaData(*fileIdentity, fileMetaData);
+    return reader;
 }
 
 Block ParquetMetaBuilder::collectFileSchema(const ContextPtr & context, ReadBuffer & read_buffer)
@@ -84,22 +117,45 @@ std::vector<Int32> ParquetMetaBuilder::pruneColumn(
 }
 
 std::unique_ptr<ColumnIndexStore> ParquetMetaBuilder::collectColumnIndex(
-    const parquet::RowGroupMetaData & rgMeta,
-    parquet::RowGroupPageIndexReader & rowGroupPageIndex,
-    const std::vector<Int32> & column_indices,
-    bool case_insensitive)
+    parquet::ParquetFileReader & reader, const parquet::RowGroupMetaData & rgMeta, Int32 row_group_index) const
 {
+    auto & footer_cache = ParquetFooterCache::instance();
+    std::shared_ptr<parquet::RowGroupPageIndexReader> rowGroupPageIndex;
+
     auto result = std::make_unique<ColumnIndexStore>();
     ColumnIndexStore & column_index_store = *result;
-    column_index_store.reserve(column_indices.size());
+    column_index_store.reserve(readColumns.size());
 
-    for (auto const column_index : column_indices)
+    for (auto const column_index : readColumns)
     {
+        std::optional<ParquetColumnPageIndex> page_index;
+        if (fileIdentity)
+            page_index = footer_cache.getPageIndex(*fileIdentity, row_group_index, column_index);
+
+        if (!page_index)
+        {
+            std::optional<MemoryTrackerSwitcher> switcher;
+            if (fileIdentity)
+                switcher.emplace(&ParquetFooterCache::memoryTracker());
+
+            /// Only touch the page index of the file if some column is not cached.
+            if (!rowGroupPageIndex)
+            {
+                const auto pageIndex = reader.GetPageIndexReader();
+                rowGroupPageIndex = pageIndex == nullptr ? nullptr : pageIndex->RowGroup(row_group_index);
+                if (rowGroupPageIndex == nullptr)
+                    return nullptr;
+            }
+            page_index = ParquetColumnPageIndex{
+                .column_index = rowGroupPageIndex->GetColumnIndex(column_index),
+                .offset_index = rowGroupPageIndex->GetOffsetIndex(column_index)};
+            if (fileIdentity)
+                footer_cache.setPageIndex(*fileIdentity, row_group_index, column_index, *page_index);
+        }
+
         const auto * col_desc = rgMeta.schema()->Column(column_index);
-        const auto col_index = rowGroupPageIndex.GetColumnIndex(column_index);
-        const auto offset_index = rowGroupPageIndex.GetOffsetIndex(column_index);
         const std::string columnName = case_insensitive ? boost::to_lower_copy(col_desc->name()) : col_desc->name();
-        column_index_store[columnName] = ColumnIndex::create(col_desc, col_index, offset_index);
+        column_index_store[columnName] = ColumnIndex::create(col_desc, page_index->column_index, page_index->offset_index);
     }
     return result;
 }
@@ -191,8 +247,59 @@ ParquetMetaBuilder & ParquetMetaBuilder::buildAllRowRange(const parquet::FileMet
     return *this;
 }
 
+std::unique_ptr<ColumnValueIndexReader> ParquetMetaBuilder::createValueIndexReader(
+    const std::shared_ptr<arrow::io::RandomAccessFile> & arrow_file,
+    const std::vector<Int32> & columns,
+    const ColumnIndexFilter & column_index_filter)
+{
+    if (!format_settings.parquet.bloom_filter_push_down || column_index_filter.equalityColumns().empty())
+        return nullptr;
+
+    const auto & schema = *fileMetaData->schema();
+    for (auto const column_index : columns)
+    {
+        const auto & name = schema.Column(column_index)->name();
+        if (column_index_filter.equalityColumns().contains(case_insensitive ? boost::to_lower_copy(name) : name))
+            valueIndexColumns.push_back(column_index);
+    }
+    if (valueIndexColumns.empty())
+        return nullptr;
+
+    std::vector<Int32> row_groups;
+    row_groups.reserve(readRowGroups.size());
+    for (const auto & row_group : readRowGroups)
+        row_groups.push_back(row_group.index);
+
+    auto reader = std::make_unique<ColumnValueIndexReader>(arrow_file, fileMetaData, case_insensitive);
+    reader->prefetch(row_groups, valueIndexColumns);
+    return reader;
+}
+
+ParquetMetaBuilder & ParquetMetaBuilder::pruneRowGroups(
+    const std::shared_ptr<arrow::io::RandomAccessFile> & arrow_file,
+    const parquet::FileMetaData & file_meta,
+    const Block & readBlock,
+    const ColumnIndexFilter * column_index_filter)
+{
+    /// With page indexes, buildRowRange gives such row groups empty row ranges instead, since ColumnIndexRowRangesProvider
+    /// needs continuous row groups.
+    if (collectPageIndex || column_index_filter == nullptr || readRowGroups.empty())
+        return *this;
+
+    const auto columns = pruneColumn(readBlock, file_meta, case_insensitive, allow_missing_columns);
+    const auto value_index_reader = createValueIndexReader(arrow_file, columns, *column_index_filter);
+    if (!value_index_reader)
+        return *this;
+    std::erase_if(
+        readRowGroups,
+        [&](const RowGroupInformation & row_group)
+        { return !column_index_filter->mayMatch(value_index_reader->read(row_group.index, valueIndexColumns)); });
+    return *this;
+}
+
 ParquetMetaBuilder & ParquetMetaBuilder::buildRowRange(
     parquet::ParquetFileReader & reader,
+    const std::shared_ptr<arrow::io::RandomAccessFile> & arrow_file,
     const parquet::FileMetaData & file_meta,
     const Block & readBlock,
     const ColumnIndexFilter * column_index_filter)
@@ -200,16 +307,25 @@ ParquetMetaBuilder & ParquetMetaBuilder::buildRowRange(
     if (collectPageIndex)
     {
         readColumns = pruneColumn(readBlock, file_meta, case_insensitive, allow_missing_columns);
+
+        /// Bloom filters and dictionaries of all row groups are fetched with coalesced reads before the page indexes.
+        const auto value_index_reader
+            = column_index_filter == nullptr ? nullptr : createValueIndexReader(arrow_file, readColumns, *column_index_filter);
         for (auto & row_group : readRowGroups)
         {
+            if (value_index_reader && !column_index_filter->mayMatch(value_index_reader->read(row_group.index, valueIndexColumns)))
+            {
+                /// Empty row ranges, the whole row group is skipped.
+                row_group.rowRanges = RowRanges{};
+                continue;
+            }
+
             const auto rgMeta = file_meta.RowGroup(row_group.index);
-            const auto pageIndex = reader.GetPageIndexReader();
-            const auto rowGroupPageIndex = pageIndex == nullptr ? nullptr : pageIndex->RowGroup(row_group.index);
-            if (column_index_filter == nullptr || rowGroupPageIndex == nullptr)
+            auto columnIndex = column_index_filter == nullptr ? nullptr : collectColumnIndex(reader, *rgMeta, row_group.index);
+            if (columnIndex == nullptr)
                 row_group.rowRanges = RowRanges::createSingle(row_group.num_rows);
             else
             {
-                auto columnIndex = collectColumnIndex(*rgMeta, *rowGroupPageIndex, readColumns, case_insensitive);
                 row_group.rowRanges = column_index_filter->calculateRowRanges(*columnIndex, row_group.num_rows);
                 row_group.columnIndexStore = std::move(columnIndex);
             }
@@ -224,18 +340,18 @@ ParquetMetaBuilder & ParquetMetaBuilder::build(
     const ColumnIndexFilter * column_index_filter,
     const std::function<bool(UInt64)> & should_include_row_group)
 {
-    auto reader = openInputParquetFile(read_buffer);
-    fileMetaData = reader->metadata();
+    auto arrow_file = openArrowFile(read_buffer);
+    auto reader = openFile(arrow_file);
     return buildRequiredRowGroups(*fileMetaData, should_include_row_group)
+        .pruneRowGroups(arrow_file, *fileMetaData, readBlock, column_index_filter)
         .buildSkipRowGroup(*fileMetaData)
         .buildSchema(*fileMetaData)
-        .buildRowRange(*reader, *fileMetaData, readBlock, column_index_filter);
+        .buildRowRange(*reader, arrow_file, *fileMetaData, readBlock, column_index_filter);
 }
 
 ParquetMetaBuilder & ParquetMetaBuilder::build(ReadBuffer & read_buffer, const std::function<bool(UInt64)> & should_include_row_group)
 {
-    auto reader = openInputParquetFile(read_buffer);
-    fileMetaData = reader->metadata();
+    auto reader = openFile(openArrowFile(read_buffer));
     return buildRequiredRowGroups(*fileMetaData, should_include_row_group)
         .buildSkipRowGroup(*fileMetaData)
         .buildSchema(*fileMetaData)
@@ -19,6 +19,7 @@
 #include <Core/Block.h>
 #include <Formats/FormatSettings.h>
 #include <Storages/Parquet/ColumnIndexFilter.h>
+#include <Storages/Parquet/ParquetFooterCache.h>
 #include <Storages/Parquet/RowRanges.h>
 #include <base/types.h>
 #include <parquet/file_reader.h>
@@ -49,7 +50,13 @@ struct ParquetMetaBuilder
     bool collectPageIndex = false;
     bool collectSchema = false;
 
+    /// If set, parsed footer and page indexes are looked up in (and populated into) ParquetFooterCache.
+    std::optional<ParquetFileIdentity> fileIdentity;
+
     std::shared_ptr<parquet::FileMetaData> fileMetaData;
+    /// Footer lookups answered by (or missing from) ParquetFooterCache, reported as scan metrics.
+    size_t footerCacheHits = 0;
+    size_t footerCacheMisses = 0;
 
     //
     std::vector<RowGroupInformation> readRowGroups;
@@ -59,6 +66,8 @@ struct ParquetMetaBuilder
 
     // collectPageIndex
     std::vector<Int32> readColumns;
+    /// Read columns whose bloom filters or dictionaries are checked.
+    std::vector<Int32> valueIndexColumns;
 
     // collectSchema
     DB::Block fileHeader;
@@ -72,28 +81,40 @@ struct ParquetMetaBuilder
     ParquetMetaBuilder &
     build(DB::ReadBuffer & read_buffer, const std::function<bool(UInt64)> & should_include_row_group = [](UInt64) { return true; });
 
-    static std::unique_ptr<parquet::ParquetFileReader> openInputParquetFile(DB::ReadBuffer & read_buffer);
+    static std::shared_ptr<arrow::io::RandomAccessFile> openArrowFile(DB::ReadBuffer & read_buffer);
+
+    static std::unique_ptr<parquet::ParquetFileReader>
+    openInputParquetFile(DB::ReadBuffer & read_buffer, const std::shared_ptr<parquet::FileMetaData> & metadata = nullptr);
 
     static DB::Block collectFileSchema(const DB::ContextPtr & context, DB::ReadBuffer & read_buffer);
 
 private:
+    std::unique_ptr<parquet::ParquetFileReader> openFile(const std::shared_ptr<arrow::io::RandomAccessFile> & arrow_file);
     ParquetMetaBuilder &
     buildRequiredRowGroups(const parquet::FileMetaData & file_meta, const std::function<bool(UInt64)> & should_include_row_group);
     ParquetMetaBuilder & buildSkipRowGroup(const parquet::FileMetaData & file_meta);
     ParquetMetaBuilder & buildAllRowRange(const parquet::FileMetaData & file_meta);
+    std::unique_ptr<ColumnValueIndexReader> createValueIndexReader(
+        const std::shared_ptr<arrow::io::RandomAccessFile> & arrow_file,
+        const std::vector<Int32> & columns,
+        const ColumnIndexFilter & column_index_filter);
+    /// Drop the row groups whose bloom filters or dictionaries can't match, if the page indexes are not collected.
+    ParquetMetaBuilder & pruneRowGroups(
+        const std::shared_ptr<arrow::io::RandomAccessFile> & arrow_file,
+        const parquet::FileMetaData & file_meta,
+        const DB::Block & readBlock,
+        const ColumnIndexFilter * column_index_filter);
     ParquetMetaBuilder & buildRowRange(
         parquet::ParquetFileReader & reader,
+        const std::shared_ptr<arrow::io::RandomAccessFile> & arrow_file,
         const parquet::FileMetaData & file_meta,
         const DB::Block & readBlock,
         const ColumnIndexFilter * column_index_filter);
 
     static std::vector<Int32>
     pruneColumn(const DB::Block & header, const parquet::FileMetaData & metadata, bool case_insensitive, bool allow_missing_columns);
-    static std::unique_ptr<ColumnIndexStore> collectColumnIndex(
-        const parquet::RowGroupMetaData & rgMeta,
-        parquet::RowGroupPageIndexReader & rowGroupPageIndex,
-        const std::vector<Int32> & column_indices,
-        bool case_insensitive = false);
+    std::unique_ptr<ColumnIndexStore>
+    collectColumnIndex(parquet::ParquetFileReader & reader, const parquet::RowGroupMetaData & rgMeta, Int32 row_group_index) const;
 
     ParquetMetaBuilder & buildSchema(const parquet::FileMetaData & file_meta);
 };
@@ -121,8 +142,14 @@ inline DB::Block removeMetaColumns(const DB::Block & header)
 
 class ColumnIndexRowRangesProvider
 {
-    ColumnIndexRowRangesProvider(std::vector<RowGroupInformation> rowGroupInfos, std::vector<Int32> readColumns)
-        : startRowGroupIndex_(rowGroupInfos[0].index), rowGroupInfos_(std::move(rowGroupInfos)), readColumns_(std::move(readColumns))
+    ColumnIndexRowRangesProvider(
+        std::vector<RowGroupInformation> rowGroupInfos,
+        std::vector<Int32> readColumns,
+        std::shared_ptr<parquet::FileMetaData> fileMetaData)
+        : startRowGroupIndex_(rowGroupInfos[0].index)
+        , rowGroupInfos_(std::move(rowGroupInfos))
+        , readColumns_(std::move(readColumns))
+        , fileMetaData_(std::move(fileMetaData))
     {
         for (const auto & rg : rowGroupInfos_)
             readRowGroups_.push_back(rg.index);
@@ -135,11 +162,12 @@ class ColumnIndexRowRangesProvider
 public:
     /// Used in UT, in case of testing VirtualColumnRowIndexReader.
     explicit ColumnIndexRowRangesProvider(std::vector<RowGroupInformation> rowGroupInfos)
-        : ColumnIndexRowRangesProvider(std::move(rowGroupInfos), {})
+        : ColumnIndexRowRangesProvider(std::move(rowGroupInfos), {}, nullptr)
     {
     }
     explicit ColumnIndexRowRangesProvider(ParquetMetaBuilder & meta_collect)
-        : ColumnIndexRowRangesProvider(std::move(meta_collect.readRowGroups), std::move(meta_collect.readColumns))
+        : ColumnIndexRowRangesProvider(
+              std::move(meta_collect.readRowGroups), std::move(meta_collect.readColumns), meta_collect.fileMetaData)
     {
     }
 
@@ -166,6 +194,8 @@ public:
 
     const std::vector<Int32> & getReadRowGroups() const { return readRowGroups_; };
     const std::vector<Int32> & getReadColumns() const { return readColumns_; };
+    /// The footer already parsed by ParquetMetaBuilder, so that readers don't need to parse it again.
+    const std::shared_ptr<parquet::FileMetaData> & getFileMetaData() const { return fileMetaData_; }
 
 private:
     Int32 adjustRowIndex(Int32 row_group_index) const
@@ -179,6 +209,7 @@ private:
     const std::vector<RowGroupInformation> rowGroupInfos_;
     std::vector<Int32> readRowGroups_;
     const std::vector<Int32> readColumns_;
+    const std::shared_ptr<parquet::FileMetaData> fileMetaData_;
 };
 
 }
\ No newline at end of file
@@ -334,7 +334,7 @@ DB::Chunk VectorizedParquetBlockInputFormat::read()
         const auto arrow_file = DB::asArrowFile(*in, record_reader_.formatSettings(), is_stopped, "Parquet", PARQUET_MAGIC_BYTES);
         if (is_stopped != 0)
             return {};
-        if (!record_reader_.initialize(arrow_file, row_ranges_provider_))
+        if (!record_reader_.initialize(arrow_file, row_ranges_provider_, row_ranges_provider_.getFileMetaData()))
             return {};
     }
     return record_reader_.nextBatch();
@@ -16,6 +16,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -145,6 +146,10 @@ public:
 
     const DB::Block & getFileSchema() const { return file_schema; }
 
+    /// Footer cache lookups done while reading this file, only counted by formats backed by a footer cache.
+    size_t footerCacheHits() const { return footer_cache_hits; }
+    size_t footerCacheMisses() const { return footer_cache_misses; }
+
 protected:
     DB::ContextPtr context;
     const SubstraitInputFile file_info;
@@ -156,6 +161,9 @@ protected:
 
     /// Currently, it is used to read an iceberg format, and initialized in the constructor of child class
     DB::Block file_schema;
+
+    std::atomic<size_t> footer_cache_hits = 0;
+    std::atomic<size_t> footer_cache_misses = 0;
 };
 
 using FormatFilePtr = std::shared_ptr<FormatFile>;
@@ -64,9 +64,20 @@ struct ShouldIncludeRowGroup
 
 namespace
 {
+/// Footers can only be cached if Spark tells us the modification time of the file.
+std::optional<ParquetFileIdentity> getFileIdentity(const SubstraitInputFile & file_info)
+{
+    if (!ParquetFooterCache::instance().enabled() || !file_info.has_properties() || file_info.properties().modificationtime() <= 0)
+        return std::nullopt;
+    return ParquetFileIdentity{
+        .path = file_info.uri_file(),
+        .last_modified_time = static_cast<size_t>(file_info.properties().modificationtime()),
+        .file_size = static_cast<size_t>(file_info.properties().filesize())};
+}
+
 ParquetMetaBuilder collectRequiredRowGroups(ReadBuffer & read_buffer, const SubstraitInputFile & file_info)
 {
-    ParquetMetaBuilder result;
+    ParquetMetaBuilder result{.fileIdentity = getFileIdentity(file_info)};
     ShouldIncludeRowGroup should_include_row_group{file_info};
     result.build(read_buffer, should_include_row_group);
     return result;
@@ -159,7 +170,8 @@ ParquetFormatFile::createInputFormat(const Block & header, const std::shared_ptr
         .collectPageIndex = usePageIndexReader || readRowIndex,
         .collectSkipRowGroup = !usePageIndexReader,
         .case_insensitive = format_settings.parquet.case_insensitive_column_matching,
-        .allow_missing_columns = format_settings.parquet.allow_missing_columns};
+        .allow_missing_columns = format_settings.parquet.allow_missing_columns,
+        .fileIdentity = getFileIdentity(file_info)};
 
     ShouldIncludeRowGroup should_include_row_group{file_info};
     if (auto * seekable_in = dynamic_cast<SeekableReadBuffer *>(read_buffer_.get()))
@@ -176,6 +188,8 @@ ParquetFormatFile::createInputFormat(const Block & header, const std::shared_ptr
     }
 
     column_index_filter_.reset();
+    footer_cache_hits += metaBuilder.footerCacheHits;
+    footer_cache_misses += metaBuilder.footerCacheMisses;
 
     if (metaBuilder.readRowGroups.empty())
         return nullptr;
@@ -223,6 +237,8 @@ std::optional<size_t> ParquetFormatFile::getTotalRows()
 
     auto in = read_buffer_builder->build(file_info);
     auto result = collectRequiredRowGroups(*in, file_info);
+    footer_cache_hits += result.footerCacheHits;
+    footer_cache_misses += result.footerCacheMisses;
 
     size_t rows = std::ranges::fold_left(
         result.readRowGroups, static_cast<size_t>(0), [](size_t sum, const auto & row_group) { return sum + row_group.num_rows; });
@@ -70,6 +70,18 @@ void SubstraitFileSource::setKeyCondition(const std::shared_ptr<const DB::Action
     column_index_filter = std::make_shared<ColumnIndexFilter>(*filter_actions_dag, context_);
 }
 
+size_t SubstraitFileSource::footerCacheHits() const
+{
+    return std::ranges::fold_left(
+        files, static_cast<size_t>(0), [](size_t sum, const auto & file) { return sum + file->footerCacheHits(); });
+}
+
+size_t SubstraitFileSource::footerCacheMisses() const
+{
+    return std::ranges::fold_left(
+        files, static_cast<size_t>(0), [](size_t sum, const auto & file) { return sum + file->footerCacheMisses(); });
+}
+
 DB::Chunk SubstraitFileSource::generate()
 {
     while (true)
@@ -45,6 +45,10 @@ public:
 
     void setKeyCondition(const std::shared_ptr<const DB::ActionsDAG> & filter_actions_dag_, DB::ContextPtr context_);
 
+    /// Parquet footer cache lookups of the files read by this source.
+    size_t footerCacheHits() const;
+    size_t footerCacheMisses() const;
+
 protected:
     DB::Chunk generate() override;
 
@@ -566,13 +566,19 @@ Java_org_apache_gluten_vectorized_CHNativeBlock_nativeSlice(JNIEnv * env, jobjec
 }
 
 JNIEXPORT jlong Java_org_apache_gluten_vectorized_CHStreamReader_createNativeShuffleReader(
-    JNIEnv * env, jclass /*clazz*/, jobject input_stream, jboolean compressed, jlong max_shuffle_read_rows, jlong max_shuffle_read_bytes)
+    JNIEnv * env,
+    jclass /*clazz*/,
+    jobject input_stream,
+    jboolean compressed,
+    jlong max_shuffle_read_rows,
+    jlong max_shuffle_read_bytes,
+    jint decompress_threads)
 {
     LOCAL_ENGINE_JNI_METHOD_START
     auto * input = env->NewGlobalRef(input_stream);
     auto read_buffer = std::make_unique<local_engine::ReadBufferFromJavaShuffleInputStream>(input);
-    auto * shuffle_reader
-        = new local_engine::ShuffleReader(std::move(read_buffer), compressed, max_shuffle_read_rows, max_shuffle_read_bytes);
+    auto * shuffle_reader = new local_engine::ShuffleReader(
+        std::move(read_buffer), compressed, max_shuffle_read_rows, max_shuffle_read_bytes, std::max<jint>(decompress_threads, 0));
     return reinterpret_cast<jlong>(shuffle_reader);
     LOCAL_ENGINE_JNI_METHOD_END(env, -1)
 }
@@ -1149,6 +1155,13 @@ JNIEXPORT jlong Java_org_apache_gluten_vectorized_StorageJoinBuilder_nativeClone
     LOCAL_ENGINE_JNI_METHOD_END(env, 0)
 }
 
+JNIEXPORT jlong Java_org_apache_gluten_vectorized_StorageJoinBuilder_nativeGetMemoryUsage(JNIEnv * env, jclass, jlong instance)
+{
+    LOCAL_ENGINE_JNI_METHOD_START
+    return local_engine::SharedPointerWrapper<local_engine::StorageJoinFromReadBuffer>::sharedPtr(instance)->getMemoryUsage();
+    LOCAL_ENGINE_JNI_METHOD_END(env, 0)
+}
+
 JNIEXPORT void
 Java_org_apache_gluten_vectorized_StorageJoinBuilder_nativeCleanBuildHashTable(JNIEnv * env, jclass, jstring hash_table_id_, jlong instance)
 {
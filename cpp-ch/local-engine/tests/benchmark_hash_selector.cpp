@@ -0,0 +1,96 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <numeric>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Functions/FunctionFactory.h>
+#include <Shuffle/SelectorBuilder.h>
+#include <benchmark/benchmark.h>
+#include <Common/QueryContext.h>
+
+using namespace DB;
+using namespace local_engine;
+
+static constexpr size_t ROWS = 65536;
+static constexpr UInt32 PARTITIONS = 200;
+
+static Block createKeysBlock()
+{
+    auto int_type = std::make_shared<DataTypeInt32>();
+    auto long_type = makeNullable(std::make_shared<DataTypeInt64>());
+    auto string_type = std::make_shared<DataTypeString>();
+    auto int_column = int_type->createColumn();
+    auto long_column = long_type->createColumn();
+    auto string_column = string_type->createColumn();
+    for (size_t i = 0; i < ROWS; ++i)
+    {
+        int_column->insert(static_cast<Int32>(i * 31));
+        long_column->insert(i % 10 ? Field(static_cast<Int64>(i * 7919)) : Field());
+        string_column->insert("customer#" + std::to_string(i % 5000));
+    }
+    return Block({
+        ColumnWithTypeAndName(std::move(int_column), int_type, "i"),
+        ColumnWithTypeAndName(std::move(long_column), long_type, "l"),
+        ColumnWithTypeAndName(std::move(string_column), string_type, "s"),
+    });
+}
+
+static std::vector<size_t> keysOf(benchmark::State & state)
+{
+    std::vector<size_t> keys(state.range(0));
+    std::iota(keys.begin(), keys.end(), 0);
+    return keys;
+}
+
+/// The hash function column, then pmod and the partition start points in separate passes
+static void BM_HashSelectorByFunction(benchmark::State & state)
+{
+    auto block = createKeysBlock();
+    const auto keys = keysOf(state);
+    ColumnsWithTypeAndName args;
+    for (auto key : keys)
+        args.emplace_back(block.getByPosition(key));
+    auto function = FunctionFactory::instance().get("sparkMurmurHash3_32", QueryContext::globalContext())->build(args);
+    for (auto _ : state)
+    {
+        auto hash_column = function->execute(args, function->getResultType(), ROWS, false);
+        IColumn::Selector selector;
+        selector.reserve(ROWS);
+        for (size_t i = 0; i < ROWS; ++i)
+        {
+            auto res = static_cast<Int32>(hash_column->get64(i)) % static_cast<Int32>(PARTITIONS);
+            selector.emplace_back(res < 0 ? res + PARTITIONS : res);
+        }
+        auto info = PartitionInfo::fromSelector(std::move(selector), PARTITIONS, false);
+        benchmark::DoNotOptimize(info);
+    }
+}
+
+static void BM_HashSelectorFused(benchmark::State & state)
+{
+    auto block = createKeysBlock();
+    HashSelectorBuilder builder(PARTITIONS, keysOf(state), "sparkMurmurHash3_32");
+    for (auto _ : state)
+    {
+        auto info = builder.build(block);
+        benchmark::DoNotOptimize(info);
+    }
+}
+
+BENCHMARK(BM_HashSelectorByFunction)->Arg(1)->Arg(2)->Arg(3)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_HashSelectorFused)->Arg(1)->Arg(2)->Arg(3)->Unit(benchmark::kMicrosecond);
@@ -136,5 +136,43 @@ static void BM_SparkRowToCHColumn_Lineitem(benchmark::State & state)
         auto out_block = SparkRowToCHColumn::convertSparkRowInfoToCHColumn(*spark_row_info, *header);
 }
 
+static void BM_CHColumnToSparkRow_NestedTypes(benchmark::State & state)
+{
+    const NameTypes name_types = {
+        {"arr", "Array(Nullable(Int64))"},
+        {"str_arr", "Nullable(Array(Nullable(String)))"},
+        {"map", "Map(String, Nullable(Int64))"},
+        {"struct", "Tuple(Int64, Nullable(String), Array(Float64))"},
+    };
+
+    auto header = getLineitemHeader(name_types);
+    auto columns = header.cloneEmptyColumns();
+    for (size_t i = 0; i < 8192; ++i)
+    {
+        Array arr;
+        Array str_arr;
+        Map map;
+        for (size_t j = 0; j < i % 16; ++j)
+        {
+            arr.emplace_back(j % 5 ? Field(static_cast<Int64>(i * j)) : Field());
+            str_arr.emplace_back(j % 7 ? Field("value_" + std::to_string(j)) : Field());
+            map.emplace_back(Tuple{Field("key_" + std::to_string(j)), Field(static_cast<Int64>(j))});
+        }
+        columns[0]->insert(arr);
+        columns[1]->insert(str_arr);
+        columns[2]->insert(map);
+        columns[3]->insert(Tuple{Field(static_cast<Int64>(i)), Field("struct_" + std::to_string(i)), Field(Array(i % 8, Field(1.0)))});
+    }
+    Block block = header.cloneWithColumns(std::move(columns));
+
+    CHColumnToSparkRow converter;
+    for (auto _ : state)
+    {
+        auto spark_row_info = converter.convertCHColumnToSparkRow(block);
+        converter.freeMem(spark_row_info->getBufferAddress(), spark_row_info->getTotalBytes());
+    }
+}
+
 BENCHMARK(BM_CHColumnToSparkRow_Lineitem)->Unit(benchmark::kMillisecond)->Iterations(10);
 BENCHMARK(BM_SparkRowToCHColumn_Lineitem)->Unit(benchmark::kMillisecond)->Iterations(10);
+BENCHMARK(BM_CHColumnToSparkRow_NestedTypes)->Unit(benchmark::kMillisecond)->Iterations(10);
@@ -0,0 +1,136 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AggregateFunctions/IAggregateFunction.h>
+#include <Columns/ColumnAggregateFunction.h>
+#include <Columns/ColumnFixedString.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypeAggregateFunction.h>
+#include <DataTypes/DataTypeFactory.h>
+#include <IO/ReadBufferFromString.h>
+#include <IO/WriteBufferFromString.h>
+#include <Storages/IO/AggregateSerializationUtils.h>
+#include <Storages/IO/NativeReader.h>
+#include <Storages/IO/NativeWriter.h>
+#include <gtest/gtest.h>
+#include <Common/Arena.h>
+#include <Common/assert_cast.h>
+
+using namespace DB;
+using namespace local_engine;
+
+namespace
+{
+/// A block with one column of `rows` states of type_name, each state aggregates two values of arguments
+Block createStates(const String & type_name, const ColumnPtr & arguments)
+{
+    const auto type = DataTypeFactory::instance().get(type_name);
+    const auto function = assert_cast<const DataTypeAggregateFunction &>(*type).getFunction();
+    auto column = type->createColumn();
+    auto & states = assert_cast<ColumnAggregateFunction &>(*column);
+    auto & arena = states.createOrGetArena();
+    const IColumn * args[] = {arguments.get()};
+    const size_t rows = arguments->size();
+    for (size_t i = 0; i < rows; ++i)
+    {
+        AggregateDataPtr place = arena.alignedAlloc(function->sizeOfData(), function->alignOfData());
+        function->create(place);
+        function->add(place, args, i, &arena);
+        function->add(place, args, (i * 7) % rows, &arena);
+        states.getData().push_back(place);
+    }
+    return Block({ColumnWithTypeAndName(std::move(column), type, "state")});
+}
+
+ColumnPtr finalizeStates(const ColumnWithTypeAndName & states)
+{
+    const auto & column = assert_cast<const ColumnAggregateFunction &>(*states.column);
+    const auto function = column.getAggregateFunction();
+    auto result = function->getResultType()->createColumn();
+    Arena arena;
+    for (const auto place : column.getData())
+        function->insertResultInto(place, *result, &arena);
+    return result;
+}
+
+void assertRoundTrip(const String & type_name, const ColumnPtr & arguments)
+{
+    Block block = createStates(type_name, arguments);
+    const Block header = block.cloneEmpty();
+    ASSERT_TRUE(isFixedSizeAggregateFunction(
+        assert_cast<const ColumnAggregateFunction &>(*block.getByPosition(0).column).getAggregateFunction()));
+
+    WriteBufferFromOwnString out;
+    NativeWriter writer(out, header);
+    writer.write(convertAggregateStateInBlock(block));
+    writer.write(convertAggregateStateInBlock(block));
+    writer.flush();
+
+    ReadBufferFromOwnString in(out.str());
+    NativeReader reader(in);
+    const Block result = reader.read();
+    ASSERT_EQ(result.rows(), 2 * block.rows());
+
+    const auto expected = finalizeStates(block.getByPosition(0));
+    const auto actual = finalizeStates(result.getByPosition(0));
+    for (size_t i = 0; i < actual->size(); ++i)
+        ASSERT_EQ(actual->compareAt(i, i % expected->size(), *expected, 1), 0) << type_name << " row " << i;
+}
+}
+
+TEST(AggregateStateSerialization, ColumnarFixedSizeStates)
+{
+    auto int64s = ColumnInt64::create();
+    auto int8s = ColumnInt8::create();
+    for (Int64 i = 0; i < 1000; ++i)
+    {
+        int64s->insertValue(i * 1000003 - 7);
+        int8s->insertValue(static_cast<Int8>(i));
+    }
+    ColumnPtr int64_arguments = std::move(int64s);
+    ColumnPtr int8_arguments = std::move(int8s);
+
+    /// Only 8-byte words
+    assertRoundTrip("AggregateFunction(sum, Int64)", int64_arguments);
+    assertRoundTrip("AggregateFunction(avg, Int64)", int64_arguments);
+    /// Only trailing bytes
+    assertRoundTrip("AggregateFunction(min, Int8)", int8_arguments);
+}
+
+TEST(AggregateStateSerialization, ColumnarLayout)
+{
+    /// Two states of {UInt64, UInt64} and a trailing byte
+    const size_t state_size = 17;
+    std::vector<char> states(2 * state_size);
+    for (size_t i = 0; i < states.size(); ++i)
+        states[i] = static_cast<char>(i);
+
+    WriteBufferFromOwnString out;
+    writeFixedSizeAggregateStatesColumnar(states.data(), 2, state_size, out);
+    const String data = out.str();
+    ASSERT_EQ(data.size(), states.size());
+    /// First words of both states, then the second words, then the trailing bytes
+    EXPECT_EQ(data.substr(0, 8), String(states.data(), 8));
+    EXPECT_EQ(data.substr(8, 8), String(states.data() + state_size, 8));
+    EXPECT_EQ(data[32], states[16]);
+    EXPECT_EQ(data[33], states[state_size + 16]);
+
+    std::vector<char> read_states(states.size());
+    char * places[] = {read_states.data(), read_states.data() + state_size};
+    ReadBufferFromOwnString in(data);
+    readFixedSizeAggregateStatesColumnar(in, places, 2, state_size);
+    EXPECT_EQ(read_states, states);
+}
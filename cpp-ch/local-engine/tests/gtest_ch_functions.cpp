@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 #include <Columns/ColumnSet.h>
+#include <Columns/ColumnTuple.h>
 #include <DataTypes/DataTypeFactory.h>
 #include <DataTypes/DataTypeSet.h>
 #include <Functions/FunctionFactory.h>
@@ -232,3 +233,43 @@ TEST(TestFunction, NotIn2)
     debug::headColumn(result2);
     ASSERT_EQ(result2->getUInt(3), 1);
 }
+
+TEST(TestFunction, FlattenJSONStringOnRequired)
+{
+    using namespace DB;
+    auto & factory = FunctionFactory::instance();
+    auto function = factory.get("flattenJSONStringOnRequired", local_engine::QueryContext::globalContext());
+
+    auto type0 = local_engine::STRING();
+    auto column0 = type0->createColumn();
+    column0->insert(R"({"a":{"b":1,"c":"x"},"d":[5,6],"s":"str"})");
+    column0->insert(R"({"a":1})");
+    column0->insert(R"({"a":{"b":null}})");
+    column0->insert("abc");
+    /// `$.a.b`, `$.a.c`, `$.a` and `$.s` are plain member chains, `$.d[0]` goes through GeneratorJSONPath.
+    auto column1 = type0->createColumnConst(4, "$.a.b|$.a.c|$.d[0]|$.s|$.a|$.x.y");
+
+    ColumnsWithTypeAndName columns
+        = {ColumnWithTypeAndName(std::move(column0), type0, "json"), ColumnWithTypeAndName(std::move(column1), type0, "paths")};
+    Block block(columns);
+    auto executable = function->build(block.getColumnsWithTypeAndName());
+    auto result = executable->execute(block.getColumnsWithTypeAndName(), executable->getResultType(), block.rows(), false);
+    std::cerr << "output:\n";
+    debug::headColumn(result);
+
+    const auto & tuple = assert_cast<const ColumnTuple &>(*result);
+    ASSERT_EQ(tuple.getColumn(0)[0], Field("1"));
+    ASSERT_EQ(tuple.getColumn(1)[0], Field("x"));
+    ASSERT_EQ(tuple.getColumn(2)[0], Field("5"));
+    ASSERT_EQ(tuple.getColumn(3)[0], Field("str"));
+    ASSERT_TRUE(tuple.getColumn(5).isNullAt(0));
+
+    ASSERT_TRUE(tuple.getColumn(0).isNullAt(1));
+    ASSERT_EQ(tuple.getColumn(4)[1], Field("1"));
+
+    ASSERT_TRUE(tuple.getColumn(0).isNullAt(2));
+    ASSERT_FALSE(tuple.getColumn(4).isNullAt(2));
+
+    for (size_t i = 0; i < tuple.tupleSize(); ++i)
+        ASSERT_TRUE(tuple.getColumn(i).isNullAt(3));
+}
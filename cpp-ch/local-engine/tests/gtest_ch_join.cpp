@@ -14,12 +14,21 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <Columns/ColumnNullable.h>
 #include <Core/Settings.h>
+#include <DataTypes/DataTypeNullable.h>
 #include <DataTypes/DataTypeFactory.h>
 #include <Functions/FunctionFactory.h>
 #include <Interpreters/Context.h>
+#include <Interpreters/ExpressionActions.h>
 #include <Interpreters/HashJoin/HashJoin.h>
 #include <Interpreters/TableJoin.h>
+#include <Join/BroadCastJoinBuilder.h>
+#include <Join/JoinRuntimeFilter.h>
+#include <Join/PartitionedHashJoin.h>
+#include <Join/StorageJoinFromReadBuffer.h>
+#include <Operator/JoinRuntimeFilterStep.h>
 #include <Parsers/ASTIdentifier.h>
 #include <Processors/Executors/PipelineExecutor.h>
 #include <Processors/Executors/PullingPipelineExecutor.h>
@@ -33,9 +42,12 @@
 #include <Storages/MergeTree/SparkMergeTreeMeta.h>
 #include <Storages/SubstraitSource/SubstraitFileSource.h>
 #include <gtest/gtest.h>
+#include <jni/SharedPointerWrapper.h>
 #include <Common/BlockTypeUtils.h>
 #include <Common/DebugUtils.h>
+#include <Common/MemoryTracker.h>
 #include <Common/QueryContext.h>
+#include <Common/assert_cast.h>
 
 using namespace DB;
 using namespace local_engine;
@@ -152,3 +164,256 @@ TEST(TestJoin, simple)
     executor.pull(res);
     debug::headBlock(res);
 }
+
+TEST(TestJoin, RuntimeFilter)
+{
+    auto int_type = makeNullable(DataTypeFactory::instance().get("Int32"));
+    auto make_block = [&](const std::vector<Field> & values)
+    {
+        auto column = int_type->createColumn();
+        for (const auto & value : values)
+            column->insert(value);
+        return Block({ColumnWithTypeAndName(std::move(column), int_type, "key")});
+    };
+    Blocks blocks{make_block({7, Field(), 3}), make_block({Field(), 7})};
+    const auto & context = QueryContext::globalContext();
+
+    auto filter = JoinKeyRuntimeFilterBuilder::build(blocks, "key", 1024, context);
+    ASSERT_TRUE(filter.has_value());
+    EXPECT_EQ(filter->min, Field(3));
+    EXPECT_EQ(filter->max, Field(7));
+    EXPECT_FALSE(filter->bloom_filter.empty());
+
+    auto check = [&](const JoinKeyRuntimeFilter & runtime_filter, const std::vector<UInt8> & expected)
+    {
+        auto probe = int_type->createColumn();
+        for (Int32 i = 0; i < 9; ++i)
+            probe->insert(i);
+        probe->insert(Field());
+        ActionsDAG actions_dag{ColumnsWithTypeAndName{ColumnWithTypeAndName(int_type, "key")}};
+        const auto * cond = runtime_filter.buildCondition(actions_dag, *actions_dag.getInputs().front(), context);
+        actions_dag.addOrReplaceInOutputs(*cond);
+        Block block({ColumnWithTypeAndName(std::move(probe), int_type, "key")});
+        ExpressionActions(std::move(actions_dag)).execute(block);
+        const auto result = block.getByName(cond->result_name).column->convertToFullColumnIfConst();
+        const auto & null_map = assert_cast<const ColumnNullable &>(*result).getNullMapData();
+        const auto & nested = assert_cast<const ColumnNullable &>(*result).getNestedColumn();
+        for (size_t i = 0; i < expected.size(); ++i)
+            EXPECT_EQ(!null_map[i] && nested.getBool(i), expected[i]) << i;
+    };
+    /// key between 3 and 7 and in the bloom filter of {3, 7}, a null key never matches
+    check(*filter, {0, 0, 0, 1, 0, 0, 0, 1, 0, 0});
+
+    /// Over the size cap, only key between 3 and 7
+    auto range_filter = JoinKeyRuntimeFilterBuilder::build(blocks, "key", 1, context);
+    ASSERT_TRUE(range_filter.has_value());
+    EXPECT_TRUE(range_filter->bloom_filter.empty());
+    check(*range_filter, {0, 0, 0, 1, 1, 1, 1, 1, 0, 0});
+
+    /// Collected by several streams
+    JoinKeyRuntimeFilterBuilder builder(int_type, 1024, context);
+    JoinKeyRuntimeFilterBuilder other(int_type, 1024, context);
+    builder.add(blocks[0].getByName("key").column);
+    other.add(blocks[1].getByName("key").column);
+    other.add(make_block({Field(), 5}).getByName("key").column);
+    builder.merge(std::move(other));
+    auto merged = builder.finish();
+    ASSERT_TRUE(merged.has_value());
+    EXPECT_EQ(merged->min, Field(3));
+    EXPECT_EQ(merged->max, Field(7));
+    check(*merged, {0, 0, 0, 1, 0, 1, 0, 1, 0, 0});
+
+    Blocks only_nulls{make_block({Field(), Field()})};
+    EXPECT_FALSE(JoinKeyRuntimeFilterBuilder::build(only_nulls, "key", 1024, context).has_value());
+}
+
+TEST(TestJoin, PartitionedHashJoinScatter)
+{
+    auto int_type = DataTypeFactory::instance().get("Int64");
+    auto nullable_type = makeNullable(int_type);
+    auto build_column = int_type->createColumn();
+    auto probe_column = nullable_type->createColumn();
+    for (Int64 i = 0; i < 1000; ++i)
+    {
+        build_column->insert(i);
+        probe_column->insert(999 - i);
+    }
+    probe_column->insert(Field());
+    Block build_block({ColumnWithTypeAndName(std::move(build_column), int_type, "k")});
+    Block probe_block({ColumnWithTypeAndName(std::move(probe_column), nullable_type, "k")});
+
+    const size_t partitions = 4;
+    auto build_partitions = PartitionedHashJoin::scatterBlock(build_block, {"k"}, partitions);
+    auto probe_partitions = PartitionedHashJoin::scatterBlock(probe_block, {"k"}, partitions);
+    ASSERT_EQ(build_partitions.size(), partitions);
+
+    /// A key is sent to the same partition on both sides, also when only one side is Nullable
+    std::map<Int64, size_t> build_partition_of;
+    size_t build_rows = 0;
+    for (size_t p = 0; p < partitions; ++p)
+    {
+        build_rows += build_partitions[p].rows();
+        const auto & column = *build_partitions[p].getByPosition(0).column;
+        for (size_t i = 0; i < column.size(); ++i)
+            build_partition_of[column.getInt(i)] = p;
+    }
+    EXPECT_EQ(build_rows, 1000);
+
+    size_t probe_rows = 0;
+    for (size_t p = 0; p < partitions; ++p)
+    {
+        probe_rows += probe_partitions[p].rows();
+        const auto & column = assert_cast<const ColumnNullable &>(*probe_partitions[p].getByPosition(0).column);
+        for (size_t i = 0; i < column.size(); ++i)
+            if (!column.isNullAt(i))
+                EXPECT_EQ(build_partition_of[column.getNestedColumn().getInt(i)], p);
+    }
+    EXPECT_EQ(probe_rows, 1001);
+}
+
+TEST(TestJoin, BroadcastTableMemoryUsage)
+{
+    auto int_type = DataTypeFactory::instance().get("Int64");
+    auto column = int_type->createColumn();
+    for (Int64 i = 0; i < 100000; ++i)
+        column->insert(i);
+    Block header({ColumnWithTypeAndName(int_type, "k")});
+    Blocks blocks{Block({ColumnWithTypeAndName(std::move(column), int_type, "k")})};
+
+    auto & tracker = StorageJoinFromReadBuffer::memoryTracker();
+    const Int64 tracked_before = tracker.get();
+    /// With mixed join conditions the hash table is built on the first getJoinLocked
+    auto table = std::make_shared<StorageJoinFromReadBuffer>(
+        blocks,
+        100000,
+        Names{"k"},
+        false,
+        JoinKind::Inner,
+        JoinStrictness::All,
+        true,
+        ColumnsDescription(header.getNamesAndTypesList()),
+        ConstraintsDescription(),
+        "memory_usage",
+        false,
+        false,
+        false);
+    blocks.clear();
+    const size_t input_bytes = table->getMemoryUsage();
+    EXPECT_GE(input_bytes, 100000 * sizeof(Int64));
+
+    auto analyzed_join = std::make_shared<TableJoin>(SizeLimits(), false, JoinKind::Inner, JoinStrictness::All, Names{"k"});
+    auto join = table->getJoinLocked(analyzed_join, QueryContext::globalContext());
+    /// The usage is read from the built hash table, which is charged to the broadcast tracker
+    const size_t built_bytes = table->getMemoryUsage();
+    EXPECT_GT(built_bytes, input_bytes);
+    const Int64 tracked_built = tracker.get();
+    EXPECT_GT(tracked_built, tracked_before);
+
+    /// Released the way the cache does when the table is evicted
+    join.reset();
+    auto * wrapper = make_wrapper(std::move(table));
+    BroadCastJoinBuilder::cleanBuildHashTable("memory_usage", wrapper->instance());
+    EXPECT_LT(tracker.get(), tracked_built);
+}
+
+TEST(TestJoin, PartitionedBroadcastJoin)
+{
+    auto int_type = DataTypeFactory::instance().get("Int64");
+    auto build_keys = int_type->createColumn();
+    auto build_values = int_type->createColumn();
+    for (Int64 i = 0; i < 20000; ++i)
+    {
+        build_keys->insert(i % 5000);
+        build_values->insert(i);
+    }
+    Block build_block(
+        {ColumnWithTypeAndName(std::move(build_keys), int_type, "k"), ColumnWithTypeAndName(std::move(build_values), int_type, "v")});
+    auto probe_keys = int_type->createColumn();
+    for (Int64 i = -100; i < 5100; ++i)
+        probe_keys->insert(i);
+    Block probe_block({ColumnWithTypeAndName(std::move(probe_keys), int_type, "pk")});
+
+    auto global_context = QueryContext::globalContext();
+    /// Sorted (probe key, build value) pairs of the inner join on pk = k
+    auto join_rows = [&](size_t build_threads, bool has_mixed_join_condition)
+    {
+        Blocks data{build_block};
+        StorageJoinFromReadBuffer table(
+            data,
+            build_block.rows(),
+            Names{"k"},
+            false,
+            JoinKind::Inner,
+            JoinStrictness::All,
+            has_mixed_join_condition,
+            ColumnsDescription(build_block.getNamesAndTypesList()),
+            ConstraintsDescription(),
+            "partitioned",
+            false,
+            false,
+            false,
+            build_threads);
+
+        auto analyzed_join = std::make_shared<TableJoin>(
+            global_context->getSettingsRef(), global_context->getGlobalTemporaryVolume(), global_context->getTempDataOnDisk());
+        analyzed_join->setKind(JoinKind::Inner);
+        analyzed_join->setStrictness(JoinStrictness::All);
+        analyzed_join->setColumnsFromJoinedTable(build_block.getNamesAndTypesList());
+        analyzed_join->addDisjunct();
+        analyzed_join->addOnKeys(std::make_shared<ASTIdentifier>("pk"), std::make_shared<ASTIdentifier>("k"), false);
+        for (const auto & column : analyzed_join->columnsFromJoinedTable())
+            analyzed_join->addJoinedColumn(column);
+
+        auto join = table.getJoinLocked(analyzed_join, global_context);
+        EXPECT_EQ(join->getName(), build_threads > 1 ? "PartitionedHashJoin" : "HashJoin");
+        std::vector<std::pair<Int64, Int64>> rows;
+        auto result = join->joinBlock(probe_block);
+        while (true)
+        {
+            auto res = result->next();
+            if (res.block.rows())
+            {
+                const auto & keys = *res.block.getByName("pk").column;
+                const auto & values = *res.block.getByName("v").column;
+                for (size_t i = 0; i < res.block.rows(); ++i)
+                    rows.emplace_back(keys.getInt(i), values.getInt(i));
+            }
+            if (res.is_last)
+                break;
+        }
+        std::ranges::sort(rows);
+        return rows;
+    };
+
+    const auto expected = join_rows(1, false);
+    EXPECT_EQ(expected.size(), 20000);
+    /// The partitioned join outputs the rows in another order, but the same rows
+    EXPECT_EQ(join_rows(4, false), expected);
+    /// Built lazily from the blocks renamed to the right sample block
+    EXPECT_EQ(join_rows(4, true), expected);
+}
+
+TEST(TestJoin, RuntimeFilterPublishedOnlyWhenBuilt)
+{
+    auto int_type = DataTypeFactory::instance().get("Int64");
+    auto header = toShared(Block({ColumnWithTypeAndName(int_type, "k")}));
+    auto keys = int_type->createColumn();
+    for (Int64 i = 0; i < 100; ++i)
+        keys->insert(i);
+    ColumnPtr key_column = std::move(keys);
+
+    for (bool complete : {false, true})
+    {
+        auto collector = std::make_shared<JoinRuntimeFilterCollector>(DataTypes{int_type}, 1024);
+        JoinRuntimeFilterStep build_step(header, collector, Names{"k"}, true);
+        JoinRuntimeFilterStep probe_step(header, collector, Names{"k"}, false);
+
+        auto builders = collector->createBuilders();
+        builders[0].add(key_column);
+        EXPECT_EQ(probe_step.publishedFilters(), 0);
+        /// An incomplete build side, e.g. cancelled, publishes nothing
+        collector->finishBuilders(std::move(builders), complete);
+        EXPECT_EQ(probe_step.publishedFilters(), complete ? 1 : 0);
+        EXPECT_EQ(build_step.publishedFilters(), 0);
+    }
+}
@@ -0,0 +1,330 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <map>
+#include <AggregateFunctions/AggregateFunctionFactory.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Interpreters/TemporaryDataOnDisk.h>
+#include <Operator/GraceAggregatingStep.h>
+#include <Operator/GraceAggregatingTransform.h>
+#include <Operator/GraceMergingAggregatedStep.h>
+#include <Poco/Util/AbstractConfiguration.h>
+#include <Processors/Executors/PullingPipelineExecutor.h>
+#include <Processors/ISource.h>
+#include <Processors/Port.h>
+#include <Processors/QueryPlan/BuildQueryPipelineSettings.h>
+#include <QueryPipeline/QueryPipelineBuilder.h>
+#include <base/scope_guard.h>
+#include <gtest/gtest.h>
+#include <Common/AggregateUtil.h>
+#include <Common/BlockTypeUtils.h>
+#include <Common/GlutenConfig.h>
+#include <Common/QueryContext.h>
+
+using namespace DB;
+using namespace local_engine;
+
+namespace
+{
+/// key = key_offset + i % key_count, value = i
+Block buildBlock(Int64 begin, Int64 end, Int64 key_offset = 0, Int64 key_count = 10)
+{
+    auto type = std::make_shared<DataTypeInt64>();
+    auto keys = ColumnInt64::create();
+    auto values = ColumnInt64::create();
+    for (Int64 i = begin; i < end; ++i)
+    {
+        keys->insertValue(key_offset + i % key_count);
+        values->insertValue(i);
+    }
+    return Block({ColumnWithTypeAndName(std::move(keys), type, "key"), ColumnWithTypeAndName(std::move(values), type, "value")});
+}
+
+/// sum(value) group by key
+Aggregator::Params buildSumAggregatorParams(const ContextPtr & context, AggregatorParamsHelper::Mode mode)
+{
+    auto type = std::make_shared<DataTypeInt64>();
+    AggregateFunctionProperties properties;
+    AggregateDescription description;
+    description.function = AggregateFunctionFactory::instance().get("sum", NullsAction::EMPTY, {type}, {}, properties);
+    description.argument_names = {"value"};
+    description.column_name = "sum(value)";
+    return AggregatorParamsHelper::buildParams(context, {"key"}, {description}, mode);
+}
+
+AggregatingTransformParamsPtr buildSumParams()
+{
+    auto params = buildSumAggregatorParams(QueryContext::globalContext(), AggregatorParamsHelper::Mode::INIT_TO_COMPLETED);
+    return std::make_shared<AggregatingTransformParams>(toShared(buildBlock(0, 0)), params, true);
+}
+
+/// Set config keys of the global context, which the grace aggregating steps read, until it's destroyed.
+class ConfigOverride
+{
+public:
+    explicit ConfigOverride(const std::map<String, String> & values)
+        : config(const_cast<Poco::Util::AbstractConfiguration &>(QueryContext::globalContext()->getConfigRef()))
+    {
+        for (const auto & [key, value] : values)
+        {
+            if (config.has(key))
+                original_values.emplace(key, config.getString(key));
+            else
+                original_values.emplace(key, std::nullopt);
+            config.setString(key, value);
+        }
+    }
+
+    ~ConfigOverride()
+    {
+        for (const auto & [key, value] : original_values)
+        {
+            if (value)
+                config.setString(key, *value);
+            else
+                config.remove(key);
+        }
+    }
+
+private:
+    Poco::Util::AbstractConfiguration & config;
+    std::map<String, std::optional<String>> original_values;
+};
+
+/// Emit the blocks one by one, the spilling processor is asked to spill before the block at spill_before is emitted.
+class SpillingSource : public ISource
+{
+public:
+    SpillingSource(Blocks blocks_, size_t spill_before_)
+        : ISource(toShared(blocks_.front().cloneEmpty())), blocks(std::move(blocks_)), spill_before(spill_before_)
+    {
+    }
+
+    String getName() const override { return "SpillingSource"; }
+
+    IProcessor * spilling_processor = nullptr;
+
+protected:
+    Chunk generate() override
+    {
+        if (next_block == blocks.size())
+            return {};
+        if (next_block == spill_before && spilling_processor)
+            spilling_processor->spillOnSize(1);
+        const auto & block = blocks[next_block++];
+        return Chunk(block.getColumns(), block.rows());
+    }
+
+private:
+    Blocks blocks;
+    size_t spill_before;
+    size_t next_block = 0;
+};
+
+/// Push the buckets into a GraceBucketMergingTransform, returns key -> sum
+std::map<Int64, Int64> mergeBuckets(std::vector<std::shared_ptr<GraceMergingBucket>> buckets)
+{
+    auto params = buildSumParams();
+    auto transform = std::make_shared<GraceBucketMergingTransform>(params, true, true);
+    OutputPort bucket_output(toShared(Block{}));
+    connect(bucket_output, transform->getInputs().front());
+    InputPort result_input(toShared(params->getHeader()));
+    connect(transform->getOutputs().front(), result_input);
+    result_input.setNeeded();
+
+    std::map<Int64, Int64> res;
+    while (true)
+    {
+        auto status = transform->prepare();
+        if (status == IProcessor::Status::Finished)
+            break;
+        if (status == IProcessor::Status::Ready)
+            transform->work();
+        else if (status == IProcessor::Status::NeedData)
+        {
+            if (buckets.empty())
+            {
+                bucket_output.finish();
+                continue;
+            }
+            auto & bucket = buckets.front();
+            bucket->reservation = *bucket->budget->tryAcquire(bucket->bytes, 0);
+            Chunk chunk;
+            chunk.getChunkInfos().add(std::move(bucket));
+            buckets.erase(buckets.begin());
+            bucket_output.push(std::move(chunk));
+        }
+        else if (status == IProcessor::Status::PortFull)
+        {
+            auto chunk = result_input.pull();
+            EXPECT_EQ(chunk.getNumColumns(), 2);
+            for (size_t i = 0; i < chunk.getNumRows(); ++i)
+            {
+                auto key = chunk.getColumns()[0]->getInt(i);
+                EXPECT_FALSE(res.contains(key));
+                res[key] = chunk.getColumns()[1]->getInt(i);
+            }
+        }
+        else
+            ADD_FAILURE() << "Unexpected status " << static_cast<int>(status);
+    }
+    return res;
+}
+}
+
+TEST(GraceMergingBudget, Acquire)
+{
+    GraceMergingBudget budget(1000);
+    /// Always accepted without another bucket in flight, even over the limit.
+    auto first = budget.tryAcquire(300, 800);
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first->reserved_bytes, 300);
+    EXPECT_FALSE(budget.tryAcquire(100, 800));
+    EXPECT_FALSE(budget.tryAcquire(100, 601));
+
+    /// The used bytes are part of the query memory, only the unused reservation counts on its own.
+    budget.update(*first, 200);
+    auto second = budget.tryAcquire(100, 700);
+    ASSERT_TRUE(second);
+
+    /// The reservation grows with the hash table.
+    budget.update(*first, 500);
+    EXPECT_EQ(first->reserved_bytes, 500);
+    EXPECT_FALSE(budget.tryAcquire(100, 850));
+
+    budget.release(*second);
+    budget.release(*first);
+    EXPECT_TRUE(budget.tryAcquire(100, 5000));
+}
+
+TEST(GraceMergingBudget, Estimate)
+{
+    GraceMergingBudget budget(0);
+    EXPECT_EQ(budget.estimate(100), 100);
+    auto reservation = budget.tryAcquire(100, 0);
+    ASSERT_TRUE(reservation);
+    budget.update(*reservation, 300);
+    budget.release(*reservation);
+    /// Scaled by the hash table bytes per spilled byte of the merged buckets.
+    EXPECT_EQ(budget.estimate(100), 300);
+    reservation = budget.tryAcquire(100, 0);
+    ASSERT_TRUE(reservation);
+    EXPECT_EQ(reservation->reserved_bytes, 300);
+
+    /// No limit
+    EXPECT_TRUE(budget.tryAcquire(1000000, 1000000));
+}
+
+TEST(GraceBucketMergingTransform, Merge)
+{
+    auto tmp_data = QueryContext::globalContext()->getTempDataOnDisk();
+    ASSERT_TRUE(tmp_data);
+    auto budget = std::make_shared<GraceMergingBudget>(0);
+    std::vector<std::shared_ptr<GraceMergingBucket>> buckets;
+    std::map<Int64, Int64> expected;
+    /// The buckets hold disjoint keys, 0 - 9 and 10 - 19
+    for (Int64 bucket_index = 1; bucket_index <= 2; ++bucket_index)
+    {
+        auto bucket = std::make_shared<GraceMergingBucket>();
+        bucket->bucket_index = bucket_index;
+        bucket->budget = budget;
+        bucket->file_stream = std::make_shared<GraceAggregatingTransform::BufferFileStream>();
+        /// One block on disk and one in memory
+        const Int64 key_offset = (bucket_index - 1) * 10;
+        auto spilled = buildBlock(0, 500, key_offset);
+        bucket->file_stream->original_file_stream.emplace(toShared(buildBlock(0, 0)), tmp_data.get());
+        bucket->file_stream->original_file_stream.value()->write(spilled);
+        auto in_memory = buildBlock(500, 1000, key_offset);
+        bucket->bytes = spilled.bytes() + in_memory.bytes();
+        bucket->file_stream->original_blocks.emplace_back(std::move(in_memory));
+        buckets.emplace_back(std::move(bucket));
+        for (Int64 i = 0; i < 1000; ++i)
+            expected[key_offset + i % 10] += i;
+    }
+
+    EXPECT_EQ(mergeBuckets(std::move(buckets)), expected);
+    /// The hash table bytes of the merged buckets are learned from their reservations.
+    EXPECT_GT(budget->estimate(1000), 0);
+}
+
+TEST(GraceAggregatingTransform, MergeSpilledBucketsInParallel)
+{
+    ConfigOverride config_override(
+        {{GraceMergingAggregateConfig::ENABLE_SPILL_TEST, "true"},
+         {GraceMergingAggregateConfig::GRACE_AGGREGATE_MERGING_PARALLELISM, "2"}});
+    auto query_id = QueryContext::instance().initializeQuery("GraceAggregatingTransform");
+    SCOPE_EXIT({ QueryContext::instance().finalizeQuery(query_id); });
+    const auto context = QueryContext::instance().currentQueryContext();
+
+    /// key = i % 20000, every block has enough keys to extend the buckets when it's asked to spill.
+    Blocks blocks;
+    for (Int64 i = 0; i < 3; ++i)
+        blocks.emplace_back(buildBlock(i * 20000, (i + 1) * 20000, 0, 20000));
+    auto source = std::make_shared<SpillingSource>(std::move(blocks), 1);
+    QueryPipelineBuilder builder;
+    builder.init(Pipe(source));
+
+    /// The spill test mode starts with 2 buckets and spills every block. The partial aggregation extends them to 4 before
+    /// the second block, so the blocks already spilled into bucket 1 are scattered again before the hand-over.
+    GraceAggregatingStep aggregating_step(
+        context, builder.getSharedHeader(), buildSumAggregatorParams(context, AggregatorParamsHelper::Mode::INIT_TO_PARTIAL), true);
+    aggregating_step.transformPipeline(builder, BuildQueryPipelineSettings{context});
+    GraceMergingAggregatedStep merging_step(
+        context, builder.getSharedHeader(), buildSumAggregatorParams(context, AggregatorParamsHelper::Mode::PARTIAL_TO_FINISHED), false);
+    merging_step.transformPipeline(builder, BuildQueryPipelineSettings{context});
+
+    auto pipeline = QueryPipelineBuilder::getPipeline(std::move(builder));
+    /// One thread, so the spill request is handled by the block right after it.
+    pipeline.setNumThreads(1);
+    std::vector<IProcessor *> merging_transforms;
+    for (const auto & processor : pipeline.getProcessors())
+    {
+        if (processor->getName() == "GraceBucketMergingTransform")
+            merging_transforms.push_back(processor.get());
+        else if (
+            processor->getName() == "GraceAggregatingTransform"
+            && &processor->getInputs().front().getOutputPort().getProcessor() == source.get())
+            source->spilling_processor = processor.get();
+    }
+    /// Each step wires 2 merging transforms to its GraceAggregatingTransform.
+    EXPECT_EQ(merging_transforms.size(), 4);
+    ASSERT_TRUE(source->spilling_processor);
+
+    PullingPipelineExecutor executor(pipeline);
+    std::map<Int64, Int64> res;
+    Block block;
+    while (executor.pull(block))
+    {
+        ASSERT_EQ(block.columns(), 2);
+        for (size_t i = 0; i < block.rows(); ++i)
+        {
+            auto key = block.getByPosition(0).column->getInt(i);
+            EXPECT_FALSE(res.contains(key));
+            res[key] = block.getByPosition(1).column->getInt(i);
+        }
+    }
+
+    ASSERT_EQ(res.size(), 20000);
+    for (Int64 key = 0; key < 20000; ++key)
+        EXPECT_EQ(res[key], 3 * key + 60000);
+
+    /// The spilled buckets were merged by the merging transforms, not by GraceAggregatingTransform.
+    size_t merged_rows = 0;
+    for (const auto * transform : merging_transforms)
+        merged_rows += transform->getProcessorDataStats().output_rows;
+    EXPECT_GT(merged_rows, 0);
+}
@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <map>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Operator/GroupTopKStep.h>
+#include <Processors/Executors/PullingPipelineExecutor.h>
+#include <Processors/Sources/SourceFromSingleChunk.h>
+#include <QueryPipeline/Pipe.h>
+#include <QueryPipeline/QueryPipeline.h>
+#include <gtest/gtest.h>
+#include <Interpreters/TemporaryDataOnDisk.h>
+#include <Common/BlockTypeUtils.h>
+#include <Common/QueryContext.h>
+
+using namespace DB;
+using namespace local_engine;
+
+namespace
+{
+/// key = i % 10, value = i
+Block buildBlock(Int64 begin, Int64 end)
+{
+    auto type = std::make_shared<DataTypeInt64>();
+    auto keys = ColumnInt64::create();
+    auto values = ColumnInt64::create();
+    for (Int64 i = begin; i < end; ++i)
+    {
+        keys->insertValue(i % 10);
+        values->insertValue(i);
+    }
+    return Block({ColumnWithTypeAndName(std::move(keys), type, "key"), ColumnWithTypeAndName(std::move(values), type, "value")});
+}
+
+/// key -> values in output order
+std::map<Int64, std::vector<Int64>>
+runTopK(Pipe pipe, bool final, size_t max_rows_before_spill, size_t limit, TemporaryDataOnDiskScopePtr tmp_data = nullptr)
+{
+    SortDescription sort_description{SortColumnDescription("value", -1, 1)};
+    pipe.addSimpleTransform(
+        [&](const SharedHeader & header)
+        {
+            return std::make_shared<GroupTopKTransform>(
+                header, std::vector<size_t>{0}, sort_description, limit, final, 0.9, tmp_data, max_rows_before_spill);
+        });
+    QueryPipeline pipeline(std::move(pipe));
+    PullingPipelineExecutor executor(pipeline);
+
+    std::map<Int64, std::vector<Int64>> res;
+    Block block;
+    while (executor.pull(block))
+    {
+        EXPECT_EQ(block.columns(), final ? 3 : 2);
+        for (size_t i = 0; i < block.rows(); ++i)
+        {
+            auto & values = res[block.getByPosition(0).column->getInt(i)];
+            values.push_back(block.getByPosition(1).column->getInt(i));
+            if (final)
+                EXPECT_EQ(block.getByPosition(2).column->getUInt(i), values.size());
+        }
+    }
+    return res;
+}
+}
+
+TEST(GroupTopKTransform, Final)
+{
+    auto source = std::make_shared<SourceFromSingleChunk>(toShared(buildBlock(0, 1000)));
+    auto res = runTopK(Pipe(source), true, 0, 3);
+    ASSERT_EQ(res.size(), 10);
+    for (Int64 key = 0; key < 10; ++key)
+        EXPECT_EQ(res[key], std::vector<Int64>({990 + key, 980 + key, 970 + key}));
+}
+
+TEST(GroupTopKTransform, FinalSpill)
+{
+    auto tmp_data = QueryContext::globalContext()->getTempDataOnDisk();
+    ASSERT_TRUE(tmp_data);
+    const size_t spilled_bytes = tmp_data->getStat().compressed_size;
+
+    Pipes pipes;
+    for (Int64 i = 0; i < 4; ++i)
+        pipes.emplace_back(std::make_shared<SourceFromSingleChunk>(toShared(buildBlock(i * 250, (i + 1) * 250))));
+    auto pipe = Pipe::unitePipes(std::move(pipes));
+    pipe.resize(1);
+
+    /// The candidates of all groups exceed the threshold after each chunk, so they are spilled and merged per bucket
+    auto res = runTopK(std::move(pipe), true, 20, 3, tmp_data);
+    EXPECT_GT(tmp_data->getStat().compressed_size, spilled_bytes);
+    ASSERT_EQ(res.size(), 10);
+    for (Int64 key = 0; key < 10; ++key)
+        EXPECT_EQ(res[key], std::vector<Int64>({990 + key, 980 + key, 970 + key}));
+}
+
+TEST(GroupTopKTransform, PartialFlush)
+{
+    Pipes pipes;
+    for (Int64 i = 0; i < 4; ++i)
+        pipes.emplace_back(std::make_shared<SourceFromSingleChunk>(toShared(buildBlock(i * 250, (i + 1) * 250))));
+    auto pipe = Pipe::unitePipes(std::move(pipes));
+    pipe.resize(1);
+
+    /// Candidates are flushed after each chunk, the output only is a pre-filter
+    auto res = runTopK(std::move(pipe), false, 10, 3);
+    ASSERT_EQ(res.size(), 10);
+    for (Int64 key = 0; key < 10; ++key)
+    {
+        auto & values = res[key];
+        EXPECT_EQ(values.size(), 12);
+        std::sort(values.begin(), values.end(), std::greater<>());
+        EXPECT_EQ(std::vector<Int64>(values.begin(), values.begin() + 3), std::vector<Int64>({990 + key, 980 + key, 970 + key}));
+    }
+}
@@ -0,0 +1,84 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <numeric>
+#include <DataTypes/DataTypeDate32.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesDecimal.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Functions/FunctionFactory.h>
+#include <Shuffle/SelectorBuilder.h>
+#include <gtest/gtest.h>
+#include <Common/QueryContext.h>
+
+using namespace DB;
+using namespace local_engine;
+
+TEST(HashSelectorBuilder, FusedMurmurHashSameAsFunction)
+{
+    const std::vector<DataTypePtr> types = {
+        std::make_shared<DataTypeInt32>(),
+        makeNullable(std::make_shared<DataTypeInt64>()),
+        makeNullable(std::make_shared<DataTypeString>()),
+        std::make_shared<DataTypeDecimal64>(18, 2),
+        std::make_shared<DataTypeInt16>(),
+        std::make_shared<DataTypeFloat64>(),
+        std::make_shared<DataTypeDate32>()};
+
+    const size_t rows = 1000;
+    ColumnsWithTypeAndName columns;
+    for (size_t c = 0; c < types.size(); ++c)
+    {
+        auto column = types[c]->createColumn();
+        for (size_t i = 0; i < rows; ++i)
+        {
+            const Int64 value = static_cast<Int64>(i * 7919 % 1001) - 500;
+            if (types[c]->isNullable() && i % 11 == 0)
+                column->insert(Field());
+            else if (isString(removeNullable(types[c])))
+                column->insert("str" + std::to_string(value));
+            else if (isDecimal(types[c]))
+                column->insert(DecimalField<Decimal64>(value, 2));
+            else if (isFloat(types[c]))
+                column->insert(i % 13 == 0 ? -0.0 : value / 3.0);
+            else
+                column->insert(value);
+        }
+        columns.emplace_back(std::move(column), types[c], "c" + std::to_string(c));
+    }
+    Block block(columns);
+
+    const UInt32 parts_num = 17;
+    std::vector<size_t> exprs_index(types.size());
+    std::iota(exprs_index.begin(), exprs_index.end(), 0);
+    HashSelectorBuilder builder(parts_num, exprs_index, "sparkMurmurHash3_32");
+    const auto info = builder.build(block);
+
+    auto function = FunctionFactory::instance().get("sparkMurmurHash3_32", QueryContext::globalContext())->build(columns);
+    const auto hash_column = function->execute(columns, function->getResultType(), rows, false);
+    std::vector<size_t> partition_rows(parts_num, 0);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        Int32 expected = static_cast<Int32>(hash_column->get64(i)) % static_cast<Int32>(parts_num);
+        if (expected < 0)
+            expected += parts_num;
+        EXPECT_EQ(info.src_partition_num[i], static_cast<size_t>(expected)) << i;
+        ++partition_rows[expected];
+    }
+    for (size_t p = 0; p < parts_num; ++p)
+        EXPECT_EQ(info.partition_start_points[p + 1] - info.partition_start_points[p], partition_rows[p]);
+}
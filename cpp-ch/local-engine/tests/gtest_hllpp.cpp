@@ -17,7 +17,11 @@
 
 #include <AggregateFunctions/AggregateFunctionUniqHyperLogLogPlusPlus.h>
 #include <IO/ReadBufferFromString.h>
+#include <IO/VarInt.h>
+#include <IO/WriteBufferFromString.h>
+#include <IO/WriteHelpers.h>
 #include <gtest/gtest.h>
+#include <Common/HashTable/Hash.h>
 
 using namespace DB;
 
@@ -86,3 +90,116 @@ TEST(HyperLogLogPlusPlusDataTest, SerializeAndDeserialize) {
 
     EXPECT_EQ(hll2.query(), 821);
 }
+
+static String serializeHLL(const HyperLogLogPlusPlusData & hll)
+{
+    WriteBufferFromOwnString write_buffer;
+    hll.serialize(write_buffer);
+    return write_buffer.str();
+}
+
+static std::vector<UInt64> generateHashes(size_t size, UInt64 seed)
+{
+    std::vector<UInt64> hashes;
+    for (size_t i = 0; i < size; ++i)
+        hashes.push_back(intHash64(seed * 1000003 + i));
+    return hashes;
+}
+
+TEST(HyperLogLogPlusPlusDataTest, SparseToDense)
+{
+    HyperLogLogPlusPlusData hll;
+    initSmallHLL(hll);
+    EXPECT_TRUE(hll.isSparse());
+
+    initLargeHLL(hll);
+    EXPECT_FALSE(hll.isSparse());
+    EXPECT_EQ(hll.query(), 821);
+}
+
+TEST(HyperLogLogPlusPlusDataTest, SerializeAndDeserializeSparse)
+{
+    HyperLogLogPlusPlusData hll1;
+    initSmallHLL(hll1);
+    ASSERT_TRUE(hll1.isSparse());
+
+    ReadBufferFromString read_buffer(serializeHLL(hll1));
+    HyperLogLogPlusPlusData hll2;
+    hll2.deserialize(read_buffer);
+    EXPECT_TRUE(hll2.isSparse());
+    EXPECT_EQ(hll2.query(), 10);
+}
+
+TEST(HyperLogLogPlusPlusDataTest, MergeIsRepresentationIndependent)
+{
+    /// Sparse and dense states of every combination give exactly the registers of adding all values to one state
+    for (size_t lhs_size : {5, 50, 5000})
+    {
+        for (size_t rhs_size : {5, 50, 5000})
+        {
+            const auto lhs_hashes = generateHashes(lhs_size, 1);
+            const auto rhs_hashes = generateHashes(rhs_size, 2);
+
+            HyperLogLogPlusPlusData lhs;
+            HyperLogLogPlusPlusData rhs;
+            HyperLogLogPlusPlusData expected;
+            for (auto x : lhs_hashes)
+            {
+                lhs.add(x);
+                expected.add(x);
+            }
+            for (auto x : rhs_hashes)
+            {
+                rhs.add(x);
+                expected.add(x);
+            }
+
+            lhs.merge(rhs);
+            if (lhs.isSparse() == expected.isSparse())
+                EXPECT_EQ(serializeHLL(lhs), serializeHLL(expected)) << lhs_size << " " << rhs_size;
+            EXPECT_EQ(lhs.query(), expected.query()) << lhs_size << " " << rhs_size;
+        }
+    }
+}
+
+TEST(HyperLogLogPlusPlusDataTest, AddBatch)
+{
+    const auto hashes = generateHashes(10000, 3);
+    HyperLogLogPlusPlusData hll1;
+    HyperLogLogPlusPlusData hll2;
+    for (auto x : hashes)
+        hll1.add(x);
+    hll2.addBatch(hashes.data(), hashes.size());
+    EXPECT_EQ(serializeHLL(hll1), serializeHLL(hll2));
+}
+
+static String serializeSparse(const std::vector<UInt64> & deltas)
+{
+    WriteBufferFromOwnString write_buffer;
+    writeBinaryLittleEndian(0.05, write_buffer);
+    writeBinaryLittleEndian(size_t{0}, write_buffer);
+    writeVarUInt(deltas.size(), write_buffer);
+    for (auto delta : deltas)
+        writeVarUInt(delta, write_buffer);
+    return write_buffer.str();
+}
+
+TEST(HyperLogLogPlusPlusDataTest, DeserializeInvalidSparse)
+{
+    auto deserialize = [](const std::vector<UInt64> & deltas)
+    {
+        ReadBufferFromString read_buffer(serializeSparse(deltas));
+        HyperLogLogPlusPlusData hll;
+        hll.deserialize(read_buffer);
+        return hll.query();
+    };
+
+    /// (index 1, value 1), (index 3, value 2)
+    EXPECT_EQ(deserialize({(1 << 6) | 1, (2 << 6) + 1}), 2);
+    /// Index out of range
+    EXPECT_THROW(deserialize({UInt64{1} << 31}), Exception);
+    EXPECT_THROW(deserialize({(1 << 6) | 1, std::numeric_limits<UInt64>::max()}), Exception);
+    /// Unsorted or duplicated indexes
+    EXPECT_THROW(deserialize({(1 << 6) | 1, 1}), Exception);
+    EXPECT_THROW(deserialize({(1 << 6) | 1, 0}), Exception);
+}
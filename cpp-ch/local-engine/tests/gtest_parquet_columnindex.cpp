@@ -17,6 +17,7 @@
 #include "config.h"
 #if USE_PARQUET
 #include <charconv>
+#include <filesystem>
 #include <future>
 #include <ranges>
 #include <string>
@@ -28,11 +29,17 @@
 #include <Storages/Parquet/ArrowUtils.h>
 #include <Storages/Parquet/ColumnIndexFilter.h>
 #include <Storages/Parquet/ParquetConverter.h>
+#include <Storages/Parquet/ParquetMeta.h>
 #include <Storages/Parquet/RowRanges.h>
 #include <Storages/Parquet/VectorizedParquetRecordReader.h>
 #include <Storages/Parquet/VirtualColumnRowIndexReader.h>
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <base/scope_guard.h>
 #include <boost/iterator/counting_iterator.hpp>
 #include <gtest/gtest.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/bloom_filter.h>
 #include <parquet/page_index.h>
 #include <parquet/schema.h>
 #include <parquet/statistics.h>
@@ -568,6 +575,78 @@ TEST(ColumnIndex, FilteringWithNotFoundColumnName)
     }
 }
 
+TEST(ColumnIndex, BloomFilterPruning)
+{
+    using namespace local_engine;
+    const auto node = parquet::schema::PrimitiveNode::Make("column1", parquet::Repetition::REQUIRED, parquet::Type::INT64);
+    const parquet::ColumnDescriptor descr(node, 0, 0);
+
+    auto bloom_filter = std::make_unique<parquet::BlockSplitBloomFilter>();
+    bloom_filter->Init(parquet::BlockSplitBloomFilter::OptimalNumOfBytes(100, 0.0001));
+    for (Int64 i = 0; i < 100; i += 2)
+        bloom_filter->InsertHash(bloom_filter->Hash(i));
+
+    ColumnValueIndexStore value_index_store;
+    value_index_store["column1"] = ColumnValueIndex::createBloomFilter(&descr, std::move(bloom_filter));
+
+    const RowType name_and_types{{"column1", BIGINT()}, {"column2", BIGINT()}};
+    auto may_match = [&](const std::string & exp)
+    {
+        const ColumnIndexFilter filter(test::parseFilter(exp, name_and_types).value(), QueryContext::globalContext());
+        return filter.mayMatch(value_index_store);
+    };
+
+    EXPECT_TRUE(may_match("column1 = 10"));
+    EXPECT_TRUE(may_match("column1 in (7, 20)"));
+    EXPECT_FALSE(may_match("column1 = 1001"));
+    EXPECT_FALSE(may_match("column1 in (1001, 1003)"));
+    // column2 has no bloom filter
+    EXPECT_TRUE(may_match("column1 = 1001 or column2 = 1"));
+    EXPECT_FALSE(may_match("column1 = 1001 and column2 = 1"));
+    EXPECT_TRUE(may_match("column1 > 1001"));
+}
+
+TEST(ColumnIndex, DictionaryRowGroupPruning)
+{
+    using namespace local_engine;
+    /// Two dictionary encoded row groups with the same min/max, even values in the first one and odd values in the second one
+    arrow::Int64Builder builder;
+    for (Int64 i = 0; i < 200; i += 2)
+        ASSERT_TRUE(builder.Append(i).ok());
+    for (Int64 i = 1; i < 200; i += 2)
+        ASSERT_TRUE(builder.Append(i).ok());
+    std::shared_ptr<arrow::Array> values;
+    ASSERT_TRUE(builder.Finish(&values).ok());
+    const auto table = arrow::Table::Make(arrow::schema({arrow::field("column1", arrow::int64(), false)}), {values});
+
+    const auto filename = std::filesystem::temp_directory_path() / "gtest_dictionary_row_group_pruning.parquet";
+    SCOPE_EXIT({ std::filesystem::remove(filename); });
+    {
+        auto out = arrow::io::FileOutputStream::Open(filename.string()).ValueOrDie();
+        ASSERT_TRUE(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), out, 100).ok());
+        ASSERT_TRUE(out->Close().ok());
+    }
+
+    const RowType name_and_types{{"column1", BIGINT()}};
+    const Block header({{BIGINT(), "column1"}});
+    auto skipped_row_groups = [&](const std::string & exp)
+    {
+        const ColumnIndexFilter filter(test::parseFilter(exp, name_and_types).value(), QueryContext::globalContext());
+        ParquetMetaBuilder meta_builder{.collectSkipRowGroup = true};
+        meta_builder.format_settings.parquet.bloom_filter_push_down = true;
+        ReadBufferFromFilePRead in(filename.string());
+        meta_builder.build(in, header, &filter);
+        EXPECT_EQ(meta_builder.readRowGroups.size() + meta_builder.skipRowGroups.size(), 2);
+        return meta_builder.skipRowGroups;
+    };
+
+    EXPECT_EQ(skipped_row_groups("column1 = 51"), std::vector<Int32>({0}));
+    EXPECT_EQ(skipped_row_groups("column1 in (10, 20)"), std::vector<Int32>({1}));
+    EXPECT_EQ(skipped_row_groups("column1 in (10, 21)"), std::vector<Int32>());
+    EXPECT_EQ(skipped_row_groups("column1 = 1001"), std::vector<Int32>({0, 1}));
+    EXPECT_EQ(skipped_row_groups("column1 > 51"), std::vector<Int32>());
+}
+
 using ParquetValue = std::variant<
     parquet::BooleanType::c_type,
     parquet::Int32Type::c_type,
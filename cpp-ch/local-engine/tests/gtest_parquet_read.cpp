@@ -45,6 +45,7 @@
 #include <tests/utils/gluten_test_util.h>
 #include <Common/BlockTypeUtils.h>
 #include <Common/DebugUtils.h>
+#include <Common/GlutenConfig.h>
 #include <Common/QueryContext.h>
 
 using namespace DB;
@@ -453,6 +454,46 @@ TEST(ParquetRead, VectorizedColumnReader)
         EXPECT_EQ(col_b.getFloat64(i), i + 1);
 }
 
+TEST(ParquetRead, FooterCache)
+{
+    const std::string sample(test::gtest_data("sample.parquet"));
+    Block blockHeader({{DOUBLE(), "b"}, {BIGINT(), "a"}});
+    const ParquetFileIdentity identity{.path = sample, .last_modified_time = 1, .file_size = 0};
+
+    auto & footer_cache = ParquetFooterCache::instance();
+    footer_cache.initialize(1_MiB);
+
+    auto build = [&](const ParquetFileIdentity & file)
+    {
+        ReadBufferFromFile in(sample);
+        ParquetMetaBuilder metaBuilder{.collectPageIndex = true, .fileIdentity = file};
+        metaBuilder.build(in, blockHeader);
+        return std::tuple{metaBuilder.fileMetaData, metaBuilder.footerCacheHits, metaBuilder.footerCacheMisses};
+    };
+
+    const auto [first, first_hits, first_misses] = build(identity);
+    EXPECT_EQ(footer_cache.misses(), 1);
+    EXPECT_EQ(footer_cache.count(), 1);
+    EXPECT_GT(footer_cache.sizeInBytes(), 0);
+    EXPECT_EQ(first_hits, 0);
+    EXPECT_EQ(first_misses, 1);
+
+    /// Same file, the parsed footer is shared.
+    const auto [second, second_hits, second_misses] = build(identity);
+    EXPECT_EQ(footer_cache.hits(), 1);
+    EXPECT_EQ(second_hits, 1);
+    EXPECT_EQ(second_misses, 0);
+    EXPECT_EQ(first.get(), second.get());
+
+    /// The file was overwritten, the stale footer must not be used.
+    const auto third = std::get<0>(build(ParquetFileIdentity{.path = sample, .last_modified_time = 2, .file_size = 0}));
+    EXPECT_EQ(footer_cache.misses(), 2);
+    EXPECT_EQ(footer_cache.count(), 1);
+    EXPECT_NE(first.get(), third.get());
+
+    footer_cache.initialize(ParquetFooterCacheConfig{}.parquet_footer_cache_max_size);
+}
+
 INCBIN(_upper_col_parquet_, SOURCE_DIR "/utils/extern-local-engine/tests/json/upper_col_parquet.json");
 TEST(ParquetRead, UpperColRead)
 {
@@ -0,0 +1,84 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Shuffle/SelectorBuilder.h>
+#include <gtest/gtest.h>
+
+using namespace DB;
+using namespace local_engine;
+
+namespace
+{
+std::vector<size_t> partitionIds(RangeSelectorBuilder & builder, Block & block)
+{
+    auto info = builder.build(block);
+    return {info.src_partition_num.begin(), info.src_partition_num.end()};
+}
+}
+
+TEST(RangeSelectorBuilder, SingleIntKey)
+{
+    /// asc nulls first
+    const String options = R"({
+        "ordering": [{"column_ref": 0, "column_name": "a", "direction": 1, "data_type": "IntegerType", "is_nullable": true}],
+        "range_bounds": [
+            [{"is_null": true}],
+            [{"is_null": false, "value": 10}],
+            [{"is_null": false, "value": 20}],
+            [{"is_null": false, "value": 30}]
+        ]})";
+    RangeSelectorBuilder builder(options, 5);
+
+    auto type = makeNullable(std::make_shared<DataTypeInt32>());
+    auto column = type->createColumn();
+    for (const auto & value : {Field(), Field(5), Field(10), Field(15), Field(30), Field(31), Field(-100)})
+        column->insert(value);
+    Block block({ColumnWithTypeAndName(std::move(column), type, "a")});
+    EXPECT_EQ(partitionIds(builder, block), std::vector<size_t>({0, 1, 1, 2, 3, 4, 1}));
+}
+
+TEST(RangeSelectorBuilder, MultipleKeysWithTies)
+{
+    /// a desc nulls last, b asc nulls first
+    const String options = R"({
+        "ordering": [
+            {"column_ref": 0, "column_name": "a", "direction": 4, "data_type": "LongType", "is_nullable": true},
+            {"column_ref": 1, "column_name": "b", "direction": 1, "data_type": "StringType", "is_nullable": false}],
+        "range_bounds": [
+            [{"is_null": false, "value": 30}, {"is_null": false, "value": "m"}],
+            [{"is_null": false, "value": 20}, {"is_null": false, "value": "c"}],
+            [{"is_null": false, "value": 20}, {"is_null": false, "value": "x"}],
+            [{"is_null": true}, {"is_null": false, "value": "k"}]
+        ]})";
+    RangeSelectorBuilder builder(options, 5);
+
+    auto a_type = makeNullable(std::make_shared<DataTypeInt64>());
+    auto b_type = std::make_shared<DataTypeString>();
+    auto a = a_type->createColumn();
+    auto b = b_type->createColumn();
+    const std::vector<std::pair<Field, String>> rows
+        = {{40, "a"}, {30, "z"}, {20, "a"}, {20, "d"}, {20, "z"}, {10, "a"}, {Field(), "a"}, {Field(), "z"}};
+    for (const auto & [a_value, b_value] : rows)
+    {
+        a->insert(a_value);
+        b->insert(b_value);
+    }
+    Block block({ColumnWithTypeAndName(std::move(a), a_type, "a"), ColumnWithTypeAndName(std::move(b), b_type, "b")});
+    EXPECT_EQ(partitionIds(builder, block), std::vector<size_t>({0, 1, 1, 2, 3, 3, 3, 4}));
+}
@@ -0,0 +1,135 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <thread>
+#include <Columns/ColumnsNumber.h>
+#include <Compression/CompressedWriteBuffer.h>
+#include <Compression/CompressionFactory.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <IO/ReadBufferFromString.h>
+#include <IO/WriteBufferFromString.h>
+#include <Shuffle/ShuffleReader.h>
+#include <Storages/IO/NativeWriter.h>
+#include <gtest/gtest.h>
+#include <Common/assert_cast.h>
+
+using namespace DB;
+using namespace local_engine;
+
+namespace
+{
+/// Many small blocks, each one in its own compressed frame
+String writeCompressedBlocks(size_t blocks, size_t rows_per_block)
+{
+    const auto type = std::make_shared<DataTypeInt64>();
+    WriteBufferFromOwnString out;
+    CompressedWriteBuffer compressed(out, CompressionCodecFactory::instance().get("LZ4", {}), 1024);
+    NativeWriter writer(compressed, Block({ColumnWithTypeAndName(type->createColumn(), type, "a")}));
+    Int64 value = 0;
+    for (size_t i = 0; i < blocks; ++i)
+    {
+        auto column = ColumnInt64::create();
+        for (size_t j = 0; j < rows_per_block; ++j)
+            column->insertValue(value++);
+        writer.write(Block({ColumnWithTypeAndName(std::move(column), type, "a")}));
+        compressed.next();
+    }
+    compressed.finalize();
+    return out.str();
+}
+
+std::vector<Int64> readAll(const String & data, size_t decompress_threads, size_t & blocks)
+{
+    ShuffleReader reader(std::make_unique<ReadBufferFromOwnString>(data), true, 1000, 1 << 20, decompress_threads);
+    std::vector<Int64> values;
+    blocks = 0;
+    while (true)
+    {
+        const auto * block = reader.read();
+        if (!block->rows())
+            break;
+        ++blocks;
+        const auto & column = assert_cast<const ColumnInt64 &>(*block->getByPosition(0).column);
+        values.insert(values.end(), column.getData().begin(), column.getData().end());
+    }
+    return values;
+}
+}
+
+TEST(ShuffleReader, ParallelDecompress)
+{
+    const String data = writeCompressedBlocks(500, 37);
+
+    size_t serial_blocks = 0;
+    const auto expected = readAll(data, 0, serial_blocks);
+    ASSERT_EQ(expected.size(), 500 * 37);
+    for (size_t i = 0; i < expected.size(); ++i)
+        ASSERT_EQ(expected[i], static_cast<Int64>(i));
+
+    for (size_t threads : {1, 4})
+    {
+        size_t blocks = 0;
+        EXPECT_EQ(readAll(data, threads, blocks), expected);
+        /// Small blocks are still coalesced to max_shuffle_read_rows
+        EXPECT_EQ(blocks, serial_blocks);
+    }
+}
+
+TEST(ShuffleReader, ParallelDecompressEarlyClose)
+{
+    const String data = writeCompressedBlocks(500, 37);
+    ShuffleReader reader(std::make_unique<ReadBufferFromOwnString>(data), true, 100, 1 << 20, 4);
+    EXPECT_GT(reader.read()->rows(), 0);
+    /// The destructor waits for the frames still being decompressed
+}
+
+namespace
+{
+/// Records whether a read happened on another thread than the one creating the buffer
+class ThreadCheckingReadBuffer : public ReadBufferFromOwnString
+{
+public:
+    explicit ThreadCheckingReadBuffer(const String & data, bool & read_on_other_thread_)
+        : ReadBufferFromOwnString(data), read_on_other_thread(read_on_other_thread_)
+    {
+    }
+
+private:
+    bool nextImpl() override
+    {
+        if (std::this_thread::get_id() != creating_thread)
+            read_on_other_thread = true;
+        /// All the data is in the initial buffer, so this is only called at the end
+        return false;
+    }
+
+    const std::thread::id creating_thread = std::this_thread::get_id();
+    bool & read_on_other_thread;
+};
+}
+
+TEST(ShuffleReader, ParallelDecompressReadsOnCallingThread)
+{
+    /// For shuffle the reads are JNI upcalls, which must stay on the task thread attached to the JVM
+    const String data = writeCompressedBlocks(100, 37);
+    bool read_on_other_thread = false;
+    ShuffleReader reader(std::make_unique<ThreadCheckingReadBuffer>(data, read_on_other_thread), true, 100, 1 << 20, 4);
+    size_t rows = 0;
+    while (const auto read_rows = reader.read()->rows())
+        rows += read_rows;
+    EXPECT_EQ(rows, 100 * 37);
+    EXPECT_FALSE(read_on_other_thread);
+}
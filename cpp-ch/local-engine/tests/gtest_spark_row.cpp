@@ -461,3 +461,59 @@ TEST(SparkRow, NullableComplexTypes)
     assertReadConsistentWithWritten(*spark_row_info, *block, type_and_fields);
     EXPECT_TRUE(spark_row_info->getTotalBytes() == 8 + 3 * 8);
 }
+
+TEST(SparkRow, MultiRowsComplexTypes)
+{
+    /// Nested values of later rows start at non-zero offsets of the nested columns
+    const auto decimal_array_type = std::make_shared<DataTypeArray>(makeNullable(std::make_shared<DataTypeDecimal32>(9, 2)));
+    const auto map_type = std::make_shared<DataTypeMap>(std::make_shared<DataTypeString>(), makeNullable(std::make_shared<DataTypeInt64>()));
+    const auto tuple_type = std::make_shared<DataTypeTuple>(
+        DataTypes{std::make_shared<DataTypeInt16>(), std::make_shared<DataTypeArray>(std::make_shared<DataTypeInt32>())});
+    Block block({
+        ColumnWithTypeAndName(decimal_array_type, "a"),
+        ColumnWithTypeAndName(makeNullable(map_type), "b"),
+        ColumnWithTypeAndName(tuple_type, "c"),
+    });
+
+    auto columns = block.mutateColumns();
+    for (size_t i = 0; i < 3; ++i)
+    {
+        Array decimals;
+        Map map;
+        Array ints;
+        for (size_t j = 0; j <= i; ++j)
+        {
+            decimals.emplace_back(j == 1 ? Field() : Field(DecimalField<Decimal32>(-static_cast<Int32>(i * 100 + j), 2)));
+            map.emplace_back(Tuple{Field("k" + std::to_string(j)), j == 0 ? Field() : Field(static_cast<Int64>(i + j))});
+            ints.emplace_back(static_cast<Int32>(i * j));
+        }
+        columns[0]->insert(decimals);
+        if (i == 1)
+            columns[1]->insert(Null{});
+        else
+            columns[1]->insert(map);
+        columns[2]->insert(Tuple{Field(static_cast<Int16>(i)), Field(ints)});
+    }
+    block.setColumns(std::move(columns));
+
+    auto spark_row_info = CHColumnToSparkRow().convertCHColumnToSparkRow(block);
+    int64_t total_bytes = 0;
+    for (size_t row = 0; row < block.rows(); ++row)
+    {
+        int64_t length = 8 + 3 * 8;
+        for (const auto & col : block)
+        {
+            const auto field = (*col.column)[row];
+            EXPECT_EQ(BackingDataLengthCalculator(col.type).calculate(*col.column, row), BackingDataLengthCalculator(col.type).calculate(field));
+            length += BackingDataLengthCalculator(col.type).calculate(field);
+        }
+        EXPECT_EQ(spark_row_info->getLengths()[row], length);
+        total_bytes += length;
+    }
+    EXPECT_EQ(spark_row_info->getTotalBytes(), total_bytes);
+
+    auto out = SparkRowToCHColumn::convertSparkRowInfoToCHColumn(*spark_row_info, block.cloneEmpty());
+    for (size_t col_idx = 0; col_idx < block.columns(); ++col_idx)
+        for (size_t row = 0; row < block.rows(); ++row)
+            EXPECT_TRUE((*block.getByPosition(col_idx).column)[row] == (*out->getByPosition(col_idx).column)[row]);
+}
@@ -46,6 +46,10 @@ const std::string kSparkTaskOffHeapMemory = "spark.gluten.memory.task.offHeap.si
 const std::string kMemoryReservationBlockSize = "spark.gluten.memory.reservationBlockSize";
 const uint64_t kMemoryReservationBlockSizeDefault = 8 << 20;
 
+// Upper bound of the adaptive chunk that memory is reserved from Spark in. 0 disables the reservation cache.
+const std::string kMemoryReservationCacheMaxChunkSize = "spark.gluten.memory.reservationCacheMaxChunkSize";
+const uint64_t kMemoryReservationCacheMaxChunkSizeDefault = 0;
+
 const std::string kCheckUsageLeak = "spark.gluten.sql.columnar.backend.velox.checkUsageLeak";
 const bool kCheckUsageLeakDefault = true;
 
@@ -80,6 +84,11 @@ const std::string kSortShuffleReaderDeserializerBufferSize =
     "spark.gluten.sql.columnar.shuffle.sort.deserializerBufferSize";
 const std::string kQatBackendName = "qat";
 const std::string kIaaBackendName = "iaa";
+// Number of QPL jobs created up front for IAA, and the max number the job pool grows to (0: 2x hardware threads).
+const std::string kIaaJobPoolSize = "spark.gluten.sql.columnar.shuffle.iaa.jobPoolSize";
+const uint32_t kIaaJobPoolSizeDefault = 64;
+const std::string kIaaJobPoolMaxSize = "spark.gluten.sql.columnar.shuffle.iaa.jobPoolMaxSize";
+const uint32_t kIaaJobPoolMaxSizeDefault = 0;
 
 const std::string kSparkRedactionRegex = "spark.redaction.regex";
 const std::string kSparkRedactionString = "*********(redacted)";
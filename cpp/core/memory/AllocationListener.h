@@ -102,4 +102,135 @@ class BlockAllocationListener final : public AllocationListener {
   mutable std::mutex mutex_;
 };
 
+/// Reserves memory from the delegated listener ahead of use, in chunks starting at minChunkSize. The chunk doubles
+/// (up to maxChunkSize) each time usage outgrows the reservation and halves each time slack is handed back, so a
+/// fast growing consumer makes a few large delegated calls instead of many small ones. Slack is only released when
+/// it exceeds two chunks, which avoids reserve / unreserve ping-pong around a chunk boundary. Call flush() to give
+/// back all of the slack, e.g. on spill or task end.
+// The class must be thread safe
+class ReservationCacheAllocationListener final : public AllocationListener {
+ public:
+  ReservationCacheAllocationListener(AllocationListener* delegated, int64_t minChunkSize, int64_t maxChunkSize)
+      : delegated_(delegated),
+        minChunkSize_(minChunkSize),
+        maxChunkSize_(std::max(minChunkSize, maxChunkSize)),
+        chunkSize_(minChunkSize) {}
+
+  void allocationChanged(int64_t diff) override {
+    if (diff == 0) {
+      return;
+    }
+    int64_t granted = reserve(diff);
+    if (granted == 0) {
+      return;
+    }
+    if (granted < 0) {
+      delegated_->allocationChanged(granted);
+      return;
+    }
+    try {
+      delegated_->allocationChanged(granted);
+      commit(granted);
+    } catch (const std::exception&) {
+      // The delegated listener could not provide a whole chunk, retry with the bytes actually needed.
+      int64_t needed = rollback(granted);
+      if (needed == 0) {
+        return;
+      }
+      try {
+        delegated_->allocationChanged(needed);
+        commit(needed);
+      } catch (const std::exception&) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pendingBytes_ -= needed;
+        usedBytes_ -= diff;
+        throw;
+      }
+    }
+  }
+
+  /// Releases all the reserved but unused bytes to the delegated listener. Returns the released bytes. Bytes still
+  /// being requested from the delegated listener are not released, so this can be called back from the delegated
+  /// listener, e.g. by a spill it triggers.
+  int64_t flush() {
+    int64_t released;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      released = reservedBytes_ - std::max<int64_t>(usedBytes_, 0);
+      if (released <= 0) {
+        return 0;
+      }
+      reservedBytes_ -= released;
+      chunkSize_ = minChunkSize_;
+    }
+    delegated_->allocationChanged(-released);
+    return released;
+  }
+
+  int64_t currentBytes() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reservedBytes_;
+  }
+
+  int64_t peakBytes() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return peakBytes_;
+  }
+
+ private:
+  // Returns the bytes to reserve (positive) or release (negative) from the delegated listener. Reserved bytes are
+  // pending until commit() or rollback(), they are not counted as slack meanwhile.
+  inline int64_t reserve(int64_t diff) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    usedBytes_ += diff;
+    if (usedBytes_ > reservedBytes_ + pendingBytes_) {
+      int64_t needed = usedBytes_ - reservedBytes_ - pendingBytes_;
+      int64_t granted = (needed + chunkSize_ - 1) / chunkSize_ * chunkSize_;
+      pendingBytes_ += granted;
+      chunkSize_ = std::min(chunkSize_ * 2, maxChunkSize_);
+      return granted;
+    }
+    int64_t slack = reservedBytes_ - std::max<int64_t>(usedBytes_, 0);
+    if (slack > 2 * chunkSize_) {
+      int64_t released = slack - chunkSize_;
+      reservedBytes_ -= released;
+      chunkSize_ = std::max(chunkSize_ / 2, minChunkSize_);
+      return -released;
+    }
+    return 0;
+  }
+
+  // Books pending bytes the delegated listener has granted.
+  inline void commit(int64_t granted) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pendingBytes_ -= granted;
+    reservedBytes_ += granted;
+    peakBytes_ = std::max(peakBytes_, reservedBytes_);
+  }
+
+  // Drops a failed pending reservation of granted bytes, then makes and returns a pending reservation of the bytes
+  // still missing.
+  inline int64_t rollback(int64_t granted) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pendingBytes_ -= granted;
+    chunkSize_ = minChunkSize_;
+    int64_t needed = std::max<int64_t>(usedBytes_ - reservedBytes_ - pendingBytes_, 0);
+    pendingBytes_ += needed;
+    return needed;
+  }
+
+  AllocationListener* const delegated_;
+  const int64_t minChunkSize_;
+  const int64_t maxChunkSize_;
+  int64_t chunkSize_;
+  int64_t usedBytes_{0L};
+  // Granted by the delegated listener.
+  int64_t reservedBytes_{0L};
+  // Being requested from the delegated listener.
+  int64_t pendingBytes_{0L};
+  int64_t peakBytes_{0L};
+
+  mutable std::mutex mutex_;
+};
+
 } // namespace gluten
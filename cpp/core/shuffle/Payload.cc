@@ -27,6 +27,10 @@
 #include "utils/Exception.h"
 #include "utils/Timer.h"
 
+#ifdef GLUTEN_ENABLE_IAA
+#include "utils/qpl/QplCodec.h"
+#endif
+
 namespace gluten {
 namespace {
 
@@ -86,6 +90,78 @@ arrow::Result<int64_t> compressBuffer(
   return kCompressedBufferHeaderLength + compressedLength;
 }
 
+#ifdef GLUTEN_ENABLE_IAA
+// Compresses the buffers concurrently on the IAA job pool, each into its own slot of 'output' sized for its maximum
+// compressed length, then compacts the slots into the layout written by compressBuffer. Returns the compacted length.
+arrow::Result<int64_t> compressBuffersAsync(
+    std::vector<std::shared_ptr<arrow::Buffer>>& buffers,
+    uint8_t* output,
+    arrow::util::Codec* codec,
+    qpl::QplAsyncCompressor& compressor) {
+  static const int64_t kCompressedBufferHeaderLength = 2 * sizeof(int64_t);
+  std::vector<uint8_t*> slots(buffers.size());
+  std::vector<uint64_t> tickets(buffers.size());
+  auto* slot = output;
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    const auto& buffer = buffers[i];
+    slots[i] = slot;
+    if (!buffer || buffer->size() == 0) {
+      slot += sizeof(int64_t);
+      continue;
+    }
+    auto maxLength = codec->MaxCompressedLen(buffer->size(), buffer->data());
+    tickets[i] = compressor.Submit(buffer->data(), buffer->size(), slot + kCompressedBufferHeaderLength, maxLength);
+    slot += kCompressedBufferHeaderLength + maxLength;
+  }
+
+  // Each slot starts at or after the compacted position, so moving it down never overwrites a slot still in use.
+  auto* outputPtr = output;
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    // Release buffer after compression. The ones not reached yet are kept alive for their running jobs.
+    auto buffer = std::move(buffers[i]);
+    if (!buffer) {
+      write<int64_t>(&outputPtr, kNullBuffer);
+      continue;
+    }
+    if (buffer->size() == 0) {
+      write<int64_t>(&outputPtr, kZeroLengthBuffer);
+      continue;
+    }
+    auto compressedLength = compressor.Wait(tickets[i]);
+    if (compressedLength >= buffer->size()) {
+      // Write uncompressed buffer.
+      write<int64_t>(&outputPtr, kUncompressedBuffer);
+      write<int64_t>(&outputPtr, buffer->size());
+      memcpy(outputPtr, buffer->data(), buffer->size());
+      outputPtr += buffer->size();
+      continue;
+    }
+    write<int64_t>(&outputPtr, compressedLength);
+    write<int64_t>(&outputPtr, buffer->size());
+    memmove(outputPtr, slots[i] + kCompressedBufferHeaderLength, compressedLength);
+    outputPtr += compressedLength;
+  }
+  return outputPtr - output;
+}
+#endif
+
+arrow::Result<int64_t> compressBuffers(
+    std::vector<std::shared_ptr<arrow::Buffer>>& buffers,
+    uint8_t* output,
+    int64_t maxLength,
+    arrow::util::Codec* codec) {
+  int64_t actualLength = 0;
+  // Compress buffers one by one.
+  for (auto& buffer : buffers) {
+    auto availableLength = maxLength - actualLength;
+    // Release buffer after compression.
+    ARROW_ASSIGN_OR_RAISE(auto compressedSize, compressBuffer(std::move(buffer), output, availableLength, codec));
+    output += compressedSize;
+    actualLength += compressedSize;
+  }
+  return actualLength;
+}
+
 arrow::Status compressAndFlush(
     const std::shared_ptr<arrow::Buffer>& buffer,
     arrow::io::OutputStream* outputStream,
@@ -198,15 +274,18 @@ arrow::Result<std::unique_ptr<BlockPayload>> BlockPayload::fromBuffers(
     ARROW_ASSIGN_OR_RAISE(compressedBuffer, arrow::AllocateResizableBuffer(maxLength, pool));
     auto* output = compressedBuffer->mutable_data();
 
-    int64_t actualLength = 0;
-    // Compress buffers one by one.
-    for (auto& buffer : buffers) {
-      auto availableLength = maxLength - actualLength;
-      // Release buffer after compression.
-      ARROW_ASSIGN_OR_RAISE(auto compressedSize, compressBuffer(std::move(buffer), output, availableLength, codec));
-      output += compressedSize;
-      actualLength += compressedSize;
+    int64_t actualLength;
+#ifdef GLUTEN_ENABLE_IAA
+    // Overlaps the compression of the buffers on the IAA hardware. Destroyed before the buffers and the output, so it
+    // waits for the jobs still running if compression fails.
+    if (auto compressor = qpl::MakeQplAsyncCompressor(codec); compressor != nullptr && numBuffers > 1) {
+      ARROW_ASSIGN_OR_RAISE(actualLength, compressBuffersAsync(buffers, output, codec, *compressor));
+    } else {
+      ARROW_ASSIGN_OR_RAISE(actualLength, compressBuffers(buffers, output, maxLength, codec));
     }
+#else
+    ARROW_ASSIGN_OR_RAISE(actualLength, compressBuffers(buffers, output, maxLength, codec));
+#endif
 
     ARROW_RETURN_IF(actualLength < 0, arrow::Status::Invalid("Writing compressed buffer out of bound."));
 
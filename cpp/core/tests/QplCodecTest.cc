@@ -0,0 +1,147 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "utils/qpl/QplCodec.h"
+#include <arrow/io/memory.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "shuffle/Payload.h"
+
+using namespace gluten::qpl;
+
+namespace {
+
+constexpr uint32_t kInitialJobs = 1;
+constexpr uint32_t kMaxJobs = 4;
+
+// Without IAA hardware the pool runs on the software path, so the tests run on any host.
+QplJobHWPool& getPool() {
+  QplJobHWPool::Configure(kInitialJobs, kMaxJobs);
+  return QplJobHWPool::GetInstance();
+}
+
+} // namespace
+
+TEST(QplJobHWPool, grow) {
+  auto& pool = getPool();
+  ASSERT_TRUE(QplJobHWPool::IsJobPoolReady());
+  ASSERT_EQ(pool.MaxJobs(), kMaxJobs);
+
+  std::vector<uint32_t> jobIds(kMaxJobs);
+  for (uint32_t i = 0; i < kMaxJobs; ++i) {
+    ASSERT_NE(pool.AcquireJob(jobIds[i]), nullptr);
+  }
+  ASSERT_EQ(pool.NumJobs(), kMaxJobs);
+  uint32_t jobId;
+  ASSERT_EQ(pool.AcquireJob(jobId), nullptr);
+
+  pool.ReleaseJob(jobIds[0]);
+  ASSERT_NE(pool.AcquireJob(jobId), nullptr);
+  ASSERT_EQ(jobId, jobIds[0]);
+  for (auto id : jobIds) {
+    pool.ReleaseJob(id);
+  }
+}
+
+TEST(QplAsyncCompressor, compress) {
+  getPool();
+  auto codec = MakeDefaultQplGZipCodec();
+  // More buffers than jobs, the ones without a job are compressed synchronously.
+  constexpr int kNumBuffers = 6;
+  constexpr int64_t kBufferSize = 64 << 10;
+  std::vector<std::vector<uint8_t>> inputs(kNumBuffers, std::vector<uint8_t>(kBufferSize));
+  std::vector<std::vector<uint8_t>> outputs(kNumBuffers);
+  for (int i = 0; i < kNumBuffers; ++i) {
+    std::iota(inputs[i].begin(), inputs[i].end(), i);
+    outputs[i].resize(codec->MaxCompressedLen(kBufferSize, inputs[i].data()));
+  }
+
+  QplAsyncCompressor compressor;
+  std::vector<uint64_t> tickets;
+  for (int i = 0; i < kNumBuffers; ++i) {
+    tickets.push_back(compressor.Submit(inputs[i].data(), kBufferSize, outputs[i].data(), outputs[i].size()));
+  }
+  ASSERT_EQ(compressor.NumPending(), kNumBuffers);
+
+  for (int i = 0; i < kNumBuffers; ++i) {
+    int64_t compressedSize;
+    if (i % 2 == 0) {
+      compressedSize = compressor.Wait(tickets[i]);
+    } else {
+      std::optional<int64_t> result;
+      while (!(result = compressor.Poll(tickets[i])).has_value()) {
+      }
+      compressedSize = result.value();
+    }
+    ASSERT_GT(compressedSize, 0);
+    ASSERT_LT(compressedSize, kBufferSize);
+
+    std::vector<uint8_t> decompressed(kBufferSize);
+    auto decompressedSize = codec->Decompress(compressedSize, outputs[i].data(), kBufferSize, decompressed.data());
+    ASSERT_TRUE(decompressedSize.ok());
+    ASSERT_EQ(*decompressedSize, kBufferSize);
+    ASSERT_EQ(decompressed, inputs[i]);
+  }
+  ASSERT_EQ(compressor.NumPending(), 0);
+}
+
+TEST(QplAsyncCompressor, blockPayload) {
+  getPool();
+  std::shared_ptr<arrow::util::Codec> codec = MakeDefaultQplGZipCodec();
+  auto* pool = arrow::default_memory_pool();
+  auto makeBuffer = [&](int64_t size, bool compressible) {
+    auto buffer = *arrow::AllocateResizableBuffer(size, pool);
+    for (int64_t i = 0; i < size; ++i) {
+      buffer->mutable_data()[i] = compressible ? i % 7 : (i * 2654435761u) >> 13;
+    }
+    return std::shared_ptr<arrow::Buffer>(std::move(buffer));
+  };
+  // More buffers than jobs, with the layouts of null, empty and incompressible buffers.
+  std::vector<std::shared_ptr<arrow::Buffer>> buffers = {
+      makeBuffer(64 << 10, true),
+      nullptr,
+      makeBuffer(0, true),
+      makeBuffer(100, false),
+      makeBuffer(32 << 10, true),
+      makeBuffer(128 << 10, true),
+      makeBuffer(1 << 10, true),
+      makeBuffer(16 << 10, true)};
+  auto expected = buffers;
+
+  auto payload = *gluten::BlockPayload::fromBuffers(
+      gluten::Payload::kCompressed, 10, std::move(buffers), nullptr, pool, codec.get());
+  auto outputStream = *arrow::io::BufferOutputStream::Create(1024, pool);
+  ASSERT_TRUE(payload->serialize(outputStream.get()).ok());
+  auto serialized = *outputStream->Finish();
+
+  arrow::io::BufferReader reader(serialized);
+  uint32_t numRows;
+  int64_t deserializeTime = 0;
+  int64_t decompressTime = 0;
+  auto deserialized =
+      *gluten::BlockPayload::deserialize(&reader, codec, pool, numRows, deserializeTime, decompressTime);
+  ASSERT_EQ(numRows, 10);
+  ASSERT_EQ(deserialized.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    if (expected[i] == nullptr) {
+      ASSERT_EQ(deserialized[i], nullptr) << i;
+    } else {
+      ASSERT_TRUE(deserialized[i]->Equals(*expected[i])) << i;
+    }
+  }
+}
@@ -80,6 +80,9 @@ struct Metrics {
     kLocalReadBytes,
     kRamReadBytes,
     kPreloadSplits,
+    kFooterCacheHits,
+    kFooterCacheMisses,
+    kSplitPreloadDepth,
 
     // Write metrics.
     kPhysicalWrittenBytes,
@@ -173,7 +173,8 @@ class SoftwareCodecDeflateQpl final {
 class QplGzipCodec final : public arrow::util::Codec {
  public:
   explicit QplGzipCodec(qpl_compression_levels compressionLevel)
-      : hwCodec_(std::make_unique<HardwareCodecDeflateQpl>(compressionLevel)),
+      : compressionLevel_(compressionLevel),
+        hwCodec_(std::make_unique<HardwareCodecDeflateQpl>(compressionLevel)),
         swCodec_(std::make_unique<SoftwareCodecDeflateQpl>(compressionLevel)) {}
 
   arrow::Result<int64_t>
@@ -228,7 +229,12 @@ class QplGzipCodec final : public arrow::util::Codec {
     return qpl_default_level;
   }
 
+  qpl_compression_levels compressionLevel() const {
+    return compressionLevel_;
+  }
+
  private:
+  qpl_compression_levels compressionLevel_;
   std::unique_ptr<HardwareCodecDeflateQpl> hwCodec_;
   std::unique_ptr<SoftwareCodecDeflateQpl> swCodec_;
 };
@@ -251,5 +257,91 @@ std::unique_ptr<arrow::util::Codec> MakeDefaultQplGZipCodec() {
   return MakeQplGZipCodec(qpl_default_level);
 }
 
+std::unique_ptr<QplAsyncCompressor> MakeQplAsyncCompressor(const arrow::util::Codec* codec) {
+  if (auto* qplCodec = dynamic_cast<const QplGzipCodec*>(codec)) {
+    return std::make_unique<QplAsyncCompressor>(qplCodec->compressionLevel());
+  }
+  return nullptr;
+}
+
+QplAsyncCompressor::QplAsyncCompressor(int compressionLevel)
+    : compressionLevel_(static_cast<qpl_compression_levels>(compressionLevel)),
+      swCodec_(std::make_unique<SoftwareCodecDeflateQpl>(compressionLevel_)) {}
+
+QplAsyncCompressor::~QplAsyncCompressor() {
+  for (auto& [ticket, task] : tasks_) {
+    if (task.job != nullptr) {
+      qpl_wait_job(task.job);
+      QplJobHWPool::GetInstance().ReleaseJob(task.jobId);
+    }
+  }
+}
+
+uint64_t QplAsyncCompressor::Submit(const uint8_t* input, int64_t inputLen, uint8_t* output, int64_t outputLen) {
+  Task task{input, inputLen, output, outputLen};
+  auto& pool = QplJobHWPool::GetInstance();
+  if (pool.IsJobPoolReady() && (task.job = pool.AcquireJob(task.jobId)) != nullptr) {
+    auto* jobPtr = task.job;
+    jobPtr->op = qpl_op_compress;
+    jobPtr->next_in_ptr = const_cast<uint8_t*>(input);
+    jobPtr->next_out_ptr = output;
+    jobPtr->available_in = inputLen;
+    jobPtr->level = compressionLevel_;
+    jobPtr->available_out = outputLen;
+    jobPtr->flags = QPL_FLAG_FIRST | QPL_FLAG_DYNAMIC_HUFFMAN | QPL_FLAG_LAST | QPL_FLAG_OMIT_VERIFY;
+    if (auto status = qpl_submit_job(jobPtr); status != QPL_STS_OK) {
+      finish(task, status);
+    }
+  } else {
+    task.result = swCodec_->doCompressData(input, inputLen, output, outputLen);
+  }
+  auto ticket = nextTicket_++;
+  tasks_.emplace(ticket, task);
+  return ticket;
+}
+
+std::optional<int64_t> QplAsyncCompressor::Poll(uint64_t ticket) {
+  auto it = tasks_.find(ticket);
+  GLUTEN_CHECK(it != tasks_.end(), "Unknown QPL compression ticket " + std::to_string(ticket));
+  auto& task = it->second;
+  if (task.job != nullptr) {
+    auto status = qpl_check_job(task.job);
+    if (status == QPL_STS_BEING_PROCESSED) {
+      return std::nullopt;
+    }
+    finish(task, status);
+  }
+  return take(ticket);
+}
+
+int64_t QplAsyncCompressor::Wait(uint64_t ticket) {
+  auto it = tasks_.find(ticket);
+  GLUTEN_CHECK(it != tasks_.end(), "Unknown QPL compression ticket " + std::to_string(ticket));
+  auto& task = it->second;
+  if (task.job != nullptr) {
+    finish(task, qpl_wait_job(task.job));
+  }
+  return take(ticket);
+}
+
+void QplAsyncCompressor::finish(Task& task, qpl_status status) {
+  if (status == QPL_STS_OK) {
+    task.result = task.job->total_out;
+  }
+  QplJobHWPool::GetInstance().ReleaseJob(task.jobId);
+  task.job = nullptr;
+  if (status != QPL_STS_OK) {
+    ARROW_LOG(WARNING) << "DeflateQpl async compression failed, falling back to SW codec. (Details: qpl job with "
+                       << "error code: " << status
+                       << " - please refer to qpl_status in ./contrib/qpl/include/qpl/c_api/status.h)";
+    task.result = swCodec_->doCompressData(task.input, task.inputLen, task.output, task.outputLen);
+  }
+}
+
+int64_t QplAsyncCompressor::take(uint64_t ticket) {
+  auto node = tasks_.extract(ticket);
+  return node.mapped().result;
+}
+
 } // namespace qpl
 } // namespace gluten
@@ -20,6 +20,9 @@
 #include <arrow/util/compression.h>
 #include <utils/qpl/QplJobPool.h>
 
+#include <optional>
+#include <unordered_map>
+
 namespace gluten {
 namespace qpl {
 
@@ -31,5 +34,55 @@ std::unique_ptr<arrow::util::Codec> MakeQplGZipCodec(int compressionLevel);
 
 std::unique_ptr<arrow::util::Codec> MakeDefaultQplGZipCodec();
 
+class SoftwareCodecDeflateQpl;
+
+/// Deflate compression submitted to the QPL job pool without waiting for it, so the caller can keep working, e.g.
+/// splitting the next partitions, while the accelerator compresses. A buffer that can't get a job, or whose job fails,
+/// is compressed synchronously on the software path instead. Input and output buffers must stay alive until poll or
+/// wait returns the result of their ticket. Not thread safe.
+class QplAsyncCompressor {
+ public:
+  explicit QplAsyncCompressor(int compressionLevel = qpl_default_level);
+
+  /// Waits for and releases the jobs still running.
+  ~QplAsyncCompressor();
+
+  /// Start compressing input into output. Returns the ticket to poll or wait for the result with.
+  uint64_t Submit(const uint8_t* input, int64_t inputLen, uint8_t* output, int64_t outputLen);
+
+  /// Return the compressed size of ticket if done, std::nullopt if still running.
+  std::optional<int64_t> Poll(uint64_t ticket);
+
+  /// Wait until ticket is done and return its compressed size.
+  int64_t Wait(uint64_t ticket);
+
+  /// Number of submitted tickets whose result has not been returned yet.
+  size_t NumPending() const {
+    return tasks_.size();
+  }
+
+ private:
+  struct Task {
+    const uint8_t* input;
+    int64_t inputLen;
+    uint8_t* output;
+    int64_t outputLen;
+    qpl_job* job = nullptr;
+    uint32_t jobId = 0;
+    int64_t result = -1;
+  };
+
+  void finish(Task& task, qpl_status status);
+  int64_t take(uint64_t ticket);
+
+  qpl_compression_levels compressionLevel_;
+  std::unique_ptr<SoftwareCodecDeflateQpl> swCodec_;
+  std::unordered_map<uint64_t, Task> tasks_;
+  uint64_t nextTicket_ = 0;
+};
+
+/// Return an async compressor with the compression level of codec if it is a QPL codec, nullptr otherwise.
+std::unique_ptr<QplAsyncCompressor> MakeQplAsyncCompressor(const arrow::util::Codec* codec);
+
 } // namespace qpl
 } // namespace gluten
@@ -19,103 +19,175 @@
 #include "utils/Macros.h"
 
 #include <arrow/util/logging.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <thread>
 
 namespace gluten {
 namespace qpl {
 
-std::array<qpl_job*, QplJobHWPool::MAX_JOB_NUMBER> QplJobHWPool::jobPool;
-std::array<std::atomic_bool, QplJobHWPool::MAX_JOB_NUMBER> QplJobHWPool::jobLocks;
+uint32_t QplJobHWPool::initialJobs = 64;
+uint32_t QplJobHWPool::maxJobs = 0;
 bool QplJobHWPool::jobPoolReady = false;
-std::unique_ptr<uint8_t[]> QplJobHWPool::hwJobsBuffer;
+
+namespace {
+
+// NUMA node of the CPU the calling thread runs on, -1 to let QPL choose.
+int32_t currentNumaNode() {
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+    return -1;
+  }
+  return static_cast<int32_t>(node);
+}
+
+} // namespace
 
 QplJobHWPool& QplJobHWPool::GetInstance() {
   static QplJobHWPool pool;
   return pool;
 }
 
-QplJobHWPool::QplJobHWPool() : randomEngine(std::random_device()()), distribution(0, MAX_JOB_NUMBER - 1) {
+void QplJobHWPool::Configure(uint32_t initial, uint32_t max) {
+  initialJobs = initial;
+  maxJobs = max;
+}
+
+QplJobHWPool::QplJobHWPool()
+    : maxJobs_(std::max<uint32_t>(
+          std::max<uint32_t>(initialJobs, 1),
+          maxJobs > 0 ? maxJobs : 2 * std::max<uint32_t>(std::thread::hardware_concurrency(), 1))),
+      jobPool_(std::make_unique<JobSlot[]>(maxJobs_)) {
   uint64_t initTime = 0;
   TIME_NANO(initTime, InitJobPool());
   DLOG(INFO) << "Init job pool took " << 1.0 * initTime / 1e6 << "ms";
 }
 
 QplJobHWPool::~QplJobHWPool() {
-  for (uint32_t i = 0; i < MAX_JOB_NUMBER; ++i) {
-    if (jobPool[i]) {
+  const auto numJobs = NumJobs();
+  for (uint32_t i = 0; i < numJobs; ++i) {
+    if (jobPool_[i].job) {
       while (!tryLockJob(i))
         ;
-      qpl_fini_job(jobPool[i]);
+      qpl_fini_job(jobPool_[i].job);
       unLockJob(i);
-      jobPool[i] = nullptr;
+      jobPool_[i].job = nullptr;
     }
   }
   jobPoolReady = false;
 }
 
 void QplJobHWPool::InitJobPool() {
-  uint32_t jobSize = 0;
   const char* qpl_version = qpl_get_library_version();
+  const auto numJobs = std::min(std::max<uint32_t>(initialJobs, 1), maxJobs_);
 
-  // Get size required for saving a single qpl job object
-  qpl_get_job_size(qpl_path_hardware, &jobSize);
-  // Allocate entire buffer for storing all job objects
-  hwJobsBuffer = std::make_unique<uint8_t[]>(jobSize * MAX_JOB_NUMBER);
-  // Initialize pool for storing all job object pointers
-  // Reallocate buffer by shifting address offset for each job object.
-  for (uint32_t index = 0; index < MAX_JOB_NUMBER; ++index) {
-    qpl_job* qplJobPtr = reinterpret_cast<qpl_job*>(hwJobsBuffer.get() + index * jobSize);
-    if (auto status = qpl_init_job(qpl_path_hardware, qplJobPtr); status != QPL_STS_OK) {
-      jobPoolReady = false;
+  for (auto path : {qpl_path_hardware, qpl_path_software}) {
+    path_ = path;
+    // Get size required for saving a single qpl job object
+    qpl_get_job_size(path_, &jobSize_);
+    uint32_t index = 0;
+    while (index < numJobs && initJob(index)) {
+      ++index;
+    }
+    if (index == numJobs) {
+      numJobs_.store(numJobs, std::memory_order_release);
+      ARROW_LOG(WARNING) << "Initialization of " << (IsHardwarePath() ? "hardware-assisted" : "software")
+                         << " DeflateQpl job pool succeeded with " << numJobs << " jobs, up to " << maxJobs_ << ".";
+      jobPoolReady = true;
+      return;
+    }
+    for (uint32_t i = 0; i < index; ++i) {
+      qpl_fini_job(jobPool_[i].job);
+      jobPool_[i].job = nullptr;
+    }
+    if (path == qpl_path_hardware) {
       ARROW_LOG(WARNING)
-          << "Initialization of hardware-assisted DeflateQpl codec failed at index: " << index
-          << ", falling back to SW codec. (Details: QplJobHWPool->qpl_init_job with error code: " << status
-          << " - please refer to qpl_status in ./contrib/qpl/include/qpl/c_api/status.h). "
+          << "Initialization of hardware-assisted DeflateQpl codec failed, falling back to the software path. "
           << "Please check if Intel In-Memory Analytics Accelerator (IAA) is properly set up. QPL Version: "
           << qpl_version;
-      return;
     }
-    jobPool[index] = qplJobPtr;
-    jobLocks[index].store(false);
   }
-  ARROW_LOG(WARNING) << "Initialization of hardware-assisted DeflateQpl codec succeeded.";
-  jobPoolReady = true;
+  jobPoolReady = false;
+}
+
+bool QplJobHWPool::initJob(uint32_t index) {
+  auto& slot = jobPool_[index];
+  // Allocated by the initializing thread, so a job created on demand lives on the NUMA node that needed it.
+  slot.buffer = std::make_unique<uint8_t[]>(jobSize_);
+  auto* qplJobPtr = reinterpret_cast<qpl_job*>(slot.buffer.get());
+  if (auto status = qpl_init_job(path_, qplJobPtr); status != QPL_STS_OK) {
+    ARROW_LOG(WARNING) << "QplJobHWPool->qpl_init_job failed at index: " << index << " with error code: " << status
+                       << " - please refer to qpl_status in ./contrib/qpl/include/qpl/c_api/status.h";
+    slot.buffer.reset();
+    return false;
+  }
+  slot.job = qplJobPtr;
+  return true;
+}
+
+bool QplJobHWPool::growJob(uint32_t& index) {
+  std::lock_guard<std::mutex> lock(growMutex_);
+  index = NumJobs();
+  if (index >= maxJobs_) {
+    return false;
+  }
+  jobPool_[index].locked.store(true);
+  if (!initJob(index)) {
+    jobPool_[index].locked.store(false);
+    return false;
+  }
+  numJobs_.store(index + 1, std::memory_order_release);
+  DLOG(INFO) << "Grew QPL job pool to " << index + 1 << " jobs.";
+  return true;
 }
 
 qpl_job* QplJobHWPool::AcquireJob(uint32_t& jobId) {
   if (!IsJobPoolReady()) {
     return nullptr;
   }
+  // Each thread starts probing at its own index to avoid contending over the same jobs.
+  static thread_local auto hint = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+  const auto numJobs = NumJobs();
+  uint32_t index = hint % numJobs;
   uint32_t retry = 0;
-  auto index = distribution(randomEngine);
   while (!tryLockJob(index)) {
-    index = distribution(randomEngine);
-    retry++;
-    if (retry > MAX_JOB_NUMBER) {
-      return nullptr;
+    if (++retry == numJobs) {
+      if (!growJob(index)) {
+        return nullptr;
+      }
+      break;
     }
+    index = (index + 1) % numJobs;
   }
-  jobId = MAX_JOB_NUMBER - index;
+  hint = index;
+  jobId = index;
   DLOG(INFO) << "Acquired job index " << index << " after " << retry << " retries.";
-  return jobPool[index];
+  auto* job = jobPool_[index].job;
+  if (IsHardwarePath()) {
+    job->numa_id = currentNumaNode();
+  }
+  return job;
 }
 
 void QplJobHWPool::ReleaseJob(uint32_t jobId) {
   if (IsJobPoolReady()) {
-    auto index = MAX_JOB_NUMBER - jobId;
-    unLockJob(index);
+    unLockJob(jobId);
   }
 }
 
 bool QplJobHWPool::tryLockJob(uint32_t index) {
   CheckJobIndex(index);
   bool expected = false;
-  return jobLocks[index].compare_exchange_strong(expected, true);
+  return jobPool_[index].locked.compare_exchange_strong(expected, true);
 }
 
 void QplJobHWPool::unLockJob(uint32_t index) {
   CheckJobIndex(index);
-  jobLocks[index].store(false);
+  jobPool_[index].locked.store(false);
 }
 
 } // namespace qpl
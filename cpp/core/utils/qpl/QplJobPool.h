@@ -20,8 +20,7 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
-#include <random>
-#include <thread>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -33,15 +32,22 @@ namespace qpl {
 
 /// QplJobHWPool is resource pool to provide the job objects, which is
 /// used for storing context information during.
-/// Memory for QPL job will be allocated when the QPLJobHWPool instance is created
+/// The pool starts with the configured number of jobs and grows on demand up to the max number of jobs, so threads
+/// don't contend over a small fixed set of jobs on hosts with many cores. If the IAA hardware can't be initialized,
+/// the pool provides software path jobs instead, which run the same operations on the CPU.
 ///
 //  QPL job can offload RLE-decoding/Filter/(De)compression works to hardware accelerator.
 class QplJobHWPool {
  public:
   static QplJobHWPool& GetInstance();
 
+  /// Set the number of jobs created at initialization and the max number of jobs. Only takes effect if called before
+  /// the first GetInstance(). A max of 0 means twice the number of hardware threads.
+  static void Configure(uint32_t initialJobs, uint32_t maxJobs);
+
   /// Acquire QPL job
   ///
+  /// The job runs on the NUMA node of the calling thread.
   /// @param jobId QPL job id, used when release QPL job
   /// \return Pointer to the QPL job. If acquire job failed, return nullptr.
   qpl_job* AcquireJob(uint32_t& jobId);
@@ -54,31 +60,53 @@ class QplJobHWPool {
     return jobPoolReady;
   }
 
+  /// \brief Return if the jobs run on the IAA hardware rather than on the software path.
+  bool IsHardwarePath() const {
+    return path_ == qpl_path_hardware;
+  }
+
+  uint32_t NumJobs() const {
+    return numJobs_.load(std::memory_order_acquire);
+  }
+
+  uint32_t MaxJobs() const {
+    return maxJobs_;
+  }
+
  private:
   QplJobHWPool();
   ~QplJobHWPool();
-  static void InitJobPool();
+  void InitJobPool();
+  bool initJob(uint32_t index);
+  /// Create a new job locked for the caller, return false if the pool is full.
+  bool growJob(uint32_t& index);
   bool tryLockJob(uint32_t index);
   void unLockJob(uint32_t index);
 
-  static inline void CheckJobIndex(uint32_t index) {
-    if (index >= MAX_JOB_NUMBER) {
-      throw GlutenException("Index exceeds MAX_JOB_NUMBER 512: " + std::to_string(index));
+  inline void CheckJobIndex(uint32_t index) const {
+    if (index >= NumJobs()) {
+      throw GlutenException("Index exceeds the number of QPL jobs " + std::to_string(NumJobs()) + ": " +
+                            std::to_string(index));
     }
   }
 
-  /// Max jobs in QPL_JOB_POOL
-  static constexpr auto MAX_JOB_NUMBER = 64;
-  /// Entire buffer for storing all job objects
-  static std::unique_ptr<uint8_t[]> hwJobsBuffer;
-  /// Job pool for storing all job object pointers
-  static std::array<qpl_job*, MAX_JOB_NUMBER> jobPool;
-  /// Locks for accessing each job object pointers
-  static std::array<std::atomic_bool, MAX_JOB_NUMBER> jobLocks;
+  struct JobSlot {
+    std::unique_ptr<uint8_t[]> buffer;
+    qpl_job* job = nullptr;
+    std::atomic_bool locked{false};
+  };
 
+  static uint32_t initialJobs;
+  static uint32_t maxJobs;
   static bool jobPoolReady;
-  std::mt19937 randomEngine;
-  std::uniform_int_distribution<int> distribution;
+
+  qpl_path_t path_ = qpl_path_hardware;
+  uint32_t jobSize_ = 0;
+  uint32_t maxJobs_;
+  /// Job slots, sized to the max number of jobs so that growing never moves them.
+  std::unique_ptr<JobSlot[]> jobPool_;
+  std::atomic<uint32_t> numJobs_{0};
+  std::mutex growMutex_;
 };
 
 } //  namespace qpl
@@ -146,7 +146,8 @@ void VeloxBackend::init(
   // Set cache_prefetch_min_pct default as 0 to force all loads are prefetched in DirectBufferInput.
   FLAGS_cache_prefetch_min_pct = backendConf_->get<int>(kCachePrefetchMinPct, 0);
 
-  // Setup and register.
+  // Setup and register. The footer cache is in front of the file systems registered after it.
+  initFooterCache();
   velox::filesystems::registerLocalFileSystem();
 
 #ifdef ENABLE_HDFS
@@ -162,6 +163,12 @@ void VeloxBackend::init(
   velox::filesystems::registerAbfsFileSystem();
 #endif
 
+#ifdef GLUTEN_ENABLE_IAA
+  qpl::QplJobHWPool::Configure(
+      backendConf_->get<uint32_t>(kIaaJobPoolSize, kIaaJobPoolSizeDefault),
+      backendConf_->get<uint32_t>(kIaaJobPoolMaxSize, kIaaJobPoolMaxSizeDefault));
+#endif
+
 #ifdef GLUTEN_ENABLE_GPU
   FLAGS_velox_cudf_debug = backendConf_->get<bool>(kDebugCudf, kDebugCudfDefault);
   if (backendConf_->get<bool>(kCudfEnabled, kCudfEnabledDefault)) {
@@ -229,7 +236,8 @@ void VeloxBackend::initJolFilesystem() {
   // FIXME It's known that if spill compression is disabled, the actual spill file size may
   //   in crease beyond this limit a little (maximum 64 rows which is by default
   //   one compression page)
-  registerJolFileSystem(maxSpillFileSize);
+  auto readThreads = backendConf_->get<uint32_t>(kJniFileSystemReadThreads, kJniFileSystemReadThreadsDefault);
+  registerJolFileSystem(maxSpillFileSize, readThreads);
 }
 
 std::unique_ptr<facebook::velox::cache::SsdCache> VeloxBackend::initSsdCache(uint64_t ssdCacheSize) {
@@ -243,7 +251,30 @@ std::unique_ptr<facebook::velox::cache::SsdCache> VeloxBackend::initSsdCache(uin
   bool checksumReadVerificationEnabled = backendConf_->get<bool>(kVeloxSsdCheckSumReadVerificationEnabled, false);
 
   cachePathPrefix_ = ssdCachePathPrefix;
-  cacheFilePrefix_ = getCacheFilePrefix();
+  std::optional<std::string> persistentCacheFilePrefix;
+  if (backendConf_->get<bool>(kVeloxSsdCachePersistent, false)) {
+    persistentCacheFilePrefix = SsdCacheManifest::lockSlot(cachePathPrefix_);
+    if (!persistentCacheFilePrefix.has_value()) {
+      LOG(WARNING) << "All persistent SSD cache slots in " << cachePathPrefix_
+                   << " are in use, falling back to a non persistent SSD cache";
+    }
+  }
+  std::optional<SsdCacheManifest::Versions> cachedFileVersions;
+  if (persistentCacheFilePrefix.has_value()) {
+    cacheFilePrefix_ = persistentCacheFilePrefix.value();
+    cachedFileVersions = SsdCacheManifest::read(cachePathPrefix_ + "/" + cacheFilePrefix_ + "manifest");
+    if (!cachedFileVersions.has_value()) {
+      // The files can't be validated without a manifest, start cold.
+      removeCacheFiles();
+      cachedFileVersions.emplace();
+    }
+    // The cache is restored from its checkpoint, so checkpointing can't be disabled.
+    if (ssdCheckpointIntervalSize == 0) {
+      ssdCheckpointIntervalSize = ssdCacheSize / 16;
+    }
+  } else {
+    cacheFilePrefix_ = getCacheFilePrefix();
+  }
   std::string ssdCachePath = ssdCachePathPrefix + "/" + cacheFilePrefix_;
   ssdCacheExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(ssdCacheIOThreads);
   const cache::SsdCache::Config config(
@@ -258,15 +289,38 @@ std::unique_ptr<facebook::velox::cache::SsdCache> VeloxBackend::initSsdCache(uin
   auto ssd = std::make_unique<velox::cache::SsdCache>(config);
   std::error_code ec;
   const std::filesystem::space_info si = std::filesystem::space(ssdCachePathPrefix, ec);
-  if (si.available < ssdCacheSize) {
+  // Restored cache files are reused in place.
+  uint64_t restoredBytes = 0;
+  if (cachedFileVersions.has_value()) {
+    for (const auto& entry : std::filesystem::directory_iterator(cachePathPrefix_)) {
+      if (entry.is_regular_file() && entry.path().filename().string().find(cacheFilePrefix_) != std::string::npos) {
+        restoredBytes += entry.file_size();
+      }
+    }
+  }
+  if (si.available + restoredBytes < ssdCacheSize) {
     VELOX_FAIL(
         "not enough space for ssd cache in " + ssdCachePath + " cache size: " + std::to_string(ssdCacheSize) +
         "free space: " + std::to_string(si.available));
   }
+  if (cachedFileVersions.has_value()) {
+    LOG(INFO) << "Restoring persistent SSD cache with " << cachedFileVersions->size() << " known files";
+    ssdCacheManifest_ = std::make_unique<SsdCacheManifest>(
+        cachePathPrefix_ + "/" + cacheFilePrefix_ + "manifest", ssd.get(), std::move(cachedFileVersions.value()));
+  }
   LOG(INFO) << "Initializing SSD cache with: " << config.toString();
   return ssd;
 }
 
+void VeloxBackend::removeCacheFiles() {
+  for (const auto& entry : std::filesystem::directory_iterator(cachePathPrefix_)) {
+    if (entry.path().filename().string().find(cacheFilePrefix_) != std::string::npos) {
+      LOG(INFO) << "Removing cache file " << entry.path().filename().string();
+      std::filesystem::remove(cachePathPrefix_ + "/" + entry.path().filename().string());
+    }
+  }
+}
+
 void VeloxBackend::initCache() {
   if (backendConf_->get<bool>(kVeloxCacheEnabled, false)) {
     uint64_t memCacheSize = backendConf_->get<uint64_t>(kVeloxMemCacheSize, kVeloxMemCacheSizeDefault);
@@ -290,6 +344,39 @@ void VeloxBackend::initCache() {
   }
 }
 
+void VeloxBackend::initFooterCache() {
+  const auto capacity = backendConf_->get<uint64_t>(kVeloxFooterCacheSize, kVeloxFooterCacheSizeDefault);
+  if (capacity > 0) {
+    const auto tailSize = backendConf_->get<uint64_t>(kVeloxFooterCacheTailSize, kVeloxFooterCacheTailSizeDefault);
+    footerCache_ = std::make_shared<FileFooterCache>(capacity, tailSize);
+    LOG(INFO) << "File footer cache of " << capacity << " bytes is ready";
+  }
+  // Also clears the cache of a previous backend instance.
+  registerFileFooterCacheFileSystem(footerCache_);
+}
+
+void VeloxBackend::logFileHandleCacheStats() const {
+  if (!backendConf_->get<bool>(kVeloxFileHandleCacheEnabled, kVeloxFileHandleCacheEnabledDefault)) {
+    return;
+  }
+  auto connector = velox::connector::getConnector(kHiveConnectorId);
+  if (auto hiveConnector = std::dynamic_pointer_cast<velox::connector::hive::HiveConnector>(connector)) {
+    const auto stats = hiveConnector->fileHandleCacheStats();
+    LOG(INFO) << "File handle cache: " << stats.numHits << " hits in " << stats.numLookups << " lookups, "
+              << stats.numElements << " cached files";
+  }
+}
+
+void VeloxBackend::logFooterCacheStats() const {
+  if (footerCache_ == nullptr) {
+    return;
+  }
+  const auto stats = footerCache_->stats();
+  LOG(INFO) << "File footer cache: " << stats.numHits << " hits, " << stats.numMisses << " misses, "
+            << stats.numInvalidations << " invalidations, " << stats.numEntries << " files, " << stats.cachedBytes
+            << " bytes";
+}
+
 void VeloxBackend::initConnector() {
   auto hiveConf = getHiveConfig(backendConf_);
 
@@ -29,6 +29,8 @@
 #include "velox/common/memory/MmapAllocator.h"
 
 #include "memory/VeloxMemoryManager.h"
+#include "utils/FileFooterCache.h"
+#include "utils/SsdCacheManifest.h"
 
 namespace gluten {
 
@@ -52,6 +54,16 @@ class VeloxBackend {
     return backendConf_;
   }
 
+  /// Not null only if the SSD cache is persistent.
+  SsdCacheManifest* getSsdCacheManifest() const {
+    return ssdCacheManifest_.get();
+  }
+
+  /// Null if the footer cache is disabled.
+  FileFooterCache* getFooterCache() const {
+    return footerCache_.get();
+  }
+
   VeloxMemoryManager* getGlobalMemoryManager() const {
     return globalMemoryManager_.get();
   }
@@ -62,17 +74,22 @@ class VeloxBackend {
     // So, we need to destruct IOThreadPoolExecutor and stop the threads before global variables get destructed.
     ioExecutor_.reset();
     globalMemoryManager_.reset();
+    logFileHandleCacheStats();
+    logFooterCacheStats();
+    registerFileFooterCacheFileSystem(nullptr);
+    footerCache_.reset();
 
     // dump cache stats on exit if enabled
     if (dynamic_cast<facebook::velox::cache::AsyncDataCache*>(asyncDataCache_.get())) {
       LOG(INFO) << asyncDataCache_->toString();
-      for (const auto& entry : std::filesystem::directory_iterator(cachePathPrefix_)) {
-        if (entry.path().filename().string().find(cacheFilePrefix_) != std::string::npos) {
-          LOG(INFO) << "Removing cache file " << entry.path().filename().string();
-          std::filesystem::remove(cachePathPrefix_ + "/" + entry.path().filename().string());
-        }
+      if (ssdCacheManifest_ == nullptr) {
+        removeCacheFiles();
+        asyncDataCache_->shutdown();
+      } else {
+        // Shutdown writes the final checkpoint, which the manifest must not be older than.
+        asyncDataCache_->shutdown();
+        ssdCacheManifest_->save();
       }
-      asyncDataCache_->shutdown();
     }
   }
 
@@ -90,11 +107,18 @@ class VeloxBackend {
   std::unique_ptr<facebook::velox::cache::SsdCache> initSsdCache(uint64_t ssdSize);
 
   void initJolFilesystem();
+  void initFooterCache();
 
   std::string getCacheFilePrefix() {
     return "cache." + boost::lexical_cast<std::string>(boost::uuids::random_generator()()) + ".";
   }
 
+  void removeCacheFiles();
+
+  void logFileHandleCacheStats() const;
+
+  void logFooterCacheStats() const;
+
   static std::unique_ptr<VeloxBackend> instance_;
 
   // A global Velox memory manager for the current process.
@@ -108,6 +132,8 @@ class VeloxBackend {
 
   std::string cachePathPrefix_;
   std::string cacheFilePrefix_;
+  std::unique_ptr<SsdCacheManifest> ssdCacheManifest_;
+  std::shared_ptr<FileFooterCache> footerCache_;
 
   std::shared_ptr<facebook::velox::config::ConfigBase> backendConf_;
 };
@@ -310,7 +310,18 @@ std::shared_ptr<ShuffleReader> VeloxRuntime::createShuffleReader(
 std::unique_ptr<ColumnarBatchSerializer> VeloxRuntime::createColumnarBatchSerializer(struct ArrowSchema* cSchema) {
   auto arrowPool = memoryManager()->defaultArrowMemoryPool();
   auto veloxPool = memoryManager()->getLeafMemoryPool();
-  return std::make_unique<VeloxColumnarBatchSerializer>(arrowPool, veloxPool, cSchema);
+  auto format = veloxCfg_->get<std::string>(kColumnarBatchSerdeFormat, kColumnarBatchSerdeFormatDefault);
+  if (format == "presto") {
+    return std::make_unique<VeloxColumnarBatchSerializer>(arrowPool, veloxPool, cSchema);
+  }
+  GLUTEN_CHECK(format == "columnar", "Unsupported " + kColumnarBatchSerdeFormat + ": " + format);
+  auto codec = veloxCfg_->get<std::string>(kColumnarBatchSerdeCodec, kColumnarBatchSerdeCodecDefault);
+  std::transform(codec.begin(), codec.end(), codec.begin(), ::tolower);
+  auto compressionType = arrow::Compression::UNCOMPRESSED;
+  if (codec != "none") {
+    GLUTEN_ASSIGN_OR_THROW(compressionType, arrow::util::Codec::GetCompressionType(codec));
+  }
+  return std::make_unique<VeloxColumnarBatchSerializer>(arrowPool, veloxPool, cSchema, true, compressionType);
 }
 
 void VeloxRuntime::enableDumping() {
@@ -48,6 +48,8 @@ const std::string kStorageReadBytes = "storageReadBytes";
 const std::string kLocalReadBytes = "localReadBytes";
 const std::string kRamReadBytes = "ramReadBytes";
 const std::string kPreloadSplits = "readyPreloadedSplits";
+const std::string kFooterCacheHits{FileFooterCache::kHitsStat};
+const std::string kFooterCacheMisses{FileFooterCache::kMissesStat};
 const std::string kNumWrittenFiles = "numWrittenFiles";
 const std::string kWriteIOTime = "writeIOWallNanos";
 
@@ -121,7 +123,22 @@ WholeStageResultIterator::WholeStageResultIterator(
 
     std::vector<std::shared_ptr<velox::connector::ConnectorSplit>> connectorSplits;
     connectorSplits.reserve(paths.size());
+    auto* ssdCacheManifest = VeloxBackend::get()->getSsdCacheManifest();
+    auto* footerCache = VeloxBackend::get()->getFooterCache();
     for (int idx = 0; idx < paths.size(); idx++) {
+      // A persistent SSD cache can only validate the entries of files with a known modification time after a
+      // restart, so the other files are not cached.
+      bool cacheable = true;
+      if (ssdCacheManifest != nullptr) {
+        if (properties[idx].has_value() && properties[idx]->modificationTime.has_value()) {
+          ssdCacheManifest->validate(paths[idx], properties[idx]->modificationTime.value());
+        } else {
+          cacheable = false;
+        }
+      }
+      if (footerCache != nullptr && properties[idx].has_value() && properties[idx]->modificationTime.has_value()) {
+        footerCache->registerFile(paths[idx], properties[idx]->modificationTime.value());
+      }
       auto partitionColumn = partitionColumns[idx];
       auto metadataColumn = metadataColumns[idx];
       std::unordered_map<std::string, std::optional<std::string>> partitionKeys;
@@ -141,7 +158,7 @@ WholeStageResultIterator::WholeStageResultIterator(
             std::nullopt,
             customSplitInfo,
             nullptr,
-            true,
+            cacheable,
             deleteFiles,
             std::unordered_map<std::string, std::string>(),
             properties[idx]);
@@ -158,7 +175,7 @@ WholeStageResultIterator::WholeStageResultIterator(
             nullptr,
             std::unordered_map<std::string, std::string>(),
             0,
-            true,
+            cacheable,
             metadataColumn,
             properties[idx]);
       }
@@ -239,6 +256,8 @@ int64_t WholeStageResultIterator::spillFixedSize(int64_t size) {
     LOG(INFO) << fmt::format("{} trying to request spill for {}.", logPrefix, velox::succinctBytes(remaining));
     auto mm = memoryManager_->getMemoryManager();
     uint64_t spilledOut = mm->arbitrator()->shrinkCapacity(remaining); // this conducts spill
+    // Memory freed by the spill may still be held in the reservation cache.
+    spilledOut += memoryManager_->flushReservation();
     uint64_t total = shrunken + spilledOut;
     LOG(INFO) << fmt::format(
         "{} successfully reclaimed total {} with shrunken {} and spilled {}.",
@@ -319,6 +338,45 @@ void WholeStageResultIterator::constructPartitionColumns(
   }
 }
 
+int32_t WholeStageResultIterator::splitPreloadDepth(
+    const std::vector<uint64_t>& splitLengths,
+    int32_t defaultDepth,
+    uint64_t memoryBudget,
+    uint64_t loadQuantum,
+    int32_t maxDepth) {
+  const int64_t numSplits = splitLengths.size();
+  if (memoryBudget == 0 || numSplits <= 1) {
+    return defaultDepth;
+  }
+  // A preloaded split holds the file footer and the first row group ranges, which are bounded by the split length
+  // and the load quantum.
+  uint64_t totalBytes = 0;
+  for (const auto length : splitLengths) {
+    totalBytes += std::min<uint64_t>(length, loadQuantum);
+  }
+  const auto bytesPerSplit = std::max<uint64_t>(totalBytes / numSplits, 1);
+  const auto depthLimit = std::max<int64_t>(std::min<int64_t>(maxDepth, numSplits - 1), 1);
+  return std::clamp<int64_t>(memoryBudget / bytesPerSplit, 1, depthLimit);
+}
+
+int32_t WholeStageResultIterator::splitPreloadDepth() const {
+  std::vector<uint64_t> splitLengths;
+  for (const auto& scanInfo : scanInfos_) {
+    splitLengths.insert(splitLengths.end(), scanInfo->lengths.begin(), scanInfo->lengths.end());
+  }
+  const auto depth = splitPreloadDepth(
+      splitLengths,
+      veloxCfg_->get<int32_t>(kVeloxSplitPreloadPerDriver, 2),
+      velox::config::toCapacity(
+          veloxCfg_->get<std::string>(kVeloxSplitPreloadMemoryBytes, kVeloxSplitPreloadMemoryBytesDefault),
+          velox::config::CapacityUnit::BYTE),
+      velox::config::toCapacity(
+          veloxCfg_->get<std::string>(kLoadQuantum, "268435456"), velox::config::CapacityUnit::BYTE),
+      veloxCfg_->get<int32_t>(kVeloxSplitPreloadMaxDepth, kVeloxSplitPreloadMaxDepthDefault));
+  VLOG(1) << "Preloading " << depth << " of " << splitLengths.size() << " splits for task " << taskInfo_ << ".";
+  return depth;
+}
+
 void WholeStageResultIterator::tryAddSplitsToTask() {
   if (noMoreSplits_) {
     return;
@@ -393,6 +451,7 @@ void WholeStageResultIterator::collectMetrics() {
     }
 
     const auto& stats = planStats.at(nodeId);
+    const bool isScan = std::find(scanNodeIds_.begin(), scanNodeIds_.end(), nodeId) != scanNodeIds_.end();
     // Add each operator stats into metrics.
     for (const auto& entry : stats.operatorStats) {
       const auto& second = entry.second;
@@ -438,6 +497,11 @@ void WholeStageResultIterator::collectMetrics() {
       metrics_->get(Metrics::kRamReadBytes)[metricIndex] = runtimeMetric("sum", second->customStats, kRamReadBytes);
       metrics_->get(Metrics::kPreloadSplits)[metricIndex] =
           runtimeMetric("sum", entry.second->customStats, kPreloadSplits);
+      metrics_->get(Metrics::kFooterCacheHits)[metricIndex] =
+          runtimeMetric("sum", second->customStats, kFooterCacheHits);
+      metrics_->get(Metrics::kFooterCacheMisses)[metricIndex] =
+          runtimeMetric("sum", second->customStats, kFooterCacheMisses);
+      metrics_->get(Metrics::kSplitPreloadDepth)[metricIndex] = isScan ? splitPreloadDepth_ : 0;
       metrics_->get(Metrics::kNumWrittenFiles)[metricIndex] =
           runtimeMetric("sum", entry.second->customStats, kNumWrittenFiles);
       metrics_->get(Metrics::kPhysicalWrittenBytes)[metricIndex] = second->physicalWrittenBytes;
@@ -557,10 +621,9 @@ std::unordered_map<std::string, std::string> WholeStageResultIterator::getQueryC
         std::to_string(veloxCfg_->get<int64_t>(kBloomFilterNumBits, 8388608));
     configs[velox::core::QueryConfig::kSparkBloomFilterMaxNumBits] =
         std::to_string(veloxCfg_->get<int64_t>(kBloomFilterMaxNumBits, 4194304));
-    // spark.gluten.sql.columnar.backend.velox.SplitPreloadPerDriver takes no effect if
-    // spark.gluten.sql.columnar.backend.velox.IOThreads is set to 0
-    configs[velox::core::QueryConfig::kMaxSplitPreloadPerDriver] =
-        std::to_string(veloxCfg_->get<int32_t>(kVeloxSplitPreloadPerDriver, 2));
+    // Split preloading takes no effect if spark.gluten.sql.columnar.backend.velox.IOThreads is set to 0
+    splitPreloadDepth_ = splitPreloadDepth();
+    configs[velox::core::QueryConfig::kMaxSplitPreloadPerDriver] = std::to_string(splitPreloadDepth_);
 
     // Disable driver cpu time slicing.
     configs[velox::core::QueryConfig::kDriverCpuTimeSliceLimitMs] = "0";
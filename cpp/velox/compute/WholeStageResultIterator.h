@@ -69,6 +69,16 @@ class WholeStageResultIterator : public ColumnarBatchIterator {
     return veloxPlan_.get();
   }
 
+  /// Number of splits each table scan preloads ahead of the one it reads, so that the preloaded splits fit into
+  /// 'memoryBudget'. Each split is estimated at its length, capped at 'loadQuantum'. The depth is at least 1 and at
+  /// most 'maxDepth' and the number of the other splits. 'defaultDepth' is used without a budget or with one split.
+  static int32_t splitPreloadDepth(
+      const std::vector<uint64_t>& splitLengths,
+      int32_t defaultDepth,
+      uint64_t memoryBudget,
+      uint64_t loadQuantum,
+      int32_t maxDepth);
+
  private:
   /// Get the Spark confs to Velox query context.
   std::unordered_map<std::string, std::string> getQueryContextConf();
@@ -89,6 +99,9 @@ class WholeStageResultIterator : public ColumnarBatchIterator {
       std::unordered_map<std::string, std::optional<std::string>>&,
       const std::unordered_map<std::string, std::string>&);
 
+  /// Split preload depth of this task from the config and its splits.
+  int32_t splitPreloadDepth() const;
+
   /// Add splits to task. Skip if already added.
   void tryAddSplitsToTask();
 
@@ -127,6 +140,7 @@ class WholeStageResultIterator : public ColumnarBatchIterator {
   std::vector<facebook::velox::core::PlanNodeId> streamIds_;
   std::vector<std::vector<facebook::velox::exec::Split>> splits_;
   bool noMoreSplits_ = false;
+  int32_t splitPreloadDepth_{0};
 };
 
 } // namespace gluten
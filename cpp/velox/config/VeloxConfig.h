@@ -41,6 +41,8 @@ const std::string kMaxSpillRunRows = "spark.gluten.sql.columnar.backend.velox.Ma
 const std::string kMaxSpillBytes = "spark.gluten.sql.columnar.backend.velox.MaxSpillBytes";
 const std::string kSpillReadBufferSize = "spark.unsafe.sorter.spill.reader.buffer.size";
 const uint64_t kMaxSpillFileSizeDefault = 1L * 1024 * 1024 * 1024;
+const std::string kJniFileSystemReadThreads = "spark.gluten.sql.columnar.backend.velox.jniFileSystemReadThreads";
+const uint32_t kJniFileSystemReadThreadsDefault = 0;
 
 const std::string kSpillableReservationGrowthPct =
     "spark.gluten.sql.columnar.backend.velox.spillableReservationGrowthPct";
@@ -65,6 +67,13 @@ const std::string kBloomFilterExpectedNumItems = "spark.gluten.sql.columnar.back
 const std::string kBloomFilterNumBits = "spark.gluten.sql.columnar.backend.velox.bloomFilter.numBits";
 const std::string kBloomFilterMaxNumBits = "spark.gluten.sql.columnar.backend.velox.bloomFilter.maxNumBits";
 const std::string kVeloxSplitPreloadPerDriver = "spark.gluten.sql.columnar.backend.velox.SplitPreloadPerDriver";
+// If positive, the number of splits preloaded ahead of the one being read is derived from this budget and the
+// estimated memory held by each preloaded split, up to kVeloxSplitPreloadMaxDepth. kVeloxSplitPreloadPerDriver is
+// ignored then.
+const std::string kVeloxSplitPreloadMemoryBytes = "spark.gluten.sql.columnar.backend.velox.splitPreloadMemoryBytes";
+const std::string kVeloxSplitPreloadMemoryBytesDefault = "0";
+const std::string kVeloxSplitPreloadMaxDepth = "spark.gluten.sql.columnar.backend.velox.splitPreloadMaxDepth";
+const int32_t kVeloxSplitPreloadMaxDepthDefault = 16;
 
 const std::string kShowTaskMetricsWhenFinished = "spark.gluten.sql.columnar.backend.velox.showTaskMetricsWhenFinished";
 const bool kShowTaskMetricsWhenFinishedDefault = false;
@@ -107,6 +116,8 @@ const uint32_t kVeloxSsdCacheShardsDefault = 1;
 const std::string kVeloxSsdCacheIOThreads = "spark.gluten.sql.columnar.backend.velox.ssdCacheIOThreads";
 const uint32_t kVeloxSsdCacheIOThreadsDefault = 1;
 const std::string kVeloxSsdODirectEnabled = "spark.gluten.sql.columnar.backend.velox.ssdODirect";
+// Keep the SSD cache files across executor restarts and restore the cache from its checkpoint on startup.
+const std::string kVeloxSsdCachePersistent = "spark.gluten.sql.columnar.backend.velox.ssdCachePersistent";
 const std::string kVeloxSsdCheckpointIntervalBytes =
     "spark.gluten.sql.columnar.backend.velox.ssdCheckpointIntervalBytes";
 const std::string kVeloxSsdDisableFileCow = "spark.gluten.sql.columnar.backend.velox.ssdDisableFileCow";
@@ -124,11 +135,27 @@ const int32_t kVeloxAsyncTimeoutOnTaskStoppingDefault = 30000; // 30s
 // udf
 const std::string kVeloxUdfLibraryPaths = "spark.gluten.sql.columnar.backend.velox.internal.udfLibraryPaths";
 
+// ColumnarBatchSerializer, "presto" or "columnar".
+const std::string kColumnarBatchSerdeFormat = "spark.gluten.sql.columnar.backend.velox.columnarBatchSerde.format";
+const std::string kColumnarBatchSerdeFormatDefault = "presto";
+// Codec of the "columnar" format, "none" to disable compression.
+const std::string kColumnarBatchSerdeCodec = "spark.gluten.sql.columnar.backend.velox.columnarBatchSerde.codec";
+const std::string kColumnarBatchSerdeCodecDefault = "lz4";
+
 // VeloxShuffleReader print flag.
 const std::string kVeloxShuffleReaderPrintFlag = "spark.gluten.velox.shuffleReaderPrintFlag";
 
 const std::string kVeloxFileHandleCacheEnabled = "spark.gluten.sql.columnar.backend.velox.fileHandleCacheEnabled";
 const bool kVeloxFileHandleCacheEnabledDefault = false;
+// Max number of opened files kept by the file handle cache, shared by all the tasks of an executor.
+const std::string kVeloxFileHandleCacheSize = "spark.gluten.sql.columnar.backend.velox.fileHandleCacheSize";
+const int32_t kVeloxFileHandleCacheSizeDefault = 20000;
+
+// Capacity of the executor-wide cache of file tails, which hold the Parquet and ORC footers. 0 disables the cache.
+const std::string kVeloxFooterCacheSize = "spark.gluten.sql.columnar.backend.velox.footerCacheSize";
+const uint64_t kVeloxFooterCacheSizeDefault = 0;
+const std::string kVeloxFooterCacheTailSize = "spark.gluten.sql.columnar.backend.velox.footerCacheTailSize";
+const uint64_t kVeloxFooterCacheTailSizeDefault = 1 << 20; // 1M
 
 /* configs for file read in velox*/
 const std::string kDirectorySizeGuess = "spark.gluten.sql.columnar.backend.velox.directorySizeGuess";
@@ -16,6 +16,11 @@
  */
 
 #include "JniFileSystem.h"
+#include <condition_variable>
+#include <mutex>
+#include <folly/ScopeGuard.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
 #include "jni/JniCommon.h"
 #include "velox/common/io/IoStatistics.h"
 
@@ -25,6 +30,9 @@ constexpr std::string_view kJolFsScheme("jol:");
 
 JavaVM* vm;
 
+// Runs JniReadFile::preadvAsync, nullptr if the asynchronous reads are disabled.
+std::unique_ptr<folly::IOThreadPoolExecutor> jniReadExecutor;
+
 jclass jniFileSystemClass;
 jclass jniReadFileClass;
 jclass jniWriteFileClass;
@@ -41,6 +49,7 @@ jmethodID jniFileSystemMkdir;
 jmethodID jniFileSystemRmdir;
 
 jmethodID jniReadFilePread;
+jmethodID jniReadFilePreadv;
 jmethodID jniReadFileShouldCoalesce;
 jmethodID jniReadFileSize;
 jmethodID jniReadFileMemoryUsage;
@@ -64,21 +73,41 @@ std::string_view removePathSchema(std::string_view path) {
   return path.substr(pos + 1);
 }
 
+// Returns a local reference, which the caller deletes.
+jlongArray newLongArray(JNIEnv* env, const std::vector<jlong>& values) {
+  const auto size = static_cast<jsize>(values.size());
+  jlongArray array = env->NewLongArray(size);
+  if (array == nullptr) {
+    checkException(env);
+    throw gluten::GlutenException("Failed to allocate a Java long array of " + std::to_string(size) + " elements");
+  }
+  env->SetLongArrayRegion(array, 0, size, values.data());
+  return array;
+}
+
+// The IO stats of the reads are not updated, the Java file reports its own metrics to Spark. The asynchronous reads
+// couldn't update them anyway, the stats may be gone by the time the read runs.
 class JniReadFile : public facebook::velox::ReadFile {
  public:
-  explicit JniReadFile(jobject obj) {
+  explicit JniReadFile(jobject obj) : state_(std::make_shared<State>()) {
     JNIEnv* env = nullptr;
     attachCurrentThreadAsDaemonOrThrow(vm, &env);
-    obj_ = env->NewGlobalRef(obj);
+    state_->obj = env->NewGlobalRef(obj);
     checkException(env);
   }
 
   ~JniReadFile() override {
+    {
+      // The reads queued on jniReadExecutor are cancelled, the running ones must not outlive the Java file.
+      std::unique_lock<std::mutex> lock(state_->mutex);
+      state_->closed = true;
+      state_->cv.wait(lock, [&]() { return state_->numRunningReads == 0; });
+    }
     try {
       closeInternal();
       JNIEnv* env = nullptr;
       attachCurrentThreadAsDaemonOrThrow(vm, &env);
-      env->DeleteGlobalRef(obj_);
+      env->DeleteGlobalRef(state_->obj);
       checkException(env);
     } catch (const std::exception& e) {
       LOG(WARNING) << "Error closing jni read file " << e.what();
@@ -93,15 +122,84 @@ class JniReadFile : public facebook::velox::ReadFile {
     JNIEnv* env = nullptr;
     attachCurrentThreadAsDaemonOrThrow(vm, &env);
     env->CallVoidMethod(
-        obj_, jniReadFilePread, static_cast<jlong>(offset), static_cast<jlong>(length), reinterpret_cast<jlong>(buf));
+        state_->obj,
+        jniReadFilePread,
+        static_cast<jlong>(offset),
+        static_cast<jlong>(length),
+        reinterpret_cast<jlong>(buf));
     checkException(env);
     return std::string_view(reinterpret_cast<const char*>(buf));
   }
 
+  // Reads all non-skipped ranges with a single JNI call.
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      facebook::velox::filesystems::File::IoStats* stats = nullptr) const override {
+    Ranges ranges(offset, buffers);
+    preadvInternal(state_->obj, ranges);
+    return ranges.length;
+  }
+
+  uint64_t preadv(
+      folly::Range<const facebook::velox::common::Region*> regions,
+      folly::Range<folly::IOBuf*> iobufs,
+      facebook::velox::filesystems::File::IoStats* stats = nullptr) const override {
+    VELOX_CHECK_EQ(regions.size(), iobufs.size());
+    Ranges ranges;
+    ranges.reserve(regions.size());
+    for (size_t i = 0; i < regions.size(); ++i) {
+      const auto& region = regions[i];
+      auto& iobuf = iobufs[i];
+      iobuf = folly::IOBuf(folly::IOBuf::CREATE, region.length);
+      ranges.add(region.offset, region.length, iobuf.writableData());
+    }
+    preadvInternal(state_->obj, ranges);
+    for (size_t i = 0; i < regions.size(); ++i) {
+      iobufs[i].append(regions[i].length);
+    }
+    return ranges.length;
+  }
+
+  // The read completes on jniReadExecutor, so the driver thread doesn't wait for the remote storage. As for the other
+  // files, 'buffers' must stay valid until the returned future completes or the file is destroyed.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      facebook::velox::filesystems::File::IoStats* stats = nullptr) const override {
+    if (jniReadExecutor == nullptr) {
+      return ReadFile::preadvAsync(offset, buffers, stats);
+    }
+    auto [promise, future] = folly::makePromiseContract<uint64_t>();
+    // Captures the state rather than this, which may be destroyed before the read runs.
+    jniReadExecutor->add([state = state_, ranges = Ranges(offset, buffers), promise = std::move(promise)]() mutable {
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->closed) {
+          promise.setException(std::runtime_error("JniReadFile was closed before the read"));
+          return;
+        }
+        ++state->numRunningReads;
+      }
+      promise.setWith([&]() {
+        preadvInternal(state->obj, ranges);
+        return ranges.length;
+      });
+      std::lock_guard<std::mutex> lock(state->mutex);
+      --state->numRunningReads;
+      state->cv.notify_all();
+    });
+    return std::move(future);
+  }
+
+  bool hasPreadvAsync() const override {
+    return jniReadExecutor != nullptr;
+  }
+
   bool shouldCoalesce() const override {
     JNIEnv* env = nullptr;
     attachCurrentThreadAsDaemonOrThrow(vm, &env);
-    jboolean out = env->CallBooleanMethod(obj_, jniReadFileShouldCoalesce);
+    jboolean out = env->CallBooleanMethod(state_->obj, jniReadFileShouldCoalesce);
     checkException(env);
     return out;
   }
@@ -109,7 +207,7 @@ class JniReadFile : public facebook::velox::ReadFile {
   uint64_t size() const override {
     JNIEnv* env = nullptr;
     attachCurrentThreadAsDaemonOrThrow(vm, &env);
-    jlong out = env->CallLongMethod(obj_, jniReadFileSize);
+    jlong out = env->CallLongMethod(state_->obj, jniReadFileSize);
     checkException(env);
     return static_cast<uint64_t>(out);
   }
@@ -117,7 +215,7 @@ class JniReadFile : public facebook::velox::ReadFile {
   uint64_t memoryUsage() const override {
     JNIEnv* env = nullptr;
     attachCurrentThreadAsDaemonOrThrow(vm, &env);
-    jlong out = env->CallLongMethod(obj_, jniReadFileMemoryUsage);
+    jlong out = env->CallLongMethod(state_->obj, jniReadFileMemoryUsage);
     checkException(env);
     return static_cast<uint64_t>(out);
   }
@@ -129,20 +227,89 @@ class JniReadFile : public facebook::velox::ReadFile {
   uint64_t getNaturalReadSize() const override {
     JNIEnv* env = nullptr;
     attachCurrentThreadAsDaemonOrThrow(vm, &env);
-    jlong out = env->CallLongMethod(obj_, jniReadFileGetNaturalReadSize);
+    jlong out = env->CallLongMethod(state_->obj, jniReadFileGetNaturalReadSize);
     checkException(env);
     return static_cast<uint64_t>(out);
   }
 
  private:
+  // Shared with the asynchronous reads.
+  struct State {
+    jobject obj;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool closed{false};
+    int32_t numRunningReads{0};
+  };
+
+  // The file ranges of a vectored read and the addresses they are read to.
+  struct Ranges {
+    Ranges() = default;
+
+    // A buffer without data is a gap to skip.
+    Ranges(uint64_t offset, const std::vector<folly::Range<char*>>& buffers) {
+      reserve(buffers.size());
+      for (const auto& range : buffers) {
+        if (range.data() != nullptr) {
+          add(offset + length, range.size(), range.data());
+        } else {
+          length += range.size();
+        }
+      }
+    }
+
+    void reserve(size_t size) {
+      offsets.reserve(size);
+      lengths.reserve(size);
+      addresses.reserve(size);
+    }
+
+    void add(uint64_t offset, uint64_t size, void* address) {
+      offsets.push_back(static_cast<jlong>(offset));
+      lengths.push_back(static_cast<jlong>(size));
+      addresses.push_back(reinterpret_cast<jlong>(address));
+      length += size;
+    }
+
+    std::vector<jlong> offsets;
+    std::vector<jlong> lengths;
+    std::vector<jlong> addresses;
+    // Total length including the gaps.
+    uint64_t length{0};
+  };
+
   void closeInternal() {
     JNIEnv* env = nullptr;
     attachCurrentThreadAsDaemonOrThrow(vm, &env);
-    env->CallVoidMethod(obj_, jniReadFileClose);
+    env->CallVoidMethod(state_->obj, jniReadFileClose);
     checkException(env);
   }
 
-  jobject obj_;
+  static void preadvInternal(jobject obj, const Ranges& ranges) {
+    if (ranges.offsets.empty()) {
+      return;
+    }
+    JNIEnv* env = nullptr;
+    attachCurrentThreadAsDaemonOrThrow(vm, &env);
+    // The thread stays attached, so the local references are deleted explicitly.
+    jlongArray jOffsets = nullptr;
+    jlongArray jLengths = nullptr;
+    jlongArray jAddresses = nullptr;
+    SCOPE_EXIT {
+      for (auto array : {jOffsets, jLengths, jAddresses}) {
+        if (array != nullptr) {
+          env->DeleteLocalRef(array);
+        }
+      }
+    };
+    jOffsets = newLongArray(env, ranges.offsets);
+    jLengths = newLongArray(env, ranges.lengths);
+    jAddresses = newLongArray(env, ranges.addresses);
+    env->CallVoidMethod(obj, jniReadFilePreadv, jOffsets, jLengths, jAddresses);
+    checkException(env);
+  }
+
+  const std::shared_ptr<State> state_;
 };
 
 class JniWriteFile : public facebook::velox::WriteFile {
@@ -432,6 +599,7 @@ void gluten::initVeloxJniFileSystem(JNIEnv* env) {
 
   // methods in JniFilesystem$ReadFile
   jniReadFilePread = getMethodIdOrError(env, jniReadFileClass, "pread", "(JJJ)V");
+  jniReadFilePreadv = getMethodIdOrError(env, jniReadFileClass, "preadv", "([J[J[J)V");
   jniReadFileShouldCoalesce = getMethodIdOrError(env, jniReadFileClass, "shouldCoalesce", "()Z");
   jniReadFileSize = getMethodIdOrError(env, jniReadFileClass, "size", "()J");
   jniReadFileMemoryUsage = getMethodIdOrError(env, jniReadFileClass, "memoryUsage", "()J");
@@ -446,6 +614,9 @@ void gluten::initVeloxJniFileSystem(JNIEnv* env) {
 }
 
 void gluten::finalizeVeloxJniFileSystem(JNIEnv* env) {
+  // Join the read threads before the classes are released.
+  jniReadExecutor.reset();
+
   env->DeleteGlobalRef(jniWriteFileClass);
   env->DeleteGlobalRef(jniReadFileClass);
   env->DeleteGlobalRef(jniFileSystemClass);
@@ -456,8 +627,11 @@ void gluten::finalizeVeloxJniFileSystem(JNIEnv* env) {
 // "jol" stands for letting Gluten choose between jni fs and local fs.
 // This doesn't implement facebook::velox::filesystems::FileSystem since it just
 // act as a entry-side router to create JniFilesystem and LocalFilesystem
-void gluten::registerJolFileSystem(uint64_t maxFileSize) {
+void gluten::registerJolFileSystem(uint64_t maxFileSize, uint32_t readThreads) {
   GLUTEN_CHECK(maxFileSize > 0, "Unexpected max file size for jol fs: " + std::to_string(maxFileSize));
+  if (readThreads > 0 && jniReadExecutor == nullptr) {
+    jniReadExecutor = std::make_unique<folly::IOThreadPoolExecutor>(readThreads);
+  }
 
   auto JolSchemeMatcher = [](std::string_view filePath) { return filePath.find(kJolFsScheme) == 0; };
 
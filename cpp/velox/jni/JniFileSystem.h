@@ -26,8 +26,8 @@ namespace gluten {
 
 // Register JNI-or-local (or JVM-over-local, as long as it describes what happens here) file system. maxFileSize is
 // necessary (!= 0) because we use this size to decide whether a new file can fit in JVM heap, otherwise we write it via
-// local fs directly.
-void registerJolFileSystem(uint64_t maxFileSize);
+// local fs directly. readThreads > 0 enables asynchronous vectored reads of JNI files on a thread pool of that size.
+void registerJolFileSystem(uint64_t maxFileSize, uint32_t readThreads = 0);
 
 void initVeloxJniFileSystem(JNIEnv* env);
 
@@ -38,6 +38,7 @@
 #include "utils/VeloxBatchResizer.h"
 #include "velox/common/base/BloomFilter.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/vector/DecodedVector.h"
 
 #ifdef GLUTEN_ENABLE_GPU
 #include "cudf/CudfPlanValidator.h"
@@ -297,6 +298,159 @@ JNIEXPORT void JNICALL Java_org_apache_gluten_utils_VeloxBloomFilterJniWrapper_m
   JNI_METHOD_END()
 }
 
+namespace {
+// Values are hashed a block at a time in a tight loop the compiler can vectorize, before the filter is touched.
+constexpr int32_t kBloomFilterHashBlockSize = 1024;
+
+template <typename Consumer>
+void forEachHashBlock(const int64_t* values, int32_t numValues, Consumer&& consumer) {
+  uint64_t hashes[kBloomFilterHashBlockSize];
+  for (int32_t offset = 0; offset < numValues; offset += kBloomFilterHashBlockSize) {
+    const int32_t size = std::min(kBloomFilterHashBlockSize, numValues - offset);
+    for (int32_t i = 0; i < size; ++i) {
+      hashes[i] = folly::hasher<int64_t>()(values[offset + i]);
+    }
+    consumer(hashes, offset, size);
+  }
+}
+
+// Non-null values of a BIGINT column. Rows are only filled when the column has nulls or is encoded.
+struct BloomFilterColumnValues {
+  // Keeps the values alive
+  velox::RowVectorPtr rowVector;
+  velox::vector_size_t numRows{0};
+  const int64_t* values{nullptr};
+  int32_t numValues{0};
+  std::vector<int64_t> gathered;
+  std::vector<velox::vector_size_t> rows;
+};
+
+BloomFilterColumnValues
+bloomFilterColumnValues(Runtime* ctx, const std::shared_ptr<ColumnarBatch>& batch, int32_t columnIndex) {
+  auto pool = dynamic_cast<VeloxMemoryManager*>(ctx->memoryManager())->getLeafMemoryPool();
+  BloomFilterColumnValues out;
+  out.rowVector = VeloxColumnarBatch::from(pool.get(), batch)->getRowVector();
+  GLUTEN_CHECK(columnIndex >= 0 && columnIndex < out.rowVector->childrenSize(), "Column index out of range");
+  const auto& column = out.rowVector->childAt(columnIndex);
+  GLUTEN_CHECK(column->type()->isBigint(), "Bloom-filter only accepts BIGINT values");
+
+  out.numRows = column->size();
+  velox::DecodedVector decoded(*column);
+  if (decoded.isIdentityMapping() && !decoded.mayHaveNulls()) {
+    out.values = decoded.data<int64_t>();
+    out.numValues = out.numRows;
+    return out;
+  }
+  out.gathered.reserve(out.numRows);
+  out.rows.reserve(out.numRows);
+  for (velox::vector_size_t row = 0; row < out.numRows; ++row) {
+    if (!decoded.isNullAt(row)) {
+      out.gathered.push_back(decoded.valueAt<int64_t>(row));
+      out.rows.push_back(row);
+    }
+  }
+  out.values = out.gathered.data();
+  out.numValues = out.gathered.size();
+  return out;
+}
+
+void bloomFilterInsert(velox::BloomFilter<std::allocator<uint64_t>>* filter, const int64_t* values, int32_t numValues) {
+  forEachHashBlock(values, numValues, [&](const uint64_t* hashes, int32_t /*offset*/, int32_t size) {
+    for (int32_t i = 0; i < size; ++i) {
+      filter->insert(hashes[i]);
+    }
+  });
+}
+
+// Sets out[rows[i]] (or out[i] if rows is null) for each value that may be contained in the filter.
+void bloomFilterMayContain(
+    velox::BloomFilter<std::allocator<uint64_t>>* filter,
+    const int64_t* values,
+    int32_t numValues,
+    const velox::vector_size_t* rows,
+    jboolean* out) {
+  forEachHashBlock(values, numValues, [&](const uint64_t* hashes, int32_t offset, int32_t size) {
+    for (int32_t i = 0; i < size; ++i) {
+      out[rows ? rows[offset + i] : offset + i] = filter->mayContain(hashes[i]);
+    }
+  });
+}
+
+jbooleanArray toJBooleanArray(JNIEnv* env, const std::vector<jboolean>& values) {
+  jbooleanArray out = env->NewBooleanArray(values.size());
+  env->SetBooleanArrayRegion(out, 0, values.size(), values.data());
+  return out;
+}
+} // namespace
+
+JNIEXPORT void JNICALL Java_org_apache_gluten_utils_VeloxBloomFilterJniWrapper_insertLongs( // NOLINT
+    JNIEnv* env,
+    jobject wrapper,
+    jlong handle,
+    jlongArray items,
+    jint numItems) {
+  JNI_METHOD_START
+  auto filter = ObjectStore::retrieve<velox::BloomFilter<std::allocator<uint64_t>>>(handle);
+  GLUTEN_CHECK(filter->isSet(), "Bloom-filter is not initialized");
+  auto safeArray = getLongArrayElementsSafe(env, items);
+  GLUTEN_CHECK(numItems <= safeArray.length(), "Number of items exceeds the array length");
+  bloomFilterInsert(filter.get(), safeArray.elems(), numItems);
+  JNI_METHOD_END()
+}
+
+JNIEXPORT void JNICALL Java_org_apache_gluten_utils_VeloxBloomFilterJniWrapper_insertColumn( // NOLINT
+    JNIEnv* env,
+    jobject wrapper,
+    jlong handle,
+    jlong batchHandle,
+    jint columnIndex) {
+  JNI_METHOD_START
+  auto ctx = getRuntime(env, wrapper);
+  auto filter = ObjectStore::retrieve<velox::BloomFilter<std::allocator<uint64_t>>>(handle);
+  GLUTEN_CHECK(filter->isSet(), "Bloom-filter is not initialized");
+  auto batch = ObjectStore::retrieve<ColumnarBatch>(batchHandle);
+  auto column = bloomFilterColumnValues(ctx, batch, columnIndex);
+  bloomFilterInsert(filter.get(), column.values, column.numValues);
+  JNI_METHOD_END()
+}
+
+JNIEXPORT jbooleanArray JNICALL Java_org_apache_gluten_utils_VeloxBloomFilterJniWrapper_mightContainLongs( // NOLINT
+    JNIEnv* env,
+    jobject wrapper,
+    jlong handle,
+    jlongArray items,
+    jint numItems) {
+  JNI_METHOD_START
+  auto filter = ObjectStore::retrieve<velox::BloomFilter<std::allocator<uint64_t>>>(handle);
+  GLUTEN_CHECK(filter->isSet(), "Bloom-filter is not initialized");
+  auto safeArray = getLongArrayElementsSafe(env, items);
+  GLUTEN_CHECK(numItems <= safeArray.length(), "Number of items exceeds the array length");
+  std::vector<jboolean> out(numItems, JNI_FALSE);
+  bloomFilterMayContain(filter.get(), safeArray.elems(), numItems, nullptr, out.data());
+  return toJBooleanArray(env, out);
+  JNI_METHOD_END(nullptr)
+}
+
+JNIEXPORT jbooleanArray JNICALL Java_org_apache_gluten_utils_VeloxBloomFilterJniWrapper_mightContainColumn( // NOLINT
+    JNIEnv* env,
+    jobject wrapper,
+    jlong handle,
+    jlong batchHandle,
+    jint columnIndex) {
+  JNI_METHOD_START
+  auto ctx = getRuntime(env, wrapper);
+  auto filter = ObjectStore::retrieve<velox::BloomFilter<std::allocator<uint64_t>>>(handle);
+  GLUTEN_CHECK(filter->isSet(), "Bloom-filter is not initialized");
+  auto batch = ObjectStore::retrieve<ColumnarBatch>(batchHandle);
+  auto column = bloomFilterColumnValues(ctx, batch, columnIndex);
+  // Null rows are left false.
+  std::vector<jboolean> out(column.numRows, JNI_FALSE);
+  bloomFilterMayContain(
+      filter.get(), column.values, column.numValues, column.rows.empty() ? nullptr : column.rows.data(), out.data());
+  return toJBooleanArray(env, out);
+  JNI_METHOD_END(nullptr)
+}
+
 JNIEXPORT jbyteArray JNICALL Java_org_apache_gluten_utils_VeloxBloomFilterJniWrapper_serialize( // NOLINT
     JNIEnv* env,
     jobject wrapper,
@@ -328,6 +482,18 @@ JNIEXPORT jlong JNICALL Java_org_apache_gluten_utils_VeloxBatchResizerJniWrapper
   JNI_METHOD_END(kInvalidObjectHandle)
 }
 
+JNIEXPORT jlong JNICALL Java_org_apache_gluten_utils_VeloxBatchResizerJniWrapper_peakRetainedBytes( // NOLINT
+    JNIEnv* env,
+    jobject wrapper,
+    jlong iterHandle) {
+  JNI_METHOD_START
+  auto iter = ObjectStore::retrieve<ResultIterator>(iterHandle);
+  auto resizer = dynamic_cast<VeloxBatchResizer*>(iter->getInputIter());
+  GLUTEN_CHECK(resizer != nullptr, "Not a VeloxBatchResizer iterator");
+  return resizer->peakRetainedBytes();
+  JNI_METHOD_END(-1L)
+}
+
 JNIEXPORT jboolean JNICALL
 Java_org_apache_gluten_utils_VeloxFileSystemValidationJniWrapper_allSupportedByRegisteredFileSystems( // NOLINT
     JNIEnv* env,
@@ -227,13 +227,21 @@ VeloxMemoryManager::VeloxMemoryManager(
     : MemoryManager(kind), listener_(std::move(listener)) {
   auto reservationBlockSize =
       backendConf.get<uint64_t>(kMemoryReservationBlockSize, kMemoryReservationBlockSizeDefault);
-  blockListener_ = std::make_unique<BlockAllocationListener>(listener_.get(), reservationBlockSize);
+  auto reservationCacheMaxChunkSize =
+      backendConf.get<uint64_t>(kMemoryReservationCacheMaxChunkSize, kMemoryReservationCacheMaxChunkSizeDefault);
+  AllocationListener* reservationListener = listener_.get();
+  if (reservationCacheMaxChunkSize > 0) {
+    reservationCache_ = std::make_unique<ReservationCacheAllocationListener>(
+        listener_.get(), reservationBlockSize, reservationCacheMaxChunkSize);
+    reservationListener = reservationCache_.get();
+  }
+  blockListener_ = std::make_unique<BlockAllocationListener>(reservationListener, reservationBlockSize);
   defaultArrowPool_ = std::make_shared<ArrowMemoryPool>(blockListener_.get());
   arrowPools_.emplace("default", defaultArrowPool_);
 
   auto checkUsageLeak = backendConf.get<bool>(kCheckUsageLeak, kCheckUsageLeakDefault);
 
-  ArbitratorFactoryRegister afr(listener_.get());
+  ArbitratorFactoryRegister afr(reservationListener);
   velox::memory::MemoryManagerOptions mmOptions{
       .alignment = velox::memory::MemoryAllocator::kMaxAlignment,
       .trackDefaultUsage = true, // memory usage tracking
@@ -354,7 +362,15 @@ const MemoryUsageStats VeloxMemoryManager::collectMemoryUsageStats() const {
 }
 
 const int64_t VeloxMemoryManager::shrink(int64_t size) {
-  return shrinkVeloxMemoryPool(veloxMemoryManager_.get(), veloxAggregatePool_.get(), size);
+  auto shrunken = shrinkVeloxMemoryPool(veloxMemoryManager_.get(), veloxAggregatePool_.get(), size);
+  return shrunken + flushReservation();
+}
+
+int64_t VeloxMemoryManager::flushReservation() {
+  if (reservationCache_ == nullptr) {
+    return 0;
+  }
+  return reservationCache_->flush();
 }
 
 namespace {
@@ -466,6 +482,12 @@ VeloxMemoryManager::~VeloxMemoryManager() {
     LOG(ERROR) << "Failed to release Velox memory manager after " << accumulatedWaitMs
                << "ms as there are still outstanding memory resources. ";
   }
+  try {
+    // Hand the cached reservation back to Spark before the listener goes away.
+    flushReservation();
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Failed to release the cached memory reservation: " << e.what();
+  }
 #ifdef ENABLE_JEMALLOC_STATS
   malloc_stats_print(NULL, NULL, NULL);
 #endif
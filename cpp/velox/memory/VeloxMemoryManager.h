@@ -91,6 +91,9 @@ class VeloxMemoryManager final : public MemoryManager {
 
   void hold() override;
 
+  /// Gives the memory reserved from Spark but not used yet back to Spark. Returns the released bytes.
+  int64_t flushReservation();
+
   /// Test only
   MemoryAllocator* allocator() const {
     return defaultArrowPool_->allocator();
@@ -110,6 +113,7 @@ class VeloxMemoryManager final : public MemoryManager {
 #endif
 
   std::unique_ptr<AllocationListener> listener_;
+  std::unique_ptr<ReservationCacheAllocationListener> reservationCache_;
   std::unique_ptr<AllocationListener> blockListener_;
 
   std::shared_ptr<ArrowMemoryPool> defaultArrowPool_;
@@ -19,6 +19,7 @@
 
 #include <arrow/buffer.h>
 
+#include "VeloxColumnarVectorSerde.h"
 #include "memory/ArrowMemory.h"
 #include "memory/VeloxColumnarBatch.h"
 #include "velox/common/memory/Memory.h"
@@ -44,8 +45,13 @@ std::unique_ptr<ByteInputStream> toByteStream(uint8_t* data, int32_t size) {
 VeloxColumnarBatchSerializer::VeloxColumnarBatchSerializer(
     arrow::MemoryPool* arrowPool,
     std::shared_ptr<memory::MemoryPool> veloxPool,
-    struct ArrowSchema* cSchema)
-    : ColumnarBatchSerializer(arrowPool), veloxPool_(std::move(veloxPool)) {
+    struct ArrowSchema* cSchema,
+    bool useColumnarFormat,
+    arrow::Compression::type compressionType)
+    : ColumnarBatchSerializer(arrowPool),
+      veloxPool_(std::move(veloxPool)),
+      useColumnarFormat_(useColumnarFormat),
+      compressionType_(compressionType) {
   // serializeColumnarBatches don't need rowType_
   if (cSchema != nullptr) {
     rowType_ = asRowType(importFromArrow(*cSchema));
@@ -60,6 +66,24 @@ std::shared_ptr<arrow::Buffer> VeloxColumnarBatchSerializer::serializeColumnarBa
   VELOX_DCHECK(batches.size() != 0, "Should serialize at least 1 vector");
   const std::shared_ptr<VeloxColumnarBatch>& vb = VeloxColumnarBatch::from(veloxPool_.get(), batches[0]);
   auto firstRowVector = vb->getRowVector();
+  if (useColumnarFormat_) {
+    auto rowVector = firstRowVector;
+    if (batches.size() > 1) {
+      vector_size_t numRows = 0;
+      for (auto& batch : batches) {
+        numRows += batch->numRows();
+      }
+      rowVector = std::static_pointer_cast<RowVector>(BaseVector::create(firstRowVector->type(), 0, veloxPool_.get()));
+      rowVector->resize(numRows);
+      vector_size_t offset = 0;
+      for (auto& batch : batches) {
+        auto input = VeloxColumnarBatch::from(veloxPool_.get(), batch)->getRowVector();
+        rowVector->copy(input.get(), offset, 0, input->size());
+        offset += input->size();
+      }
+    }
+    return VeloxColumnarVectorSerde::serialize(rowVector, compressionType_, arrowPool_, veloxPool_.get());
+  }
   auto numRows = firstRowVector->size();
   auto arena = std::make_unique<StreamArena>(veloxPool_.get());
   auto rowType = asRowType(firstRowVector->type());
@@ -81,6 +105,11 @@ std::shared_ptr<arrow::Buffer> VeloxColumnarBatchSerializer::serializeColumnarBa
 }
 
 std::shared_ptr<ColumnarBatch> VeloxColumnarBatchSerializer::deserialize(uint8_t* data, int32_t size) {
+  // A Presto page starts with a non-negative row count, so it never matches the magic.
+  if (VeloxColumnarVectorSerde::isSerialized(data, size)) {
+    return std::make_shared<VeloxColumnarBatch>(
+        VeloxColumnarVectorSerde::deserialize(data, size, rowType_, veloxPool_.get()));
+  }
   RowVectorPtr result;
   auto byteStream = toByteStream(data, size);
   serde_->deserialize(byteStream.get(), veloxPool_.get(), rowType_, &result, &options_);
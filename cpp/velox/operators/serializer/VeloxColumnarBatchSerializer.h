@@ -18,6 +18,7 @@
 #pragma once
 
 #include <arrow/c/abi.h>
+#include <arrow/util/compression.h>
 
 #include "memory/ColumnarBatch.h"
 #include "operators/serializer/ColumnarBatchSerializer.h"
@@ -25,12 +26,16 @@
 
 namespace gluten {
 
+/// Serializes with PrestoVectorSerde by default. If useColumnarFormat is set, batches are serialized with
+/// VeloxColumnarVectorSerde and compressionType instead. deserialize accepts both formats.
 class VeloxColumnarBatchSerializer final : public ColumnarBatchSerializer {
  public:
   VeloxColumnarBatchSerializer(
       arrow::MemoryPool* arrowPool,
       std::shared_ptr<facebook::velox::memory::MemoryPool> veloxPool,
-      struct ArrowSchema* cSchema);
+      struct ArrowSchema* cSchema,
+      bool useColumnarFormat = false,
+      arrow::Compression::type compressionType = arrow::Compression::UNCOMPRESSED);
 
   std::shared_ptr<arrow::Buffer> serializeColumnarBatches(
       const std::vector<std::shared_ptr<ColumnarBatch>>& batches) override;
@@ -40,6 +45,8 @@ class VeloxColumnarBatchSerializer final : public ColumnarBatchSerializer {
  private:
   std::shared_ptr<facebook::velox::memory::MemoryPool> veloxPool_;
   facebook::velox::RowTypePtr rowType_;
+  const bool useColumnarFormat_;
+  const arrow::Compression::type compressionType_;
   std::unique_ptr<facebook::velox::serializer::presto::PrestoVectorSerde> serde_;
   facebook::velox::serializer::presto::PrestoVectorSerde::PrestoOptions options_;
 };
@@ -0,0 +1,428 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "VeloxColumnarVectorSerde.h"
+
+#include <arrow/buffer_builder.h>
+
+#include "utils/Compression.h"
+#include "utils/Exception.h"
+#include "velox/vector/ConstantVector.h"
+#include "velox/vector/FlatVector.h"
+#include "velox/vector/VectorTypeUtils.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+namespace {
+
+constexpr int32_t kVersion = 1;
+constexpr int64_t kBufferAlignment = 64;
+
+enum Encoding : uint8_t { kFlat = 0, kConstant = 1, kDictionary = 2 };
+
+// Keeps the payload alive as long as any vector buffer viewing it.
+struct PayloadReleaser {
+  void addRef() const {}
+
+  void release() const {}
+
+  const BufferPtr payload;
+};
+
+class Writer {
+ public:
+  Writer(arrow::util::Codec* codec, arrow::MemoryPool* arrowPool, memory::MemoryPool* veloxPool)
+      : codec_(codec), veloxPool_(veloxPool), builder_(arrowPool) {}
+
+  template <typename T>
+  void put(const T& value) {
+    GLUTEN_THROW_NOT_OK(builder_.Append(&value, sizeof(T)));
+  }
+
+  // Raw size, stored size, then the stored (compressed if smaller) bytes at an aligned offset.
+  void putBuffer(const void* data, int64_t size) {
+    put<int64_t>(size);
+    if (size == 0) {
+      put<int64_t>(0);
+      return;
+    }
+    const void* stored = data;
+    int64_t storedSize = size;
+    if (codec_ != nullptr) {
+      const auto maxSize = codec_->MaxCompressedLen(size, static_cast<const uint8_t*>(data));
+      if (compressed_ == nullptr || compressed_->capacity() < maxSize) {
+        compressed_ = AlignedBuffer::allocate<uint8_t>(maxSize, veloxPool_);
+      }
+      GLUTEN_ASSIGN_OR_THROW(
+          auto compressedSize,
+          codec_->Compress(size, static_cast<const uint8_t*>(data), maxSize, compressed_->asMutable<uint8_t>()));
+      if (compressedSize < size) {
+        stored = compressed_->as<uint8_t>();
+        storedSize = compressedSize;
+      }
+    }
+    put<int64_t>(storedSize);
+    align();
+    GLUTEN_THROW_NOT_OK(builder_.Append(stored, storedSize));
+  }
+
+  void putNulls(const BaseVector& vector) {
+    if (vector.mayHaveNulls() && vector.rawNulls() != nullptr) {
+      putBuffer(vector.rawNulls(), bits::nbytes(vector.size()));
+    } else {
+      putBuffer(nullptr, 0);
+    }
+  }
+
+  void writeVector(const VectorPtr& input) {
+    const auto& vector = BaseVector::loadedVectorShared(input);
+    const auto size = vector->size();
+    if (vector->typeKind() == TypeKind::UNKNOWN) {
+      put<uint8_t>(kConstant);
+      put<int32_t>(size);
+      put<uint8_t>(true);
+      return;
+    }
+    switch (vector->encoding()) {
+      case VectorEncoding::Simple::CONSTANT: {
+        put<uint8_t>(kConstant);
+        put<int32_t>(size);
+        const bool isNull = size == 0 || vector->isNullAt(0);
+        put<uint8_t>(isNull);
+        if (!isNull) {
+          auto value = BaseVector::create(vector->type(), 1, veloxPool_);
+          value->copy(vector.get(), 0, 0, 1);
+          writeVector(value);
+        }
+        return;
+      }
+      case VectorEncoding::Simple::DICTIONARY:
+        put<uint8_t>(kDictionary);
+        put<int32_t>(size);
+        putNulls(*vector);
+        putBuffer(vector->wrapInfo()->as<uint8_t>(), size * sizeof(vector_size_t));
+        writeVector(vector->valueVector());
+        return;
+      case VectorEncoding::Simple::FLAT:
+      case VectorEncoding::Simple::ROW:
+      case VectorEncoding::Simple::ARRAY:
+      case VectorEncoding::Simple::MAP:
+        writeFlat(*vector);
+        return;
+      default: {
+        auto flat = vector;
+        BaseVector::flattenVector(flat);
+        writeFlat(*flat);
+        return;
+      }
+    }
+  }
+
+  std::shared_ptr<arrow::Buffer> finish() {
+    std::shared_ptr<arrow::Buffer> out;
+    GLUTEN_THROW_NOT_OK(builder_.Finish(&out));
+    return out;
+  }
+
+ private:
+  void align() {
+    const auto padding = (kBufferAlignment - builder_.length() % kBufferAlignment) % kBufferAlignment;
+    GLUTEN_THROW_NOT_OK(builder_.Advance(padding));
+  }
+
+  void writeFlat(const BaseVector& vector) {
+    const auto size = vector.size();
+    put<uint8_t>(kFlat);
+    put<int32_t>(size);
+    putNulls(vector);
+    switch (vector.typeKind()) {
+      case TypeKind::ROW: {
+        const auto& row = *vector.asUnchecked<RowVector>();
+        put<int32_t>(row.childrenSize());
+        for (const auto& child : row.children()) {
+          writeVector(child);
+        }
+        return;
+      }
+      case TypeKind::ARRAY: {
+        const auto& array = *vector.asUnchecked<ArrayVector>();
+        putBuffer(array.rawOffsets(), size * sizeof(vector_size_t));
+        putBuffer(array.rawSizes(), size * sizeof(vector_size_t));
+        writeVector(array.elements());
+        return;
+      }
+      case TypeKind::MAP: {
+        const auto& map = *vector.asUnchecked<MapVector>();
+        putBuffer(map.rawOffsets(), size * sizeof(vector_size_t));
+        putBuffer(map.rawSizes(), size * sizeof(vector_size_t));
+        writeVector(map.mapKeys());
+        writeVector(map.mapValues());
+        return;
+      }
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY: {
+        // String views hold pointers, so lengths and the concatenated bytes are written instead.
+        const auto* views = vector.asUnchecked<FlatVector<StringView>>()->rawValues();
+        auto lengths = AlignedBuffer::allocate<int32_t>(size, veloxPool_);
+        auto* rawLengths = lengths->asMutable<int32_t>();
+        int64_t totalLength = 0;
+        for (vector_size_t i = 0; i < size; ++i) {
+          rawLengths[i] = vector.isNullAt(i) ? 0 : views[i].size();
+          totalLength += rawLengths[i];
+        }
+        auto chars = AlignedBuffer::allocate<char>(totalLength, veloxPool_);
+        auto* rawChars = chars->asMutable<char>();
+        for (vector_size_t i = 0; i < size; ++i) {
+          if (rawLengths[i] > 0) {
+            std::memcpy(rawChars, views[i].data(), rawLengths[i]);
+            rawChars += rawLengths[i];
+          }
+        }
+        putBuffer(lengths->as<uint8_t>(), size * sizeof(int32_t));
+        putBuffer(chars->as<uint8_t>(), totalLength);
+        return;
+      }
+      case TypeKind::BOOLEAN:
+        putBuffer(vector.values()->as<uint8_t>(), bits::nbytes(size));
+        return;
+      default:
+        VELOX_CHECK(vector.type()->isFixedWidth(), "Unsupported type {}", vector.type()->toString());
+        putBuffer(vector.values()->as<uint8_t>(), size * vector.type()->cppSizeInBytes());
+        return;
+    }
+  }
+
+  arrow::util::Codec* const codec_;
+  memory::MemoryPool* const veloxPool_;
+  arrow::BufferBuilder builder_;
+  BufferPtr compressed_;
+};
+
+template <TypeKind Kind>
+VectorPtr makeFlatVector(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    vector_size_t size,
+    BufferPtr values) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  return std::make_shared<FlatVector<T>>(
+      pool, type, std::move(nulls), size, std::move(values), std::vector<BufferPtr>{});
+}
+
+// Reads from offset 'pos' of the serialized data. Buffer alignment is relative to the start of the data, the same
+// origin the writer pads against, so the header must not be stripped off before reading.
+class Reader {
+ public:
+  Reader(
+      const uint8_t* data,
+      int64_t size,
+      int64_t pos,
+      BufferPtr payload,
+      arrow::util::Codec* codec,
+      memory::MemoryPool* pool)
+      : data_(data), size_(size), payload_(std::move(payload)), codec_(codec), pool_(pool), pos_(pos) {}
+
+  template <typename T>
+  T get() {
+    GLUTEN_CHECK(pos_ + static_cast<int64_t>(sizeof(T)) <= size_, "Truncated serialized data");
+    T value;
+    std::memcpy(&value, data_ + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return value;
+  }
+
+  // Returns nullptr for an empty buffer if nullable, an empty buffer otherwise.
+  BufferPtr getBuffer(bool nullable = false) {
+    const auto rawSize = get<int64_t>();
+    const auto storedSize = get<int64_t>();
+    if (rawSize == 0) {
+      return nullable ? nullptr : AlignedBuffer::allocate<char>(0, pool_);
+    }
+    pos_ += (kBufferAlignment - pos_ % kBufferAlignment) % kBufferAlignment;
+    GLUTEN_CHECK(pos_ + storedSize <= size_, "Truncated serialized data");
+    const auto* stored = data_ + pos_;
+    pos_ += storedSize;
+
+    if (storedSize < rawSize) {
+      GLUTEN_CHECK(codec_ != nullptr, "Compressed buffer without codec");
+      auto buffer = AlignedBuffer::allocate<char>(rawSize, pool_);
+      GLUTEN_ASSIGN_OR_THROW(
+          auto decompressedSize, codec_->Decompress(storedSize, stored, rawSize, buffer->asMutable<uint8_t>()));
+      GLUTEN_CHECK(decompressedSize == rawSize, "Corrupted compressed buffer");
+      return buffer;
+    }
+    if (payload_ != nullptr) {
+      return BufferView<PayloadReleaser>::create(stored, rawSize, PayloadReleaser{payload_});
+    }
+    auto buffer = AlignedBuffer::allocate<char>(rawSize, pool_);
+    std::memcpy(buffer->asMutable<uint8_t>(), stored, rawSize);
+    return buffer;
+  }
+
+  VectorPtr readVector(const TypePtr& type) {
+    const auto encoding = get<uint8_t>();
+    const auto size = get<int32_t>();
+    switch (encoding) {
+      case kConstant: {
+        if (get<uint8_t>()) {
+          return BaseVector::createNullConstant(type, size, pool_);
+        }
+        return BaseVector::wrapInConstant(size, 0, readVector(type));
+      }
+      case kDictionary: {
+        auto nulls = getBuffer(true);
+        auto indices = getBuffer();
+        return BaseVector::wrapInDictionary(std::move(nulls), std::move(indices), size, readVector(type));
+      }
+      case kFlat:
+        return readFlat(type, size);
+      default:
+        throw GlutenException("Unknown vector encoding " + std::to_string(encoding));
+    }
+  }
+
+ private:
+  VectorPtr readFlat(const TypePtr& type, vector_size_t size) {
+    auto nulls = getBuffer(true);
+    switch (type->kind()) {
+      case TypeKind::ROW: {
+        const auto numChildren = get<int32_t>();
+        GLUTEN_CHECK(numChildren == type->size(), "Mismatched number of row children");
+        std::vector<VectorPtr> children;
+        children.reserve(numChildren);
+        for (auto i = 0; i < numChildren; ++i) {
+          children.push_back(readVector(type->childAt(i)));
+        }
+        return std::make_shared<RowVector>(pool_, type, std::move(nulls), size, std::move(children));
+      }
+      case TypeKind::ARRAY: {
+        auto offsets = getBuffer();
+        auto sizes = getBuffer();
+        auto elements = readVector(type->childAt(0));
+        return std::make_shared<ArrayVector>(
+            pool_, type, std::move(nulls), size, std::move(offsets), std::move(sizes), std::move(elements));
+      }
+      case TypeKind::MAP: {
+        auto offsets = getBuffer();
+        auto sizes = getBuffer();
+        auto keys = readVector(type->childAt(0));
+        auto values = readVector(type->childAt(1));
+        return std::make_shared<MapVector>(
+            pool_,
+            type,
+            std::move(nulls),
+            size,
+            std::move(offsets),
+            std::move(sizes),
+            std::move(keys),
+            std::move(values));
+      }
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY: {
+        auto lengths = getBuffer();
+        auto chars = getBuffer();
+        const auto* rawLengths = lengths->as<int32_t>();
+        const auto* rawChars = chars->as<char>();
+        auto values = AlignedBuffer::allocate<StringView>(size, pool_);
+        auto* rawValues = values->asMutable<StringView>();
+        for (vector_size_t i = 0; i < size; ++i) {
+          rawValues[i] = StringView(rawChars, rawLengths[i]);
+          rawChars += rawLengths[i];
+        }
+        return std::make_shared<FlatVector<StringView>>(
+            pool_, type, std::move(nulls), size, std::move(values), std::vector<BufferPtr>{std::move(chars)});
+      }
+      default: {
+        auto values = getBuffer();
+        return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+            makeFlatVector, type->kind(), pool_, type, std::move(nulls), size, std::move(values));
+      }
+    }
+  }
+
+  const uint8_t* const data_;
+  const int64_t size_;
+  const BufferPtr payload_;
+  arrow::util::Codec* const codec_;
+  memory::MemoryPool* const pool_;
+  int64_t pos_;
+};
+
+// magic, version, compression type, number of rows
+constexpr int32_t kHeaderSize = 4 * sizeof(int32_t);
+
+} // namespace
+
+bool VeloxColumnarVectorSerde::isSerialized(const uint8_t* data, int32_t size) {
+  if (size < kHeaderSize) {
+    return false;
+  }
+  int32_t magic;
+  std::memcpy(&magic, data, sizeof(magic));
+  return magic == kMagic;
+}
+
+std::shared_ptr<arrow::Buffer> VeloxColumnarVectorSerde::serialize(
+    const RowVectorPtr& rowVector,
+    arrow::Compression::type compressionType,
+    arrow::MemoryPool* arrowPool,
+    memory::MemoryPool* veloxPool) {
+  auto codec = createArrowIpcCodec(compressionType, CodecBackend::NONE);
+  if (codec == nullptr) {
+    compressionType = arrow::Compression::UNCOMPRESSED;
+  }
+  Writer writer(codec.get(), arrowPool, veloxPool);
+  writer.put<int32_t>(kMagic);
+  writer.put<int32_t>(kVersion);
+  writer.put<int32_t>(compressionType);
+  writer.put<int32_t>(rowVector->size());
+  writer.writeVector(rowVector);
+  return writer.finish();
+}
+
+RowVectorPtr VeloxColumnarVectorSerde::deserialize(
+    const uint8_t* data,
+    int32_t size,
+    const RowTypePtr& rowType,
+    memory::MemoryPool* pool) {
+  GLUTEN_CHECK(isSerialized(data, size), "Data is not serialized by VeloxColumnarVectorSerde");
+  int32_t header[4];
+  std::memcpy(header, data, kHeaderSize);
+  GLUTEN_CHECK(header[1] == kVersion, "Unsupported VeloxColumnarVectorSerde version " + std::to_string(header[1]));
+  const auto compressionType = static_cast<arrow::Compression::type>(header[2]);
+
+  std::unique_ptr<arrow::util::Codec> codec;
+  BufferPtr payload;
+  if (compressionType == arrow::Compression::UNCOMPRESSED) {
+    // One copy into an aligned buffer, which all the result vectors then point into.
+    payload = AlignedBuffer::allocate<uint8_t>(size, pool);
+    std::memcpy(payload->asMutable<uint8_t>(), data, size);
+    data = payload->as<uint8_t>();
+  } else {
+    codec = createArrowIpcCodec(compressionType, CodecBackend::NONE);
+  }
+
+  Reader reader(data, size, kHeaderSize, payload, codec.get(), pool);
+  auto result = std::dynamic_pointer_cast<RowVector>(reader.readVector(rowType));
+  GLUTEN_CHECK(result != nullptr, "Serialized data is not a row vector");
+  GLUTEN_CHECK(result->size() == header[3], "Mismatched number of rows");
+  return result;
+}
+
+} // namespace gluten
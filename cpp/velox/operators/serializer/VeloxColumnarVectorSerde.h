@@ -0,0 +1,55 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <arrow/buffer.h>
+#include <arrow/memory_pool.h>
+#include <arrow/util/compression.h>
+
+#include "velox/vector/ComplexVector.h"
+
+namespace gluten {
+
+/// Columnar serialization of a RowVector that keeps the Velox memory layout, as an alternative to PrestoVectorSerde.
+///
+/// Every buffer (nulls, values, indices, offsets, string bytes) is written as is, optionally compressed with the
+/// given codec, and starts at a 64-byte aligned offset. Constant and dictionary encodings are preserved. Reading
+/// doesn't decode values: an uncompressed payload is copied once into an aligned buffer and every vector buffer is a
+/// view into it, compressed buffers are decompressed straight into the buffers of the result vectors.
+class VeloxColumnarVectorSerde {
+ public:
+  /// First 4 bytes of the serialized data. PrestoVectorSerde starts with the non-negative number of rows instead.
+  static constexpr int32_t kMagic = static_cast<int32_t>(0xC01A7B01);
+
+  /// Whether data is in this format.
+  static bool isSerialized(const uint8_t* data, int32_t size);
+
+  static std::shared_ptr<arrow::Buffer> serialize(
+      const facebook::velox::RowVectorPtr& rowVector,
+      arrow::Compression::type compressionType,
+      arrow::MemoryPool* arrowPool,
+      facebook::velox::memory::MemoryPool* veloxPool);
+
+  static facebook::velox::RowVectorPtr deserialize(
+      const uint8_t* data,
+      int32_t size,
+      const facebook::velox::RowTypePtr& rowType,
+      facebook::velox::memory::MemoryPool* pool);
+};
+
+} // namespace gluten
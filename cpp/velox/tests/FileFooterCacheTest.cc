@@ -0,0 +1,191 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "utils/FileFooterCache.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+
+namespace {
+
+// Counts the reads that reach the file.
+class CountingReadFile : public InMemoryReadFile {
+ public:
+  explicit CountingReadFile(std::string content) : InMemoryReadFile(std::move(content)) {}
+
+  std::string_view pread(uint64_t offset, uint64_t length, void* buf, filesystems::File::IoStats* stats = nullptr)
+      const override {
+    ++numReads;
+    return InMemoryReadFile::pread(offset, length, buf, stats);
+  }
+
+  mutable int32_t numReads{0};
+};
+
+std::string makeContent(size_t size, char seed) {
+  std::string content(size, '\0');
+  for (size_t i = 0; i < size; ++i) {
+    content[i] = static_cast<char>(seed + i % 31);
+  }
+  return content;
+}
+
+} // namespace
+
+class FileFooterCacheTest : public ::testing::Test {
+ protected:
+  static constexpr uint64_t kTailSize = 1024;
+
+  FileFooterCache::ReadResult readTail(FileFooterCache& cache, const std::string& path, const CountingReadFile& file) {
+    const auto offset = file.size() - 100;
+    std::string buf(100, '\0');
+    auto result = cache.read(path, file, offset, 100, buf.data());
+    if (result != FileFooterCache::ReadResult::kBypass) {
+      std::string expected(100, '\0');
+      file.InMemoryReadFile::pread(offset, 100, expected.data());
+      EXPECT_EQ(buf, expected);
+    }
+    return result;
+  }
+};
+
+TEST_F(FileFooterCacheTest, hitAfterMiss) {
+  FileFooterCache cache(1 << 20, kTailSize);
+  const auto content = makeContent(10'000, 'a');
+  CountingReadFile file(content);
+  cache.registerFile("/a", 1);
+
+  ASSERT_EQ(readTail(cache, "/a", file), FileFooterCache::ReadResult::kMiss);
+  ASSERT_EQ(file.numReads, 1);
+  // Another task reopening the file.
+  CountingReadFile reopened(content);
+  ASSERT_EQ(readTail(cache, "/a", reopened), FileFooterCache::ReadResult::kHit);
+  ASSERT_EQ(reopened.numReads, 0);
+
+  // A larger footer read before the cached tail is a miss, then both reads hit.
+  std::string buf(500, '\0');
+  ASSERT_EQ(cache.read("/a", file, 10'000 - 600, 500, buf.data()), FileFooterCache::ReadResult::kMiss);
+  ASSERT_EQ(buf, content.substr(10'000 - 600, 500));
+  ASSERT_EQ(cache.read("/a", reopened, 10'000 - 600, 500, buf.data()), FileFooterCache::ReadResult::kHit);
+  ASSERT_EQ(readTail(cache, "/a", reopened), FileFooterCache::ReadResult::kHit);
+  ASSERT_EQ(reopened.numReads, 0);
+
+  const auto stats = cache.stats();
+  ASSERT_EQ(stats.numHits, 3);
+  ASSERT_EQ(stats.numMisses, 2);
+  ASSERT_EQ(stats.numEntries, 1);
+}
+
+TEST_F(FileFooterCacheTest, bypass) {
+  FileFooterCache cache(1 << 20, kTailSize);
+  CountingReadFile file(makeContent(10'000, 'a'));
+
+  // Not registered, i.e. the modification time is unknown.
+  ASSERT_EQ(readTail(cache, "/a", file), FileFooterCache::ReadResult::kBypass);
+  cache.registerFile("/a", 1);
+  // Not in the tail.
+  std::string buf(100, '\0');
+  ASSERT_EQ(cache.read("/a", file, 0, 100, buf.data()), FileFooterCache::ReadResult::kBypass);
+  ASSERT_EQ(cache.read("/a", file, 10'000 - kTailSize - 1, 100, buf.data()), FileFooterCache::ReadResult::kBypass);
+  ASSERT_EQ(file.numReads, 0);
+  ASSERT_EQ(cache.stats().numMisses, 0);
+}
+
+TEST_F(FileFooterCacheTest, invalidation) {
+  FileFooterCache cache(1 << 20, kTailSize);
+  CountingReadFile file(makeContent(10'000, 'a'));
+  cache.registerFile("/a", 1);
+  ASSERT_EQ(readTail(cache, "/a", file), FileFooterCache::ReadResult::kMiss);
+  cache.registerFile("/a", 1);
+  ASSERT_EQ(readTail(cache, "/a", file), FileFooterCache::ReadResult::kHit);
+
+  // Rewritten with the same size.
+  CountingReadFile modified(makeContent(10'000, 'b'));
+  cache.registerFile("/a", 2);
+  ASSERT_EQ(readTail(cache, "/a", modified), FileFooterCache::ReadResult::kMiss);
+  ASSERT_EQ(readTail(cache, "/a", modified), FileFooterCache::ReadResult::kHit);
+  ASSERT_EQ(cache.stats().numInvalidations, 1);
+
+  // Same modification time, other size.
+  CountingReadFile resized(makeContent(20'000, 'c'));
+  ASSERT_EQ(readTail(cache, "/a", resized), FileFooterCache::ReadResult::kMiss);
+  ASSERT_EQ(readTail(cache, "/a", resized), FileFooterCache::ReadResult::kHit);
+}
+
+TEST_F(FileFooterCacheTest, evictLeastRecentlyUsed) {
+  // Room for two small files read in full, with the entry overheads.
+  FileFooterCache cache(2 * kTailSize + 512, kTailSize);
+  CountingReadFile file(makeContent(kTailSize, 'a'));
+  std::string buf(kTailSize, '\0');
+  for (const auto* path : {"/a", "/b"}) {
+    cache.registerFile(path, 1);
+    ASSERT_EQ(cache.read(path, file, 0, kTailSize, buf.data()), FileFooterCache::ReadResult::kMiss);
+  }
+  ASSERT_EQ(cache.read("/a", file, 0, kTailSize, buf.data()), FileFooterCache::ReadResult::kHit);
+
+  cache.registerFile("/c", 1);
+  ASSERT_EQ(cache.read("/c", file, 0, kTailSize, buf.data()), FileFooterCache::ReadResult::kMiss);
+  const auto stats = cache.stats();
+  ASSERT_LE(stats.cachedBytes, 2 * kTailSize + 512);
+  ASSERT_EQ(stats.numEntries, 2);
+  // "/b" was the least recently used.
+  ASSERT_EQ(readTail(cache, "/b", file), FileFooterCache::ReadResult::kBypass);
+  ASSERT_EQ(readTail(cache, "/a", file), FileFooterCache::ReadResult::kHit);
+  ASSERT_EQ(readTail(cache, "/c", file), FileFooterCache::ReadResult::kHit);
+}
+
+TEST_F(FileFooterCacheTest, unregisteredFileNotWrapped) {
+  auto cache = std::make_shared<FileFooterCache>(1 << 20, kTailSize);
+  auto counting = std::make_unique<CountingReadFile>(makeContent(10'000, 'a'));
+  auto* rawCounting = counting.get();
+  auto file = makeFooterCachingReadFile(std::move(counting), "/spill", cache);
+  ASSERT_EQ(file.get(), rawCounting);
+  ASSERT_EQ(cache->stats().numEntries, 0);
+}
+
+TEST_F(FileFooterCacheTest, readFile) {
+  auto cache = std::make_shared<FileFooterCache>(1 << 20, kTailSize);
+  const auto content = makeContent(10'000, 'a');
+  cache->registerFile("/a", 1);
+
+  auto counting = std::make_unique<CountingReadFile>(content);
+  auto* rawCounting = counting.get();
+  auto file = makeFooterCachingReadFile(std::move(counting), "/a", cache);
+  ASSERT_EQ(file->size(), content.size());
+  ASSERT_EQ(file->pread(10'000 - 100, 100), content.substr(10'000 - 100));
+  ASSERT_EQ(rawCounting->numReads, 1);
+
+  // A vectored read of the tail, with a gap.
+  std::string first(20, '\0');
+  std::string second(30, '\0');
+  std::vector<folly::Range<char*>> buffers = {
+      {first.data(), first.size()}, {nullptr, 10}, {second.data(), second.size()}};
+  ASSERT_EQ(file->preadv(10'000 - 60, buffers), 60);
+  ASSERT_EQ(first, content.substr(10'000 - 60, 20));
+  ASSERT_EQ(second, content.substr(10'000 - 30, 30));
+  ASSERT_EQ(rawCounting->numReads, 1);
+
+  // Reads of the data pages go to the file.
+  ASSERT_EQ(file->pread(0, 100), content.substr(0, 100));
+  ASSERT_EQ(rawCounting->numReads, 2);
+  ASSERT_EQ(cache->stats().numHits, 2);
+}
+
+} // namespace gluten
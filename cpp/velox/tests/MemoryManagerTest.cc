@@ -130,6 +130,106 @@ TEST_F(MemoryManagerTest, memoryAllocatorWithBlockReservation) {
   ASSERT_EQ(allocator_->getBytes(), 0);
 }
 
+TEST(ReservationCacheAllocationListenerTest, adaptiveChunk) {
+  struct CountingListener : public MockAllocationListener {
+    void allocationChanged(int64_t diff) override {
+      ++calls;
+      MockAllocationListener::allocationChanged(diff);
+    }
+    int32_t calls{0};
+  } delegated;
+  ReservationCacheAllocationListener listener(&delegated, 1 * kMB, 8 * kMB);
+
+  // The chunk doubles on each miss: 1MB, 2MB, 4MB, 8MB, 8MB...
+  for (auto i = 0; i < 62; ++i) {
+    listener.allocationChanged(kMB / 2);
+  }
+  ASSERT_EQ(delegated.calls, 6);
+  ASSERT_EQ(delegated.currentBytes_, 31 * kMB);
+  ASSERT_EQ(listener.currentBytes(), delegated.currentBytes_);
+
+  // Slack within two chunks is kept.
+  listener.allocationChanged(-8 * kMB);
+  ASSERT_EQ(delegated.calls, 6);
+
+  // Beyond that it is released down to one chunk, which halves.
+  listener.allocationChanged(-10 * kMB);
+  ASSERT_EQ(delegated.calls, 7);
+  ASSERT_EQ(delegated.currentBytes_, 21 * kMB);
+
+  ASSERT_EQ(listener.flush(), 8 * kMB);
+  ASSERT_EQ(delegated.currentBytes_, 13 * kMB);
+  listener.allocationChanged(-13 * kMB);
+  ASSERT_EQ(listener.flush(), 1 * kMB);
+  ASSERT_EQ(delegated.currentBytes_, 0);
+  ASSERT_EQ(delegated.peakBytes_, 31 * kMB);
+}
+
+TEST(ReservationCacheAllocationListenerTest, fallbackToNeededBytes) {
+  struct LimitedListener : public MockAllocationListener {
+    void allocationChanged(int64_t diff) override {
+      if (diff > 0 && currentBytes_ + diff > 3 * kMB) {
+        throw std::runtime_error("OOM");
+      }
+      MockAllocationListener::allocationChanged(diff);
+    }
+  } delegated;
+  ReservationCacheAllocationListener listener(&delegated, 2 * kMB, 8 * kMB);
+
+  listener.allocationChanged(kMB);
+  ASSERT_EQ(delegated.currentBytes_, 2 * kMB);
+  // A 4MB chunk doesn't fit, the exact shortfall does.
+  listener.allocationChanged(2 * kMB);
+  ASSERT_EQ(delegated.currentBytes_, 3 * kMB);
+  ASSERT_THROW(listener.allocationChanged(kMB), std::runtime_error);
+  ASSERT_EQ(listener.currentBytes(), 3 * kMB);
+  listener.allocationChanged(-3 * kMB);
+  listener.flush();
+  ASSERT_EQ(delegated.currentBytes_, 0);
+}
+
+TEST(ReservationCacheAllocationListenerTest, flushFromDelegated) {
+  // Spills on each reservation, like a Spark task memory manager spilling its own consumer.
+  struct SpillingListener : public MockAllocationListener {
+    void allocationChanged(int64_t diff) override {
+      if (diff > 0) {
+        listener->flush();
+      }
+      if (diff > 0 && currentBytes_ + diff > 3 * kMB) {
+        throw std::runtime_error("OOM");
+      }
+      if (diff < 0 && static_cast<uint64_t>(-diff) > currentBytes_) {
+        overReleased = true;
+      }
+      MockAllocationListener::allocationChanged(diff);
+    }
+    ReservationCacheAllocationListener* listener{nullptr};
+    bool overReleased{false};
+  } delegated;
+  ReservationCacheAllocationListener listener(&delegated, 2 * kMB, 8 * kMB);
+  delegated.listener = &listener;
+
+  // The 2MB chunk in flight is not slack, the flush must not release it before it is granted.
+  listener.allocationChanged(kMB);
+  ASSERT_FALSE(delegated.overReleased);
+  ASSERT_EQ(delegated.currentBytes_, 2 * kMB);
+  ASSERT_EQ(listener.currentBytes(), delegated.currentBytes_);
+
+  // The 4MB chunk doesn't fit, the flush releases nothing and the 1MB shortfall is booked once.
+  listener.allocationChanged(2 * kMB);
+  ASSERT_FALSE(delegated.overReleased);
+  ASSERT_EQ(delegated.currentBytes_, 3 * kMB);
+  ASSERT_EQ(listener.currentBytes(), delegated.currentBytes_);
+
+  // A failed reservation leaves the bytes granted so far.
+  ASSERT_THROW(listener.allocationChanged(kMB), std::runtime_error);
+  ASSERT_EQ(listener.currentBytes(), delegated.currentBytes_);
+  listener.allocationChanged(-3 * kMB);
+  ASSERT_EQ(listener.flush(), 3 * kMB);
+  ASSERT_EQ(delegated.currentBytes_, 0);
+  ASSERT_FALSE(delegated.overReleased);
+}
+
 namespace {
 class AllocationListenerWrapper : public AllocationListener {
  public:
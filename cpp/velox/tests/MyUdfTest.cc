@@ -29,7 +29,7 @@ class MyUdfTest : public FunctionBaseTest {
   static void SetUpTestCase() {
     parse::registerTypeResolver();
     auto udfLoader = gluten::UdfLoader::getInstance();
-    udfLoader->loadUdfLibraries("../udf/examples/libmyudf.so");
+    udfLoader->loadUdfLibraries("../udf/examples/libmyudf.so,../udf/examples/libmyvectorudf.so");
     udfLoader->registerUdf();
     memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
   }
@@ -40,3 +40,21 @@ TEST_F(MyUdfTest, hivestringstring) {
   const core::QueryConfig config({});
   EXPECT_EQ(TypeKind::VARCHAR, exec::simpleFunctions().resolveFunction(name, {VARCHAR(), VARCHAR()})->type()->kind());
 }
+
+TEST_F(MyUdfTest, vectorPlusOne) {
+  auto plusOne = []() {
+    return std::make_shared<core::CallTypedExpr>(
+        BIGINT(),
+        std::vector<core::TypedExprPtr>{std::make_shared<core::FieldAccessTypedExpr>(BIGINT(), "c0")},
+        "org.apache.gluten.udf.VectorPlusOne");
+  };
+
+  auto result = evaluate(plusOne(), makeRowVector({makeNullableFlatVector<int64_t>({1, std::nullopt, -3, 41})}));
+  test::assertEqualVectors(makeNullableFlatVector<int64_t>({2, std::nullopt, -2, 42}), result);
+
+  // Dictionary encoded input is flattened before it is passed to the UDF.
+  result = evaluate(
+      plusOne(),
+      makeRowVector({wrapInDictionary(makeIndices({3, 0}), 2, makeFlatVector<int64_t>({1, 2, 3, 4}))}));
+  test::assertEqualVectors(makeFlatVector<int64_t>({5, 2}), result);
+}
@@ -0,0 +1,74 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "compute/WholeStageResultIterator.h"
+
+namespace gluten {
+
+namespace {
+
+constexpr uint64_t kMB = 1 << 20;
+
+int32_t depth(
+    const std::vector<uint64_t>& splitLengths,
+    uint64_t memoryBudget,
+    uint64_t loadQuantum,
+    int32_t maxDepth) {
+  return WholeStageResultIterator::splitPreloadDepth(splitLengths, 2, memoryBudget, loadQuantum, maxDepth);
+}
+
+} // namespace
+
+TEST(SplitPreloadDepthTest, defaultDepth) {
+  // No budget.
+  ASSERT_EQ(depth(std::vector<uint64_t>(100, kMB), 0, 256 * kMB, 16), 2);
+  // A single split, nothing to preload ahead of it.
+  ASSERT_EQ(depth({kMB}, 64 * kMB, 256 * kMB, 16), 2);
+  ASSERT_EQ(depth({}, 64 * kMB, 256 * kMB, 16), 2);
+}
+
+TEST(SplitPreloadDepthTest, budget) {
+  // 64MB for 1MB splits.
+  ASSERT_EQ(depth(std::vector<uint64_t>(100, kMB), 64 * kMB, 256 * kMB, 100), 64);
+  // Average of 1MB and 3MB splits.
+  std::vector<uint64_t> lengths;
+  for (int i = 0; i < 50; ++i) {
+    lengths.push_back(kMB);
+    lengths.push_back(3 * kMB);
+  }
+  ASSERT_EQ(depth(lengths, 64 * kMB, 256 * kMB, 100), 32);
+  // At least one split, even if a single one doesn't fit.
+  ASSERT_EQ(depth(std::vector<uint64_t>(100, 128 * kMB), 64 * kMB, 256 * kMB, 16), 1);
+}
+
+TEST(SplitPreloadDepthTest, loadQuantum) {
+  // Large splits only hold up to the load quantum each.
+  ASSERT_EQ(depth(std::vector<uint64_t>(100, 1024 * kMB), 64 * kMB, 8 * kMB, 100), 8);
+  ASSERT_EQ(depth(std::vector<uint64_t>(100, 1024 * kMB), 64 * kMB, 256 * kMB, 100), 1);
+}
+
+TEST(SplitPreloadDepthTest, maxDepth) {
+  ASSERT_EQ(depth(std::vector<uint64_t>(100, kMB), 64 * kMB, 256 * kMB, 16), 16);
+  // Bounded by the number of the other splits.
+  ASSERT_EQ(depth(std::vector<uint64_t>(5, kMB), 64 * kMB, 256 * kMB, 16), 4);
+  // A non-positive max depth still preloads one split.
+  ASSERT_EQ(depth(std::vector<uint64_t>(100, kMB), 64 * kMB, 256 * kMB, 0), 1);
+}
+
+} // namespace gluten
@@ -0,0 +1,115 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include <folly/executors/IOThreadPoolExecutor.h>
+
+#include "utils/SsdCacheManifest.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+using namespace facebook::velox;
+
+namespace gluten {
+
+class SsdCacheManifestTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    executor_ = std::make_unique<folly::IOThreadPoolExecutor>(1);
+    ssdCache_ = std::make_unique<cache::SsdCache>(
+        cache::SsdCache::Config(tmpDir_->getPath() + "/cache.", 64 << 20, 1, executor_.get()));
+  }
+
+  void TearDown() override {
+    ssdCache_->shutdown();
+  }
+
+  std::string manifestPath() const {
+    return tmpDir_->getPath() + "/manifest";
+  }
+
+  std::shared_ptr<exec::test::TempDirectoryPath> tmpDir_{exec::test::TempDirectoryPath::create()};
+  std::unique_ptr<folly::IOThreadPoolExecutor> executor_;
+  std::unique_ptr<cache::SsdCache> ssdCache_;
+};
+
+TEST_F(SsdCacheManifestTest, saveAndRead) {
+  SsdCacheManifest manifest(manifestPath(), ssdCache_.get(), {});
+  ASSERT_FALSE(manifest.validate("/data/a.parquet", 100));
+  ASSERT_FALSE(manifest.validate("/data/b.parquet", 200));
+  manifest.save();
+  ASSERT_FALSE(std::filesystem::exists(manifestPath() + ".tmp"));
+
+  auto versions = SsdCacheManifest::read(manifestPath());
+  ASSERT_TRUE(versions.has_value());
+  ASSERT_EQ(versions->size(), 2);
+  ASSERT_EQ(versions->at("/data/a.parquet"), 100);
+  ASSERT_EQ(versions->at("/data/b.parquet"), 200);
+  // Removed once read, a process dying before the next save starts cold.
+  ASSERT_FALSE(std::filesystem::exists(manifestPath()));
+  ASSERT_FALSE(SsdCacheManifest::read(manifestPath()).has_value());
+}
+
+TEST_F(SsdCacheManifestTest, validate) {
+  SsdCacheManifest manifest(manifestPath(), ssdCache_.get(), {{"/data/a.parquet", 100}});
+  // Same version as the restored entries.
+  ASSERT_FALSE(manifest.validate("/data/a.parquet", 100));
+  // Modified since the entries were cached.
+  ASSERT_TRUE(manifest.validate("/data/a.parquet", 101));
+  ASSERT_FALSE(manifest.validate("/data/a.parquet", 101));
+  // Not cached before.
+  ASSERT_FALSE(manifest.validate("/data/b.parquet", 100));
+
+  manifest.save();
+  auto versions = SsdCacheManifest::read(manifestPath());
+  ASSERT_TRUE(versions.has_value());
+  ASSERT_EQ(versions->at("/data/a.parquet"), 101);
+  ASSERT_EQ(versions->at("/data/b.parquet"), 100);
+}
+
+TEST_F(SsdCacheManifestTest, corrupted) {
+  SsdCacheManifest manifest(manifestPath(), ssdCache_.get(), {{"/data/a.parquet", 100}, {"/data/b.parquet", 200}});
+  manifest.save();
+  const auto size = std::filesystem::file_size(manifestPath());
+
+  // Truncated, e.g. by a crash while saving.
+  std::filesystem::resize_file(manifestPath(), size - 3);
+  ASSERT_FALSE(SsdCacheManifest::read(manifestPath()).has_value());
+
+  // Not a manifest.
+  {
+    std::ofstream out(manifestPath(), std::ios::binary | std::ios::trunc);
+    out << "not a manifest";
+  }
+  ASSERT_FALSE(SsdCacheManifest::read(manifestPath()).has_value());
+  ASSERT_FALSE(std::filesystem::exists(manifestPath()));
+}
+
+TEST_F(SsdCacheManifestTest, lockSlot) {
+  auto first = SsdCacheManifest::lockSlot(tmpDir_->getPath(), 2);
+  ASSERT_EQ(first, "cache.persistent.0.");
+  // flock conflicts between the open files of the same process too.
+  auto second = SsdCacheManifest::lockSlot(tmpDir_->getPath(), 2);
+  ASSERT_EQ(second, "cache.persistent.1.");
+  ASSERT_FALSE(SsdCacheManifest::lockSlot(tmpDir_->getPath(), 2).has_value());
+  ASSERT_FALSE(SsdCacheManifest::lockSlot(tmpDir_->getPath() + "/missing", 2).has_value());
+}
+
+} // namespace gluten
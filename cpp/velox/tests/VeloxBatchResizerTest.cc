@@ -83,4 +83,44 @@ TEST_F(VeloxBatchResizerTest, sanity) {
   ASSERT_ANY_THROW(checkResize(0, 0, {}, {}));
 }
 
+TEST_F(VeloxBatchResizerTest, noCopyUnlessCoalesced) {
+  auto small = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  auto large = makeRowVector({makeFlatVector<int64_t>(100, [](auto row) { return row; })});
+  std::vector<std::shared_ptr<ColumnarBatch>> inBatches{
+      std::make_shared<VeloxColumnarBatch>(small), std::make_shared<VeloxColumnarBatch>(large)};
+  VeloxBatchResizer resizer(pool(), 10, 40, std::make_unique<ColumnarBatchArray>(std::move(inBatches)));
+
+  // The small batch is followed by one that doesn't fit, it is passed through.
+  auto out = std::dynamic_pointer_cast<VeloxColumnarBatch>(resizer.next());
+  ASSERT_EQ(out->getRowVector()->childAt(0), small->childAt(0));
+
+  // Slices share the buffers of the large batch.
+  out = std::dynamic_pointer_cast<VeloxColumnarBatch>(resizer.next());
+  ASSERT_EQ(out->numRows(), 40);
+  ASSERT_EQ(
+      out->getRowVector()->childAt(0)->values()->as<int64_t>(), large->childAt(0)->values()->as<int64_t>());
+  ASSERT_EQ(resizer.retainedBytes(), large->retainedSize());
+  ASSERT_NE(resizer.next(), nullptr);
+  ASSERT_NE(resizer.next(), nullptr);
+  ASSERT_EQ(resizer.next(), nullptr);
+  ASSERT_EQ(resizer.retainedBytes(), 0);
+  ASSERT_EQ(resizer.peakRetainedBytes(), large->retainedSize());
+}
+
+TEST_F(VeloxBatchResizerTest, coalesce) {
+  std::vector<std::shared_ptr<ColumnarBatch>> inBatches;
+  for (auto i = 0; i < 4; ++i) {
+    inBatches.push_back(std::make_shared<VeloxColumnarBatch>(makeRowVector(
+        {makeFlatVector<int64_t>({i * 2, i * 2 + 1}), makeNullableFlatVector<std::string>({std::nullopt, "s"})})));
+  }
+  VeloxBatchResizer resizer(pool(), 8, 100, std::make_unique<ColumnarBatchArray>(std::move(inBatches)));
+  auto out = std::dynamic_pointer_cast<VeloxColumnarBatch>(resizer.next());
+  auto expected = makeRowVector(
+      {makeFlatVector<int64_t>({0, 1, 2, 3, 4, 5, 6, 7}),
+       makeNullableFlatVector<std::string>(
+           {std::nullopt, "s", std::nullopt, "s", std::nullopt, "s", std::nullopt, "s"})});
+  test::assertEqualVectors(expected, out->getRowVector());
+  ASSERT_EQ(resizer.next(), nullptr);
+}
+
 } // namespace gluten
@@ -21,6 +21,7 @@
 #include "memory/ArrowMemoryPool.h"
 #include "memory/VeloxColumnarBatch.h"
 #include "operators/serializer/VeloxColumnarBatchSerializer.h"
+#include "operators/serializer/VeloxColumnarVectorSerde.h"
 #include "utils/VeloxArrowUtils.h"
 
 #include "velox/vector/arrow/Bridge.h"
@@ -72,4 +73,93 @@ TEST_F(VeloxColumnarBatchSerializerTest, serialize) {
   test::assertEqualVectors(vector, deserializedVector);
 }
 
+TEST_F(VeloxColumnarBatchSerializerTest, columnarFormat) {
+  auto* arrowPool = getDefaultMemoryManager()->defaultArrowMemoryPool();
+
+  std::vector<VectorPtr> children = {
+      makeNullableFlatVector<int64_t>({1, std::nullopt, 3, 4, 5}),
+      makeNullableFlatVector<bool>({std::nullopt, true, false, std::nullopt, true}),
+      makeNullableFlatVector<StringView>({"alice", "bob", std::nullopt, "", "Alice4uuudeuhdhfudhfudhfudhbvudubvudfvu"}),
+      makeNullableFlatVector<int128_t>({34567235, 4567, std::nullopt, 34567, 333}, DECIMAL(20, 4)),
+      makeFlatVector<Timestamp>({Timestamp(1, 2), Timestamp(3, 4), Timestamp(5, 6), Timestamp(7, 8), Timestamp(9, 0)}),
+      makeConstant<StringView>("constant", 5),
+      makeNullConstant(TypeKind::BIGINT, 5),
+      wrapInDictionary(makeIndices({0, 0, 1, 1, 0}), makeFlatVector<StringView>({"dict0", "dict1"})),
+      makeArrayVector<int32_t>({{1, 2}, {}, {3}, {4, 5}, {6}}),
+      makeMapVector<int32_t, StringView>({{{1, "a"}}, {}, {{2, "b"}, {3, "c"}}, {}, {{4, "d"}}}),
+      makeRowVector({makeFlatVector<int32_t>({1, 2, 3, 4, 5}), makeFlatVector<double>({1.0, 2.0, 3.0, 4.0, 5.0})}),
+  };
+  auto vector = makeRowVector(children);
+
+  for (auto compressionType : {arrow::Compression::UNCOMPRESSED, arrow::Compression::LZ4_FRAME}) {
+    auto serializer =
+        std::make_shared<VeloxColumnarBatchSerializer>(arrowPool, pool_, nullptr, true, compressionType);
+    auto buffer = serializer->serializeColumnarBatches(
+        {std::make_shared<VeloxColumnarBatch>(vector), std::make_shared<VeloxColumnarBatch>(vector)});
+
+    ArrowSchema cSchema;
+    exportToArrow(vector, cSchema, ArrowUtils::getBridgeOptions());
+    auto deserializer = std::make_shared<VeloxColumnarBatchSerializer>(arrowPool, pool_, &cSchema);
+    auto deserialized = deserializer->deserialize(const_cast<uint8_t*>(buffer->data()), buffer->size());
+    auto deserializedVector = std::dynamic_pointer_cast<VeloxColumnarBatch>(deserialized)->getRowVector();
+    ASSERT_EQ(deserializedVector->size(), 2 * vector->size());
+    test::assertEqualVectors(vector, deserializedVector->slice(0, vector->size()));
+    test::assertEqualVectors(vector, deserializedVector->slice(vector->size(), vector->size()));
+
+    // A single batch keeps the constant and dictionary encodings.
+    buffer = serializer->serializeColumnarBatches({std::make_shared<VeloxColumnarBatch>(vector)});
+    exportToArrow(vector, cSchema, ArrowUtils::getBridgeOptions());
+    deserializer = std::make_shared<VeloxColumnarBatchSerializer>(arrowPool, pool_, &cSchema);
+    deserialized = deserializer->deserialize(const_cast<uint8_t*>(buffer->data()), buffer->size());
+    deserializedVector = std::dynamic_pointer_cast<VeloxColumnarBatch>(deserialized)->getRowVector();
+    test::assertEqualVectors(vector, deserializedVector);
+    ASSERT_EQ(deserializedVector->childAt(5)->encoding(), VectorEncoding::Simple::CONSTANT);
+    ASSERT_EQ(deserializedVector->childAt(6)->encoding(), VectorEncoding::Simple::CONSTANT);
+    ASSERT_EQ(deserializedVector->childAt(7)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  }
+}
+
+TEST_F(VeloxColumnarBatchSerializerTest, columnarFormatBufferContents) {
+  auto* arrowPool = getDefaultMemoryManager()->defaultArrowMemoryPool();
+
+  // Odd sized buffers ahead of every other buffer, so that each one needs padding to its aligned offset.
+  constexpr vector_size_t kSize = 37;
+  auto int8s = makeFlatVector<int8_t>(kSize, [](auto row) { return row * 3; });
+  auto bools = makeFlatVector<bool>(kSize, [](auto row) { return row % 3 == 0; }, nullEvery(5));
+  auto strings = makeFlatVector<std::string>(
+      kSize, [](auto row) { return std::string(row % 7, 'a' + row % 26); }, nullEvery(4));
+  auto int64s = makeFlatVector<int64_t>(kSize, [](auto row) { return row * 1'000'000'007LL; }, nullEvery(3));
+  auto arrays = makeArrayVector<int16_t>(
+      kSize, [](auto row) { return row % 4; }, [](auto row, auto index) { return row + index; }, nullEvery(6));
+  auto vector = makeRowVector({int8s, bools, strings, int64s, arrays});
+
+  for (auto compressionType : {arrow::Compression::UNCOMPRESSED, arrow::Compression::LZ4_FRAME}) {
+    auto buffer = VeloxColumnarVectorSerde::serialize(vector, compressionType, arrowPool, pool());
+    ASSERT_TRUE(VeloxColumnarVectorSerde::isSerialized(buffer->data(), buffer->size()));
+    auto result =
+        VeloxColumnarVectorSerde::deserialize(buffer->data(), buffer->size(), asRowType(vector->type()), pool());
+    ASSERT_EQ(result->size(), kSize);
+
+    for (auto i = 0; i < vector->childrenSize(); ++i) {
+      const auto& expected = vector->childAt(i);
+      const auto& actual = result->childAt(i);
+      ASSERT_EQ(actual->encoding(), expected->encoding());
+      ASSERT_EQ(actual->rawNulls() != nullptr, expected->rawNulls() != nullptr);
+      if (expected->rawNulls() != nullptr) {
+        ASSERT_EQ(std::memcmp(actual->rawNulls(), expected->rawNulls(), bits::nbytes(kSize)), 0) << "child " << i;
+      }
+    }
+    ASSERT_EQ(std::memcmp(result->childAt(0)->values()->as<int8_t>(), int8s->rawValues(), kSize), 0);
+    ASSERT_EQ(
+        std::memcmp(result->childAt(1)->values()->as<uint8_t>(), bools->values()->as<uint8_t>(), bits::nbytes(kSize)),
+        0);
+    ASSERT_EQ(
+        std::memcmp(result->childAt(3)->values()->as<int64_t>(), int64s->rawValues(), kSize * sizeof(int64_t)), 0);
+    const auto* resultArrays = result->childAt(4)->as<ArrayVector>();
+    ASSERT_EQ(std::memcmp(resultArrays->rawOffsets(), arrays->rawOffsets(), kSize * sizeof(vector_size_t)), 0);
+    ASSERT_EQ(std::memcmp(resultArrays->rawSizes(), arrays->rawSizes(), kSize * sizeof(vector_size_t)), 0);
+    test::assertEqualVectors(vector, result);
+  }
+}
+
 } // namespace gluten
@@ -16,11 +16,14 @@
  */
 
 #include <dlfcn.h>
+#include <folly/ScopeGuard.h>
 #include <google/protobuf/arena.h>
+#include <algorithm>
 #include <vector>
 #include "velox/expression/SignatureBinder.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/type/fbhive/HiveTypeParser.h"
+#include "velox/vector/arrow/Bridge.h"
 
 #include "Udaf.h"
 #include "Udf.h"
@@ -28,6 +31,7 @@
 #include "utils/Exception.h"
 #include "utils/Macros.h"
 #include "utils/StringUtil.h"
+#include "utils/VeloxArrowUtils.h"
 
 namespace {
 
@@ -43,6 +47,84 @@ void* loadSymFromLibrary(
   return sym;
 }
 
+// Type signature of Velox function registry, e.g. array(bigint) for ARRAY<BIGINT>.
+std::string toSignatureType(const facebook::velox::TypePtr& type) {
+  std::string out;
+  switch (type->kind()) {
+    case facebook::velox::TypeKind::ARRAY:
+    case facebook::velox::TypeKind::MAP:
+    case facebook::velox::TypeKind::ROW: {
+      out = facebook::velox::TypeKindName::toName(type->kind());
+      out += "(";
+      for (auto i = 0; i < type->size(); ++i) {
+        out += (i > 0 ? "," : "") + toSignatureType(type->childAt(i));
+      }
+      out += ")";
+      break;
+    }
+    default:
+      out = type->toString();
+  }
+  std::transform(out.begin(), out.end(), out.begin(), ::tolower);
+  return out;
+}
+
+// Velox vector function calling a vector UDF through the Arrow C Data interface, once per batch.
+class ArrowVectorUdf final : public facebook::velox::exec::VectorFunction {
+ public:
+  explicit ArrowVectorUdf(const gluten::VectorUdfEntry& entry) : entry_(entry) {}
+
+  void apply(
+      const facebook::velox::SelectivityVector& rows,
+      std::vector<facebook::velox::VectorPtr>& args,
+      const facebook::velox::TypePtr& outputType,
+      facebook::velox::exec::EvalCtx& context,
+      facebook::velox::VectorPtr& result) const override {
+    auto* pool = context.pool();
+    const auto numRows = rows.end();
+    const auto options = gluten::ArrowUtils::getBridgeOptions();
+
+    std::vector<ArrowArray> arrowArgs(args.size());
+    std::vector<ArrowArray*> arrowArgPtrs(args.size());
+    SCOPE_EXIT {
+      for (auto& arrowArg : arrowArgs) {
+        if (arrowArg.release != nullptr) {
+          arrowArg.release(&arrowArg);
+        }
+      }
+    };
+    for (auto i = 0; i < args.size(); ++i) {
+      arrowArgs[i].release = nullptr;
+      auto arg = args[i];
+      facebook::velox::BaseVector::flattenVector(arg);
+      facebook::velox::exportToArrow(arg, arrowArgs[i], pool, options);
+      arrowArgPtrs[i] = &arrowArgs[i];
+    }
+
+    ArrowArray arrowResult;
+    arrowResult.release = nullptr;
+    const char* errorMessage = nullptr;
+    const int status = entry_.evaluate(
+        numRows, rows.allBits(), static_cast<int32_t>(args.size()), arrowArgPtrs.data(), &arrowResult, &errorMessage);
+    if (status != 0) {
+      if (arrowResult.release != nullptr) {
+        arrowResult.release(&arrowResult);
+      }
+      VELOX_USER_FAIL("Vector UDF {} failed: {}", entry_.name, errorMessage ? errorMessage : "unknown error");
+    }
+    VELOX_CHECK_NOT_NULL(arrowResult.release, "Vector UDF {} returned no result", entry_.name);
+    VELOX_CHECK_GE(arrowResult.length, numRows, "Vector UDF {} returned too few rows", entry_.name);
+
+    ArrowSchema arrowResultSchema;
+    facebook::velox::exportToArrow(outputType, arrowResultSchema, options);
+    auto vector = facebook::velox::importFromArrowAsOwner(arrowResultSchema, arrowResult, pool);
+    context.moveOrCopyResult(vector, rows, result);
+  }
+
+ private:
+  const gluten::VectorUdfEntry entry_;
+};
+
 } // namespace
 
 namespace gluten {
@@ -124,6 +206,14 @@ std::unordered_set<std::shared_ptr<UdfLoader::UdfSignature>> UdfLoader::getRegis
     } else {
       LOG(INFO) << "No UDAF found in " << libPath;
     }
+
+    // Handle vector UDFs.
+    for (const auto& entry : getVectorUdfEntries(libPath, handle)) {
+      auto dataType = toSubstraitTypeStr(entry.dataType);
+      auto argTypes = toSubstraitTypeStr(entry.numArgs, entry.argTypes);
+      signatures_.insert(std::make_shared<UdfSignature>(
+          entry.name, dataType, argTypes, entry.variableArity, entry.allowTypeConversion));
+    }
   }
   return signatures_;
 }
@@ -148,10 +238,67 @@ std::unordered_set<std::string> UdfLoader::getRegisteredUdafNames() {
 
 void UdfLoader::registerUdf() {
   for (const auto& item : handles_) {
-    void* sym = loadSymFromLibrary(item.second, item.first, GLUTEN_TOSTRING(GLUTEN_REGISTER_UDF));
-    auto registerUdf = reinterpret_cast<void (*)()>(sym);
-    registerUdf();
+    const auto& vectorUdfEntries = getVectorUdfEntries(item.first, item.second);
+    // A library with only vector UDFs needs no register function.
+    void* sym =
+        loadSymFromLibrary(item.second, item.first, GLUTEN_TOSTRING(GLUTEN_REGISTER_UDF), vectorUdfEntries.empty());
+    if (sym) {
+      auto registerUdf = reinterpret_cast<void (*)()>(sym);
+      registerUdf();
+    }
+    for (const auto& entry : vectorUdfEntries) {
+      registerVectorUdf(entry);
+    }
+  }
+}
+
+const std::vector<VectorUdfEntry>& UdfLoader::getVectorUdfEntries(const std::string& libPath, void* handle) {
+  if (const auto it = vectorUdfEntries_.find(libPath); it != vectorUdfEntries_.end()) {
+    return it->second;
+  }
+  auto& entries = vectorUdfEntries_[libPath];
+  void* getNumVectorUdfSym = loadSymFromLibrary(handle, libPath, GLUTEN_TOSTRING(GLUTEN_GET_NUM_VECTOR_UDF), false);
+  if (!getNumVectorUdfSym) {
+    LOG(INFO) << "No vector UDF found in " << libPath;
+    return entries;
+  }
+
+  void* getAbiVersionSym = loadSymFromLibrary(handle, libPath, GLUTEN_TOSTRING(GLUTEN_GET_VECTOR_UDF_ABI_VERSION));
+  auto abiVersion = reinterpret_cast<int (*)()>(getAbiVersionSym)();
+  if (abiVersion != GLUTEN_VECTOR_UDF_ABI_VERSION) {
+    throw gluten::GlutenException(
+        "Vector UDF ABI version " + std::to_string(abiVersion) + " of " + libPath + " is not supported, expected " +
+        std::to_string(GLUTEN_VECTOR_UDF_ABI_VERSION));
+  }
+
+  auto getNumVectorUdf = reinterpret_cast<int (*)()>(getNumVectorUdfSym);
+  entries.resize(getNumVectorUdf());
+  void* getVectorUdfEntriesSym =
+      loadSymFromLibrary(handle, libPath, GLUTEN_TOSTRING(GLUTEN_GET_VECTOR_UDF_ENTRIES));
+  auto getVectorUdfEntries = reinterpret_cast<void (*)(VectorUdfEntry*)>(getVectorUdfEntriesSym);
+  getVectorUdfEntries(entries.data());
+  for (const auto& entry : entries) {
+    GLUTEN_CHECK(entry.evaluate != nullptr, std::string("Vector UDF ") + entry.name + " has no evaluate function");
+  }
+  return entries;
+}
+
+void UdfLoader::registerVectorUdf(const VectorUdfEntry& entry) {
+  auto builder = facebook::velox::exec::FunctionSignatureBuilder().returnType(
+      toSignatureType(parser_.parse(entry.dataType)));
+  for (auto i = 0; i < entry.numArgs; ++i) {
+    builder.argumentType(toSignatureType(parser_.parse(entry.argTypes[i])));
+  }
+  if (entry.variableArity) {
+    builder.variableArity();
   }
+  auto metadata = facebook::velox::exec::VectorFunctionMetadataBuilder()
+                      .defaultNullBehavior(entry.defaultNullBehavior)
+                      .deterministic(entry.deterministic)
+                      .build();
+  facebook::velox::exec::registerVectorFunction(
+      entry.name, {builder.build()}, std::make_unique<ArrowVectorUdf>(entry), metadata);
+  LOG(INFO) << "Registered vector UDF " << entry.name;
 }
 
 std::shared_ptr<UdfLoader> UdfLoader::getInstance() {
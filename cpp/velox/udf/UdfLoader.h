@@ -22,6 +22,7 @@
 #include <unordered_map>
 #include <vector>
 #include "substrait/VeloxToSubstraitType.h"
+#include "udf/VectorUdf.h"
 #include "velox/type/Type.h"
 #include "velox/type/fbhive/HiveTypeParser.h"
 
@@ -85,7 +86,13 @@ class UdfLoader {
 
   std::string toSubstraitTypeStr(int32_t numArgs, const char** args);
 
+  // Vector UDF entries of a library, empty if the library has none.
+  const std::vector<VectorUdfEntry>& getVectorUdfEntries(const std::string& libPath, void* handle);
+
+  void registerVectorUdf(const VectorUdfEntry& entry);
+
   std::unordered_map<std::string, void*> handles_;
+  std::unordered_map<std::string, std::vector<VectorUdfEntry>> vectorUdfEntries_;
 
   facebook::velox::type::fbhive::HiveTypeParser parser_{};
   google::protobuf::Arena arena_{};
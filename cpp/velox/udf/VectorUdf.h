@@ -0,0 +1,73 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <arrow/c/abi.h>
+#include <cstdint>
+
+namespace gluten {
+
+// Version of the vector UDF ABI below. A library reports the version it is built against through
+// getVectorUdfAbiVersion(), libraries built against another version are rejected when loaded.
+#define GLUTEN_VECTOR_UDF_ABI_VERSION 1
+
+// Evaluates a vector UDF on a batch of rows.
+//   numRows: number of rows of each argument and of the result.
+//   selection: bitmap of numRows bits in 64-bit words, LSB first. Only the results of the set rows are used. With
+//     defaultNullBehavior, rows where any argument is null are already cleared.
+//   args: Arrow C Data arrays of the arguments in flat (non-dictionary) encoding, owned by the caller and only valid
+//     during the call.
+//   result: to be filled with an array of numRows rows of the return type. Gluten takes ownership and calls its
+//     release callback.
+//   errorMessage: on failure, set to a message that stays valid until the next call on the same thread.
+// Returns 0 on success.
+typedef int (*VectorUdfEvaluate)(
+    int64_t numRows,
+    const uint64_t* selection,
+    int32_t numArgs,
+    struct ArrowArray* const* args,
+    struct ArrowArray* result,
+    const char** errorMessage);
+
+struct VectorUdfEntry {
+  const char* name;
+  const char* dataType;
+
+  int numArgs;
+  const char** argTypes;
+
+  VectorUdfEvaluate evaluate;
+
+  bool variableArity{false};
+  bool allowTypeConversion{false};
+  // Whether the result is null if any argument is null. Such rows are then never passed to evaluate.
+  bool defaultNullBehavior{true};
+  bool deterministic{true};
+};
+
+#define GLUTEN_GET_VECTOR_UDF_ABI_VERSION getVectorUdfAbiVersion
+#define DEFINE_GET_VECTOR_UDF_ABI_VERSION extern "C" int GLUTEN_GET_VECTOR_UDF_ABI_VERSION()
+
+#define GLUTEN_GET_NUM_VECTOR_UDF getNumVectorUdf
+#define DEFINE_GET_NUM_VECTOR_UDF extern "C" int GLUTEN_GET_NUM_VECTOR_UDF()
+
+#define GLUTEN_GET_VECTOR_UDF_ENTRIES getVectorUdfEntries
+#define DEFINE_GET_VECTOR_UDF_ENTRIES \
+  extern "C" void GLUTEN_GET_VECTOR_UDF_ENTRIES(gluten::VectorUdfEntry* vectorUdfEntries)
+
+} // namespace gluten
@@ -0,0 +1,93 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <vector>
+#include "udf/VectorUdf.h"
+
+// Vector UDF example, built against the Arrow C Data interface only.
+
+namespace {
+
+static const char* kBigInt = "bigint";
+
+namespace plusone {
+
+struct Result {
+  std::vector<int64_t> values;
+  const void* buffers[2];
+};
+
+void release(ArrowArray* array) {
+  delete static_cast<Result*>(array->private_data);
+  array->release = nullptr;
+}
+
+// name: org.apache.gluten.udf.VectorPlusOne
+// signatures:
+//    bigint -> bigint
+// type: VectorUdf
+int evaluate(
+    int64_t numRows,
+    const uint64_t* /*selection*/,
+    int32_t numArgs,
+    ArrowArray* const* args,
+    ArrowArray* result,
+    const char** errorMessage) {
+  if (numArgs != 1) {
+    *errorMessage = "VectorPlusOne takes one argument";
+    return 1;
+  }
+  const auto* input = static_cast<const int64_t*>(args[0]->buffers[1]) + args[0]->offset;
+  auto* out = new Result();
+  out->values.resize(numRows);
+  // Null rows never reach here and the values of unselected rows are ignored, so the loop needs no branch.
+  for (int64_t i = 0; i < numRows; ++i) {
+    out->values[i] = input[i] + 1;
+  }
+  out->buffers[0] = nullptr;
+  out->buffers[1] = out->values.data();
+
+  result->length = numRows;
+  result->null_count = 0;
+  result->offset = 0;
+  result->n_buffers = 2;
+  result->n_children = 0;
+  result->buffers = out->buffers;
+  result->children = nullptr;
+  result->dictionary = nullptr;
+  result->release = release;
+  result->private_data = out;
+  return 0;
+}
+
+const char* kArgs[] = {kBigInt};
+
+} // namespace plusone
+} // namespace
+
+DEFINE_GET_VECTOR_UDF_ABI_VERSION {
+  return GLUTEN_VECTOR_UDF_ABI_VERSION;
+}
+
+DEFINE_GET_NUM_VECTOR_UDF {
+  return 1;
+}
+
+DEFINE_GET_VECTOR_UDF_ENTRIES {
+  vectorUdfEntries[0] = {"org.apache.gluten.udf.VectorPlusOne", kBigInt, 1, plusone::kArgs, plusone::evaluate};
+}
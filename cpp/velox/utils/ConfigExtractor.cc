@@ -218,6 +218,8 @@ std::shared_ptr<facebook::velox::config::ConfigBase> getHiveConfig(
 
   hiveConfMap[facebook::velox::connector::hive::HiveConfig::kEnableFileHandleCache] =
       conf->get<bool>(kVeloxFileHandleCacheEnabled, kVeloxFileHandleCacheEnabledDefault) ? "true" : "false";
+  hiveConfMap[facebook::velox::connector::hive::HiveConfig::kNumCacheFileHandles] =
+      std::to_string(conf->get<int32_t>(kVeloxFileHandleCacheSize, kVeloxFileHandleCacheSizeDefault));
   hiveConfMap[facebook::velox::connector::hive::HiveConfig::kMaxCoalescedBytes] =
       conf->get<std::string>(kMaxCoalescedBytes, "67108864"); // 64M
   hiveConfMap[facebook::velox::connector::hive::HiveConfig::kMaxCoalescedDistance] =
@@ -0,0 +1,334 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FileFooterCache.h"
+
+#include <atomic>
+#include <cstring>
+
+#include <folly/ScopeGuard.h>
+#include <folly/futures/Future.h>
+
+#include "velox/common/base/RuntimeMetrics.h"
+#include "velox/common/file/FileSystems.h"
+
+using namespace facebook;
+
+namespace gluten {
+
+void FileFooterCache::registerFile(const std::string& path, int64_t modificationTime) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(path);
+  if (it != entries_.end()) {
+    auto& entry = it->second;
+    if (entry.modificationTime != modificationTime) {
+      dropTail(entry);
+      entry.modificationTime = modificationTime;
+      ++stats_.numInvalidations;
+    }
+    touch(entry);
+    return;
+  }
+  lru_.push_front(path);
+  Entry entry{modificationTime};
+  entry.lruPosition = lru_.begin();
+  bytes_ += entryBytes(path, entry);
+  entries_.emplace(path, std::move(entry));
+  evict();
+}
+
+bool FileFooterCache::isRegistered(const std::string& path) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return entries_.count(path) > 0;
+}
+
+FileFooterCache::ReadResult FileFooterCache::read(
+    const std::string& path,
+    const velox::ReadFile& file,
+    uint64_t offset,
+    uint64_t length,
+    void* buf,
+    velox::filesystems::File::IoStats* stats) {
+  const auto fileSize = file.size();
+  if (!inTail(fileSize, offset, length)) {
+    return ReadResult::kBypass;
+  }
+
+  std::shared_ptr<const std::string> cached;
+  uint64_t cachedOffset = 0;
+  int64_t modificationTime = 0;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = entries_.find(path);
+    if (it == entries_.end()) {
+      return ReadResult::kBypass;
+    }
+    auto& entry = it->second;
+    touch(entry);
+    if (entry.tail != nullptr && entry.fileSize == fileSize && entry.tailOffset <= offset) {
+      ++stats_.numHits;
+      cached = entry.tail;
+      cachedOffset = entry.tailOffset;
+    } else {
+      modificationTime = entry.modificationTime;
+    }
+  }
+  if (cached != nullptr) {
+    // The cached bytes are immutable, so they are copied without holding the lock.
+    std::memcpy(buf, cached->data() + (offset - cachedOffset), length);
+    if (stats != nullptr) {
+      stats->addCounter(std::string(kHitsStat), velox::RuntimeCounter(1));
+    }
+    return ReadResult::kHit;
+  }
+
+  // Reads through the end of the file, so that the other footer reads of the file hit.
+  auto tail = std::make_shared<std::string>(fileSize - offset, '\0');
+  file.pread(offset, tail->size(), tail->data(), stats);
+  std::memcpy(buf, tail->data(), length);
+  if (stats != nullptr) {
+    stats->addCounter(std::string(kMissesStat), velox::RuntimeCounter(1));
+  }
+
+  std::lock_guard<std::mutex> l(mutex_);
+  ++stats_.numMisses;
+  auto it = entries_.find(path);
+  // Not cached if the file was evicted or registered with another version while being read.
+  if (it == entries_.end() || it->second.modificationTime != modificationTime) {
+    return ReadResult::kMiss;
+  }
+  auto& entry = it->second;
+  if (entry.tail != nullptr && entry.fileSize == fileSize && entry.tailOffset <= offset) {
+    return ReadResult::kMiss;
+  }
+  dropTail(entry);
+  entry.fileSize = fileSize;
+  entry.tailOffset = offset;
+  entry.tail = std::move(tail);
+  bytes_ += entry.tail->size();
+  evict();
+  return ReadResult::kMiss;
+}
+
+FileFooterCache::Stats FileFooterCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto stats = stats_;
+  stats.numEntries = entries_.size();
+  stats.cachedBytes = bytes_;
+  return stats;
+}
+
+void FileFooterCache::touch(Entry& entry) {
+  lru_.splice(lru_.begin(), lru_, entry.lruPosition);
+}
+
+void FileFooterCache::dropTail(Entry& entry) {
+  if (entry.tail != nullptr) {
+    bytes_ -= entry.tail->size();
+    entry.tail.reset();
+  }
+}
+
+void FileFooterCache::evict() {
+  while (bytes_ > capacity_ && !lru_.empty()) {
+    auto it = entries_.find(lru_.back());
+    bytes_ -= entryBytes(it->first, it->second);
+    entries_.erase(it);
+    lru_.pop_back();
+  }
+}
+
+namespace {
+
+class FooterCachingReadFile : public velox::ReadFile {
+ public:
+  FooterCachingReadFile(
+      std::unique_ptr<velox::ReadFile> file,
+      std::string path,
+      std::shared_ptr<FileFooterCache> cache)
+      : file_(std::move(file)), path_(std::move(path)), cache_(std::move(cache)) {}
+
+  std::string_view pread(
+      uint64_t offset,
+      uint64_t length,
+      void* buf,
+      velox::filesystems::File::IoStats* stats = nullptr) const override {
+    if (cache_->read(path_, *file_, offset, length, buf, stats) == FileFooterCache::ReadResult::kBypass) {
+      return file_->pread(offset, length, buf, stats);
+    }
+    return {static_cast<char*>(buf), length};
+  }
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      velox::filesystems::File::IoStats* stats = nullptr) const override {
+    if (!inTail(offset, buffers)) {
+      return file_->preadv(offset, buffers, stats);
+    }
+    // Reads the ranges one by one through pread, which serves them from the cache.
+    return ReadFile::preadv(offset, buffers, stats);
+  }
+
+  uint64_t preadv(
+      folly::Range<const velox::common::Region*> regions,
+      folly::Range<folly::IOBuf*> iobufs,
+      velox::filesystems::File::IoStats* stats = nullptr) const override {
+    return file_->preadv(regions, iobufs, stats);
+  }
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      velox::filesystems::File::IoStats* stats = nullptr) const override {
+    if (!inTail(offset, buffers)) {
+      return file_->preadvAsync(offset, buffers, stats);
+    }
+    return folly::makeSemiFuture(ReadFile::preadv(offset, buffers, stats));
+  }
+
+  bool hasPreadvAsync() const override {
+    return file_->hasPreadvAsync();
+  }
+
+  bool shouldCoalesce() const override {
+    return file_->shouldCoalesce();
+  }
+
+  uint64_t size() const override {
+    return file_->size();
+  }
+
+  uint64_t memoryUsage() const override {
+    return file_->memoryUsage();
+  }
+
+  std::string getName() const override {
+    return file_->getName();
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return file_->getNaturalReadSize();
+  }
+
+ private:
+  bool inTail(uint64_t offset, const std::vector<folly::Range<char*>>& buffers) const {
+    uint64_t length = 0;
+    for (const auto& range : buffers) {
+      length += range.size();
+    }
+    return cache_->inTail(file_->size(), offset, length);
+  }
+
+  const std::unique_ptr<velox::ReadFile> file_;
+  const std::string path_;
+  const std::shared_ptr<FileFooterCache> cache_;
+};
+
+// Delegates to the file system the path resolves to without this one, and wraps the files it opens for read.
+class FooterCacheFileSystem : public velox::filesystems::FileSystem {
+ public:
+  FooterCacheFileSystem(
+      std::shared_ptr<velox::filesystems::FileSystem> fs,
+      std::shared_ptr<FileFooterCache> cache)
+      : FileSystem({}), fs_(std::move(fs)), cache_(std::move(cache)) {}
+
+  std::string name() const override {
+    return fs_->name();
+  }
+
+  std::unique_ptr<velox::ReadFile> openFileForRead(
+      std::string_view path,
+      const velox::filesystems::FileOptions& options) override {
+    return makeFooterCachingReadFile(fs_->openFileForRead(path, options), std::string(path), cache_);
+  }
+
+  std::unique_ptr<velox::WriteFile> openFileForWrite(
+      std::string_view path,
+      const velox::filesystems::FileOptions& options) override {
+    return fs_->openFileForWrite(path, options);
+  }
+
+  void remove(std::string_view path) override {
+    fs_->remove(path);
+  }
+
+  void rename(std::string_view oldPath, std::string_view newPath, bool overwrite) override {
+    fs_->rename(oldPath, newPath, overwrite);
+  }
+
+  bool exists(std::string_view path) override {
+    return fs_->exists(path);
+  }
+
+  std::vector<std::string> list(std::string_view path) override {
+    return fs_->list(path);
+  }
+
+  void mkdir(std::string_view path, const velox::filesystems::DirectoryOptions& options = {}) override {
+    fs_->mkdir(path, options);
+  }
+
+  void rmdir(std::string_view path) override {
+    fs_->rmdir(path);
+  }
+
+ private:
+  const std::shared_ptr<velox::filesystems::FileSystem> fs_;
+  const std::shared_ptr<FileFooterCache> cache_;
+};
+
+std::shared_ptr<FileFooterCache> footerCache;
+// Set while resolving the file system behind FooterCacheFileSystem, so that it doesn't match itself.
+thread_local bool resolvingWrappedFileSystem = false;
+
+} // namespace
+
+std::unique_ptr<velox::ReadFile> makeFooterCachingReadFile(
+    std::unique_ptr<velox::ReadFile> file,
+    std::string path,
+    std::shared_ptr<FileFooterCache> cache) {
+  if (!cache->isRegistered(path)) {
+    return file;
+  }
+  return std::make_unique<FooterCachingReadFile>(std::move(file), std::move(path), std::move(cache));
+}
+
+void registerFileFooterCacheFileSystem(std::shared_ptr<FileFooterCache> cache) {
+  static std::once_flag registered;
+  std::atomic_store(&footerCache, std::move(cache));
+  std::call_once(registered, []() {
+    auto schemeMatcher = [](std::string_view filePath) {
+      // Spill files of the "jol:" and "jni:" file systems are never cached.
+      return !resolvingWrappedFileSystem && std::atomic_load(&footerCache) != nullptr &&
+          filePath.find("jol:") != 0 && filePath.find("jni:") != 0;
+    };
+    auto fileSystemGenerator =
+        [](std::shared_ptr<const velox::config::ConfigBase> properties,
+           std::string_view filePath) -> std::shared_ptr<velox::filesystems::FileSystem> {
+      resolvingWrappedFileSystem = true;
+      SCOPE_EXIT {
+        resolvingWrappedFileSystem = false;
+      };
+      return std::make_shared<FooterCacheFileSystem>(
+          velox::filesystems::getFileSystem(filePath, properties), std::atomic_load(&footerCache));
+    };
+    velox::filesystems::registerFileSystem(schemeMatcher, fileSystemGenerator);
+  });
+}
+
+} // namespace gluten
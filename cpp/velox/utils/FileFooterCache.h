@@ -0,0 +1,125 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "velox/common/file/File.h"
+
+namespace gluten {
+
+/// Executor-wide LRU cache of the last bytes of data files, which hold the Parquet and ORC footers. The readers of
+/// consecutive tasks reading the same files, e.g. the dimension tables of a star join, then don't fetch the footer
+/// from the storage again.
+///
+/// A file is cached under its path, size and modification time. The modification time is not known to the file
+/// system, so it is registered from the split before the file is read, and the files without one are never cached.
+/// The cache is bounded in bytes, including the entries of registered files that hold no bytes yet.
+class FileFooterCache {
+ public:
+  struct Stats {
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    uint64_t numInvalidations{0};
+    uint64_t numEntries{0};
+    uint64_t cachedBytes{0};
+  };
+
+  enum class ReadResult { kBypass, kHit, kMiss };
+
+  /// Names of the scan runtime stats counting the cache hits and misses.
+  static constexpr std::string_view kHitsStat{"footerCacheHits"};
+  static constexpr std::string_view kMissesStat{"footerCacheMisses"};
+
+  /// Reads within the last 'maxTailSize' bytes of a file go through the cache.
+  FileFooterCache(uint64_t capacity, uint64_t maxTailSize) : capacity_(capacity), maxTailSize_(maxTailSize) {}
+
+  /// Records the modification time of a file a split is about to read. Drops the cached bytes of the file if it was
+  /// modified since they were cached.
+  void registerFile(const std::string& path, int64_t modificationTime);
+
+  /// Whether 'path' has an entry. Files that are not registered when they are opened are read around the cache.
+  bool isRegistered(const std::string& path) const;
+
+  /// Reads [offset, offset + length) of 'file' at 'path' into 'buf' if the range is in the tail of a registered file.
+  /// On a miss, reads the file from 'offset' to its end and caches it. Returns kBypass without reading anything if the
+  /// range can't be cached.
+  ReadResult read(
+      const std::string& path,
+      const facebook::velox::ReadFile& file,
+      uint64_t offset,
+      uint64_t length,
+      void* buf,
+      facebook::velox::filesystems::File::IoStats* stats = nullptr);
+
+  /// Whether [offset, offset + length) is in the tail of a file of 'fileSize' bytes.
+  bool inTail(uint64_t fileSize, uint64_t offset, uint64_t length) const {
+    return length > 0 && offset + length <= fileSize && fileSize - offset <= maxTailSize_;
+  }
+
+  Stats stats() const;
+
+ private:
+  struct Entry {
+    int64_t modificationTime;
+    // Size of the file when 'tail' was read, and the offset 'tail' starts at.
+    uint64_t fileSize{0};
+    uint64_t tailOffset{0};
+    std::shared_ptr<const std::string> tail;
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  static uint64_t entryBytes(const std::string& path, const Entry& entry) {
+    return sizeof(Entry) + 2 * path.size() + (entry.tail == nullptr ? 0 : entry.tail->size());
+  }
+
+  void touch(Entry& entry);
+
+  void dropTail(Entry& entry);
+
+  // Evicts the least recently used entries until the cache is within capacity.
+  void evict();
+
+  const uint64_t capacity_;
+  const uint64_t maxTailSize_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  // Most recently used first.
+  std::list<std::string> lru_;
+  uint64_t bytes_{0};
+  Stats stats_;
+};
+
+/// Routes the files opened for read through 'cache', by registering a file system in front of the ones registered
+/// later. Must be called before the other file systems are registered. A null 'cache' disables the routing.
+void registerFileFooterCacheFileSystem(std::shared_ptr<FileFooterCache> cache);
+
+/// Wraps 'file' so that its reads go through 'cache'. Returns 'file' itself if 'path' is not registered, e.g. spill or
+/// local files, so that their reads don't pay for the size lookup and the lock of the cache.
+std::unique_ptr<facebook::velox::ReadFile> makeFooterCachingReadFile(
+    std::unique_ptr<facebook::velox::ReadFile> file,
+    std::string path,
+    std::shared_ptr<FileFooterCache> cache);
+
+} // namespace gluten
@@ -0,0 +1,144 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SsdCacheManifest.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/caching/StringIdMap.h"
+
+using namespace facebook;
+
+namespace gluten {
+namespace {
+
+constexpr int32_t kManifestMagic = 0x53534d46;
+
+template <typename T>
+void writeValue(std::ofstream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::ifstream& in, T& value) {
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+} // namespace
+
+std::optional<SsdCacheManifest::Versions> SsdCacheManifest::read(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return std::nullopt;
+  }
+  // Removed once read, so a process that dies before saving again leaves no stale manifest behind.
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+
+  int32_t magic;
+  int64_t numEntries;
+  if (!readValue(in, magic) || magic != kManifestMagic || !readValue(in, numEntries) || numEntries < 0) {
+    return std::nullopt;
+  }
+  Versions versions;
+  versions.reserve(std::min<int64_t>(numEntries, 1 << 20));
+  for (int64_t i = 0; i < numEntries; ++i) {
+    int64_t modificationTime;
+    int32_t length;
+    if (!readValue(in, modificationTime) || !readValue(in, length) || length < 0) {
+      return std::nullopt;
+    }
+    std::string filePath(length, '\0');
+    if (!in.read(filePath.data(), length)) {
+      return std::nullopt;
+    }
+    versions.emplace(std::move(filePath), modificationTime);
+  }
+  return versions;
+}
+
+bool SsdCacheManifest::validate(const std::string& filePath, int64_t modificationTime) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = versions_.try_emplace(filePath, modificationTime);
+    if (inserted || it->second == modificationTime) {
+      return false;
+    }
+    it->second = modificationTime;
+  }
+  LOG(INFO) << "Evicting SSD cache entries of modified file " << filePath;
+  velox::StringIdLease fileId(velox::fileIds(), filePath);
+  folly::F14FastSet<uint64_t> filesToRemove{fileId.id()};
+  folly::F14FastSet<uint64_t> filesRetained;
+  // Entries can't be removed while the cache is being written.
+  while (!ssdCache_->removeFileEntries(filesToRemove, filesRetained)) {
+    ssdCache_->waitForWriteToFinish();
+  }
+  return true;
+}
+
+void SsdCacheManifest::save() const {
+  const auto tmpPath = path_ + ".tmp";
+  size_t numFiles;
+  {
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    std::lock_guard<std::mutex> lock(mutex_);
+    numFiles = versions_.size();
+    writeValue(out, kManifestMagic);
+    writeValue<int64_t>(out, versions_.size());
+    for (const auto& [filePath, modificationTime] : versions_) {
+      writeValue(out, modificationTime);
+      writeValue<int32_t>(out, filePath.size());
+      out.write(filePath.data(), filePath.size());
+    }
+    if (!out.flush()) {
+      LOG(WARNING) << "Failed to write SSD cache manifest " << tmpPath;
+      return;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, path_, ec);
+  if (ec) {
+    LOG(WARNING) << "Failed to save SSD cache manifest " << path_ << ": " << ec.message();
+    return;
+  }
+  LOG(INFO) << "Saved SSD cache manifest " << path_ << " with " << numFiles << " files";
+}
+
+std::optional<std::string> SsdCacheManifest::lockSlot(const std::string& directory, int32_t maxSlots) {
+  for (int32_t slot = 0; slot < maxSlots; ++slot) {
+    const auto lockPath = directory + "/cache.persistent.lock." + std::to_string(slot);
+    const int fd = ::open(lockPath.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, 0644);
+    if (fd < 0) {
+      LOG(WARNING) << "Failed to open " << lockPath << ": " << std::strerror(errno);
+      return std::nullopt;
+    }
+    if (::flock(fd, LOCK_EX | LOCK_NB) == 0) {
+      return "cache.persistent." + std::to_string(slot) + ".";
+    }
+    ::close(fd);
+  }
+  return std::nullopt;
+}
+
+} // namespace gluten
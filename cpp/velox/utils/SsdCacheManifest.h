@@ -0,0 +1,61 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "velox/common/caching/SsdCache.h"
+
+namespace gluten {
+
+/// Modification times of the files read through a persistent SSD cache. The SSD cache keys its entries on the file
+/// path only, so the manifest is saved next to the cache checkpoint on shutdown. After a restart, the entries restored
+/// for a file are evicted before it is read again if the file was modified in the meantime.
+class SsdCacheManifest {
+ public:
+  using Versions = std::unordered_map<std::string, int64_t>;
+
+  SsdCacheManifest(std::string path, facebook::velox::cache::SsdCache* ssdCache, Versions versions)
+      : path_(std::move(path)), ssdCache_(ssdCache), versions_(std::move(versions)) {}
+
+  /// Reads and removes the manifest at path. Returns std::nullopt if it is missing or corrupted, e.g. after a crash,
+  /// in which case the cache restored from the checkpoint can't be validated.
+  static std::optional<Versions> read(const std::string& path);
+
+  /// Records the modification time of filePath. Returns true if cached entries of another version were evicted.
+  bool validate(const std::string& filePath, int64_t modificationTime);
+
+  void save() const;
+
+  /// Locks the first free one of 'maxSlots' slots of persistent SSD cache files in 'directory', so executors sharing a
+  /// host don't write to the same files. The lock is held until the process exits. Returns the cache file prefix of
+  /// the slot, or std::nullopt if all slots are taken.
+  static std::optional<std::string> lockSlot(const std::string& directory, int32_t maxSlots = 16);
+
+ private:
+  const std::string path_;
+  facebook::velox::cache::SsdCache* const ssdCache_;
+
+  mutable std::mutex mutex_;
+  Versions versions_;
+};
+
+} // namespace gluten
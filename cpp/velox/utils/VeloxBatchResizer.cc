@@ -43,6 +43,27 @@ class SliceRowVector : public ColumnarBatchIterator {
   facebook::velox::RowVectorPtr in_;
   int32_t cursor_ = 0;
 };
+
+// Copies the pending vectors into one vector, which is allocated once with its final size. A single pending vector
+// is returned as is.
+facebook::velox::RowVectorPtr concatenate(
+    facebook::velox::memory::MemoryPool* pool,
+    const std::vector<facebook::velox::RowVectorPtr>& pending,
+    facebook::velox::vector_size_t numRows) {
+  GLUTEN_CHECK(!pending.empty(), "Invalid state");
+  if (pending.size() == 1) {
+    return pending.front();
+  }
+  auto out = std::static_pointer_cast<facebook::velox::RowVector>(
+      facebook::velox::BaseVector::create(pending.front()->type(), numRows, pool));
+  facebook::velox::vector_size_t offset = 0;
+  for (const auto& rv : pending) {
+    out->copy(rv.get(), offset, 0, rv->size());
+    offset += rv->size();
+  }
+  GLUTEN_CHECK(offset == numRows, "Invalid state");
+  return out;
+}
 } // namespace
 
 gluten::VeloxBatchResizer::VeloxBatchResizer(
@@ -67,6 +88,7 @@ std::shared_ptr<ColumnarBatch> VeloxBatchResizer::next() {
     }
     // Cached output was drained. Continue reading data from input iterator.
     next_ = nullptr;
+    retainedBytes_ = 0;
   }
 
   auto cb = in_->next();
@@ -76,33 +98,40 @@ std::shared_ptr<ColumnarBatch> VeloxBatchResizer::next() {
   }
 
   if (cb->numRows() < minOutputBatchSize_) {
+    // Only collect the input vectors here, they are copied once when the output batch is complete. If no other
+    // vector follows, the input is passed through without a copy.
     auto vb = VeloxColumnarBatch::from(pool_, cb);
-    auto rv = vb->getRowVector();
-    auto buffer = facebook::velox::RowVector::createEmpty(rv->type(), pool_);
-    buffer->append(rv.get());
+    std::vector<facebook::velox::RowVectorPtr> pending{vb->getRowVector()};
+    facebook::velox::vector_size_t numPendingRows = pending.back()->size();
 
     for (auto nextCb = in_->next(); nextCb != nullptr; nextCb = in_->next()) {
       auto nextVb = VeloxColumnarBatch::from(pool_, nextCb);
       auto nextRv = nextVb->getRowVector();
-      if (buffer->size() + nextRv->size() > maxOutputBatchSize_) {
+      if (numPendingRows + nextRv->size() > maxOutputBatchSize_) {
         GLUTEN_CHECK(next_ == nullptr, "Invalid state");
         next_ = std::make_unique<SliceRowVector>(maxOutputBatchSize_, nextRv);
-        return std::make_shared<VeloxColumnarBatch>(buffer);
+        retainedBytes_ = nextRv->retainedSize();
+        peakRetainedBytes_ = std::max(peakRetainedBytes_, retainedBytes_);
+        break;
       }
-      buffer->append(nextRv.get());
-      if (buffer->size() >= minOutputBatchSize_) {
+      numPendingRows += nextRv->size();
+      pending.push_back(std::move(nextRv));
+      if (numPendingRows >= minOutputBatchSize_) {
         // Buffer is full.
         break;
       }
     }
-    return std::make_shared<VeloxColumnarBatch>(buffer);
+    return std::make_shared<VeloxColumnarBatch>(concatenate(pool_, pending, numPendingRows));
   }
 
   if (cb->numRows() > maxOutputBatchSize_) {
+    // Slices share the buffers of the input vector, which stays alive until all of them are released.
     auto vb = VeloxColumnarBatch::from(pool_, cb);
     auto rv = vb->getRowVector();
     GLUTEN_CHECK(next_ == nullptr, "Invalid state");
     next_ = std::make_unique<SliceRowVector>(maxOutputBatchSize_, rv);
+    retainedBytes_ = rv->retainedSize();
+    peakRetainedBytes_ = std::max(peakRetainedBytes_, retainedBytes_);
     auto next = next_->next();
     GLUTEN_CHECK(next != nullptr, "Invalid state");
     return next;
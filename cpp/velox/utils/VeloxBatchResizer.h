@@ -35,6 +35,16 @@ class VeloxBatchResizer : public ColumnarBatchIterator {
 
   int64_t spillFixedSize(int64_t size) override;
 
+  /// Bytes of the input vector held while its slices are being returned.
+  int64_t retainedBytes() const {
+    return retainedBytes_;
+  }
+
+  /// Max of retainedBytes() so far, reported as an operator metric.
+  int64_t peakRetainedBytes() const {
+    return peakRetainedBytes_;
+  }
+
  private:
   facebook::velox::memory::MemoryPool* pool_;
   const int32_t minOutputBatchSize_;
@@ -42,6 +52,8 @@ class VeloxBatchResizer : public ColumnarBatchIterator {
   std::unique_ptr<ColumnarBatchIterator> in_;
 
   std::unique_ptr<ColumnarBatchIterator> next_ = nullptr;
+  int64_t retainedBytes_ = 0;
+  int64_t peakRetainedBytes_ = 0;
 };
 
 } // namespace gluten
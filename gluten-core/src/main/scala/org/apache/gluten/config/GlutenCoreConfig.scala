@@ -182,6 +182,17 @@ object GlutenCoreConfig {
       .bytesConf(ByteUnit.BYTE)
       .createWithDefaultString("8MB")
 
+  val COLUMNAR_MEMORY_RESERVATION_CACHE_MAX_CHUNK_SIZE =
+    buildConf("spark.gluten.memory.reservationCacheMaxChunkSize")
+      .internal()
+      .doc(
+        "If larger than 0, native memory is reserved from Spark ahead of use in chunks that grow " +
+          "from the reservation block size up to this size while the task keeps allocating, and " +
+          "unused reservation is returned lazily or on spill. Reduces the number of JNI " +
+          "reservation calls of allocation heavy tasks. 0 disables the cache.")
+      .bytesConf(ByteUnit.BYTE)
+      .createWithDefaultString("0")
+
   val NUM_TASK_SLOTS_PER_EXECUTOR =
     buildConf("spark.gluten.numTaskSlotsPerExecutor")
       .internal()
@@ -1032,6 +1032,24 @@ object GlutenConfig {
       .transform(_.toLowerCase(Locale.ROOT))
       .createOptional
 
+  val COLUMNAR_SHUFFLE_IAA_JOB_POOL_SIZE =
+    buildStaticConf("spark.gluten.sql.columnar.shuffle.iaa.jobPoolSize")
+      .internal()
+      .doc("Number of QPL jobs created at startup when codecBackend is iaa.")
+      .intConf
+      .checkValue(_ > 0, "must be a positive number")
+      .createWithDefault(64)
+
+  val COLUMNAR_SHUFFLE_IAA_JOB_POOL_MAX_SIZE =
+    buildStaticConf("spark.gluten.sql.columnar.shuffle.iaa.jobPoolMaxSize")
+      .internal()
+      .doc(
+        "Max number of QPL jobs when codecBackend is iaa. The job pool grows up to it when " +
+          "all the jobs are in use. 0 means twice the number of hardware threads.")
+      .intConf
+      .checkValue(_ >= 0, "must not be negative")
+      .createWithDefault(0)
+
   val COLUMNAR_SHUFFLE_COMPRESSION_MODE =
     buildConf("spark.gluten.sql.columnar.shuffle.compressionMode")
       .internal()